@@ -83,6 +83,113 @@ BENCHMARK_DEFINE_F(Ipv4AddressFixture, BM_parse_boost)(benchmark::State& state)
 }
 BENCHMARK_REGISTER_F(Ipv4AddressFixture, BM_parse_boost)->Apply(Arguments);
 
+// IPv4 batch parser tests
+// 
+static const std::vector<std::string>& ipv4_batch() {
+    static const std::vector<std::string> addresses = [] {
+        std::vector<std::string> result;
+        for (uint32_t i = 0; i < 1024; ++i) {
+            const auto ip = i * 2654435761U;
+            result.push_back(ipaddress::ipv4_address::from_uint(ip >> (i % 3 * 8)).to_string());
+        }
+        return result;
+    }();
+    return addresses;
+}
+
+static void BM_parse_many_loop_ipaddress(benchmark::State& state) {
+    const auto& addresses = ipv4_batch();
+    std::vector<ipaddress::ipv4_address> result(addresses.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < addresses.size(); ++i) {
+            auto code = ipaddress::error_code::no_error;
+            result[i] = ipaddress::ipv4_address::parse(addresses[i], code);
+        }
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * addresses.size()));
+}
+BENCHMARK(BM_parse_many_loop_ipaddress);
+
+static void BM_parse_many_ipaddress(benchmark::State& state) {
+    const auto& addresses = ipv4_batch();
+    std::vector<ipaddress::ipv4_address> result(addresses.size());
+    std::vector<ipaddress::error_code> codes(addresses.size());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ipaddress::ipv4_address::parse_many(addresses.data(), addresses.size(), result.data(), codes.data()));
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * addresses.size()));
+}
+BENCHMARK(BM_parse_many_ipaddress);
+
+// IPv4 address formatter tests
+// 
+BENCHMARK_DEFINE_F(Ipv4AddressFixture, BM_to_string_ipaddress)(benchmark::State& state) {
+    const auto ip = ipaddress::ipv4_address::parse(str);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ip.to_string());
+    }
+}
+BENCHMARK_REGISTER_F(Ipv4AddressFixture, BM_to_string_ipaddress)->Apply(Arguments);
+
+BENCHMARK_DEFINE_F(Ipv4AddressFixture, BM_to_chars_ipaddress)(benchmark::State& state) {
+    const auto ip = ipaddress::ipv4_address::parse(str);
+    char buffer[ipaddress::ipv4_address::base_max_string_len];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ip.to_chars(buffer, buffer + sizeof(buffer)));
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK_REGISTER_F(Ipv4AddressFixture, BM_to_chars_ipaddress)->Apply(Arguments);
+
+BENCHMARK_DEFINE_F(Ipv4AddressFixture, BM_to_chars_inet_ntop)(benchmark::State& state) {
+    in_addr ip_addr{};
+    inet_pton(AF_INET, str.data(), &ip_addr);
+    char buffer[INET_ADDRSTRLEN];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(inet_ntop(AF_INET, &ip_addr, buffer, sizeof(buffer)));
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK_REGISTER_F(Ipv4AddressFixture, BM_to_chars_inet_ntop)->Apply(Arguments);
+
+BENCHMARK_DEFINE_F(Ipv4AddressFixture, BM_to_string_boost)(benchmark::State& state) {
+    const auto ip = boost::asio::ip::make_address_v4(str);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ip.to_string());
+    }
+}
+BENCHMARK_REGISTER_F(Ipv4AddressFixture, BM_to_string_boost)->Apply(Arguments);
+
+static void BM_format_many_loop_ipaddress(benchmark::State& state) {
+    const auto& strings = ipv4_batch();
+    std::vector<ipaddress::ipv4_address> addresses(strings.size());
+    ipaddress::ipv4_address::parse_many(strings.data(), strings.size(), addresses.data());
+    std::string result;
+    for (auto _ : state) {
+        result.clear();
+        for (const auto& address : addresses) {
+            result += address.to_string();
+            result += '\n';
+        }
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * addresses.size()));
+}
+BENCHMARK(BM_format_many_loop_ipaddress);
+
+static void BM_format_many_ipaddress(benchmark::State& state) {
+    const auto& strings = ipv4_batch();
+    std::vector<ipaddress::ipv4_address> addresses(strings.size());
+    ipaddress::ipv4_address::parse_many(strings.data(), strings.size(), addresses.data());
+    std::vector<char> result(addresses.size() * (ipaddress::ipv4_address::base_max_string_len + 1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ipaddress::ipv4_address::format_many(addresses.data(), addresses.size(), result.data(), result.data() + result.size()));
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * addresses.size()));
+}
+BENCHMARK(BM_format_many_ipaddress);
+
 // IPv6 address parser tests
 // 
 BENCHMARK_DEFINE_F(Ipv6AddressFixture, BM_parse_ipaddress)(benchmark::State& state) {
@@ -109,3 +216,246 @@ BENCHMARK_DEFINE_F(Ipv6AddressFixture, BM_parse_boost)(benchmark::State& state)
     }
 }
 BENCHMARK_REGISTER_F(Ipv6AddressFixture, BM_parse_boost)->Apply(Arguments);
+
+// IPv6 address formatter tests
+// 
+BENCHMARK_DEFINE_F(Ipv6AddressFixture, BM_to_string_ipaddress)(benchmark::State& state) {
+    const auto ip = ipaddress::ipv6_address::parse(str);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ip.to_string());
+    }
+}
+BENCHMARK_REGISTER_F(Ipv6AddressFixture, BM_to_string_ipaddress)->Apply(Arguments);
+
+BENCHMARK_DEFINE_F(Ipv6AddressFixture, BM_to_chars_ipaddress)(benchmark::State& state) {
+    const auto ip = ipaddress::ipv6_address::parse(str);
+    char buffer[ipaddress::ipv6_address::base_max_string_len];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ip.to_chars(buffer, buffer + sizeof(buffer)));
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK_REGISTER_F(Ipv6AddressFixture, BM_to_chars_ipaddress)->Apply(Arguments);
+
+BENCHMARK_DEFINE_F(Ipv6AddressFixture, BM_to_chars_inet_ntop)(benchmark::State& state) {
+    in6_addr ip_addr{};
+    inet_pton(AF_INET6, str.substr(0, str.find('%')).data(), &ip_addr);
+    char buffer[INET6_ADDRSTRLEN];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(inet_ntop(AF_INET6, &ip_addr, buffer, sizeof(buffer)));
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK_REGISTER_F(Ipv6AddressFixture, BM_to_chars_inet_ntop)->Apply(Arguments);
+
+BENCHMARK_DEFINE_F(Ipv6AddressFixture, BM_to_string_boost)(benchmark::State& state) {
+    const auto ip = boost::asio::ip::make_address_v6(str);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ip.to_string());
+    }
+}
+BENCHMARK_REGISTER_F(Ipv6AddressFixture, BM_to_string_boost)->Apply(Arguments);
+
+// Address classification tests
+// 
+BENCHMARK_DEFINE_F(Ipv4AddressFixture, BM_is_props_ipaddress)(benchmark::State& state) {
+    const auto ip = ipaddress::ipv4_address::parse(str);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ip.is_private());
+        benchmark::DoNotOptimize(ip.is_global());
+        benchmark::DoNotOptimize(ip.is_reserved());
+        benchmark::DoNotOptimize(ip.is_multicast());
+        benchmark::DoNotOptimize(ip.is_loopback());
+        benchmark::DoNotOptimize(ip.is_link_local());
+    }
+}
+BENCHMARK_REGISTER_F(Ipv4AddressFixture, BM_is_props_ipaddress)->Apply(Arguments);
+
+BENCHMARK_DEFINE_F(Ipv4AddressFixture, BM_classify_ipaddress)(benchmark::State& state) {
+    const auto ip = ipaddress::ipv4_address::parse(str);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ip.classify());
+    }
+}
+BENCHMARK_REGISTER_F(Ipv4AddressFixture, BM_classify_ipaddress)->Apply(Arguments);
+
+BENCHMARK_DEFINE_F(Ipv6AddressFixture, BM_is_props_ipaddress)(benchmark::State& state) {
+    const auto ip = ipaddress::ipv6_address::parse(str);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ip.is_private());
+        benchmark::DoNotOptimize(ip.is_global());
+        benchmark::DoNotOptimize(ip.is_reserved());
+        benchmark::DoNotOptimize(ip.is_multicast());
+        benchmark::DoNotOptimize(ip.is_loopback());
+        benchmark::DoNotOptimize(ip.is_link_local());
+        benchmark::DoNotOptimize(ip.is_site_local());
+    }
+}
+BENCHMARK_REGISTER_F(Ipv6AddressFixture, BM_is_props_ipaddress)->Apply(Arguments);
+
+BENCHMARK_DEFINE_F(Ipv6AddressFixture, BM_classify_ipaddress)(benchmark::State& state) {
+    const auto ip = ipaddress::ipv6_address::parse(str);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ip.classify());
+    }
+}
+BENCHMARK_REGISTER_F(Ipv6AddressFixture, BM_classify_ipaddress)->Apply(Arguments);
+
+static std::vector<ipaddress::ipv4_address> ipv4_address_batch() {
+    std::vector<ipaddress::ipv4_address> result;
+    for (const auto& address : ipv4_batch()) {
+        result.push_back(ipaddress::ipv4_address::parse(address));
+    }
+    result.resize(256);
+    return result;
+}
+
+static void BM_classify_many_loop_ipaddress(benchmark::State& state) {
+    const auto addresses = ipv4_address_batch();
+    std::vector<uint8_t> flags(addresses.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < addresses.size(); ++i) {
+            const auto& ip = addresses[i];
+            flags[i] = uint8_t(ip.is_private()) | uint8_t(ip.is_global()) << 1 | uint8_t(ip.is_multicast()) << 3;
+        }
+        benchmark::DoNotOptimize(flags.data());
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * addresses.size()));
+}
+BENCHMARK(BM_classify_many_loop_ipaddress);
+
+static void BM_classify_many_ipaddress(benchmark::State& state) {
+    const auto addresses = ipv4_address_batch();
+    std::vector<uint8_t> flags(addresses.size());
+    for (auto _ : state) {
+        ipaddress::ipv4_address::classify_many(addresses.data(), addresses.size(), flags.data());
+        benchmark::DoNotOptimize(flags.data());
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * addresses.size()));
+}
+BENCHMARK(BM_classify_many_ipaddress);
+
+// Address comparison and hashing tests
+// 
+static std::vector<ipaddress::ipv6_address> ipv6_address_batch() {
+    std::vector<ipaddress::ipv6_address> result;
+    for (const auto& ipv4 : ipv4_address_batch()) {
+        const auto ip = uint64_t(ipv4.to_uint()) * 0x9e3779b97f4a7c15ULL;
+        result.push_back(ipaddress::ipv6_address::from_uint(ipaddress::uint128_t(0x20010db800000000ULL | (ip >> 48), ip)));
+    }
+    return result;
+}
+
+template <typename T>
+static void sort_batch(benchmark::State& state, const std::vector<T>& addresses) {
+    std::vector<T> sorted(addresses.size());
+    for (auto _ : state) {
+        std::copy(addresses.cbegin(), addresses.cend(), sorted.begin());
+        std::sort(sorted.begin(), sorted.end());
+        benchmark::DoNotOptimize(sorted.data());
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * addresses.size()));
+}
+
+template <typename T>
+static void hash_batch(benchmark::State& state, const std::vector<T>& addresses) {
+    for (auto _ : state) {
+        size_t result = 0;
+        for (const auto& ip : addresses) {
+            result ^= ip.hash();
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * addresses.size()));
+}
+
+static void BM_sort_ipv4_ipaddress(benchmark::State& state) {
+    sort_batch(state, ipv4_address_batch());
+}
+BENCHMARK(BM_sort_ipv4_ipaddress);
+
+static void BM_sort_ipv6_ipaddress(benchmark::State& state) {
+    sort_batch(state, ipv6_address_batch());
+}
+BENCHMARK(BM_sort_ipv6_ipaddress);
+
+static void BM_hash_ipv4_ipaddress(benchmark::State& state) {
+    hash_batch(state, ipv4_address_batch());
+}
+BENCHMARK(BM_hash_ipv4_ipaddress);
+
+static void BM_hash_ipv6_ipaddress(benchmark::State& state) {
+    hash_batch(state, ipv6_address_batch());
+}
+BENCHMARK(BM_hash_ipv6_ipaddress);
+
+// Mixed IPv4/IPv6 parser tests
+// 
+static std::vector<std::string> mixed_batch(bool networks) {
+    std::vector<std::string> result;
+    const auto ipv4 = ipv4_address_batch();
+    const auto ipv6 = ipv6_address_batch();
+    for (size_t i = 0; i < ipv4.size(); ++i) {
+        result.push_back(ipv4[i].to_string() + (networks ? "/32" : ""));
+        result.push_back(ipv6[i].to_string() + (networks ? "/128" : ""));
+    }
+    return result;
+}
+
+static void BM_parse_mixed_two_pass_ipaddress(benchmark::State& state) {
+    const auto addresses = mixed_batch(false);
+    std::vector<ipaddress::ip_address> result(addresses.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < addresses.size(); ++i) {
+            auto code = ipaddress::error_code::no_error;
+            const auto ipv4 = ipaddress::ipv4_address::parse(addresses[i], code);
+            result[i] = code == ipaddress::error_code::no_error ? ipaddress::ip_address(ipv4) : ipaddress::ip_address(ipaddress::ipv6_address::parse(addresses[i], code));
+        }
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * addresses.size()));
+}
+BENCHMARK(BM_parse_mixed_two_pass_ipaddress);
+
+static void BM_parse_mixed_ipaddress(benchmark::State& state) {
+    const auto addresses = mixed_batch(false);
+    std::vector<ipaddress::ip_address> result(addresses.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < addresses.size(); ++i) {
+            auto code = ipaddress::error_code::no_error;
+            result[i] = ipaddress::ip_address::parse(addresses[i], code);
+        }
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * addresses.size()));
+}
+BENCHMARK(BM_parse_mixed_ipaddress);
+
+static void BM_parse_mixed_two_pass_ipnetwork(benchmark::State& state) {
+    const auto networks = mixed_batch(true);
+    std::vector<ipaddress::ip_network> result(networks.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < networks.size(); ++i) {
+            auto code = ipaddress::error_code::no_error;
+            const auto net4 = ipaddress::ipv4_network::parse(networks[i], code);
+            result[i] = code == ipaddress::error_code::no_error ? ipaddress::ip_network(net4) : ipaddress::ip_network(ipaddress::ipv6_network::parse(networks[i], code));
+        }
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * networks.size()));
+}
+BENCHMARK(BM_parse_mixed_two_pass_ipnetwork);
+
+static void BM_parse_mixed_ipnetwork(benchmark::State& state) {
+    const auto networks = mixed_batch(true);
+    std::vector<ipaddress::ip_network> result(networks.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < networks.size(); ++i) {
+            auto code = ipaddress::error_code::no_error;
+            result[i] = ipaddress::ip_network::parse(networks[i], code);
+        }
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * networks.size()));
+}
+BENCHMARK(BM_parse_mixed_ipnetwork);
@@ -0,0 +1,118 @@
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <ipaddress/ipaddress.hpp>
+#include <ipaddress/parallel.hpp>
+
+// Synthetic full-table datasets: prefix length distributions roughly follow
+// those of the public IPv4 and IPv6 BGP tables, so most prefixes do not merge.
+//
+static std::vector<ipaddress::ipv4_network> make_ipv4_table(size_t count) {
+    static const size_t lengths[] = { 8, 12, 16, 18, 19, 20, 21, 22, 22, 23, 23, 24, 24, 24, 24, 24, 24, 24, 24, 24 };
+    std::mt19937 rng(2024);
+    std::vector<ipaddress::ipv4_network> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const auto prefixlen = lengths[rng() % (sizeof(lengths) / sizeof(lengths[0]))];
+        const auto address = ipaddress::ipv4_address::from_uint(uint32_t(rng()));
+        result.push_back(ipaddress::ipv4_network::from_address(address, prefixlen, false));
+    }
+    return result;
+}
+
+static std::vector<ipaddress::ipv6_network> make_ipv6_table(size_t count) {
+    static const size_t lengths[] = { 19, 20, 24, 28, 29, 32, 32, 36, 40, 44, 48, 48, 48, 48, 48, 48, 48, 48, 56, 64 };
+    std::mt19937_64 rng(2024);
+    std::vector<ipaddress::ipv6_network> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const auto prefixlen = lengths[rng() % (sizeof(lengths) / sizeof(lengths[0]))];
+        const auto upper = (rng() & 0x1FFFFFFFFFFFFFFFULL) | 0x2000000000000000ULL;
+        const auto address = ipaddress::ipv6_address::from_uint(ipaddress::uint128_t(upper, rng()));
+        result.push_back(ipaddress::ipv6_network::from_address(address, prefixlen, false));
+    }
+    return result;
+}
+
+// Dense feed: host routes and small prefixes packed into 10.0.0.0/12, so that
+// most of the input is merged into larger blocks.
+//
+static std::vector<ipaddress::ipv4_network> make_ipv4_dense(size_t count) {
+    static const size_t lengths[] = { 22, 24, 24, 26, 28, 30, 32, 32, 32, 32 };
+    std::mt19937 rng(2024);
+    std::vector<ipaddress::ipv4_network> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const auto prefixlen = lengths[rng() % (sizeof(lengths) / sizeof(lengths[0]))];
+        const auto address = ipaddress::ipv4_address::from_uint(0x0A000000 | (uint32_t(rng()) & 0x000FFFFF));
+        result.push_back(ipaddress::ipv4_network::from_address(address, prefixlen, false));
+    }
+    return result;
+}
+
+template <typename Net>
+static void collapse(benchmark::State& state, const std::vector<Net>& networks) {
+    for (auto _ : state) {
+        auto result = ipaddress::collapse_addresses(networks.begin(), networks.end());
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * networks.size()));
+}
+
+template <typename Net>
+static void collapse_with_buffer(benchmark::State& state, const std::vector<Net>& networks) {
+    ipaddress::collapse_buffer<Net> buffer;
+    buffer.reserve(networks.size());
+    for (auto _ : state) {
+        auto result = ipaddress::collapse_addresses(networks.begin(), networks.end(), buffer);
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * networks.size()));
+}
+
+static void BM_collapse_ipv4_table(benchmark::State& state) {
+    collapse(state, make_ipv4_table(size_t(state.range(0))));
+}
+BENCHMARK(BM_collapse_ipv4_table)->Arg(10000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_collapse_ipv4_dense(benchmark::State& state) {
+    collapse(state, make_ipv4_dense(size_t(state.range(0))));
+}
+BENCHMARK(BM_collapse_ipv4_dense)->Arg(10000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_collapse_ipv6_table(benchmark::State& state) {
+    collapse(state, make_ipv6_table(size_t(state.range(0))));
+}
+BENCHMARK(BM_collapse_ipv6_table)->Arg(10000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_collapse_ipv4_table_buffer(benchmark::State& state) {
+    collapse_with_buffer(state, make_ipv4_table(size_t(state.range(0))));
+}
+BENCHMARK(BM_collapse_ipv4_table_buffer)->Arg(10000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_collapse_ipv6_table_buffer(benchmark::State& state) {
+    collapse_with_buffer(state, make_ipv6_table(size_t(state.range(0))));
+}
+BENCHMARK(BM_collapse_ipv6_table_buffer)->Arg(10000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+template <typename Net>
+static void collapse_with_threads(benchmark::State& state, const std::vector<Net>& networks) {
+    const auto threads = size_t(state.range(1));
+    for (auto _ : state) {
+        auto result = ipaddress::collapse_addresses(networks.begin(), networks.end(), threads);
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * networks.size()));
+}
+
+static void BM_collapse_ipv4_table_threads(benchmark::State& state) {
+    collapse_with_threads(state, make_ipv4_table(size_t(state.range(0))));
+}
+BENCHMARK(BM_collapse_ipv4_table_threads)->ArgsProduct({ { 1000000 }, { 1, 2, 4, 8 } })->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_collapse_ipv6_table_threads(benchmark::State& state) {
+    collapse_with_threads(state, make_ipv6_table(size_t(state.range(0))));
+}
+BENCHMARK(BM_collapse_ipv6_table_threads)->ArgsProduct({ { 1000000 }, { 1, 2, 4, 8 } })->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,167 @@
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+#include <shared_mutex>
+
+#include <benchmark/benchmark.h>
+
+#include <ipaddress/ipaddress.hpp>
+
+// Lookup throughput of worker threads while a control thread streams route updates:
+// each update flaps 64 routes of a synthetic BGP-like table. The concurrent table is
+// compared with an ip_prefix_table behind a std::shared_mutex, where the workers take
+// the lock in shared mode and the control thread holds it exclusively while it
+// modifies and rebuilds the table. The "updates" counter is the rate of committed batches.
+//
+static std::vector<ipaddress::ipv4_network> make_ipv4_table(size_t count) {
+    static const size_t lengths[] = { 8, 12, 16, 18, 19, 20, 21, 22, 22, 23, 23, 24, 24, 24, 24, 24, 24, 24, 24, 24 };
+    std::mt19937 rng(2024);
+    std::vector<ipaddress::ipv4_network> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const auto prefixlen = lengths[rng() % (sizeof(lengths) / sizeof(lengths[0]))];
+        const auto address = ipaddress::ipv4_address::from_uint(uint32_t(rng()));
+        result.push_back(ipaddress::ipv4_network::from_address(address, prefixlen, false));
+    }
+    return result;
+}
+
+static std::vector<ipaddress::ipv4_address> make_queries(const std::vector<ipaddress::ipv4_network>& table, size_t count) {
+    std::mt19937_64 rng(42);
+    std::vector<ipaddress::ipv4_address> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const auto& network = table[rng() % table.size()];
+        const auto host = network.hostmask().to_uint() & uint32_t(rng());
+        result.push_back(ipaddress::ipv4_address::from_uint(network.network_address().to_uint() | host));
+    }
+    return result;
+}
+
+constexpr size_t batch_size = 64;
+
+struct update_stream {
+    std::vector<ipaddress::ipv4_network> networks;
+    std::vector<ipaddress::ipv4_address> queries;
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> updates{0};
+    std::thread thread;
+
+    template <typename Fn>
+    void start(size_t count, Fn&& update) {
+        networks = make_ipv4_table(count);
+        queries = make_queries(networks, 1 << 16);
+        thread = std::thread([this, update]() {
+            std::mt19937 rng(7);
+            for (uint32_t generation = 0; !done.load(); ++generation) {
+                update(rng, generation);
+                ++updates;
+            }
+        });
+    }
+
+    void stop() {
+        done = true;
+        thread.join();
+    }
+};
+
+static std::unique_ptr<update_stream> stream;
+static std::unique_ptr<ipaddress::ip_concurrent_prefix_table<ipaddress::ipv4_network, uint32_t>> concurrent_table;
+static std::unique_ptr<ipaddress::ip_prefix_table<ipaddress::ipv4_network, uint32_t>> locked_table;
+static std::shared_mutex table_mutex;
+
+static void setup_concurrent(const benchmark::State& state) {
+    stream.reset(new update_stream());
+    concurrent_table.reset(new ipaddress::ip_concurrent_prefix_table<ipaddress::ipv4_network, uint32_t>());
+    const auto networks = make_ipv4_table(size_t(state.range(0)));
+    auto transaction = concurrent_table->update();
+    for (size_t i = 0; i < networks.size(); ++i) {
+        transaction.insert(networks[i], uint32_t(i));
+    }
+    transaction.commit();
+    stream->start(networks.size(), [](std::mt19937& rng, uint32_t generation) {
+        auto transaction = concurrent_table->update();
+        for (size_t i = 0; i < batch_size; ++i) {
+            const auto& network = stream->networks[rng() % stream->networks.size()];
+            if (generation % 2 == 0) {
+                transaction.erase(network);
+            } else {
+                transaction.insert(network, generation);
+            }
+        }
+        transaction.commit();
+    });
+}
+
+static void setup_locked(const benchmark::State& state) {
+    stream.reset(new update_stream());
+    locked_table.reset(new ipaddress::ip_prefix_table<ipaddress::ipv4_network, uint32_t>());
+    const auto networks = make_ipv4_table(size_t(state.range(0)));
+    for (size_t i = 0; i < networks.size(); ++i) {
+        locked_table->insert(networks[i], uint32_t(i));
+    }
+    locked_table->build();
+    stream->start(networks.size(), [](std::mt19937& rng, uint32_t generation) {
+        std::unique_lock<std::shared_mutex> lock(table_mutex);
+        for (size_t i = 0; i < batch_size; ++i) {
+            const auto& network = stream->networks[rng() % stream->networks.size()];
+            if (generation % 2 == 0) {
+                locked_table->erase(network);
+            } else {
+                locked_table->insert(network, generation);
+            }
+        }
+        locked_table->build();
+    });
+}
+
+static void teardown(const benchmark::State&) {
+    stream->stop();
+    stream.reset();
+    concurrent_table.reset();
+    locked_table.reset();
+}
+
+static void report(benchmark::State& state, uint64_t updates) {
+    state.SetItemsProcessed(int64_t(state.iterations() * batch_size));
+    if (state.thread_index() == 0) {
+        state.counters["updates"] = benchmark::Counter(double(stream->updates.load() - updates), benchmark::Counter::kIsRate);
+    }
+}
+
+// Workers look up batches of 64 addresses, pinning a snapshot or taking the lock once per batch
+//
+static void BM_concurrent_prefix_table_ipv4(benchmark::State& state) {
+    auto reader = concurrent_table->make_reader();
+    const auto& queries = stream->queries;
+    const auto updates = stream->updates.load();
+    size_t i = state.thread_index() * 4096;
+    for (auto _ : state) {
+        const auto snapshot = reader.pin();
+        for (size_t j = 0; j < batch_size; ++j) {
+            benchmark::DoNotOptimize(snapshot->longest_match(queries[i++ & 0xFFFF]));
+        }
+    }
+    report(state, updates);
+}
+BENCHMARK(BM_concurrent_prefix_table_ipv4)->Setup(setup_concurrent)->Teardown(teardown)
+    ->Arg(100000)->Arg(900000)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_shared_mutex_prefix_table_ipv4(benchmark::State& state) {
+    const auto& queries = stream->queries;
+    const auto updates = stream->updates.load();
+    size_t i = state.thread_index() * 4096;
+    for (auto _ : state) {
+        std::shared_lock<std::shared_mutex> lock(table_mutex);
+        for (size_t j = 0; j < batch_size; ++j) {
+            benchmark::DoNotOptimize(locked_table->longest_match(queries[i++ & 0xFFFF]));
+        }
+    }
+    report(state, updates);
+}
+BENCHMARK(BM_shared_mutex_prefix_table_ipv4)->Setup(setup_locked)->Teardown(teardown)
+    ->Arg(100000)->Arg(900000)->ThreadRange(1, 8)->UseRealTime();
@@ -0,0 +1,178 @@
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <ipaddress/ipaddress.hpp>
+
+// Random blocklists and queries of which about one in a hundred is listed, as for traffic
+// checked against a threat-intel list; the counters report the measured false positive rate
+// and the size of each structure per entry
+//
+static std::vector<ipaddress::ipv4_address> make_ipv4(size_t count) {
+    std::mt19937 rng(2024);
+    std::vector<ipaddress::ipv4_address> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        result.push_back(ipaddress::ipv4_address::from_uint(uint32_t(rng())));
+    }
+    return result;
+}
+
+static std::vector<ipaddress::ipv4_address> make_ipv4_queries(const std::vector<ipaddress::ipv4_address>& addresses) {
+    std::mt19937 rng(42);
+    std::vector<ipaddress::ipv4_address> result;
+    result.reserve(1 << 20);
+    for (size_t i = 0; i < (1 << 20); ++i) {
+        result.push_back(i % 100 == 0 ? addresses[rng() % addresses.size()] : ipaddress::ipv4_address::from_uint(uint32_t(rng())));
+    }
+    return result;
+}
+
+static std::vector<ipaddress::ipv6_address> make_ipv6(size_t count) {
+    std::mt19937_64 rng(2024);
+    std::vector<ipaddress::ipv6_address> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        result.push_back(ipaddress::ipv6_address::from_uint(ipaddress::uint128_t(0x2001000000000000ULL | (rng() >> 16), rng())));
+    }
+    return result;
+}
+
+static std::vector<ipaddress::ipv6_address> make_ipv6_queries(const std::vector<ipaddress::ipv6_address>& addresses) {
+    std::mt19937_64 rng(42);
+    std::vector<ipaddress::ipv6_address> result;
+    result.reserve(1 << 20);
+    for (size_t i = 0; i < (1 << 20); ++i) {
+        result.push_back(i % 100 == 0
+            ? addresses[rng() % addresses.size()]
+            : ipaddress::ipv6_address::from_uint(ipaddress::uint128_t(0x2001000000000000ULL | (rng() >> 16), rng())));
+    }
+    return result;
+}
+
+static std::vector<ipaddress::ipv4_network> make_ipv4_networks(size_t count) {
+    std::mt19937 rng(2024);
+    std::vector<ipaddress::ipv4_network> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const auto prefixlen = size_t(20 + rng() % 13);
+        const auto address = ipaddress::ipv4_address::from_uint(uint32_t(rng()) & ~uint32_t(uint64_t(0xFFFFFFFF) >> prefixlen));
+        result.push_back(ipaddress::ipv4_network::from_address(address, prefixlen));
+    }
+    return result;
+}
+
+template <typename Filter, typename T>
+static void filter_build(benchmark::State& state, const std::vector<T>& entries) {
+    for (auto _ : state) {
+        const Filter filter(entries.begin(), entries.end());
+        benchmark::DoNotOptimize(filter.size_in_bytes());
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * entries.size()));
+}
+
+template <typename Filter, typename T, typename Address>
+static void filter_contains(benchmark::State& state, const std::vector<T>& entries, const std::vector<Address>& queries) {
+    const Filter filter(entries.begin(), entries.end());
+    const ipaddress::ip_flat_set<Address> exact(entries.begin(), entries.end());
+    for (auto _ : state) {
+        size_t found = 0;
+        for (const auto& address : queries) {
+            found += filter.contains(address);
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    size_t false_positives = 0;
+    size_t negatives = 0;
+    for (const auto& address : queries) {
+        if (!exact.contains(address)) {
+            ++negatives;
+            false_positives += filter.contains(address);
+        }
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * queries.size()));
+    state.counters["fpr"] = double(false_positives) / double(negatives);
+    state.counters["bits_per_entry"] = double(filter.size_in_bytes() * 8) / double(entries.size());
+}
+
+template <typename Address>
+static void flat_set_contains(benchmark::State& state, const std::vector<Address>& entries, const std::vector<Address>& queries) {
+    const ipaddress::ip_flat_set<Address> set(entries.begin(), entries.end());
+    for (auto _ : state) {
+        size_t found = 0;
+        for (const auto& address : queries) {
+            found += set.contains(address);
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * queries.size()));
+    state.counters["bits_per_entry"] = double(set.capacity() * sizeof(Address) * 8) / double(entries.size());
+}
+
+static void BM_flat_set_ipv4(benchmark::State& state) {
+    const auto addresses = make_ipv4(size_t(state.range(0)));
+    flat_set_contains(state, addresses, make_ipv4_queries(addresses));
+}
+BENCHMARK(BM_flat_set_ipv4)->Arg(100000)->Arg(10000000)->Unit(benchmark::kMillisecond);
+
+static void BM_bloom_filter_ipv4(benchmark::State& state) {
+    const auto addresses = make_ipv4(size_t(state.range(0)));
+    filter_contains<ipaddress::ip_bloom_filter<ipaddress::ipv4_address>>(state, addresses, make_ipv4_queries(addresses));
+}
+BENCHMARK(BM_bloom_filter_ipv4)->Arg(100000)->Arg(10000000)->Unit(benchmark::kMillisecond);
+
+static void BM_xor_filter_ipv4(benchmark::State& state) {
+    const auto addresses = make_ipv4(size_t(state.range(0)));
+    filter_contains<ipaddress::ip_xor_filter<ipaddress::ipv4_address>>(state, addresses, make_ipv4_queries(addresses));
+}
+BENCHMARK(BM_xor_filter_ipv4)->Arg(100000)->Arg(10000000)->Unit(benchmark::kMillisecond);
+
+static void BM_xor16_filter_ipv4(benchmark::State& state) {
+    const auto addresses = make_ipv4(size_t(state.range(0)));
+    filter_contains<ipaddress::ip_xor_filter<ipaddress::ipv4_address, uint16_t>>(state, addresses, make_ipv4_queries(addresses));
+}
+BENCHMARK(BM_xor16_filter_ipv4)->Arg(100000)->Arg(10000000)->Unit(benchmark::kMillisecond);
+
+static void BM_flat_set_ipv6(benchmark::State& state) {
+    const auto addresses = make_ipv6(size_t(state.range(0)));
+    flat_set_contains(state, addresses, make_ipv6_queries(addresses));
+}
+BENCHMARK(BM_flat_set_ipv6)->Arg(100000)->Arg(10000000)->Unit(benchmark::kMillisecond);
+
+static void BM_bloom_filter_ipv6(benchmark::State& state) {
+    const auto addresses = make_ipv6(size_t(state.range(0)));
+    filter_contains<ipaddress::ip_bloom_filter<ipaddress::ipv6_address>>(state, addresses, make_ipv6_queries(addresses));
+}
+BENCHMARK(BM_bloom_filter_ipv6)->Arg(100000)->Arg(10000000)->Unit(benchmark::kMillisecond);
+
+static void BM_xor_filter_ipv6(benchmark::State& state) {
+    const auto addresses = make_ipv6(size_t(state.range(0)));
+    filter_contains<ipaddress::ip_xor_filter<ipaddress::ipv6_address>>(state, addresses, make_ipv6_queries(addresses));
+}
+BENCHMARK(BM_xor_filter_ipv6)->Arg(100000)->Arg(10000000)->Unit(benchmark::kMillisecond);
+
+static void BM_bloom_filter_ipv4_networks(benchmark::State& state) {
+    const auto networks = make_ipv4_networks(size_t(state.range(0)));
+    const auto queries = make_ipv4_queries(make_ipv4(1000));
+    const ipaddress::ip_bloom_filter<ipaddress::ipv4_network> filter(networks.begin(), networks.end());
+    for (auto _ : state) {
+        size_t found = 0;
+        for (const auto& address : queries) {
+            found += filter.contains(address);
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * queries.size()));
+}
+BENCHMARK(BM_bloom_filter_ipv4_networks)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_bloom_filter_build_ipv4(benchmark::State& state) {
+    filter_build<ipaddress::ip_bloom_filter<ipaddress::ipv4_address>>(state, make_ipv4(size_t(state.range(0))));
+}
+BENCHMARK(BM_bloom_filter_build_ipv4)->Arg(100000)->Arg(10000000)->Unit(benchmark::kMillisecond);
+
+static void BM_xor_filter_build_ipv4(benchmark::State& state) {
+    filter_build<ipaddress::ip_xor_filter<ipaddress::ipv4_address>>(state, make_ipv4(size_t(state.range(0))));
+}
+BENCHMARK(BM_xor_filter_build_ipv4)->Arg(100000)->Arg(10000000)->Unit(benchmark::kMillisecond);
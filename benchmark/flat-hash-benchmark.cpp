@@ -0,0 +1,82 @@
+#include <random>
+#include <vector>
+#include <unordered_set>
+
+#include <benchmark/benchmark.h>
+
+#include <ipaddress/ipaddress.hpp>
+
+// Synthetic flow keys: random client addresses, three quarters IPv4 and
+// one quarter IPv6, as found in the logs of a dual-stack service.
+//
+static const std::vector<ipaddress::ip_address>& make_addresses() {
+    static const std::vector<ipaddress::ip_address> result = [] {
+        std::mt19937_64 rng(2024);
+        std::vector<ipaddress::ip_address> addresses;
+        addresses.reserve(10000000);
+        for (size_t i = 0; i < 10000000; ++i) {
+            const auto value = rng();
+            if (value % 4 != 0) {
+                addresses.push_back(ipaddress::ipv4_address::from_uint(uint32_t(value >> 32)));
+            } else {
+                addresses.push_back(ipaddress::ipv6_address::from_uint(ipaddress::uint128_t(0x2001000000000000ULL | (value >> 40), rng())));
+            }
+        }
+        return addresses;
+    }();
+    return result;
+}
+
+template <typename Set>
+static void insert(benchmark::State& state) {
+    const auto& addresses = make_addresses();
+    for (auto _ : state) {
+        Set set;
+        for (const auto& address : addresses) {
+            set.insert(address);
+        }
+        benchmark::DoNotOptimize(set.size());
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * addresses.size()));
+}
+
+template <typename Set, typename Contains>
+static void lookup(benchmark::State& state, Contains contains) {
+    const auto& addresses = make_addresses();
+    Set set;
+    for (size_t i = 0; i < addresses.size(); i += 2) {
+        set.insert(addresses[i]);
+    }
+    for (auto _ : state) {
+        size_t found = 0;
+        for (const auto& address : addresses) {
+            found += contains(set, address) ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * addresses.size()));
+}
+
+static void BM_flat_set_insert(benchmark::State& state) {
+    insert<ipaddress::ip_flat_set<ipaddress::ip_address>>(state);
+}
+BENCHMARK(BM_flat_set_insert)->Unit(benchmark::kMillisecond);
+
+static void BM_unordered_set_insert(benchmark::State& state) {
+    insert<std::unordered_set<ipaddress::ip_address>>(state);
+}
+BENCHMARK(BM_unordered_set_insert)->Unit(benchmark::kMillisecond);
+
+static void BM_flat_set_lookup(benchmark::State& state) {
+    lookup<ipaddress::ip_flat_set<ipaddress::ip_address>>(state, [](const ipaddress::ip_flat_set<ipaddress::ip_address>& set, const ipaddress::ip_address& address) {
+        return set.contains(address);
+    });
+}
+BENCHMARK(BM_flat_set_lookup)->Unit(benchmark::kMillisecond);
+
+static void BM_unordered_set_lookup(benchmark::State& state) {
+    lookup<std::unordered_set<ipaddress::ip_address>>(state, [](const std::unordered_set<ipaddress::ip_address>& set, const ipaddress::ip_address& address) {
+        return set.count(address) != 0;
+    });
+}
+BENCHMARK(BM_unordered_set_lookup)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,108 @@
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <ipaddress/ipaddress.hpp>
+
+// Synthetic allowlists of mostly long prefixes, so that even a million
+// entries stay largely separate ranges instead of merging into a few blocks.
+//
+static std::vector<ipaddress::ipv4_network> make_ipv4_list(size_t count, uint32_t seed) {
+    static const size_t lengths[] = { 20, 21, 22, 22, 23, 23, 24, 24, 24, 24, 24, 24, 24, 24, 25, 26, 28, 30, 32, 32 };
+    std::mt19937 rng(seed);
+    std::vector<ipaddress::ipv4_network> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const auto prefixlen = lengths[rng() % (sizeof(lengths) / sizeof(lengths[0]))];
+        const auto address = ipaddress::ipv4_address::from_uint(uint32_t(rng()));
+        result.push_back(ipaddress::ipv4_network::from_address(address, prefixlen, false));
+    }
+    return result;
+}
+
+static std::vector<ipaddress::ipv6_network> make_ipv6_list(size_t count, uint64_t seed) {
+    static const size_t lengths[] = { 24, 28, 29, 32, 32, 36, 40, 44, 48, 48, 48, 48, 48, 48, 48, 48, 56, 64, 64, 128 };
+    std::mt19937_64 rng(seed);
+    std::vector<ipaddress::ipv6_network> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const auto prefixlen = lengths[rng() % (sizeof(lengths) / sizeof(lengths[0]))];
+        const auto upper = (rng() & 0x1FFFFFFFFFFFFFFFULL) | 0x2000000000000000ULL;
+        const auto address = ipaddress::ipv6_address::from_uint(ipaddress::uint128_t(upper, rng()));
+        result.push_back(ipaddress::ipv6_network::from_address(address, prefixlen, false));
+    }
+    return result;
+}
+
+template <typename Net>
+static void build(benchmark::State& state, const std::vector<Net>& networks) {
+    for (auto _ : state) {
+        ipaddress::ip_set<Net> set(networks.begin(), networks.end());
+        benchmark::DoNotOptimize(set.ranges_count());
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * networks.size()));
+}
+
+template <typename Net, typename Op>
+static void combine(benchmark::State& state, const std::vector<Net>& lhs, const std::vector<Net>& rhs, Op op) {
+    const ipaddress::ip_set<Net> a(lhs.begin(), lhs.end());
+    const ipaddress::ip_set<Net> b(rhs.begin(), rhs.end());
+    for (auto _ : state) {
+        auto result = op(a, b);
+        benchmark::DoNotOptimize(result.ranges_count());
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * (a.ranges_count() + b.ranges_count())));
+}
+
+template <typename Net>
+static void iterate(benchmark::State& state, const std::vector<Net>& networks) {
+    const ipaddress::ip_set<Net> set(networks.begin(), networks.end());
+    for (auto _ : state) {
+        size_t count = 0;
+        for (const auto& net : set) {
+            count += net.prefixlen();
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * set.ranges_count()));
+}
+
+static void BM_ip_set_build_ipv4(benchmark::State& state) {
+    build(state, make_ipv4_list(size_t(state.range(0)), 1));
+}
+BENCHMARK(BM_ip_set_build_ipv4)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_ip_set_build_ipv6(benchmark::State& state) {
+    build(state, make_ipv6_list(size_t(state.range(0)), 1));
+}
+BENCHMARK(BM_ip_set_build_ipv6)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_ip_set_union_ipv4(benchmark::State& state) {
+    const auto count = size_t(state.range(0));
+    combine(state, make_ipv4_list(count, 1), make_ipv4_list(count, 2), [](const ipaddress::ip_set<ipaddress::ipv4_network>& a, const ipaddress::ip_set<ipaddress::ipv4_network>& b) { return a | b; });
+}
+BENCHMARK(BM_ip_set_union_ipv4)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_ip_set_difference_ipv4(benchmark::State& state) {
+    const auto count = size_t(state.range(0));
+    combine(state, make_ipv4_list(count, 1), make_ipv4_list(count, 2), [](const ipaddress::ip_set<ipaddress::ipv4_network>& a, const ipaddress::ip_set<ipaddress::ipv4_network>& b) { return a - b; });
+}
+BENCHMARK(BM_ip_set_difference_ipv4)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_ip_set_symmetric_difference_ipv4(benchmark::State& state) {
+    const auto count = size_t(state.range(0));
+    combine(state, make_ipv4_list(count, 1), make_ipv4_list(count, 2), [](const ipaddress::ip_set<ipaddress::ipv4_network>& a, const ipaddress::ip_set<ipaddress::ipv4_network>& b) { return a ^ b; });
+}
+BENCHMARK(BM_ip_set_symmetric_difference_ipv4)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_ip_set_difference_ipv6(benchmark::State& state) {
+    const auto count = size_t(state.range(0));
+    combine(state, make_ipv6_list(count, 1), make_ipv6_list(count, 2), [](const ipaddress::ip_set<ipaddress::ipv6_network>& a, const ipaddress::ip_set<ipaddress::ipv6_network>& b) { return a - b; });
+}
+BENCHMARK(BM_ip_set_difference_ipv6)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_ip_set_iterate_ipv4(benchmark::State& state) {
+    iterate(state, make_ipv4_list(size_t(state.range(0)), 1));
+}
+BENCHMARK(BM_ip_set_iterate_ipv4)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,123 @@
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <ipaddress/ipaddress.hpp>
+
+// Synthetic full-table datasets: prefix length distributions roughly follow
+// those of the public IPv4 (~900k routes, dominated by /24) and IPv6 (~200k routes,
+// dominated by /48) BGP tables.
+//
+static std::vector<ipaddress::ipv4_network> make_ipv4_table(size_t count) {
+    static const size_t lengths[] = { 8, 12, 16, 18, 19, 20, 21, 22, 22, 23, 23, 24, 24, 24, 24, 24, 24, 24, 24, 24 };
+    std::mt19937 rng(2024);
+    std::vector<ipaddress::ipv4_network> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const auto prefixlen = lengths[rng() % (sizeof(lengths) / sizeof(lengths[0]))];
+        const auto address = ipaddress::ipv4_address::from_uint(uint32_t(rng()));
+        result.push_back(ipaddress::ipv4_network::from_address(address, prefixlen, false));
+    }
+    return result;
+}
+
+static std::vector<ipaddress::ipv6_network> make_ipv6_table(size_t count) {
+    static const size_t lengths[] = { 19, 20, 24, 28, 29, 32, 32, 36, 40, 44, 48, 48, 48, 48, 48, 48, 48, 48, 56, 64 };
+    std::mt19937_64 rng(2024);
+    std::vector<ipaddress::ipv6_network> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const auto prefixlen = lengths[rng() % (sizeof(lengths) / sizeof(lengths[0]))];
+        const auto upper = (rng() & 0x1FFFFFFFFFFFFFFFULL) | 0x2000000000000000ULL;
+        const auto address = ipaddress::ipv6_address::from_uint(ipaddress::uint128_t(upper, rng()));
+        result.push_back(ipaddress::ipv6_network::from_address(address, prefixlen, false));
+    }
+    return result;
+}
+
+template <typename Address, typename Net>
+static std::vector<Address> make_queries(const std::vector<Net>& table, size_t count) {
+    std::mt19937_64 rng(42);
+    std::vector<Address> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const auto& network = table[rng() % table.size()];
+        const auto host = network.hostmask().to_uint() & typename Address::uint_type(rng());
+        result.push_back(Address::from_uint(network.network_address().to_uint() | host));
+    }
+    return result;
+}
+
+// Longest prefix match lookups
+//
+static void BM_prefix_table_ipv4(benchmark::State& state) {
+    const auto networks = make_ipv4_table(size_t(state.range(0)));
+    const auto queries = make_queries<ipaddress::ipv4_address>(networks, 1 << 16);
+    ipaddress::ip_prefix_table<ipaddress::ipv4_network, uint32_t> table;
+    for (size_t i = 0; i < networks.size(); ++i) {
+        table.insert(networks[i], uint32_t(i));
+    }
+    table.build();
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(table.longest_match(queries[i++ & 0xFFFF]));
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()));
+}
+BENCHMARK(BM_prefix_table_ipv4)->Arg(1000)->Arg(100000)->Arg(900000);
+
+static void BM_prefix_table_ipv6(benchmark::State& state) {
+    const auto networks = make_ipv6_table(size_t(state.range(0)));
+    const auto queries = make_queries<ipaddress::ipv6_address>(networks, 1 << 16);
+    ipaddress::ip_prefix_table<ipaddress::ipv6_network, uint32_t> table;
+    for (size_t i = 0; i < networks.size(); ++i) {
+        table.insert(networks[i], uint32_t(i));
+    }
+    table.build();
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(table.longest_match(queries[i++ & 0xFFFF]));
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()));
+}
+BENCHMARK(BM_prefix_table_ipv6)->Arg(1000)->Arg(200000);
+
+// Linear scan with contains() for comparison
+//
+static void BM_linear_scan_ipv4(benchmark::State& state) {
+    const auto networks = make_ipv4_table(size_t(state.range(0)));
+    const auto queries = make_queries<ipaddress::ipv4_address>(networks, 1 << 16);
+
+    size_t i = 0;
+    for (auto _ : state) {
+        const auto& address = queries[i++ & 0xFFFF];
+        const ipaddress::ipv4_network* best = nullptr;
+        for (const auto& network : networks) {
+            if (network.contains(address) && (!best || network.prefixlen() > best->prefixlen())) {
+                best = &network;
+            }
+        }
+        benchmark::DoNotOptimize(best);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()));
+}
+BENCHMARK(BM_linear_scan_ipv4)->Arg(1000);
+
+// Table construction
+//
+static void BM_prefix_table_build_ipv4(benchmark::State& state) {
+    const auto networks = make_ipv4_table(size_t(state.range(0)));
+    for (auto _ : state) {
+        ipaddress::ip_prefix_table<ipaddress::ipv4_network, uint32_t> table;
+        for (size_t i = 0; i < networks.size(); ++i) {
+            table.insert(networks[i], uint32_t(i));
+        }
+        table.build();
+        benchmark::DoNotOptimize(table.size());
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_prefix_table_build_ipv4)->Arg(900000)->Unit(benchmark::kMillisecond);
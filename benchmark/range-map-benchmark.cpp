@@ -0,0 +1,71 @@
+#include <map>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <ipaddress/ipaddress.hpp>
+
+// Synthetic geolocation table: consecutive IPv4 ranges of random lengths with small
+// gaps between them, each mapped to a 16-bit location id.
+//
+static std::vector<std::pair<std::pair<ipaddress::ipv4_address, ipaddress::ipv4_address>, uint16_t>> make_ipv4_rows(size_t count) {
+    std::mt19937 rng(2024);
+    std::vector<std::pair<std::pair<ipaddress::ipv4_address, ipaddress::ipv4_address>, uint16_t>> result;
+    result.reserve(count);
+    uint32_t first = 0x01000000;
+    for (size_t i = 0; i < count; ++i) {
+        const auto last = first + (uint32_t(rng()) % 768);
+        result.push_back({ { ipaddress::ipv4_address::from_uint(first), ipaddress::ipv4_address::from_uint(last) }, uint16_t(rng()) });
+        first = last + 1 + (uint32_t(rng()) % 64);
+    }
+    return result;
+}
+
+static std::vector<ipaddress::ipv4_address> make_queries(size_t count) {
+    std::mt19937 rng(42);
+    std::vector<ipaddress::ipv4_address> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        result.push_back(ipaddress::ipv4_address::from_uint(0x01000000 + uint32_t(rng()) % 0x60000000));
+    }
+    return result;
+}
+
+static void BM_range_map_find(benchmark::State& state) {
+    const auto rows = make_ipv4_rows(size_t(state.range(0)));
+    const auto queries = make_queries(1 << 20);
+    const ipaddress::ip_range_map<uint16_t> map(rows.begin(), rows.end());
+    for (auto _ : state) {
+        uint32_t sum = 0;
+        for (const auto& address : queries) {
+            const auto* value = map.find(address);
+            sum += value ? *value : 0;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * queries.size()));
+}
+BENCHMARK(BM_range_map_find)->Arg(100000)->Arg(4000000)->Unit(benchmark::kMillisecond);
+
+static void BM_std_map_find(benchmark::State& state) {
+    const auto rows = make_ipv4_rows(size_t(state.range(0)));
+    const auto queries = make_queries(1 << 20);
+    std::map<ipaddress::ip_address, std::pair<ipaddress::ip_address, uint16_t>> map;
+    for (const auto& row : rows) {
+        map.emplace(row.first.first, std::make_pair(ipaddress::ip_address(row.first.second), row.second));
+    }
+    for (auto _ : state) {
+        uint32_t sum = 0;
+        for (const auto& query : queries) {
+            const ipaddress::ip_address address(query);
+            auto it = map.upper_bound(address);
+            if (it != map.begin() && address <= (--it)->second.first) {
+                sum += it->second.second;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * queries.size()));
+}
+BENCHMARK(BM_std_map_find)->Arg(100000)->Arg(4000000)->Unit(benchmark::kMillisecond);
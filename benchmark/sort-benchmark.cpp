@@ -0,0 +1,130 @@
+#include <random>
+#include <vector>
+#include <algorithm>
+
+#include <benchmark/benchmark.h>
+
+#include <ipaddress/ipaddress.hpp>
+#include <ipaddress/parallel.hpp>
+
+// Random addresses: IPv4 over the whole address space, IPv6 under 2000::/3
+// with a random interface id, and a mix of both with one IPv6 address in four.
+//
+static std::vector<ipaddress::ipv4_address> make_ipv4(size_t count) {
+    std::mt19937 rng(2024);
+    std::vector<ipaddress::ipv4_address> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        result.push_back(ipaddress::ipv4_address::from_uint(uint32_t(rng())));
+    }
+    return result;
+}
+
+static std::vector<ipaddress::ipv6_address> make_ipv6(size_t count) {
+    std::mt19937_64 rng(2024);
+    std::vector<ipaddress::ipv6_address> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const auto upper = (rng() & 0x1FFFFFFFFFFFFFFFULL) | 0x2000000000000000ULL;
+        result.push_back(ipaddress::ipv6_address::from_uint(ipaddress::uint128_t(upper, rng())));
+    }
+    return result;
+}
+
+static std::vector<ipaddress::ip_address> make_mixed(size_t count) {
+    std::mt19937_64 rng(2024);
+    std::vector<ipaddress::ip_address> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const auto value = rng();
+        if (value % 4 == 0) {
+            const auto upper = (rng() & 0x1FFFFFFFFFFFFFFFULL) | 0x2000000000000000ULL;
+            result.push_back(ipaddress::ip_address(ipaddress::ipv6_address::from_uint(ipaddress::uint128_t(upper, rng()))));
+        } else {
+            result.push_back(ipaddress::ip_address(ipaddress::ipv4_address::from_uint(uint32_t(value >> 32))));
+        }
+    }
+    return result;
+}
+
+// BGP-like IPv4 table, most prefixes are /24
+//
+static std::vector<ipaddress::ipv4_network> make_ipv4_table(size_t count) {
+    static const size_t lengths[] = { 8, 12, 16, 18, 19, 20, 21, 22, 22, 23, 23, 24, 24, 24, 24, 24, 24, 24, 24, 24 };
+    std::mt19937 rng(2024);
+    std::vector<ipaddress::ipv4_network> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const auto prefixlen = lengths[rng() % (sizeof(lengths) / sizeof(lengths[0]))];
+        const auto address = ipaddress::ipv4_address::from_uint(uint32_t(rng()));
+        result.push_back(ipaddress::ipv4_network::from_address(address, prefixlen, false));
+    }
+    return result;
+}
+
+template <typename T>
+static void std_sort(benchmark::State& state, const std::vector<T>& values) {
+    std::vector<T> data;
+    for (auto _ : state) {
+        state.PauseTiming();
+        data = values;
+        state.ResumeTiming();
+        std::sort(data.begin(), data.end());
+        benchmark::DoNotOptimize(data.data());
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * values.size()));
+}
+
+template <typename T>
+static void radix_sort(benchmark::State& state, const std::vector<T>& values) {
+    const auto threads = size_t(state.range(1));
+    std::vector<T> data;
+    for (auto _ : state) {
+        state.PauseTiming();
+        data = values;
+        state.ResumeTiming();
+        ipaddress::sort_addresses(data.begin(), data.end(), threads);
+        benchmark::DoNotOptimize(data.data());
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * values.size()));
+}
+
+static void BM_std_sort_ipv4(benchmark::State& state) {
+    std_sort(state, make_ipv4(size_t(state.range(0))));
+}
+BENCHMARK(BM_std_sort_ipv4)->Arg(1000000)->Arg(10000000)->Unit(benchmark::kMillisecond);
+
+static void BM_sort_addresses_ipv4(benchmark::State& state) {
+    radix_sort(state, make_ipv4(size_t(state.range(0))));
+}
+BENCHMARK(BM_sort_addresses_ipv4)->ArgsProduct({ { 1000000, 10000000 }, { 1, 4 } })->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_std_sort_ipv6(benchmark::State& state) {
+    std_sort(state, make_ipv6(size_t(state.range(0))));
+}
+BENCHMARK(BM_std_sort_ipv6)->Arg(1000000)->Arg(10000000)->Unit(benchmark::kMillisecond);
+
+static void BM_sort_addresses_ipv6(benchmark::State& state) {
+    radix_sort(state, make_ipv6(size_t(state.range(0))));
+}
+BENCHMARK(BM_sort_addresses_ipv6)->ArgsProduct({ { 1000000, 10000000 }, { 1, 4 } })->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_std_sort_mixed(benchmark::State& state) {
+    std_sort(state, make_mixed(size_t(state.range(0))));
+}
+BENCHMARK(BM_std_sort_mixed)->Arg(1000000)->Arg(10000000)->Unit(benchmark::kMillisecond);
+
+static void BM_sort_addresses_mixed(benchmark::State& state) {
+    radix_sort(state, make_mixed(size_t(state.range(0))));
+}
+BENCHMARK(BM_sort_addresses_mixed)->ArgsProduct({ { 1000000, 10000000 }, { 1, 4 } })->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_std_sort_ipv4_table(benchmark::State& state) {
+    std_sort(state, make_ipv4_table(size_t(state.range(0))));
+}
+BENCHMARK(BM_std_sort_ipv4_table)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_sort_addresses_ipv4_table(benchmark::State& state) {
+    radix_sort(state, make_ipv4_table(size_t(state.range(0))));
+}
+BENCHMARK(BM_sort_addresses_ipv4_table)->ArgsProduct({ { 1000000 }, { 1, 4 } })->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,125 @@
+#include <random>
+#include <vector>
+#include <algorithm>
+
+#include <benchmark/benchmark.h>
+
+#include <ipaddress/ipaddress.hpp>
+
+// Random address lists and queries of which about half are hits
+//
+static std::vector<ipaddress::ipv4_address> make_ipv4(size_t count) {
+    std::mt19937 rng(2024);
+    std::vector<ipaddress::ipv4_address> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        result.push_back(ipaddress::ipv4_address::from_uint(uint32_t(rng())));
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+static std::vector<ipaddress::ipv4_address> make_ipv4_queries(const std::vector<ipaddress::ipv4_address>& addresses) {
+    std::mt19937 rng(42);
+    std::vector<ipaddress::ipv4_address> result;
+    result.reserve(1 << 20);
+    for (size_t i = 0; i < (1 << 20); ++i) {
+        result.push_back(i % 2 == 0 ? addresses[rng() % addresses.size()] : ipaddress::ipv4_address::from_uint(uint32_t(rng())));
+    }
+    return result;
+}
+
+static std::vector<ipaddress::ipv6_address> make_ipv6(size_t count) {
+    std::mt19937_64 rng(2024);
+    std::vector<ipaddress::ipv6_address> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        result.push_back(ipaddress::ipv6_address::from_uint(ipaddress::uint128_t(0x2001000000000000ULL | (rng() >> 16), rng())));
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+static std::vector<ipaddress::ipv6_address> make_ipv6_queries(const std::vector<ipaddress::ipv6_address>& addresses) {
+    std::mt19937_64 rng(42);
+    std::vector<ipaddress::ipv6_address> result;
+    result.reserve(1 << 20);
+    for (size_t i = 0; i < (1 << 20); ++i) {
+        result.push_back(i % 2 == 0
+            ? addresses[rng() % addresses.size()]
+            : ipaddress::ipv6_address::from_uint(ipaddress::uint128_t(0x2001000000000000ULL | (rng() >> 16), rng())));
+    }
+    return result;
+}
+
+template <typename Address>
+static void binary_search(benchmark::State& state, const std::vector<Address>& addresses, const std::vector<Address>& queries) {
+    for (auto _ : state) {
+        size_t found = 0;
+        for (const auto& address : queries) {
+            found += std::binary_search(addresses.begin(), addresses.end(), address);
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * queries.size()));
+}
+
+template <typename Address>
+static void index_contains(benchmark::State& state, const std::vector<Address>& addresses, const std::vector<Address>& queries) {
+    const ipaddress::ip_sorted_index<Address> index(addresses.begin(), addresses.end());
+    for (auto _ : state) {
+        size_t found = 0;
+        for (const auto& address : queries) {
+            found += index.contains(address);
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * queries.size()));
+}
+
+template <typename Address>
+static void index_contains_batch(benchmark::State& state, const std::vector<Address>& addresses, const std::vector<Address>& queries) {
+    const ipaddress::ip_sorted_index<Address> index(addresses.begin(), addresses.end());
+    std::vector<char> found(queries.size());
+    for (auto _ : state) {
+        index.contains(queries.begin(), queries.end(), found.begin());
+        benchmark::DoNotOptimize(found.data());
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * queries.size()));
+}
+
+static void BM_binary_search_ipv4(benchmark::State& state) {
+    const auto addresses = make_ipv4(size_t(state.range(0)));
+    binary_search(state, addresses, make_ipv4_queries(addresses));
+}
+BENCHMARK(BM_binary_search_ipv4)->Arg(100000)->Arg(10000000)->Unit(benchmark::kMillisecond);
+
+static void BM_sorted_index_ipv4(benchmark::State& state) {
+    const auto addresses = make_ipv4(size_t(state.range(0)));
+    index_contains(state, addresses, make_ipv4_queries(addresses));
+}
+BENCHMARK(BM_sorted_index_ipv4)->Arg(100000)->Arg(10000000)->Unit(benchmark::kMillisecond);
+
+static void BM_sorted_index_batch_ipv4(benchmark::State& state) {
+    const auto addresses = make_ipv4(size_t(state.range(0)));
+    index_contains_batch(state, addresses, make_ipv4_queries(addresses));
+}
+BENCHMARK(BM_sorted_index_batch_ipv4)->Arg(100000)->Arg(10000000)->Unit(benchmark::kMillisecond);
+
+static void BM_binary_search_ipv6(benchmark::State& state) {
+    const auto addresses = make_ipv6(size_t(state.range(0)));
+    binary_search(state, addresses, make_ipv6_queries(addresses));
+}
+BENCHMARK(BM_binary_search_ipv6)->Arg(100000)->Arg(10000000)->Unit(benchmark::kMillisecond);
+
+static void BM_sorted_index_ipv6(benchmark::State& state) {
+    const auto addresses = make_ipv6(size_t(state.range(0)));
+    index_contains(state, addresses, make_ipv6_queries(addresses));
+}
+BENCHMARK(BM_sorted_index_ipv6)->Arg(100000)->Arg(10000000)->Unit(benchmark::kMillisecond);
+
+static void BM_sorted_index_batch_ipv6(benchmark::State& state) {
+    const auto addresses = make_ipv6(size_t(state.range(0)));
+    index_contains_batch(state, addresses, make_ipv6_queries(addresses));
+}
+BENCHMARK(BM_sorted_index_batch_ipv6)->Arg(100000)->Arg(10000000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,84 @@
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <ipaddress/ipaddress.hpp>
+
+// Synthetic GeoIP-style datasets: consecutive ranges of random lengths that tile
+// a part of the address space, so most ranges are not aligned to a CIDR block.
+// IPv6 ranges start and end on /64 boundaries, as allocations usually do.
+//
+static std::vector<std::pair<ipaddress::ipv4_address, ipaddress::ipv4_address>> make_ipv4_ranges(size_t count) {
+    std::mt19937 rng(2024);
+    std::vector<std::pair<ipaddress::ipv4_address, ipaddress::ipv4_address>> result;
+    result.reserve(count);
+    uint32_t first = 0x01000000;
+    for (size_t i = 0; i < count; ++i) {
+        const auto last = first + (uint32_t(rng()) >> (20 + rng() % 12));
+        result.emplace_back(ipaddress::ipv4_address::from_uint(first), ipaddress::ipv4_address::from_uint(last));
+        first = last + 1;
+    }
+    return result;
+}
+
+static std::vector<std::pair<ipaddress::ipv6_address, ipaddress::ipv6_address>> make_ipv6_ranges(size_t count) {
+    std::mt19937_64 rng(2024);
+    std::vector<std::pair<ipaddress::ipv6_address, ipaddress::ipv6_address>> result;
+    result.reserve(count);
+    uint64_t first = 0x2000000000000000ULL;
+    for (size_t i = 0; i < count; ++i) {
+        const auto last = first + (rng() >> (52 + rng() % 12));
+        result.emplace_back(
+            ipaddress::ipv6_address::from_uint(ipaddress::uint128_t(first, 0)),
+            ipaddress::ipv6_address::from_uint(ipaddress::uint128_t(last, 0xFFFFFFFFFFFFFFFFULL)));
+        first = last + 1;
+    }
+    return result;
+}
+
+template <typename Range>
+static void summarize_iterator(benchmark::State& state, const std::vector<Range>& ranges) {
+    std::vector<typename decltype(ipaddress::summarize_address_range(ranges[0].first, ranges[0].second))::value_type> result;
+    for (auto _ : state) {
+        result.clear();
+        for (const auto& range : ranges) {
+            for (const auto& net : ipaddress::summarize_address_range(range.first, range.second)) {
+                result.push_back(net);
+            }
+        }
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * ranges.size()));
+}
+
+template <typename Range>
+static void summarize_bulk(benchmark::State& state, const std::vector<Range>& ranges) {
+    std::vector<typename decltype(ipaddress::summarize_address_range(ranges[0].first, ranges[0].second))::value_type> result;
+    for (auto _ : state) {
+        result.clear();
+        ipaddress::summarize_address_ranges(ranges.begin(), ranges.end(), std::back_inserter(result));
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * ranges.size()));
+}
+
+static void BM_summarize_ipv4_iterator(benchmark::State& state) {
+    summarize_iterator(state, make_ipv4_ranges(size_t(state.range(0))));
+}
+BENCHMARK(BM_summarize_ipv4_iterator)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_summarize_ipv4_bulk(benchmark::State& state) {
+    summarize_bulk(state, make_ipv4_ranges(size_t(state.range(0))));
+}
+BENCHMARK(BM_summarize_ipv4_bulk)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_summarize_ipv6_iterator(benchmark::State& state) {
+    summarize_iterator(state, make_ipv6_ranges(size_t(state.range(0))));
+}
+BENCHMARK(BM_summarize_ipv6_iterator)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_summarize_ipv6_bulk(benchmark::State& state) {
+    summarize_bulk(state, make_ipv6_ranges(size_t(state.range(0))));
+}
+BENCHMARK(BM_summarize_ipv6_bulk)->Arg(1000000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,125 @@
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <ipaddress/ipaddress.hpp>
+
+// This file is built twice: once with the portable uint128_t and once with
+// IPADDRESS_UINT128_NATIVE, so that the two backends can be compared side by side.
+//
+#ifdef IPADDRESS_HAS_INT128
+#  define UINT128_BACKEND "native"
+#else
+#  define UINT128_BACKEND "portable"
+#endif
+
+static std::vector<ipaddress::uint128_t> make_values(size_t count, int bits) {
+    std::mt19937_64 rng(2024);
+    std::vector<ipaddress::uint128_t> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const ipaddress::uint128_t value(rng(), rng());
+        result.push_back(value >> (128 - bits));
+    }
+    return result;
+}
+
+// uint128_t arithmetic
+//
+static void BM_uint128_multiply(benchmark::State& state) {
+    const auto lhs = make_values(1024, 128);
+    const auto rhs = make_values(1024, 64);
+    for (auto _ : state) {
+        ipaddress::uint128_t result = 0;
+        for (size_t i = 0; i < lhs.size(); ++i) {
+            result ^= lhs[i] * rhs[i];
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * lhs.size()));
+}
+BENCHMARK(BM_uint128_multiply)->Name("BM_uint128_multiply/" UINT128_BACKEND);
+
+static void BM_uint128_divide(benchmark::State& state) {
+    const auto lhs = make_values(1024, 128);
+    const auto rhs = make_values(1024, int(state.range(0)));
+    for (auto _ : state) {
+        ipaddress::uint128_t result = 0;
+        for (size_t i = 0; i < lhs.size(); ++i) {
+            result ^= lhs[i] / (rhs[i] | 1);
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * lhs.size()));
+}
+BENCHMARK(BM_uint128_divide)->Name("BM_uint128_divide/" UINT128_BACKEND)->Arg(32)->Arg(64)->Arg(96);
+
+static void BM_uint128_shift(benchmark::State& state) {
+    const auto values = make_values(1024, 128);
+    for (auto _ : state) {
+        ipaddress::uint128_t result = 0;
+        for (size_t i = 0; i < values.size(); ++i) {
+            result ^= (values[i] << (i % 127)) + (values[i] >> (i % 113));
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * values.size()));
+}
+BENCHMARK(BM_uint128_shift)->Name("BM_uint128_shift/" UINT128_BACKEND);
+
+// IPv6 iteration and indexing
+//
+static void BM_ipv6_hosts_iterate(benchmark::State& state) {
+    const auto network = ipaddress::ipv6_network::parse("2001:db8::/112");
+    for (auto _ : state) {
+        size_t count = 0;
+        for (const auto& address : network.hosts()) {
+            count += address.bytes()[15];
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * 65535));
+}
+BENCHMARK(BM_ipv6_hosts_iterate)->Name("BM_ipv6_hosts_iterate/" UINT128_BACKEND);
+
+static void BM_ipv6_hosts_index(benchmark::State& state) {
+    const auto hosts = ipaddress::ipv6_network::parse("2001:db8::/64").hosts();
+    const auto indices = make_values(1024, 63);
+    for (auto _ : state) {
+        size_t count = 0;
+        for (const auto& index : indices) {
+            count += hosts[index].bytes()[15];
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * indices.size()));
+}
+BENCHMARK(BM_ipv6_hosts_index)->Name("BM_ipv6_hosts_index/" UINT128_BACKEND);
+
+static void BM_ipv6_subnets_index(benchmark::State& state) {
+    const auto subnets = ipaddress::ipv6_network::parse("2001:db8::/32").subnets(64);
+    const auto indices = make_values(1024, 64);
+    for (auto _ : state) {
+        size_t count = 0;
+        for (const auto& index : indices) {
+            count += subnets[index].network_address().bytes()[11];
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * indices.size()));
+}
+BENCHMARK(BM_ipv6_subnets_index)->Name("BM_ipv6_subnets_index/" UINT128_BACKEND);
+
+static void BM_ipv6_subnets_count(benchmark::State& state) {
+    const auto network = ipaddress::ipv6_network::parse("2001:db8::/32");
+    for (auto _ : state) {
+        size_t count = 0;
+        for (size_t prefixlen = 33; prefixlen <= 128; ++prefixlen) {
+            count += size_t(network.subnets(prefixlen - 32).size() % 1000);
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations() * 96));
+}
+BENCHMARK(BM_ipv6_subnets_count)->Name("BM_ipv6_subnets_count/" UINT128_BACKEND);
@@ -155,19 +155,33 @@ protected:
     }
 
     IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE size_t ip_to_chars(const base_type& bytes, format /*fmt*/, char (&result)[base_max_string_len + 1]) IPADDRESS_NOEXCEPT {
-        size_t offset = 0;
-        char buffer[4] {};
+        const auto end = ip_to_chars(bytes, result);
+        *end = '\0';
+        return size_t(end - result);
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE size_t ip_string_length(const base_type& bytes) IPADDRESS_NOEXCEPT {
+        size_t length = 3;
         for (size_t b = 0; b < 4; ++b) {
-            const size_t length = byte_to_string(bytes[b], buffer);
-            for (size_t i = 0; i < length; ++i) {
-                result[offset++] = buffer[i];
-            }
+            length += size_t(_octet_chars[size_t(bytes[b]) * 4 + 3] - '0');
+        }
+        return length;
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE char* ip_to_chars(const base_type& bytes, char* result) IPADDRESS_NOEXCEPT {
+        for (size_t b = 0; b < 4; ++b) {
+            // Three characters are always copied and the padding is overwritten by the
+            // next ones, so the output range must have room for 2 more characters
+            const auto octet = size_t(bytes[b]) * 4;
+            result[0] = _octet_chars[octet];
+            result[1] = _octet_chars[octet + 1];
+            result[2] = _octet_chars[octet + 2];
+            result += _octet_chars[octet + 3] - '0';
             if (b < 3) {
-                result[offset++] = '.';
+                *result++ = '.';
             }
         }
-        result[offset] = '\0';
-        return offset;
+        return result;
     }
 
     IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE std::string ip_reverse_pointer(const base_type& bytes) {
@@ -269,25 +283,25 @@ private:
         }
     }
 
-    IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE size_t byte_to_string(uint8_t byte, char (&str)[4]) IPADDRESS_NOEXCEPT {
-        size_t length = 0;
-        char* p = str;
-        do {
-            *p++ = char((byte % 10) + '0');
-            byte /= 10;
-            ++length;
-        } while (byte != 0);
-
-        *p = '\0';
-
-        for (size_t i = 0, midle = length / 2; i < midle; ++i) {
-            auto tmp = str[i];
-            str[i] = *--p;
-            *p = tmp;
-        }
-
-        return length;
-    }
+    // Decimal text of every octet value: the digits padded with spaces to three characters,
+    // followed by the number of digits
+    static constexpr char _octet_chars[256 * 4 + 1] =
+        "0  11  12  13  14  15  16  17  18  19  110 211 212 213 214 215 2"
+        "16 217 218 219 220 221 222 223 224 225 226 227 228 229 230 231 2"
+        "32 233 234 235 236 237 238 239 240 241 242 243 244 245 246 247 2"
+        "48 249 250 251 252 253 254 255 256 257 258 259 260 261 262 263 2"
+        "64 265 266 267 268 269 270 271 272 273 274 275 276 277 278 279 2"
+        "80 281 282 283 284 285 286 287 288 289 290 291 292 293 294 295 2"
+        "96 297 298 299 2100310131023103310431053106310731083109311031113"
+        "1123113311431153116311731183119312031213122312331243125312631273"
+        "1283129313031313132313331343135313631373138313931403141314231433"
+        "1443145314631473148314931503151315231533154315531563157315831593"
+        "1603161316231633164316531663167316831693170317131723173317431753"
+        "1763177317831793180318131823183318431853186318731883189319031913"
+        "1923193319431953196319731983199320032013202320332043205320632073"
+        "2083209321032113212321332143215321632173218321932203221322232233"
+        "2243225322632273228322932303231323232333234323532363237323832393"
+        "2403241324232433244324532463247324832493250325132523253325432553";
 };
 
 template <typename Ext>
@@ -305,6 +319,9 @@ constexpr size_t base_v4<Ext>::base_max_prefixlen;
 template <typename Ext>
 constexpr typename base_v4<Ext>::uint_type base_v4<Ext>::base_all_ones;
 
+template <typename Ext>
+constexpr char base_v4<Ext>::_octet_chars[256 * 4 + 1];
+
 } // namespace IPADDRESS_NAMESPACE
 
 #endif // IPADDRESS_BASE_V4_HPP
@@ -78,6 +78,11 @@ protected:
             return {};
         }
 
+        ip_address_base<Ext> fast_ip;
+        if (ip_from_string_fast(begin, end, fast_ip)) {
+            return fast_ip;
+        }
+
         auto ip_and_scope = split_scope_id(begin, end, code, value);
 
         if (code != error_code::no_error) {
@@ -125,99 +130,52 @@ protected:
     }
 
     IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE size_t ip_to_chars(const base_type& bytes, const fixed_string<IPADDRESS_IPV6_SCOPE_MAX_LENGTH>& scope_id, format fmt, char (&result)[base_max_string_len + 1]) IPADDRESS_NOEXCEPT {
+        constexpr char digits[] = "0123456789abcdef";
         constexpr auto hextets_count = size_t(base_size >> 1);
-        char hextets[hextets_count][5] = {};
-        const size_t max_hextets = base_size >> 1;
-        for (size_t i = 0; i < max_hextets; ++i) {
-            const uint16_t value = (uint16_t(bytes[i * 2]) << 8) | uint16_t(bytes[i * 2 + 1]);
-            to_hex(value, hextets[i]);
-        }
-        
-        auto count = max_hextets;
-        auto has_doublecolon_start = false;
-        auto has_doublecolon_end = false;
-
-        if (fmt == format::compact || fmt == format::compressed) {
-            for (size_t i = 0; i < hextets_count; ++i) {
-                auto& hextet = hextets[i];
-                for (size_t h = 0; h < 3; ++h) {
-                    if (hextet[0] != '0') {
-                        break;
-                    }
-                    hextet[0] = hextet[1];
-                    hextet[1] = hextet[2];
-                    hextet[2] = hextet[3];
-                    hextet[3] = hextet[4];
-                }
-            }
-
-            if (fmt == format::compressed) {
-                int best_doublecolon_len = 0;
-                int best_doublecolon_start = -1;
-                int doublecolon_len = 0;
-                int doublecolon_start = -1;
-
-                for (size_t i = 0; i < max_hextets; ++i) {
-                    const auto& hextet = hextets[i];
-                    if (hextet[0] == '0') {
-                        doublecolon_len += 1;
-
-                        if (doublecolon_start == -1) {
-                            doublecolon_start = int(i);
-                        }
-                        if (doublecolon_len > best_doublecolon_len) {
-                            best_doublecolon_len = doublecolon_len;
-                            best_doublecolon_start = doublecolon_start;
-                        }
-                    } else {
-                        doublecolon_len = 0;
-                        doublecolon_start = -1;
-                    }
-                }
-
-                if (best_doublecolon_len > 1) {
-                    const int best_doublecolon_end = best_doublecolon_start + best_doublecolon_len;
-                    if (best_doublecolon_end == max_hextets) {
-                        has_doublecolon_end = true;
-                    }
-                    hextets[best_doublecolon_start][0] = '\0';
-                    for (int h = best_doublecolon_start; h < max_hextets - 1; ++h) {
-                        const auto lindex = h + 1;
-                        const auto rindex = h + best_doublecolon_len;
-                        if (rindex >= max_hextets) {
-                            break;
-                        }
-                        hextets[lindex][0] = hextets[rindex][0];
-                        hextets[lindex][1] = hextets[rindex][1];
-                        hextets[lindex][2] = hextets[rindex][2];
-                        hextets[lindex][3] = hextets[rindex][3];
-                    }
-                    count -= best_doublecolon_len - 1;
-                    
-                    if (best_doublecolon_start == 0) {
-                        has_doublecolon_start = true;
-                    }
+        uint16_t hextets[hextets_count] = {};
+        uint32_t zeros = 0;
+        for (size_t i = 0; i < hextets_count; ++i) {
+            hextets[i] = uint16_t((uint16_t(bytes[i * 2]) << 8) | uint16_t(bytes[i * 2 + 1]));
+            zeros |= uint32_t(hextets[i] == 0) << i;
+        }
+
+        // The longest run of zero hextets (the first one on a tie) is found on the
+        // bitmask: after k steps of mask &= mask >> 1 only the bits starting runs
+        // of at least k + 1 zero hextets remain
+        size_t run_start = hextets_count;
+        size_t run_length = 0;
+        if (fmt == format::compressed) {
+            auto runs = zeros & (zeros >> 1);
+            for (auto length = 2; runs != 0; ++length, runs &= runs >> 1) {
+                run_length = size_t(length);
+                run_start = 0;
+                while (((runs >> run_start) & 1) == 0) {
+                    ++run_start;
                 }
             }
         }
 
         size_t offset = 0;
-        if (has_doublecolon_start) {
-            result[offset++] = ':';
-        }
-        for (size_t i = 0; i < count - 1; ++i) {
-            const auto& hextet = hextets[i];
-            for (size_t c = 0; hextet[c] != '\0'; ++c) {
-                result[offset++] = hextet[c];
+        for (size_t i = 0; i < hextets_count;) {
+            if (i == run_start) {
+                if (i == 0) {
+                    result[offset++] = ':';
+                }
+                result[offset++] = ':';
+                i += run_length;
+                continue;
+            }
+            const auto hextet = hextets[i];
+            auto shift = 12;
+            if (fmt != format::full) {
+                shift = hextet > 0xFFF ? 12 : hextet > 0xFF ? 8 : hextet > 0xF ? 4 : 0;
+            }
+            for (; shift >= 0; shift -= 4) {
+                result[offset++] = digits[(hextet >> shift) & 0xF];
+            }
+            if (++i < hextets_count) {
+                result[offset++] = ':';
             }
-            result[offset++] = ':';
-        }
-        const auto hextet = hextets[count - 1];
-        for (size_t c = 0; hextet[c] != '\0'; ++c) {
-            result[offset++] = hextet[c];
-        }
-        if (has_doublecolon_end) {
-            result[offset++] = ':';
         }
         if (!scope_id.empty()) {
             result[offset++] = '%';
@@ -300,6 +258,148 @@ protected:
     }
 
 private:
+    // Single pass over the input that decodes hextets directly into bytes. Only
+    // well-formed addresses are handled here; for anything else false is returned
+    // and the caller falls back to the multi-pass parser below, which is the one
+    // that reports errors, so error codes stay the same.
+    template <typename Iter>
+    IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool ip_from_string_fast(Iter begin, Iter end, ip_address_base<Ext>& result) IPADDRESS_NOEXCEPT {
+        uint16_t hextets[_max_parts] = {};
+        size_t count = 0;
+        size_t gap = _max_parts + 1;
+        auto it = begin;
+
+        if (*it == ':') {
+            if (++it == end || *it != ':') {
+                return false;
+            }
+            ++it;
+            gap = 0;
+        }
+
+        while (it < end && *it != '%') {
+            const auto group = it;
+            uint32_t hextet = 0;
+            size_t digits = 0;
+            for (; it < end && digits < 5; ++it, ++digits) {
+                const auto digit = hex_digit(uint32_t(*it));
+                if (digit > 15) {
+                    break;
+                }
+                hextet = (hextet << 4) | digit;
+            }
+
+            if (it < end && *it == '.') {
+                // The legacy parser counts the empty parts around a double colon as well,
+                // and permits an IPv4 suffix only after at most 6 parts
+                const auto parts = count + (gap == 0 ? 2 : gap <= _max_parts ? 1 : 0);
+                uint32_t ipv4 = 0;
+                it = group;
+                if (parts + 2 > _max_parts || !ipv4_from_string_fast(it, end, ipv4)) {
+                    return false;
+                }
+                hextets[count++] = uint16_t(ipv4 >> 16);
+                hextets[count++] = uint16_t(ipv4 & 0xFFFF);
+                break;
+            }
+
+            if (digits == 0 || digits > 4 || count == _max_parts) {
+                return false;
+            }
+            hextets[count++] = uint16_t(hextet);
+
+            if (it == end || *it == '%') {
+                break;
+            }
+            if (*it != ':' || ++it == end) {
+                return false;
+            }
+            if (*it == ':') {
+                if (gap <= _max_parts) {
+                    return false;
+                }
+                gap = count;
+                ++it;
+            } else if (*it == '%') {
+                return false;
+            }
+        }
+
+        if (gap > _max_parts ? count != _max_parts : count > _max_parts - 1) {
+            return false;
+        }
+
+        base_type bytes = {};
+        const auto head = gap > _max_parts ? count : gap;
+        for (size_t i = 0; i < count; ++i) {
+            const auto index = i < head ? i : _max_parts - count + i;
+            bytes[index * 2] = uint8_t(hextets[i] >> 8);
+            bytes[index * 2 + 1] = uint8_t(hextets[i] & 0xFF);
+        }
+
+        result = ip_address_base<Ext>(bytes);
+
+        if (it < end) {
+        #if IPADDRESS_IPV6_SCOPE_MAX_LENGTH > 0
+            char scope_id[IPADDRESS_IPV6_SCOPE_MAX_LENGTH + 1] = {};
+            size_t length = 0;
+        #endif // IPADDRESS_IPV6_SCOPE_MAX_LENGTH
+            for (++it; it < end; ++it) {
+                const auto c = uint32_t(*it);
+                if (c == 0 || c > 127 || internal::is_invalid_scope_id_symbol(char(c))) {
+                    return false;
+                }
+            #if IPADDRESS_IPV6_SCOPE_MAX_LENGTH > 0
+                if (length == IPADDRESS_IPV6_SCOPE_MAX_LENGTH) {
+                    return false;
+                }
+                scope_id[length++] = char(c);
+            #endif // IPADDRESS_IPV6_SCOPE_MAX_LENGTH
+            }
+        #if IPADDRESS_IPV6_SCOPE_MAX_LENGTH > 0
+            if (length == 0) {
+                return false;
+            }
+            auto code = error_code::no_error;
+            result._data.scope_id = make_fixed_string(scope_id, code);
+            if (code != error_code::no_error) {
+                return false;
+            }
+        #endif // IPADDRESS_IPV6_SCOPE_MAX_LENGTH
+        }
+
+        return true;
+    }
+
+    template <typename Iter>
+    IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool ipv4_from_string_fast(Iter& it, Iter end, uint32_t& result) IPADDRESS_NOEXCEPT {
+        uint32_t ip = 0;
+        for (size_t i = 0; i < 4; ++i) {
+            if (i > 0) {
+                if (it == end || *it != '.') {
+                    return false;
+                }
+                ++it;
+            }
+            uint32_t octet = 0;
+            size_t digits = 0;
+            const auto leading_zero = it < end && *it == '0';
+            for (; it < end && uint32_t(*it) - '0' < 10; ++it, ++digits) {
+                octet = octet * 10 + (uint32_t(*it) - '0');
+            }
+            if (digits == 0 || digits > 3 || octet > 255 || (leading_zero && digits > 1)) {
+                return false;
+            }
+            ip = (ip << 8) | octet;
+        }
+        result = ip;
+        return it == end || *it == '%';
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE uint32_t hex_digit(uint32_t c) IPADDRESS_NOEXCEPT {
+        return c - '0' < 10 ? c - '0' : (c | 0x20) - 'a' < 6 ? (c | 0x20) - 'a' + 10 : 16;
+    }
+
     template <typename Iter>
     struct ip_and_scope {
         Iter end_ip;
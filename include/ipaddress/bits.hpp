@@ -0,0 +1,74 @@
+/**
+ * @file      bits.hpp
+ * @brief     Bit manipulation helpers
+ * @author    Vladimir Shaleev
+ * @copyright MIT License
+ *
+ * This header provides small bit manipulation primitives such as population count
+ * and leading/trailing zero counts, which are used by the lookup structures and range
+ * summarization of the library. Compiler intrinsics are
+ * used where available, with portable fallbacks for other toolchains.
+ */
+
+#ifndef IPADDRESS_BITS_HPP
+#define IPADDRESS_BITS_HPP
+
+#include "config.hpp"
+
+namespace IPADDRESS_NAMESPACE {
+
+namespace internal {
+
+IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE uint32_t popcount_fallback(uint64_t value) IPADDRESS_NOEXCEPT {
+    value = value - ((value >> 1) & 0x5555555555555555ULL);
+    value = (value & 0x3333333333333333ULL) + ((value >> 2) & 0x3333333333333333ULL);
+    value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return uint32_t((value * 0x0101010101010101ULL) >> 56);
+}
+
+IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE uint32_t popcount(uint64_t value) IPADDRESS_NOEXCEPT {
+#if defined(__GNUC__) || defined(__clang__)
+    return uint32_t(__builtin_popcountll(value));
+#else
+    return popcount_fallback(value);
+#endif
+}
+
+IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE uint32_t countl_zero_fallback(uint64_t value) IPADDRESS_NOEXCEPT {
+    uint32_t count = 0;
+    for (uint64_t bit = 1ULL << 63; bit != 0 && (value & bit) == 0; bit >>= 1) {
+        ++count;
+    }
+    return count;
+}
+
+IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE uint32_t countr_zero_fallback(uint64_t value) IPADDRESS_NOEXCEPT {
+    uint32_t count = 0;
+    for (uint64_t bit = 1; bit != 0 && (value & bit) == 0; bit <<= 1) {
+        ++count;
+    }
+    return count;
+}
+
+// Both return 64 for a zero value, unlike the builtins, whose result is undefined there
+IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE uint32_t countl_zero(uint64_t value) IPADDRESS_NOEXCEPT {
+#if defined(__GNUC__) || defined(__clang__)
+    return value != 0 ? uint32_t(__builtin_clzll(value)) : 64;
+#else
+    return countl_zero_fallback(value);
+#endif
+}
+
+IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE uint32_t countr_zero(uint64_t value) IPADDRESS_NOEXCEPT {
+#if defined(__GNUC__) || defined(__clang__)
+    return value != 0 ? uint32_t(__builtin_ctzll(value)) : 64;
+#else
+    return countr_zero_fallback(value);
+#endif
+}
+
+} // namespace IPADDRESS_NAMESPACE::internal
+
+} // namespace IPADDRESS_NAMESPACE
+
+#endif // IPADDRESS_BITS_HPP
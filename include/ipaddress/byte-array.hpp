@@ -363,6 +363,78 @@ public:
     }
 }; // byte_array<0>
 
+namespace internal {
+
+// Bytes are loaded as big-endian words so that comparing the words gives the same result
+// as comparing the bytes lexicographically; compilers lower these to a load and a bswap.
+IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE uint32_t load_be32(const uint8_t* bytes) IPADDRESS_NOEXCEPT {
+    return (uint32_t(bytes[0]) << 24) | (uint32_t(bytes[1]) << 16) | (uint32_t(bytes[2]) << 8) | uint32_t(bytes[3]);
+}
+
+IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE uint64_t load_be64(const uint8_t* bytes) IPADDRESS_NOEXCEPT {
+    return (uint64_t(load_be32(bytes)) << 32) | uint64_t(load_be32(bytes + 4));
+}
+
+IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE void store_be32(uint8_t* bytes, uint32_t value) IPADDRESS_NOEXCEPT {
+    bytes[0] = uint8_t(value >> 24);
+    bytes[1] = uint8_t(value >> 16);
+    bytes[2] = uint8_t(value >> 8);
+    bytes[3] = uint8_t(value);
+}
+
+IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE void store_be64(uint8_t* bytes, uint64_t value) IPADDRESS_NOEXCEPT {
+    store_be32(bytes, uint32_t(value >> 32));
+    store_be32(bytes + 4, uint32_t(value));
+}
+
+template <size_t N>
+IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool equal_bytes(const uint8_t* lhs, const uint8_t* rhs) IPADDRESS_NOEXCEPT {
+    size_t i = 0;
+    for (; i + 8 <= N; i += 8) {
+        if (load_be64(lhs + i) != load_be64(rhs + i)) {
+            return false;
+        }
+    }
+    for (; i + 4 <= N; i += 4) {
+        if (load_be32(lhs + i) != load_be32(rhs + i)) {
+            return false;
+        }
+    }
+    for (; i < N; ++i) {
+        if (lhs[i] != rhs[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <size_t N>
+IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE int compare_bytes(const uint8_t* lhs, const uint8_t* rhs) IPADDRESS_NOEXCEPT {
+    size_t i = 0;
+    for (; i + 8 <= N; i += 8) {
+        const auto l = load_be64(lhs + i);
+        const auto r = load_be64(rhs + i);
+        if (l != r) {
+            return l < r ? -1 : 1;
+        }
+    }
+    for (; i + 4 <= N; i += 4) {
+        const auto l = load_be32(lhs + i);
+        const auto r = load_be32(rhs + i);
+        if (l != r) {
+            return l < r ? -1 : 1;
+        }
+    }
+    for (; i < N; ++i) {
+        if (lhs[i] != rhs[i]) {
+            return lhs[i] < rhs[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+} // namespace IPADDRESS_NAMESPACE::internal
+
 /**
  * Checks if two byte_array objects are equal.
  * 
@@ -377,12 +449,7 @@ public:
  */
 IPADDRESS_EXPORT template <size_t N>
 IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool operator==(const byte_array<N>& lhs, const byte_array<N>& rhs) IPADDRESS_NOEXCEPT {
-    for (size_t i = 0; i < N; ++i) {
-        if (lhs[i] != rhs[i]) {
-            return false;
-        }
-    }
-    return true;
+    return internal::equal_bytes<N>(lhs.data(), rhs.data());
 }
 
 /**
@@ -421,12 +488,7 @@ IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool operator!=(c
      */
     IPADDRESS_EXPORT template <size_t N>
     IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE std::strong_ordering operator<=>(const byte_array<N>& lhs, const byte_array<N>& rhs) IPADDRESS_NOEXCEPT {
-        for (size_t i = 0; i < N; ++i) {
-            if (const auto result = lhs[i] <=> rhs[i]; result != std::strong_ordering::equivalent) {
-                return result;
-            }
-        }
-        return std::strong_ordering::equivalent;
+        return internal::compare_bytes<N>(lhs.data(), rhs.data()) <=> 0;
     }
 
 #else // !IPADDRESS_HAS_SPACESHIP_OPERATOR
@@ -445,14 +507,7 @@ IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool operator!=(c
      */
     IPADDRESS_EXPORT template <size_t N>
     IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool operator<(const byte_array<N>& lhs, const byte_array<N>& rhs) IPADDRESS_NOEXCEPT {
-        for (size_t i = 0; i < N; ++i) {
-            if (lhs._data[i] < rhs._data[i]) {
-                return true;
-            } else if (lhs._data[i] != rhs._data[i]) {
-                break;
-            }
-        }
-        return false;
+        return internal::compare_bytes<N>(lhs.data(), rhs.data()) < 0;
     }
 
     /**
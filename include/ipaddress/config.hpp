@@ -173,4 +173,26 @@
 #  define IPADDRESS_IPV6_SCOPE_MAX_LENGTH 16
 #endif
 
+#if defined(IPADDRESS_UINT128_NATIVE) && defined(__SIZEOF_INT128__)
+#  define IPADDRESS_HAS_INT128
+#endif
+
+#if !defined(IPADDRESS_NO_PREFETCH) && (defined(__GNUC__) || defined(__clang__))
+#  define IPADDRESS_PREFETCH
+#endif
+
+#if !defined(IPADDRESS_NO_SIMD) && (defined(__SSSE3__) || (defined(_MSC_VER) && defined(__AVX__)))
+#  define IPADDRESS_SSSE3
+#  ifndef IPADDRESS_MODULE
+#    include <tmmintrin.h>
+#  endif
+#endif
+
+#if !defined(IPADDRESS_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#  define IPADDRESS_SSE2
+#  ifndef IPADDRESS_MODULE
+#    include <emmintrin.h>
+#  endif
+#endif
+
 #endif // IPADDRESS_CONFIG_HPP
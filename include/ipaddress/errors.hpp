@@ -89,7 +89,13 @@ IPADDRESS_EXPORT enum class error_code {
     new_prefix_must_be_longer, /**< The new prefix length must be longer for the operation being performed. */
     cannot_set_prefixlen_diff_and_new_prefix, /**< Both prefix length difference and new prefix cannot be set simultaneously. */
     not_contained_network, /**< The network is not a subnet of the other network as expected. */
-    last_address_must_be_greater_than_first /**< The last IP address in the range must be greater than the first IP address. */
+    last_address_must_be_greater_than_first, /**< The last IP address in the range must be greater than the first IP address. */
+    overlapping_ranges, /**< The address ranges overlap where they are required to be disjoint. */
+    invalid_database, /**< The data is not a prefix database of a supported version, or was written for another value type or byte order. */
+    cannot_map_file, /**< The file cannot be opened or mapped into memory. */
+    invalid_encoding, /**< The binary data is truncated, malformed or encodes a value of another type. */
+    unsorted_sequence, /**< The sequence is not sorted in ascending order where it is required to be. */
+    network_too_large /**< The network covers too many of the fixed-length prefixes that the operation stores it as. */
 };
 
 /**
@@ -378,6 +384,18 @@ IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE void raise_error(error_code code, uin
             throw logic_error(code, "network is not a subnet of other");
         case error_code::last_address_must_be_greater_than_first:
             throw logic_error(code, "last address must be greater than first");
+        case error_code::overlapping_ranges:
+            throw logic_error(code, "address ranges overlap");
+        case error_code::invalid_database:
+            throw logic_error(code, "invalid prefix database");
+        case error_code::cannot_map_file:
+            throw error(code, "cannot map file");
+        case error_code::invalid_encoding:
+            throw logic_error(code, "invalid binary encoding");
+        case error_code::unsorted_sequence:
+            throw logic_error(code, "sequence is not sorted");
+        case error_code::network_too_large:
+            throw logic_error(code, "network is too large");
         default:
             throw error(code, "unknown error");
     }
@@ -0,0 +1,136 @@
+/**
+ * @file      eytzinger.hpp
+ * @brief     Eytzinger layout of sorted keys
+ * @author    Vladimir Shaleev
+ * @copyright MIT License
+ *
+ * This header provides the search primitives shared by ip_range_map and ip_sorted_index,
+ * which store their sorted keys in Eytzinger (breadth-first) order. The first levels of every
+ * search share a handful of cache lines, the descent is branch-free, and the cache line holding
+ * the next four levels is prefetched while the current one is compared. The prefetch is
+ * compiled out when IPADDRESS_NO_PREFETCH is defined.
+ */
+
+#ifndef IPADDRESS_EYTZINGER_HPP
+#define IPADDRESS_EYTZINGER_HPP
+
+#include "uint128.hpp"
+#include "bits.hpp"
+
+namespace IPADDRESS_NAMESPACE {
+
+namespace internal {
+
+// Keys laid out in Eytzinger order: slot k has children 2k and 2k + 1, slot 0 is unused.
+// A search descends to a leaf position past the last level; the turns taken on the way
+// give both neighbours of the value: the last left turn was at its lower bound and the
+// last right turn at the greatest key below it.
+
+template <typename UInt>
+IPADDRESS_FORCE_INLINE void eytzinger_prefetch(const UInt* keys, size_t k) IPADDRESS_NOEXCEPT {
+#ifdef IPADDRESS_PREFETCH
+    // The 16 descendants four levels down are adjacent, fetch them while this level is compared.
+    // The address may lie past the array, which is harmless for a prefetch.
+    __builtin_prefetch(reinterpret_cast<const void*>(reinterpret_cast<uintptr_t>(keys) + k * 16 * sizeof(UInt)));
+#else
+    (void) keys;
+    (void) k;
+#endif
+}
+
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_t eytzinger_less(uint32_t lhs, uint32_t rhs) IPADDRESS_NOEXCEPT {
+    return size_t(lhs < rhs);
+}
+
+// Both halves are compared unconditionally: in a batch the loads of the other queries hide
+// the latency, and the branch of the short-circuit in operator< would only be mispredicted.
+// A single search keeps operator<, whose speculation runs ahead on the likely path.
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_t eytzinger_less(const uint128_t& lhs, const uint128_t& rhs) IPADDRESS_NOEXCEPT {
+    return size_t(lhs.upper() < rhs.upper()) | (size_t(lhs.upper() == rhs.upper()) & size_t(lhs.lower() < rhs.lower()));
+}
+
+// Returns the leaf reached by the value in the n keys stored at keys[1] .. keys[n]
+template <typename UInt>
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_t eytzinger_descend(const UInt* keys, size_t n, const UInt& value) IPADDRESS_NOEXCEPT {
+    size_t k = 1;
+    while (k <= n) {
+        eytzinger_prefetch(keys, k);
+        k = 2 * k + size_t(keys[k] < value);
+    }
+    return k;
+}
+
+// Descends a group of values at once, one level at a time. The first levels are complete,
+// so every value takes the same number of steps there and only the last level is checked.
+template <typename UInt>
+IPADDRESS_FORCE_INLINE void eytzinger_descend(const UInt* keys, size_t n, const UInt* values, size_t count, size_t* leaves) IPADDRESS_NOEXCEPT {
+    size_t levels = 0;
+    while ((size_t(2) << levels) <= n) {
+        ++levels;
+    }
+    std::fill(leaves, leaves + count, size_t(1));
+    for (size_t level = 0; level < levels; ++level) {
+        for (size_t i = 0; i < count; ++i) {
+            const auto k = leaves[i];
+            eytzinger_prefetch(keys, k);
+            leaves[i] = 2 * k + eytzinger_less(keys[k], values[i]);
+        }
+    }
+    for (size_t i = 0; i < count; ++i) {
+        const auto k = leaves[i];
+        if (k <= n) {
+            leaves[i] = 2 * k + eytzinger_less(keys[k], values[i]);
+        }
+    }
+}
+
+// Drop the trailing right turns and the last left turn to get the lower bound
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_t eytzinger_lower_bound(size_t leaf) IPADDRESS_NOEXCEPT {
+    return leaf >> (countr_zero(~uint64_t(leaf)) + 1);
+}
+
+// Drop the trailing left turns and the last right turn to get the greatest key below
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_t eytzinger_predecessor(size_t leaf) IPADDRESS_NOEXCEPT {
+    return leaf >> (countr_zero(uint64_t(leaf)) + 1);
+}
+
+// Returns the slot of the smallest of n keys, or 0 if there are none
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_t eytzinger_front(size_t n) IPADDRESS_NOEXCEPT {
+    size_t k = 1;
+    while (2 * k <= n) {
+        k = 2 * k;
+    }
+    return n != 0 ? k : 0;
+}
+
+// Returns the slot of the largest of n keys, or 0 if there are none
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_t eytzinger_back(size_t n) IPADDRESS_NOEXCEPT {
+    size_t k = 1;
+    while (2 * k + 1 <= n) {
+        k = 2 * k + 1;
+    }
+    return n != 0 ? k : 0;
+}
+
+// Calls place(i, k) for every i in 0 .. n - 1 with the slot k of the i-th smallest of n keys
+template <typename Place>
+IPADDRESS_FORCE_INLINE void eytzinger_build(size_t n, const Place& place) {
+    // In-order traversal of the implicit tree visits the slots in ascending order
+    size_t i = 0;
+    size_t k = 1;
+    while (i < n) {
+        while (k <= n) {
+            k *= 2;
+        }
+        k = eytzinger_lower_bound(k);
+        place(i, k);
+        ++i;
+        k = 2 * k + 1;
+    }
+}
+
+} // namespace IPADDRESS_NAMESPACE::internal
+
+} // namespace IPADDRESS_NAMESPACE
+
+#endif // IPADDRESS_EYTZINGER_HPP
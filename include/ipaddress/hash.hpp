@@ -11,7 +11,8 @@
  * for different sizes of data. Magic numbers and bitwise operations in hash_combine 
  * functions help distribute hash values evenly, which is important for avoiding 
  * collisions in hash tables. The hash_sum and calc_hash functions provide a convenient 
- * interface for calculating hash sums and computing the hash sum of multiple values.
+ * interface for calculating hash sums and computing the hash sum of multiple values;
+ * addresses are hashed as whole words with a single hash_sum call.
  */
 
 #ifndef IPADDRESS_HASH_HPP
@@ -55,6 +56,30 @@ IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE size_t hash_sum(s
     return hash(seed + 0x9e3779b9 + value);
 }
 
+// Hashes a 128-bit value with a single mixing round: the high word is spread by
+// a multiplication by the golden ratio before the low word is added.
+IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE size_t hash_sum(size_t seed, uint64_t upper, uint64_t lower) IPADDRESS_NOEXCEPT {
+    const hash_combine<8> hash{};
+    return hash((upper ^ uint64_t(seed)) * 0x9e3779b97f4a7c15ULL + lower);
+}
+
+// A stronger 64-bit mixer for open addressing (the finalizer of MurmurHash3), where both
+// the low bits (the probe start) and the high bits (the control byte) of the result must
+// be well distributed regardless of the size of size_t.
+IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE uint64_t strong_hash(uint64_t value) IPADDRESS_NOEXCEPT {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+// Both rounds are bijections, so values that differ only in the low word never collide
+IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE uint64_t strong_hash(uint64_t upper, uint64_t lower) IPADDRESS_NOEXCEPT {
+    return strong_hash(strong_hash(upper) ^ lower);
+}
+
 template <typename Arg>
 IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE size_t calc_hash(size_t seed, Arg arg) IPADDRESS_NOEXCEPT {
     return hash_sum(seed, arg);
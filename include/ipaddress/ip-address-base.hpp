@@ -43,6 +43,101 @@ IPADDRESS_EXPORT enum class format {
     compressed /**< Compressed format with maximal omission of segments or octets. */
 };
 
+/**
+ * Enumerates the special-purpose properties of an IP address.
+ *
+ * The flags are returned all at once by `classify()` and correspond to the
+ * individual `is_*` methods of the IP address classes. Values can be combined
+ * and tested with the bitwise operators.
+ */
+IPADDRESS_EXPORT enum class address_flags : uint32_t {
+    none = 0x00, /**< No flags are set. */
+    is_private = 0x01, /**< The address is allocated for private networks. */
+    is_global = 0x02, /**< The address is allocated for public networks. */
+    is_reserved = 0x04, /**< The address is otherwise IETF reserved. */
+    is_multicast = 0x08, /**< The address is reserved for multicast use. */
+    is_loopback = 0x10, /**< The address is a loopback address. */
+    is_link_local = 0x20, /**< The address is reserved for link-local usage. */
+    is_site_local = 0x40, /**< The address is reserved for site-local usage (IPv6 only). */
+    is_unspecified = 0x80 /**< The address is unspecified. */
+};
+
+/**
+ * Combines two sets of address flags.
+ *
+ * @param[in] lhs The first set of flags.
+ * @param[in] rhs The second set of flags.
+ * @return The flags set in either operand.
+ */
+IPADDRESS_EXPORT IPADDRESS_NODISCARD constexpr IPADDRESS_FORCE_INLINE address_flags operator|(address_flags lhs, address_flags rhs) IPADDRESS_NOEXCEPT {
+    return address_flags(uint32_t(lhs) | uint32_t(rhs));
+}
+
+/**
+ * Intersects two sets of address flags.
+ *
+ * @param[in] lhs The first set of flags.
+ * @param[in] rhs The second set of flags.
+ * @return The flags set in both operands.
+ */
+IPADDRESS_EXPORT IPADDRESS_NODISCARD constexpr IPADDRESS_FORCE_INLINE address_flags operator&(address_flags lhs, address_flags rhs) IPADDRESS_NOEXCEPT {
+    return address_flags(uint32_t(lhs) & uint32_t(rhs));
+}
+
+/**
+ * Computes the symmetric difference of two sets of address flags.
+ *
+ * @param[in] lhs The first set of flags.
+ * @param[in] rhs The second set of flags.
+ * @return The flags set in exactly one of the operands.
+ */
+IPADDRESS_EXPORT IPADDRESS_NODISCARD constexpr IPADDRESS_FORCE_INLINE address_flags operator^(address_flags lhs, address_flags rhs) IPADDRESS_NOEXCEPT {
+    return address_flags(uint32_t(lhs) ^ uint32_t(rhs));
+}
+
+/**
+ * Inverts a set of address flags.
+ *
+ * @param[in] flags The flags to invert.
+ * @return All known flags that are not set in \a flags.
+ */
+IPADDRESS_EXPORT IPADDRESS_NODISCARD constexpr IPADDRESS_FORCE_INLINE address_flags operator~(address_flags flags) IPADDRESS_NOEXCEPT {
+    return address_flags(~uint32_t(flags) & 0xFF);
+}
+
+/**
+ * Adds the flags of \a rhs to \a lhs.
+ *
+ * @param[in,out] lhs The flags to update.
+ * @param[in] rhs The flags to add.
+ * @return A reference to \a lhs.
+ */
+IPADDRESS_EXPORT IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE address_flags& operator|=(address_flags& lhs, address_flags rhs) IPADDRESS_NOEXCEPT {
+    return lhs = lhs | rhs;
+}
+
+/**
+ * Keeps only the flags of \a lhs that are also set in \a rhs.
+ *
+ * @param[in,out] lhs The flags to update.
+ * @param[in] rhs The flags to keep.
+ * @return A reference to \a lhs.
+ */
+IPADDRESS_EXPORT IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE address_flags& operator&=(address_flags& lhs, address_flags rhs) IPADDRESS_NOEXCEPT {
+    return lhs = lhs & rhs;
+}
+
+/**
+ * Toggles the flags of \a rhs in \a lhs.
+ *
+ * @param[in,out] lhs The flags to update.
+ * @param[in] rhs The flags to toggle.
+ * @return A reference to \a lhs.
+ */
+IPADDRESS_EXPORT IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE address_flags& operator^=(address_flags& lhs, address_flags rhs) IPADDRESS_NOEXCEPT {
+    return lhs = lhs ^ rhs;
+}
+
 /**
  * A template base class for IP address representations.
  * 
@@ -514,6 +609,55 @@ public:
         return true;
     }
 
+    /**
+     * Classifies the IP address against the special-purpose address registries.
+     *
+     * Returns the results of `is_private()`, `is_global()`, `is_reserved()`, `is_multicast()`,
+     * `is_loopback()`, `is_link_local()`, `is_unspecified()` and, for IPv6, `is_site_local()`
+     * at once. The flags are looked up in a table precomputed from the registries, so a single
+     * call is cheaper than querying several of the properties individually.
+     *
+     * @code{.cpp}
+     *   constexpr auto flags = ipv4_address::parse("192.168.1.1").classify();
+     *   static_assert((flags & address_flags::is_private) != address_flags::none, "");
+     * @endcode
+     * @return The set of flags that apply to the IP address.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE address_flags classify() const IPADDRESS_NOEXCEPT;
+
+    /**
+     * Converts the IP address to a character sequence.
+     * 
+     * Writes the string representation of the IP address into the range [\a first, \a last)
+     * without allocating memory, similar to `std::to_chars`. No null terminator is written.
+     * If the range is too small, nothing is written and `nullptr` is returned.
+     * 
+     * @code{.cpp}
+     *   char buffer[ipv6_address::base_max_string_len];
+     *   auto ip = ipv6_address::parse("2001:db8::1");
+     *   auto end = ip.to_chars(buffer, buffer + sizeof(buffer));
+     *   std::cout << std::string(buffer, end) << std::endl;
+     * 
+     *   // out:
+     *   // 2001:db8::1
+     * @endcode
+     * @param[out] first The beginning of the output range.
+     * @param[in] last The end of the output range.
+     * @param[in] fmt The format to use for the string representation. Defaults to `format::compressed`.
+     * @return A pointer one past the last character written, or `nullptr` if the range is too small.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE char* to_chars(char* first, char* last, format fmt = format::compressed) const IPADDRESS_NOEXCEPT {
+        char res[Base::base_max_string_len + 1]{};
+        const auto len = Base::ip_to_chars(Base::bytes(), fmt, res);
+        if (size_t(last - first) < len) {
+            return nullptr;
+        }
+        for (size_t i = 0; i < len; ++i) {
+            first[i] = res[i];
+        }
+        return first + len;
+    }
+
     /**
      * Converts the IP address to a string representation.
      * 
@@ -27,14 +27,34 @@ namespace IPADDRESS_NAMESPACE {
 
 namespace internal {
 
+// Returns true if the string cannot start an IPv4 address (or network),
+// which must begin with 1 to 3 digits followed by a dot. Only the first
+// four characters are checked. If it returns false, the IPv4 parser
+// runs first, and if it fails, the error is reported by the IPv6 parser
+template <typename Str>
+IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool is_ipv6_string(const Str& address) IPADDRESS_NOEXCEPT {
+    size_t digits = 0;
+    for (const auto c : address) {
+        if (c == '.') {
+            return false;
+        }
+        if (c < '0' || c > '9' || ++digits > 3) {
+            return true;
+        }
+    }
+    return true;
+}
+
 template <typename T>
 struct ip_any_parser {
     template <typename Str>
     IPADDRESS_NODISCARD_WHEN_NO_EXCEPTIONS static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE T parse(const Str& address) IPADDRESS_NOEXCEPT_WHEN_NO_EXCEPTIONS {
-        auto code = error_code::no_error;
-        const auto ipv4 = ipv4_address::parse(address, code);
-        if (code == error_code::no_error) {
-            return T(ipv4);
+        if (!is_ipv6_string(address)) {
+            auto code = error_code::no_error;
+            const auto ipv4 = ipv4_address::parse(address, code);
+            if (code == error_code::no_error) {
+                return T(ipv4);
+            }
         }
         return T(ipv6_address::parse(address));
     }
@@ -42,9 +62,11 @@ struct ip_any_parser {
     template <typename Str>
     static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE T parse(const Str& address, error_code& code) IPADDRESS_NOEXCEPT {
         code = error_code::no_error;
-        const auto ipv4 = ipv4_address::parse(address, code);
-        if (code == error_code::no_error) {
-            return T(ipv4);
+        if (!is_ipv6_string(address)) {
+            const auto ipv4 = ipv4_address::parse(address, code);
+            if (code == error_code::no_error) {
+                return T(ipv4);
+            }
         }
         const auto ipv6 = ipv6_address::parse(address, code);
         if (code == error_code::no_error) {
@@ -181,6 +203,18 @@ public:
         return _version == ip_version::V4 ? false : _ipv.ipv6.is_site_local();
     }
 
+    /**
+     * Classifies the IP address against the special-purpose address registries.
+     *
+     * Returns all the properties checked by the `is_*` methods at once, with a
+     * single lookup in a precomputed table.
+     *
+     * @return The set of flags that apply to the IP address.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE address_flags classify() const IPADDRESS_NOEXCEPT {
+        return _version == ip_version::V4 ? _ipv.ipv4.classify() : _ipv.ipv6.classify();
+    }
+
     /**
      * Checks if the IP address is an IPv4 address.
      * 
@@ -459,6 +493,21 @@ public:
         return _version == ip_version::V4 ? uint128_t(_ipv.ipv4.to_uint()) : _ipv.ipv6.to_uint();
     }
 
+    /**
+     * Converts the IP address to a character sequence.
+     * 
+     * Writes the string representation of the IP address into the range [\a first, \a last)
+     * without allocating memory. No null terminator is written.
+     * 
+     * @param[out] first The beginning of the output range.
+     * @param[in] last The end of the output range.
+     * @param[in] fmt The format to use for the string representation, defaults to compressed format.
+     * @return A pointer one past the last character written, or `nullptr` if the range is too small.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE char* to_chars(char* first, char* last, format fmt = format::compressed) const IPADDRESS_NOEXCEPT {
+        return _version == ip_version::V4 ? _ipv.ipv4.to_chars(first, last, fmt) : _ipv.ipv6.to_chars(first, last, fmt);
+    }
+
     /**
      * Converts the IP address to a string.
      * 
@@ -30,10 +30,12 @@ template <typename T>
 struct net_any_parser {
     template <typename Str>
     IPADDRESS_NODISCARD_WHEN_NO_EXCEPTIONS static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE T parse(const Str& address, bool strict) IPADDRESS_NOEXCEPT_WHEN_NO_EXCEPTIONS {
-        auto code = error_code::no_error;
-        const auto net4 = ipv4_network::parse(address, code, strict);
-        if (code == error_code::no_error) {
-            return T(net4);
+        if (!is_ipv6_string(address)) {
+            auto code = error_code::no_error;
+            const auto net4 = ipv4_network::parse(address, code, strict);
+            if (code == error_code::no_error) {
+                return T(net4);
+            }
         }
         return T(ipv6_network::parse(address, strict));
     }
@@ -41,9 +43,11 @@ struct net_any_parser {
     template <typename Str>
     static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE T parse(const Str& address, error_code& code, bool strict) IPADDRESS_NOEXCEPT {
         code = error_code::no_error;
-        const auto net4 = ipv4_network::parse(address, code, strict);
-        if (code == error_code::no_error) {
-            return T(net4);
+        if (!is_ipv6_string(address)) {
+            const auto net4 = ipv4_network::parse(address, code, strict);
+            if (code == error_code::no_error) {
+                return T(net4);
+            }
         }
         const auto net6 = ipv6_network::parse(address, code, strict);
         if (code == error_code::no_error) {
@@ -662,6 +666,100 @@ public:
         return exclude_network_sequence<ip_network>(lhs, rhs);
     }
 
+    /**
+     * Computes the network definitions resulting from removing a collection of networks from this one.
+     *
+     * The excluded networks are sorted once and the gaps between them are summarized in a single
+     * sweep. Excluded networks may overlap or repeat.
+     *
+     * @code{.cpp}
+     *   constexpr auto a = ip_network::parse("192.0.2.0/24");
+     *   const ip_network b[] = { ip_network::parse("192.0.2.64/26"), ip_network::parse("192.0.2.1/32") };
+     *
+     *   for (const auto& net : a.address_exclude(std::begin(b), std::end(b))) {
+     *      std::cout << net << std::endl;
+     *   }
+     *
+     *   // out:
+     *   // 192.0.2.0/32
+     *   // 192.0.2.2/31
+     *   // 192.0.2.4/30
+     *   // 192.0.2.8/29
+     *   // 192.0.2.16/28
+     *   // 192.0.2.32/27
+     *   // 192.0.2.128/25
+     * @endcode
+     * @tparam It The type of the iterator over the networks to exclude.
+     * @param[in] first The beginning of the range of networks to exclude.
+     * @param[in] last The end of the range of networks to exclude.
+     * @return The minimal list of networks covering the remaining addresses, in ascending order.
+     * @throw logic_error Raise if any of the networks has a different version or is not completely contained in this network.
+     */
+    template <typename It>
+    IPADDRESS_NODISCARD_WHEN_NO_EXCEPTIONS IPADDRESS_FORCE_INLINE std::vector<ip_network> address_exclude(It first, It last) const IPADDRESS_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+        error_code code = error_code::no_error;
+        auto result = address_exclude(first, last, code);
+        if (code != error_code::no_error) {
+            raise_error(code, 0, "", 0);
+        }
+        return result;
+    }
+
+    /**
+     * Computes the network definitions resulting from removing a collection of networks from this one, with error handling.
+     *
+     * @code{.cpp}
+     *   constexpr auto a = ip_network::parse("192.0.2.0/24");
+     *   const ip_network b[] = { ip_network::parse("192.0.2.0/25"), ip_network::parse("192.0.2.192/26") };
+     *
+     *   auto err = error_code::no_error;
+     *   auto networks = a.address_exclude(std::begin(b), std::end(b), err);
+     *
+     *   if (err == error_code::no_error) {
+     *       for (const auto& net : networks) {
+     *          std::cout << net << std::endl;
+     *       }
+     *   }
+     *
+     *   // out:
+     *   // 192.0.2.128/26
+     * @endcode
+     * @tparam It The type of the iterator over the networks to exclude.
+     * @param[in] first The beginning of the range of networks to exclude.
+     * @param[in] last The end of the range of networks to exclude.
+     * @param[out] code An error_code object that will be set if an error occurs during the operation.
+     * @return The minimal list of networks covering the remaining addresses, in ascending order, or an empty list if an error occurs.
+     */
+    template <typename It>
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE std::vector<ip_network> address_exclude(It first, It last, error_code& code) const {
+        code = error_code::no_error;
+        std::vector<ipv4_network> excluded4;
+        std::vector<ipv6_network> excluded6;
+        for (; first != last; ++first) {
+            const ip_network& net = *first;
+            if (_version != net._version) {
+                code = error_code::invalid_version;
+                return {};
+            }
+            if (_version == ip_version::V4) {
+                excluded4.push_back(net._ipv_net.ipv4);
+            } else {
+                excluded6.push_back(net._ipv_net.ipv6);
+            }
+        }
+        std::vector<ip_network> result;
+        if (_version == ip_version::V4) {
+            for (const auto& net : _ipv_net.ipv4.address_exclude(excluded4.begin(), excluded4.end(), code)) {
+                result.push_back(ip_network(net));
+            }
+        } else {
+            for (const auto& net : _ipv_net.ipv6.address_exclude(excluded6.begin(), excluded6.end(), code)) {
+                result.push_back(ip_network(net));
+            }
+        }
+        return result;
+    }
+
     /**
      * Retrieves the IPv4 network.
      * 
@@ -767,6 +865,21 @@ public:
             : ip_network(ipv6_network::from_address(address.v6().value(), code, prefixlen, strict));
     }
 
+    /**
+     * Converts the network to a character sequence.
+     * 
+     * Writes the network address and the prefix length into the range [\a first, \a last)
+     * without allocating memory. No null terminator is written.
+     * 
+     * @param[out] first The beginning of the output range.
+     * @param[in] last The end of the output range.
+     * @param[in] fmt The format to use for the string representation. *Defaults to format::compressed*.
+     * @return A pointer one past the last character written, or `nullptr` if the range is too small.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE char* to_chars(char* first, char* last, format fmt = format::compressed) const IPADDRESS_NOEXCEPT {
+        return is_v4() ? _ipv_net.ipv4.to_chars(first, last, fmt) : _ipv_net.ipv6.to_chars(first, last, fmt);
+    }
+
     /**
      * Converts the network to a string representation.
      * 
@@ -0,0 +1,793 @@
+/**
+ * @file      ip-binary.hpp
+ * @brief     Compact binary encoding of addresses and networks
+ * @author    Vladimir Shaleev
+ * @copyright MIT License
+ *
+ * This file provides functions for storing IP addresses and networks in a compact binary form.
+ * Two encodings are available:
+ *
+ * - The tagged encoding stores each value on its own: a tag byte with the IP version and kind,
+ *   followed by the address bytes. For networks, the tag is followed by the prefix length and
+ *   only the bytes covered by the prefix, so `10.0.0.0/8` takes 3 bytes and `2001:db8::/32`
+ *   takes 6 bytes. Any value can be decoded independently, and an address or network of a
+ *   specific version can be decoded as ip_address or ip_network.
+ * - The sorted encoding stores a sequence sorted in ascending order as the differences between
+ *   neighbouring values, written as variable-length integers (LEB128). Dense sequences, such as
+ *   the client addresses of a network or a routing table, then take one or two bytes per value.
+ *
+ * Both encodings are independent of the byte order of the machine. The scope id of IPv6
+ * addresses is not stored.
+ */
+
+#ifndef IPADDRESS_IP_BINARY_HPP
+#define IPADDRESS_IP_BINARY_HPP
+
+#include "ip-any-network.hpp"
+
+namespace IPADDRESS_NAMESPACE {
+
+namespace internal {
+
+enum binary_tag : uint8_t {
+    binary_ipv4_address = 0x04,
+    binary_ipv6_address = 0x06,
+    binary_ipv4_network = 0x14,
+    binary_ipv6_network = 0x16
+};
+
+struct binary_value {
+    uint8_t tag;
+    uint8_t prefixlen;
+    uint8_t bytes[16];
+};
+
+IPADDRESS_FORCE_INLINE uint8_t* write_varint(uint8_t* out, uint64_t value) IPADDRESS_NOEXCEPT {
+    while (value >= 0x80) {
+        *out++ = uint8_t(value) | 0x80;
+        value >>= 7;
+    }
+    *out++ = uint8_t(value);
+    return out;
+}
+
+IPADDRESS_FORCE_INLINE uint8_t* write_varint(uint8_t* out, uint128_t value) IPADDRESS_NOEXCEPT {
+    while (value.upper() != 0) {
+        *out++ = uint8_t(value.lower()) | 0x80;
+        value >>= 7;
+    }
+    return write_varint(out, value.lower());
+}
+
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool read_varint(const uint8_t*& it, const uint8_t* last, uint64_t& value) IPADDRESS_NOEXCEPT {
+    uint64_t result = 0;
+    for (size_t shift = 0; it != last; shift += 7) {
+        const auto byte = *it++;
+        if (shift == 63 && byte > 1) {
+            return false;
+        }
+        result |= uint64_t(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool read_varint(const uint8_t*& it, const uint8_t* last, uint128_t& value) IPADDRESS_NOEXCEPT {
+    uint64_t lower = 0;
+    for (size_t shift = 0; shift < 63; shift += 7) {
+        if (it == last) {
+            return false;
+        }
+        const auto byte = *it++;
+        lower |= uint64_t(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            value = uint128_t(0, lower);
+            return true;
+        }
+    }
+    uint128_t result(0, lower);
+    for (size_t shift = 63; it != last; shift += 7) {
+        const auto byte = *it++;
+        if (shift == 126 && byte > 3) {
+            return false;
+        }
+        result |= uint128_t(0, byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+IPADDRESS_FORCE_INLINE uint8_t* write_tagged(uint8_t* out, binary_tag tag, const uint8_t* bytes, size_t size) IPADDRESS_NOEXCEPT {
+    *out++ = tag;
+    std::memcpy(out, bytes, size);
+    return out + size;
+}
+
+IPADDRESS_FORCE_INLINE uint8_t* write_tagged_network(uint8_t* out, binary_tag tag, const uint8_t* bytes, size_t prefixlen) IPADDRESS_NOEXCEPT {
+    const auto size = (prefixlen + 7) / 8;
+    *out++ = tag;
+    *out++ = uint8_t(prefixlen);
+    std::memcpy(out, bytes, size);
+    return out + size;
+}
+
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool read_tagged(const uint8_t*& it, const uint8_t* last, binary_value& value) IPADDRESS_NOEXCEPT {
+    if (it == last) {
+        return false;
+    }
+    value.tag = it[0];
+    value.prefixlen = 0;
+    size_t size = 0;
+    size_t header = 1;
+    switch (value.tag) {
+        case binary_ipv4_address:
+            size = 4;
+            break;
+        case binary_ipv6_address:
+            size = 16;
+            break;
+        case binary_ipv4_network:
+        case binary_ipv6_network:
+            if (last - it < 2 || it[1] > (value.tag == binary_ipv4_network ? 32 : 128)) {
+                return false;
+            }
+            value.prefixlen = it[1];
+            size = (value.prefixlen + 7) / 8;
+            header = 2;
+            break;
+        default:
+            return false;
+    }
+    if (size_t(last - it) < header + size) {
+        return false;
+    }
+    std::memset(value.bytes, 0, sizeof(value.bytes));
+    std::memcpy(value.bytes, it + header, size);
+    if (value.prefixlen % 8 != 0 && (value.bytes[size - 1] & (0xFF >> (value.prefixlen % 8))) != 0) {
+        return false;
+    }
+    it += header + size;
+    return true;
+}
+
+template <typename Network, typename UInt>
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool make_binary_network(const UInt& key, size_t prefixlen, Network& value) IPADDRESS_NOEXCEPT {
+    error_code code = error_code::no_error;
+    value = Network::from_address(Network::ip_address_type::from_uint(key), code, prefixlen, true);
+    return code == error_code::no_error;
+}
+
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE uint32_t binary_uint32(const uint8_t* bytes) IPADDRESS_NOEXCEPT {
+    return (uint32_t(bytes[0]) << 24) | (uint32_t(bytes[1]) << 16) | (uint32_t(bytes[2]) << 8) | uint32_t(bytes[3]);
+}
+
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE uint128_t binary_uint128(const uint8_t* bytes) IPADDRESS_NOEXCEPT {
+    return uint128_t(
+        (uint64_t(binary_uint32(bytes)) << 32) | binary_uint32(bytes + 4),
+        (uint64_t(binary_uint32(bytes + 8)) << 32) | binary_uint32(bytes + 12));
+}
+
+// Each specialization describes how one type is stored:
+//   max_size       the maximum size of the tagged encoding
+//   max_delta      the maximum size of an element of the sorted encoding
+//   has_v4/has_v6  which version blocks the sorted encoding has
+//   has_prefix     whether elements of the sorted encoding carry a prefix length
+//   encode/decode  the tagged encoding
+//   is_v4, key4, key6, prefixlen, make4, make6  the parts of the sorted encoding
+template <typename T>
+struct binary_traits;
+
+template <>
+struct binary_traits<ipv4_address> {
+    static constexpr size_t max_size = 5;
+    static constexpr size_t max_delta = 5;
+    static constexpr bool has_v4 = true;
+    static constexpr bool has_v6 = false;
+    static constexpr bool has_prefix = false;
+
+    IPADDRESS_FORCE_INLINE static uint8_t* encode(const ipv4_address& value, uint8_t* out) IPADDRESS_NOEXCEPT {
+        return write_tagged(out, binary_ipv4_address, value.data(), 4);
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static bool decode(const binary_value& binary, ipv4_address& value) IPADDRESS_NOEXCEPT {
+        value = ipv4_address::from_uint(binary_uint32(binary.bytes));
+        return binary.tag == binary_ipv4_address;
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static bool is_v4(const ipv4_address& /*value*/) IPADDRESS_NOEXCEPT {
+        return true;
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static uint32_t key4(const ipv4_address& value) IPADDRESS_NOEXCEPT {
+        return value.to_uint();
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static uint128_t key6(const ipv4_address& /*value*/) IPADDRESS_NOEXCEPT {
+        return 0;
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static uint8_t prefixlen(const ipv4_address& /*value*/) IPADDRESS_NOEXCEPT {
+        return 32;
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static bool make4(uint32_t key, size_t /*prefixlen*/, ipv4_address& value) IPADDRESS_NOEXCEPT {
+        value = ipv4_address::from_uint(key);
+        return true;
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static bool make6(const uint128_t& /*key*/, size_t /*prefixlen*/, ipv4_address& /*value*/) IPADDRESS_NOEXCEPT {
+        return false;
+    }
+};
+
+template <>
+struct binary_traits<ipv6_address> {
+    static constexpr size_t max_size = 17;
+    static constexpr size_t max_delta = 19;
+    static constexpr bool has_v4 = false;
+    static constexpr bool has_v6 = true;
+    static constexpr bool has_prefix = false;
+
+    IPADDRESS_FORCE_INLINE static uint8_t* encode(const ipv6_address& value, uint8_t* out) IPADDRESS_NOEXCEPT {
+        return write_tagged(out, binary_ipv6_address, value.data(), 16);
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static bool decode(const binary_value& binary, ipv6_address& value) IPADDRESS_NOEXCEPT {
+        value = ipv6_address::from_uint(binary_uint128(binary.bytes));
+        return binary.tag == binary_ipv6_address;
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static bool is_v4(const ipv6_address& /*value*/) IPADDRESS_NOEXCEPT {
+        return false;
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static uint32_t key4(const ipv6_address& /*value*/) IPADDRESS_NOEXCEPT {
+        return 0;
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static uint128_t key6(const ipv6_address& value) IPADDRESS_NOEXCEPT {
+        return value.to_uint();
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static uint8_t prefixlen(const ipv6_address& /*value*/) IPADDRESS_NOEXCEPT {
+        return 128;
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static bool make4(uint32_t /*key*/, size_t /*prefixlen*/, ipv6_address& /*value*/) IPADDRESS_NOEXCEPT {
+        return false;
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static bool make6(const uint128_t& key, size_t /*prefixlen*/, ipv6_address& value) IPADDRESS_NOEXCEPT {
+        value = ipv6_address::from_uint(key);
+        return true;
+    }
+};
+
+template <>
+struct binary_traits<ip_address> {
+    static constexpr size_t max_size = 17;
+    static constexpr size_t max_delta = 19;
+    static constexpr bool has_v4 = true;
+    static constexpr bool has_v6 = true;
+    static constexpr bool has_prefix = false;
+
+    IPADDRESS_FORCE_INLINE static uint8_t* encode(const ip_address& value, uint8_t* out) IPADDRESS_NOEXCEPT {
+        return value.is_v4()
+            ? write_tagged(out, binary_ipv4_address, value.data(), 4)
+            : write_tagged(out, binary_ipv6_address, value.data(), 16);
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static bool decode(const binary_value& binary, ip_address& value) IPADDRESS_NOEXCEPT {
+        if (binary.tag == binary_ipv4_address) {
+            value = ipv4_address::from_uint(binary_uint32(binary.bytes));
+            return true;
+        }
+        value = ipv6_address::from_uint(binary_uint128(binary.bytes));
+        return binary.tag == binary_ipv6_address;
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static bool is_v4(const ip_address& value) IPADDRESS_NOEXCEPT {
+        return value.is_v4();
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static uint32_t key4(const ip_address& value) IPADDRESS_NOEXCEPT {
+        return value.to_uint32();
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static uint128_t key6(const ip_address& value) IPADDRESS_NOEXCEPT {
+        return value.to_uint128();
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static uint8_t prefixlen(const ip_address& value) IPADDRESS_NOEXCEPT {
+        return value.is_v4() ? 32 : 128;
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static bool make4(uint32_t key, size_t /*prefixlen*/, ip_address& value) IPADDRESS_NOEXCEPT {
+        value = ipv4_address::from_uint(key);
+        return true;
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static bool make6(const uint128_t& key, size_t /*prefixlen*/, ip_address& value) IPADDRESS_NOEXCEPT {
+        value = ipv6_address::from_uint(key);
+        return true;
+    }
+};
+
+template <>
+struct binary_traits<ipv4_network> {
+    static constexpr size_t max_size = 6;
+    static constexpr size_t max_delta = 6;
+    static constexpr bool has_v4 = true;
+    static constexpr bool has_v6 = false;
+    static constexpr bool has_prefix = true;
+
+    IPADDRESS_FORCE_INLINE static uint8_t* encode(const ipv4_network& value, uint8_t* out) IPADDRESS_NOEXCEPT {
+        return write_tagged_network(out, binary_ipv4_network, value.network_address().data(), value.prefixlen());
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static bool decode(const binary_value& binary, ipv4_network& value) IPADDRESS_NOEXCEPT {
+        return binary.tag == binary_ipv4_network && make_binary_network(binary_uint32(binary.bytes), binary.prefixlen, value);
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static bool is_v4(const ipv4_network& /*value*/) IPADDRESS_NOEXCEPT {
+        return true;
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static uint32_t key4(const ipv4_network& value) IPADDRESS_NOEXCEPT {
+        return value.network_address().to_uint();
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static uint128_t key6(const ipv4_network& /*value*/) IPADDRESS_NOEXCEPT {
+        return 0;
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static uint8_t prefixlen(const ipv4_network& value) IPADDRESS_NOEXCEPT {
+        return uint8_t(value.prefixlen());
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static bool make4(uint32_t key, size_t prefixlen, ipv4_network& value) IPADDRESS_NOEXCEPT {
+        return make_binary_network(key, prefixlen, value);
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static bool make6(const uint128_t& /*key*/, size_t /*prefixlen*/, ipv4_network& /*value*/) IPADDRESS_NOEXCEPT {
+        return false;
+    }
+};
+
+template <>
+struct binary_traits<ipv6_network> {
+    static constexpr size_t max_size = 18;
+    static constexpr size_t max_delta = 20;
+    static constexpr bool has_v4 = false;
+    static constexpr bool has_v6 = true;
+    static constexpr bool has_prefix = true;
+
+    IPADDRESS_FORCE_INLINE static uint8_t* encode(const ipv6_network& value, uint8_t* out) IPADDRESS_NOEXCEPT {
+        return write_tagged_network(out, binary_ipv6_network, value.network_address().data(), value.prefixlen());
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static bool decode(const binary_value& binary, ipv6_network& value) IPADDRESS_NOEXCEPT {
+        return binary.tag == binary_ipv6_network && make_binary_network(binary_uint128(binary.bytes), binary.prefixlen, value);
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static bool is_v4(const ipv6_network& /*value*/) IPADDRESS_NOEXCEPT {
+        return false;
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static uint32_t key4(const ipv6_network& /*value*/) IPADDRESS_NOEXCEPT {
+        return 0;
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static uint128_t key6(const ipv6_network& value) IPADDRESS_NOEXCEPT {
+        return value.network_address().to_uint();
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static uint8_t prefixlen(const ipv6_network& value) IPADDRESS_NOEXCEPT {
+        return uint8_t(value.prefixlen());
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static bool make4(uint32_t /*key*/, size_t /*prefixlen*/, ipv6_network& /*value*/) IPADDRESS_NOEXCEPT {
+        return false;
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static bool make6(const uint128_t& key, size_t prefixlen, ipv6_network& value) IPADDRESS_NOEXCEPT {
+        return make_binary_network(key, prefixlen, value);
+    }
+};
+
+template <>
+struct binary_traits<ip_network> {
+    static constexpr size_t max_size = 18;
+    static constexpr size_t max_delta = 20;
+    static constexpr bool has_v4 = true;
+    static constexpr bool has_v6 = true;
+    static constexpr bool has_prefix = true;
+
+    IPADDRESS_FORCE_INLINE static uint8_t* encode(const ip_network& value, uint8_t* out) IPADDRESS_NOEXCEPT {
+        return value.version() == ip_version::V4
+            ? write_tagged_network(out, binary_ipv4_network, value.network_address().data(), value.prefixlen())
+            : write_tagged_network(out, binary_ipv6_network, value.network_address().data(), value.prefixlen());
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static bool decode(const binary_value& binary, ip_network& value) IPADDRESS_NOEXCEPT {
+        if (binary.tag == binary_ipv4_network) {
+            return make4(binary_uint32(binary.bytes), binary.prefixlen, value);
+        }
+        return binary.tag == binary_ipv6_network && make6(binary_uint128(binary.bytes), binary.prefixlen, value);
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static bool is_v4(const ip_network& value) IPADDRESS_NOEXCEPT {
+        return value.version() == ip_version::V4;
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static uint32_t key4(const ip_network& value) IPADDRESS_NOEXCEPT {
+        return value.network_address().to_uint32();
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static uint128_t key6(const ip_network& value) IPADDRESS_NOEXCEPT {
+        return value.network_address().to_uint128();
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static uint8_t prefixlen(const ip_network& value) IPADDRESS_NOEXCEPT {
+        return uint8_t(value.prefixlen());
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static bool make4(uint32_t key, size_t prefixlen, ip_network& value) IPADDRESS_NOEXCEPT {
+        ipv4_network network;
+        const auto result = make_binary_network(key, prefixlen, network);
+        value = ip_network(network);
+        return result;
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE static bool make6(const uint128_t& key, size_t prefixlen, ip_network& value) IPADDRESS_NOEXCEPT {
+        ipv6_network network;
+        const auto result = make_binary_network(key, prefixlen, network);
+        value = ip_network(network);
+        return result;
+    }
+};
+
+// A block of the sorted encoding: the number of elements followed by
+// the delta of each element from the previous one (starting from zero)
+template <typename T, typename UInt, typename It, typename Key>
+IPADDRESS_FORCE_INLINE uint8_t* encode_sorted_block(It first, It last, uint8_t* out, bool v4, Key key, error_code& code) IPADDRESS_NOEXCEPT {
+    using traits = binary_traits<T>;
+
+    out = write_varint(out, uint64_t(std::distance(first, last)));
+    UInt previous = 0;
+    for (; first != last; ++first) {
+        const auto current = key(*first);
+        if (traits::is_v4(*first) != v4 || current < previous) {
+            code = error_code::unsorted_sequence;
+            return out;
+        }
+        out = write_varint(out, current - previous);
+        if (traits::has_prefix) {
+            *out++ = traits::prefixlen(*first);
+        }
+        previous = current;
+    }
+    return out;
+}
+
+template <typename T, typename UInt, typename OutputIt, typename Make>
+IPADDRESS_FORCE_INLINE OutputIt decode_sorted_block(const uint8_t*& it, const uint8_t* last, OutputIt out, UInt max, Make make, error_code& code) IPADDRESS_NOEXCEPT {
+    using traits = binary_traits<T>;
+
+    uint64_t count = 0;
+    if (!read_varint(it, last, count) || count > uint64_t(last - it)) {
+        code = error_code::invalid_encoding;
+        return out;
+    }
+    UInt current = 0;
+    for (uint64_t i = 0; i < count; ++i) {
+        typename std::conditional<std::is_same<UInt, uint32_t>::value, uint64_t, uint128_t>::type delta = 0;
+        if (!read_varint(it, last, delta) || delta > max - current) {
+            code = error_code::invalid_encoding;
+            return out;
+        }
+        current += UInt(delta);
+        size_t prefixlen = 0;
+        if (traits::has_prefix) {
+            if (it == last) {
+                code = error_code::invalid_encoding;
+                return out;
+            }
+            prefixlen = *it++;
+        }
+        T value;
+        if (!make(current, prefixlen, value)) {
+            code = error_code::invalid_encoding;
+            return out;
+        }
+        *out++ = value;
+    }
+    return out;
+}
+
+} // namespace IPADDRESS_NAMESPACE::internal
+
+/**
+ * Returns the maximum size of the tagged binary encoding of a value.
+ *
+ * A buffer of this size is always enough for encode_binary().
+ *
+ * @tparam T the type of value: ipv4_address, ipv6_address, ip_address, ipv4_network, ipv6_network or ip_network.
+ * @return The maximum number of bytes.
+ */
+IPADDRESS_EXPORT template <typename T>
+IPADDRESS_NODISCARD constexpr IPADDRESS_FORCE_INLINE size_t max_binary_size() IPADDRESS_NOEXCEPT {
+    return internal::binary_traits<T>::max_size;
+}
+
+/**
+ * Returns the maximum size of the sorted binary encoding of a sequence.
+ *
+ * A buffer of this size is always enough for encode_sorted_binary().
+ *
+ * @tparam T the type of elements: ipv4_address, ipv6_address, ip_address, ipv4_network, ipv6_network or ip_network.
+ * @param[in] count the number of elements in the sequence.
+ * @return The maximum number of bytes.
+ */
+IPADDRESS_EXPORT template <typename T>
+IPADDRESS_NODISCARD constexpr IPADDRESS_FORCE_INLINE size_t max_sorted_binary_size(size_t count) IPADDRESS_NOEXCEPT {
+    return 20 + count * internal::binary_traits<T>::max_delta;
+}
+
+/**
+ * Writes the tagged binary encoding of a value.
+ *
+ * An address takes 5 (IPv4) or 17 (IPv6) bytes. A network takes 2 bytes plus the number
+ * of bytes covered by its prefix length.
+ *
+ * @code{.cpp}
+ *   uint8_t buffer[max_binary_size<ip_network>()];
+ *   const auto* end = encode_binary(ip_network::parse("10.0.0.0/8"), buffer);
+ *   std::cout << (end - buffer) << std::endl;
+ *
+ *   // out:
+ *   // 3
+ * @endcode
+ * @tparam T the type of value.
+ * @param[in] value the value to encode.
+ * @param[out] out the buffer, which must have room for at least max_binary_size<T>() bytes.
+ * @return A pointer past the last written byte.
+ */
+IPADDRESS_EXPORT template <typename T>
+IPADDRESS_FORCE_INLINE uint8_t* encode_binary(const T& value, uint8_t* out) IPADDRESS_NOEXCEPT {
+    return internal::binary_traits<T>::encode(value, out);
+}
+
+/**
+ * Reads a value in the tagged binary encoding.
+ *
+ * An IPv4 or IPv6 value can also be read as ip_address or ip_network.
+ *
+ * @tparam T the type of value.
+ * @param[in] first the beginning of the data.
+ * @param[in] last the end of the data.
+ * @param[out] value the decoded value.
+ * @param[out] code an error_code object that will be set if the data is truncated, malformed or holds a value of another type.
+ * @return A pointer past the decoded value, or \a first on error.
+ */
+IPADDRESS_EXPORT template <typename T>
+IPADDRESS_FORCE_INLINE const uint8_t* decode_binary(const uint8_t* first, const uint8_t* last, T& value, error_code& code) IPADDRESS_NOEXCEPT {
+    code = error_code::no_error;
+    auto it = first;
+    internal::binary_value binary;
+    if (!internal::read_tagged(it, last, binary) || !internal::binary_traits<T>::decode(binary, value)) {
+        code = error_code::invalid_encoding;
+        return first;
+    }
+    return it;
+}
+
+/**
+ * Reads a value in the tagged binary encoding.
+ *
+ * @tparam T the type of value.
+ * @param[in] first the beginning of the data.
+ * @param[in] last the end of the data.
+ * @param[out] value the decoded value.
+ * @return A pointer past the decoded value.
+ * @throw logic_error Raise if the data is truncated, malformed or holds a value of another type.
+ */
+IPADDRESS_EXPORT template <typename T>
+IPADDRESS_FORCE_INLINE const uint8_t* decode_binary(const uint8_t* first, const uint8_t* last, T& value) IPADDRESS_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+    error_code code = error_code::no_error;
+    const auto result = decode_binary(first, last, value, code);
+    if (code != error_code::no_error) {
+        raise_error(code, 0, "", 0);
+    }
+    return result;
+}
+
+/**
+ * Writes the tagged binary encoding of each value of a range, one after another.
+ *
+ * @tparam InputIt the type of the input iterator.
+ * @param[in] first the beginning of the range of values.
+ * @param[in] last the end of the range of values.
+ * @param[out] out the buffer, which must have room for at least `max_binary_size<T>()` bytes per value.
+ * @return A pointer past the last written byte.
+ */
+IPADDRESS_EXPORT template <typename InputIt>
+IPADDRESS_FORCE_INLINE uint8_t* encode_binary_sequence(InputIt first, InputIt last, uint8_t* out) IPADDRESS_NOEXCEPT {
+    using traits = internal::binary_traits<typename std::iterator_traits<InputIt>::value_type>;
+
+    for (; first != last; ++first) {
+        out = traits::encode(*first, out);
+    }
+    return out;
+}
+
+/**
+ * Reads values in the tagged binary encoding until the end of the data.
+ *
+ * @code{.cpp}
+ *   std::vector<ip_network> networks;
+ *   error_code code = error_code::no_error;
+ *   decode_binary_sequence<ip_network>(data.data(), data.data() + data.size(), std::back_inserter(networks), code);
+ * @endcode
+ * @tparam T the type of values.
+ * @tparam OutputIt the type of the output iterator.
+ * @param[in] first the beginning of the data.
+ * @param[in] last the end of the data.
+ * @param[out] out the beginning of the destination range.
+ * @param[out] code an error_code object that will be set if the data is truncated, malformed or holds a value of another type;
+ *                  the values decoded before the error are written to \a out.
+ * @return An output iterator past the last decoded value.
+ */
+IPADDRESS_EXPORT template <typename T, typename OutputIt>
+IPADDRESS_FORCE_INLINE OutputIt decode_binary_sequence(const uint8_t* first, const uint8_t* last, OutputIt out, error_code& code) IPADDRESS_NOEXCEPT {
+    code = error_code::no_error;
+    internal::binary_value binary;
+    while (first != last) {
+        T value;
+        if (!internal::read_tagged(first, last, binary) || !internal::binary_traits<T>::decode(binary, value)) {
+            code = error_code::invalid_encoding;
+            return out;
+        }
+        *out++ = value;
+    }
+    return out;
+}
+
+/**
+ * Reads values in the tagged binary encoding until the end of the data.
+ *
+ * @tparam T the type of values.
+ * @tparam OutputIt the type of the output iterator.
+ * @param[in] first the beginning of the data.
+ * @param[in] last the end of the data.
+ * @param[out] out the beginning of the destination range.
+ * @return An output iterator past the last decoded value.
+ * @throw logic_error Raise if the data is truncated, malformed or holds a value of another type.
+ */
+IPADDRESS_EXPORT template <typename T, typename OutputIt>
+IPADDRESS_FORCE_INLINE OutputIt decode_binary_sequence(const uint8_t* first, const uint8_t* last, OutputIt out) IPADDRESS_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+    error_code code = error_code::no_error;
+    out = decode_binary_sequence<T>(first, last, out, code);
+    if (code != error_code::no_error) {
+        raise_error(code, 0, "", 0);
+    }
+    return out;
+}
+
+/**
+ * Writes the sorted binary encoding of a range of values.
+ *
+ * The values must be sorted in ascending order (for networks, by network address). Each value
+ * is stored as the difference from the previous value in a variable-length integer, followed
+ * by the prefix length for networks. For ip_address and ip_network, all IPv4 values come first
+ * and are stored as a separate block from IPv6 values. Duplicates are kept.
+ *
+ * @code{.cpp}
+ *   std::vector<ipv4_address> addresses = ...; // sorted
+ *   std::vector<uint8_t> data(max_sorted_binary_size<ipv4_address>(addresses.size()));
+ *   error_code code = error_code::no_error;
+ *   data.resize(encode_sorted_binary(addresses.begin(), addresses.end(), data.data(), code) - data.data());
+ * @endcode
+ * @tparam ForwardIt the type of the forward iterator.
+ * @param[in] first the beginning of the range of values.
+ * @param[in] last the end of the range of values.
+ * @param[out] out the buffer, which must have room for at least max_sorted_binary_size<T>() bytes.
+ * @param[out] code an error_code object that will be set if the values are not sorted.
+ * @return A pointer past the last written byte.
+ */
+IPADDRESS_EXPORT template <typename ForwardIt>
+IPADDRESS_FORCE_INLINE uint8_t* encode_sorted_binary(ForwardIt first, ForwardIt last, uint8_t* out, error_code& code) IPADDRESS_NOEXCEPT {
+    using value_type = typename std::iterator_traits<ForwardIt>::value_type;
+    using traits = internal::binary_traits<value_type>;
+
+    code = error_code::no_error;
+    auto middle = first;
+    if (traits::has_v4) {
+        middle = std::find_if(first, last, [](const value_type& value) { return !traits::is_v4(value); });
+        out = internal::encode_sorted_block<value_type, uint32_t>(first, middle, out, true, [](const value_type& value) { return traits::key4(value); }, code);
+    }
+    if (traits::has_v6 && code == error_code::no_error) {
+        out = internal::encode_sorted_block<value_type, uint128_t>(middle, last, out, false, [](const value_type& value) { return traits::key6(value); }, code);
+    }
+    return out;
+}
+
+/**
+ * Writes the sorted binary encoding of a range of values.
+ *
+ * @tparam ForwardIt the type of the forward iterator.
+ * @param[in] first the beginning of the range of values.
+ * @param[in] last the end of the range of values.
+ * @param[out] out the buffer, which must have room for at least max_sorted_binary_size<T>() bytes.
+ * @return A pointer past the last written byte.
+ * @throw logic_error Raise if the values are not sorted.
+ */
+IPADDRESS_EXPORT template <typename ForwardIt>
+IPADDRESS_FORCE_INLINE uint8_t* encode_sorted_binary(ForwardIt first, ForwardIt last, uint8_t* out) IPADDRESS_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+    error_code code = error_code::no_error;
+    out = encode_sorted_binary(first, last, out, code);
+    if (code != error_code::no_error) {
+        raise_error(code, 0, "", 0);
+    }
+    return out;
+}
+
+/**
+ * Reads a sequence in the sorted binary encoding.
+ *
+ * @tparam T the type of values, the same as used for encoding.
+ * @tparam OutputIt the type of the output iterator.
+ * @param[in] first the beginning of the data.
+ * @param[in] last the end of the data.
+ * @param[out] out the beginning of the destination range.
+ * @param[out] code an error_code object that will be set if the data is truncated or malformed;
+ *                  the values decoded before the error are written to \a out.
+ * @return An output iterator past the last decoded value.
+ */
+IPADDRESS_EXPORT template <typename T, typename OutputIt>
+IPADDRESS_FORCE_INLINE OutputIt decode_sorted_binary(const uint8_t* first, const uint8_t* last, OutputIt out, error_code& code) IPADDRESS_NOEXCEPT {
+    using traits = internal::binary_traits<T>;
+
+    code = error_code::no_error;
+    if (traits::has_v4) {
+        out = internal::decode_sorted_block<T, uint32_t>(first, last, out, uint32_t(0xFFFFFFFF), [](uint32_t key, size_t prefixlen, T& value) { return traits::make4(key, prefixlen, value); }, code);
+    }
+    if (traits::has_v6 && code == error_code::no_error) {
+        out = internal::decode_sorted_block<T, uint128_t>(first, last, out, ~uint128_t(0), [](const uint128_t& key, size_t prefixlen, T& value) { return traits::make6(key, prefixlen, value); }, code);
+    }
+    if (code == error_code::no_error && first != last) {
+        code = error_code::invalid_encoding;
+    }
+    return out;
+}
+
+/**
+ * Reads a sequence in the sorted binary encoding.
+ *
+ * @tparam T the type of values, the same as used for encoding.
+ * @tparam OutputIt the type of the output iterator.
+ * @param[in] first the beginning of the data.
+ * @param[in] last the end of the data.
+ * @param[out] out the beginning of the destination range.
+ * @return An output iterator past the last decoded value.
+ * @throw logic_error Raise if the data is truncated or malformed.
+ */
+IPADDRESS_EXPORT template <typename T, typename OutputIt>
+IPADDRESS_FORCE_INLINE OutputIt decode_sorted_binary(const uint8_t* first, const uint8_t* last, OutputIt out) IPADDRESS_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+    error_code code = error_code::no_error;
+    out = decode_sorted_binary<T>(first, last, out, code);
+    if (code != error_code::no_error) {
+        raise_error(code, 0, "", 0);
+    }
+    return out;
+}
+
+} // namespace IPADDRESS_NAMESPACE
+
+#endif // IPADDRESS_IP_BINARY_HPP
@@ -0,0 +1,783 @@
+/**
+ * @file      ip-compact-address.hpp
+ * @brief     Compact address types without scope storage
+ * @author    Vladimir Shaleev
+ * @copyright MIT License
+ *
+ * This header defines the ipv6_address_compact and ip_address_compact classes. Unlike
+ * ipv6_address, which keeps a fixed-size scope id next to the address bytes, these types
+ * store only the bytes of an address (and, for ip_address_compact, a one-byte version tag),
+ * so that they occupy exactly 16 and 17 bytes respectively. They are intended for large
+ * in-memory tables and caches where the scope id is not needed, and convert to and from
+ * the regular address types. Comparison, hashing and classification produce the same
+ * results as for the corresponding full address without a scope id.
+ */
+
+#ifndef IPADDRESS_IP_COMPACT_ADDRESS_HPP
+#define IPADDRESS_IP_COMPACT_ADDRESS_HPP
+
+#include "ip-networks.hpp"
+#include "ip-any-address.hpp"
+
+namespace IPADDRESS_NAMESPACE {
+
+/**
+ * A compact representation of an IPv6 address.
+ *
+ * The class holds only the 16 bytes of an IPv6 address in **network byte order**. The scope id
+ * of an ipv6_address is dropped when it is converted to this type, so the object is exactly 16
+ * bytes in size regardless of the `IPADDRESS_IPV6_SCOPE_MAX_LENGTH` setting.
+ */
+IPADDRESS_EXPORT class ipv6_address_compact {
+public:
+    using base_type = typename ipv6_address::base_type; /**< Base type for IPv6 address storage. */
+    using uint_type = typename ipv6_address::uint_type; /**< Unsigned integer type for IPv6 address representation. */
+
+    /**
+     * Default constructor.
+     *
+     * Constructs an unspecified IPv6 address (`::`).
+     */
+    IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE ipv6_address_compact() IPADDRESS_NOEXCEPT { // NOLINT(modernize-use-equals-default): for C++11 support
+    }
+
+    /**
+     * Constructs a compact address from an array of bytes.
+     *
+     * @param[in] bytes The bytes of the address in **network byte order**.
+     */
+    IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE explicit ipv6_address_compact(const base_type& bytes) IPADDRESS_NOEXCEPT : _bytes(bytes) {
+    }
+
+    /**
+     * Constructs a compact address from an IPv6 address.
+     *
+     * @param[in] ipv6 The IPv6 address to store.
+     * @remark The scope id of \a ipv6 is not preserved.
+     */
+    IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE explicit ipv6_address_compact(const ipv6_address& ipv6) IPADDRESS_NOEXCEPT : _bytes(ipv6.bytes()) {
+    }
+
+    /**
+     * Creates a compact address from an unsigned integer.
+     *
+     * @param[in] ip The unsigned integer representing the IPv6 address.
+     * @return A compact IPv6 address.
+     */
+    IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE ipv6_address_compact from_uint(const uint_type& ip) IPADDRESS_NOEXCEPT {
+        return ipv6_address_compact(ipv6_address::from_uint(ip));
+    }
+
+    /**
+     * Converts the compact address back to an IPv6 address.
+     *
+     * @return An ipv6_address with the same bytes and no scope id.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE ipv6_address to_address() const IPADDRESS_NOEXCEPT {
+        return ipv6_address(_bytes);
+    }
+
+    /**
+     * Converts the address to an unsigned integer.
+     *
+     * @return The unsigned integer representation of the IPv6 address.
+     * @remark Bytes in integer are presented in **host byte order**.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE uint_type to_uint() const IPADDRESS_NOEXCEPT {
+        return to_address().to_uint();
+    }
+
+    /**
+     * Provides access to the underlying bytes of the address.
+     *
+     * @return A reference to the bytes in **network byte order** (big-endian).
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE const base_type& bytes() const IPADDRESS_NOEXCEPT {
+        return _bytes;
+    }
+
+    /**
+     * Retrieves the raw data of the address in **network byte order** (big-endian).
+     *
+     * @return A pointer to the raw data of the address.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE const uint8_t* data() const IPADDRESS_NOEXCEPT {
+        return _bytes.data();
+    }
+
+    /**
+     * Retrieves the version of the address.
+     *
+     * @return Always `ip_version::V6`.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE ip_version version() const IPADDRESS_NOEXCEPT {
+        return ip_version::V6;
+    }
+
+    /**
+     * Retrieves the size of the address in bytes.
+     *
+     * @return Always 16.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE size_t size() const IPADDRESS_NOEXCEPT {
+        return _bytes.size();
+    }
+
+    /**
+     * Computes a hash value for the address.
+     *
+     * @return A `size_t` hash value equal to the hash of the same ipv6_address without a scope id.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE size_t hash() const IPADDRESS_NOEXCEPT {
+        return to_address().hash();
+    }
+
+    /**
+     * Classifies the address against all special-purpose ranges at once.
+     *
+     * @return The set of flags that apply to the address.
+     * @see ip_address_base::classify.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE address_flags classify() const IPADDRESS_NOEXCEPT {
+        return to_address().classify();
+    }
+
+    /**
+     * Checks if the address is a multicast address.
+     *
+     * @return `true` if the address is reserved for multicast use, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool is_multicast() const IPADDRESS_NOEXCEPT {
+        return to_address().is_multicast();
+    }
+
+    /**
+     * Checks if the address is allocated for private networks.
+     *
+     * @return `true` if the address is private, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool is_private() const IPADDRESS_NOEXCEPT {
+        return to_address().is_private();
+    }
+
+    /**
+     * Checks if the address is allocated for public networks.
+     *
+     * @return `true` if the address is global, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool is_global() const IPADDRESS_NOEXCEPT {
+        return to_address().is_global();
+    }
+
+    /**
+     * Checks if the address is otherwise IETF reserved.
+     *
+     * @return `true` if the address is reserved, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool is_reserved() const IPADDRESS_NOEXCEPT {
+        return to_address().is_reserved();
+    }
+
+    /**
+     * Checks if the address is a loopback address.
+     *
+     * @return `true` if the address is a loopback address, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool is_loopback() const IPADDRESS_NOEXCEPT {
+        return to_address().is_loopback();
+    }
+
+    /**
+     * Checks if the address is reserved for link-local usage.
+     *
+     * @return `true` if the address is link-local, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool is_link_local() const IPADDRESS_NOEXCEPT {
+        return to_address().is_link_local();
+    }
+
+    /**
+     * Checks if the address is unspecified.
+     *
+     * @return `true` if the address is unspecified, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool is_unspecified() const IPADDRESS_NOEXCEPT {
+        return to_address().is_unspecified();
+    }
+
+    /**
+     * Checks if the address is a site-local address.
+     *
+     * @return `true` if the address is site-local, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool is_site_local() const IPADDRESS_NOEXCEPT {
+        return to_address().is_site_local();
+    }
+
+    /**
+     * Determines if the address is an IPv4-mapped address.
+     *
+     * @return An `optional` containing the mapped IPv4 address, or an empty `optional` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE optional<ipv4_address> ipv4_mapped() const IPADDRESS_NOEXCEPT {
+        return to_address().ipv4_mapped();
+    }
+
+    /**
+     * Writes the address to a character buffer.
+     *
+     * @param[in] first The beginning of the output buffer.
+     * @param[in] last The end of the output buffer.
+     * @param[in] fmt The format to use for the string representation.
+     * @return A pointer one past the last written character, or `nullptr` if the buffer is too small.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE char* to_chars(char* first, char* last, format fmt = format::compressed) const IPADDRESS_NOEXCEPT {
+        return to_address().to_chars(first, last, fmt);
+    }
+
+    /**
+     * Converts the address to a string.
+     *
+     * @param[in] fmt The format to use for the string representation.
+     * @return A string representation of the address.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE std::string to_string(format fmt = format::compressed) const {
+        return to_address().to_string(fmt);
+    }
+
+    /**
+     * Converts the address to a wide string.
+     *
+     * @param[in] fmt The format to use for the string representation.
+     * @return A wide string representation of the address.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE std::wstring to_wstring(format fmt = format::compressed) const {
+        return to_address().to_wstring(fmt);
+    }
+
+    /**
+     * Swaps the contents of this address with another.
+     *
+     * @param[in,out] ip The other address to swap with.
+     */
+    IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE void swap(ipv6_address_compact& ip) IPADDRESS_NOEXCEPT {
+        _bytes.swap(ip._bytes);
+    }
+
+    /**
+     * Converts the compact address to an IPv6 address.
+     *
+     * @return An ipv6_address with the same bytes and no scope id.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE explicit operator ipv6_address() const IPADDRESS_NOEXCEPT {
+        return to_address();
+    }
+
+    /**
+     * Checks if two addresses are equal.
+     *
+     * @param[in] rhs The right-hand side address for comparison.
+     * @return `true` if both addresses are equal, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool operator==(const ipv6_address_compact& rhs) const IPADDRESS_NOEXCEPT {
+        return _bytes == rhs._bytes;
+    }
+
+    /**
+     * Checks if two addresses are not equal.
+     *
+     * @param[in] rhs The right-hand side address for comparison.
+     * @return `true` if both addresses are not equal, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool operator!=(const ipv6_address_compact& rhs) const IPADDRESS_NOEXCEPT {
+        return !(*this == rhs);
+    }
+
+#ifdef IPADDRESS_HAS_SPACESHIP_OPERATOR
+
+    /**
+     * Compares two addresses using the three-way comparison operator (spaceship operator).
+     *
+     * @param[in] rhs The right-hand side address for comparison.
+     * @return A value of type `std::strong_ordering` that represents the result of the comparison.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE std::strong_ordering operator<=>(const ipv6_address_compact& rhs) const IPADDRESS_NOEXCEPT {
+        return _bytes <=> rhs._bytes;
+    }
+
+#else // !IPADDRESS_HAS_SPACESHIP_OPERATOR
+
+    /**
+     * Checks if one address is less than another.
+     *
+     * @param[in] rhs The right-hand side address for comparison.
+     * @return `true` if the left-hand side address is less than the right-hand side, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool operator<(const ipv6_address_compact& rhs) const IPADDRESS_NOEXCEPT {
+        return _bytes < rhs._bytes;
+    }
+
+    /**
+     * Checks if one address is greater than another.
+     *
+     * @param[in] rhs The right-hand side address for comparison.
+     * @return `true` if the left-hand side address is greater than the right-hand side, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool operator>(const ipv6_address_compact& rhs) const IPADDRESS_NOEXCEPT {
+        return rhs < *this;
+    }
+
+    /**
+     * Checks if one address is less than or equal to another.
+     *
+     * @param[in] rhs The right-hand side address for comparison.
+     * @return `true` if the left-hand side address is less than or equal to the right-hand side, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool operator<=(const ipv6_address_compact& rhs) const IPADDRESS_NOEXCEPT {
+        return !(rhs < *this);
+    }
+
+    /**
+     * Checks if one address is greater than or equal to another.
+     *
+     * @param[in] rhs The right-hand side address for comparison.
+     * @return `true` if the left-hand side address is greater than or equal to the right-hand side, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool operator>=(const ipv6_address_compact& rhs) const IPADDRESS_NOEXCEPT {
+        return !(*this < rhs);
+    }
+
+#endif // !IPADDRESS_HAS_SPACESHIP_OPERATOR
+
+private:
+    base_type _bytes {};
+}; // ipv6_address_compact
+
+/**
+ * A compact representation of an IP address of either version.
+ *
+ * The class holds the 16 bytes of an address in **network byte order** followed by a one-byte
+ * version tag, so that it is exactly 17 bytes in size. An IPv4 address occupies the first four
+ * bytes and the remaining bytes are zero. As with ipv6_address_compact, the scope id of an IPv6
+ * address is not stored. Ordering matches ip_address: IPv4 addresses sort before IPv6 addresses.
+ */
+IPADDRESS_EXPORT class ip_address_compact {
+public:
+    using base_type_ipv4 = typename ipv4_address::base_type; /**< Base type for IPv4 address storage. */
+    using base_type_ipv6 = typename ipv6_address::base_type; /**< Base type for IPv6 address storage. */
+
+    /**
+     * Default constructor.
+     *
+     * Constructs an unspecified address with version IPv4.
+     */
+    IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE ip_address_compact() IPADDRESS_NOEXCEPT { // NOLINT(modernize-use-equals-default): for C++11 support
+    }
+
+    /**
+     * Constructs a compact address from an IPv4 address.
+     *
+     * @param[in] ipv4 The IPv4 address to store.
+     */
+    IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE explicit ip_address_compact(const ipv4_address& ipv4) IPADDRESS_NOEXCEPT
+        : _bytes(base_type_ipv6 { ipv4.bytes()[0], ipv4.bytes()[1], ipv4.bytes()[2], ipv4.bytes()[3] }) {
+    }
+
+    /**
+     * Constructs a compact address from an IPv6 address.
+     *
+     * @param[in] ipv6 The IPv6 address to store.
+     * @remark The scope id of \a ipv6 is not preserved.
+     */
+    IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE explicit ip_address_compact(const ipv6_address& ipv6) IPADDRESS_NOEXCEPT : _bytes(ipv6.bytes()), _version(uint8_t(ip_version::V6)) {
+    }
+
+    /**
+     * Constructs a compact address from a compact IPv6 address.
+     *
+     * @param[in] ipv6 The compact IPv6 address to store.
+     */
+    IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE explicit ip_address_compact(const ipv6_address_compact& ipv6) IPADDRESS_NOEXCEPT : _bytes(ipv6.bytes()), _version(uint8_t(ip_version::V6)) {
+    }
+
+    /**
+     * Constructs a compact address from an IP address.
+     *
+     * @param[in] ip The IP address to store.
+     * @remark The scope id of an IPv6 address is not preserved.
+     */
+    IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE explicit ip_address_compact(const ip_address& ip) IPADDRESS_NOEXCEPT
+        : ip_address_compact(ip.is_v4() ? ip_address_compact(*ip.v4()) : ip_address_compact(*ip.v6())) {
+    }
+
+    /**
+     * Converts the compact address back to an IP address.
+     *
+     * @return An ip_address of the same version and bytes, without a scope id.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE ip_address to_address() const IPADDRESS_NOEXCEPT {
+        return is_v4() ? ip_address(ipv4()) : ip_address(ipv6());
+    }
+
+    /**
+     * Retrieves the version of the address.
+     *
+     * @return The IP version of the address.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE ip_version version() const IPADDRESS_NOEXCEPT {
+        return ip_version(_version);
+    }
+
+    /**
+     * Checks if the address is an IPv4 address.
+     *
+     * @return `true` if the address is an IPv4 address, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool is_v4() const IPADDRESS_NOEXCEPT {
+        return _version == uint8_t(ip_version::V4);
+    }
+
+    /**
+     * Checks if the address is an IPv6 address.
+     *
+     * @return `true` if the address is an IPv6 address, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool is_v6() const IPADDRESS_NOEXCEPT {
+        return _version == uint8_t(ip_version::V6);
+    }
+
+    /**
+     * Retrieves the size of the address in bytes.
+     *
+     * @return 4 for an IPv4 address and 16 for an IPv6 address.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE size_t size() const IPADDRESS_NOEXCEPT {
+        return is_v4() ? 4 : 16;
+    }
+
+    /**
+     * Retrieves the raw data of the address in **network byte order** (big-endian).
+     *
+     * @return A pointer to the raw data of the address; only size() bytes are meaningful.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE const uint8_t* data() const IPADDRESS_NOEXCEPT {
+        return _bytes.data();
+    }
+
+    /**
+     * Retrieves the IPv4 address.
+     *
+     * @return An optional containing the IPv4 address, or an empty optional if the address is not IPv4.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE optional<ipv4_address> v4() const IPADDRESS_NOEXCEPT {
+        return is_v4() ? optional<ipv4_address>(ipv4()) : optional<ipv4_address>();
+    }
+
+    /**
+     * Retrieves the IPv6 address.
+     *
+     * @return An optional containing the IPv6 address, or an empty optional if the address is not IPv6.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE optional<ipv6_address> v6() const IPADDRESS_NOEXCEPT {
+        return is_v6() ? optional<ipv6_address>(ipv6()) : optional<ipv6_address>();
+    }
+
+    /**
+     * Computes a hash value for the address.
+     *
+     * @return A `size_t` hash value equal to the hash of the same ip_address without a scope id.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE size_t hash() const IPADDRESS_NOEXCEPT {
+        return is_v4() ? ipv4().hash() : ipv6().hash();
+    }
+
+    /**
+     * Classifies the address against all special-purpose ranges at once.
+     *
+     * @return The set of flags that apply to the address.
+     * @see ip_address_base::classify.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE address_flags classify() const IPADDRESS_NOEXCEPT {
+        return is_v4() ? ipv4().classify() : ipv6().classify();
+    }
+
+    /**
+     * Checks if the address is a multicast address.
+     *
+     * @return `true` if the address is reserved for multicast use, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool is_multicast() const IPADDRESS_NOEXCEPT {
+        return is_v4() ? ipv4().is_multicast() : ipv6().is_multicast();
+    }
+
+    /**
+     * Checks if the address is allocated for private networks.
+     *
+     * @return `true` if the address is private, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool is_private() const IPADDRESS_NOEXCEPT {
+        return is_v4() ? ipv4().is_private() : ipv6().is_private();
+    }
+
+    /**
+     * Checks if the address is allocated for public networks.
+     *
+     * @return `true` if the address is global, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool is_global() const IPADDRESS_NOEXCEPT {
+        return is_v4() ? ipv4().is_global() : ipv6().is_global();
+    }
+
+    /**
+     * Checks if the address is otherwise IETF reserved.
+     *
+     * @return `true` if the address is reserved, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool is_reserved() const IPADDRESS_NOEXCEPT {
+        return is_v4() ? ipv4().is_reserved() : ipv6().is_reserved();
+    }
+
+    /**
+     * Checks if the address is a loopback address.
+     *
+     * @return `true` if the address is a loopback address, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool is_loopback() const IPADDRESS_NOEXCEPT {
+        return is_v4() ? ipv4().is_loopback() : ipv6().is_loopback();
+    }
+
+    /**
+     * Checks if the address is reserved for link-local usage.
+     *
+     * @return `true` if the address is link-local, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool is_link_local() const IPADDRESS_NOEXCEPT {
+        return is_v4() ? ipv4().is_link_local() : ipv6().is_link_local();
+    }
+
+    /**
+     * Checks if the address is unspecified.
+     *
+     * @return `true` if the address is unspecified, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool is_unspecified() const IPADDRESS_NOEXCEPT {
+        return is_v4() ? ipv4().is_unspecified() : ipv6().is_unspecified();
+    }
+
+    /**
+     * Checks if the address is a site-local address.
+     *
+     * @return `true` if the address is an IPv6 site-local address, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool is_site_local() const IPADDRESS_NOEXCEPT {
+        return is_v4() ? false : ipv6().is_site_local();
+    }
+
+    /**
+     * Writes the address to a character buffer.
+     *
+     * @param[in] first The beginning of the output buffer.
+     * @param[in] last The end of the output buffer.
+     * @param[in] fmt The format to use for the string representation.
+     * @return A pointer one past the last written character, or `nullptr` if the buffer is too small.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE char* to_chars(char* first, char* last, format fmt = format::compressed) const IPADDRESS_NOEXCEPT {
+        return is_v4() ? ipv4().to_chars(first, last, fmt) : ipv6().to_chars(first, last, fmt);
+    }
+
+    /**
+     * Converts the address to a string.
+     *
+     * @param[in] fmt The format to use for the string representation.
+     * @return A string representation of the address.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE std::string to_string(format fmt = format::compressed) const {
+        return is_v4() ? ipv4().to_string(fmt) : ipv6().to_string(fmt);
+    }
+
+    /**
+     * Converts the address to a wide string.
+     *
+     * @param[in] fmt The format to use for the string representation.
+     * @return A wide string representation of the address.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE std::wstring to_wstring(format fmt = format::compressed) const {
+        return is_v4() ? ipv4().to_wstring(fmt) : ipv6().to_wstring(fmt);
+    }
+
+    /**
+     * Swaps the contents of this address with another.
+     *
+     * @param[in,out] ip The other address to swap with.
+     */
+    IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE void swap(ip_address_compact& ip) IPADDRESS_NOEXCEPT {
+        const auto tmp = _version;
+        _bytes.swap(ip._bytes);
+        _version = ip._version;
+        ip._version = tmp;
+    }
+
+    /**
+     * Converts the compact address to an IP address.
+     *
+     * @return An ip_address of the same version and bytes, without a scope id.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE explicit operator ip_address() const IPADDRESS_NOEXCEPT {
+        return to_address();
+    }
+
+    /**
+     * Checks if two addresses are equal.
+     *
+     * @param[in] rhs The right-hand side address for comparison.
+     * @return `true` if both addresses are equal, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool operator==(const ip_address_compact& rhs) const IPADDRESS_NOEXCEPT {
+        return _version == rhs._version && _bytes == rhs._bytes;
+    }
+
+    /**
+     * Checks if two addresses are not equal.
+     *
+     * @param[in] rhs The right-hand side address for comparison.
+     * @return `true` if both addresses are not equal, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool operator!=(const ip_address_compact& rhs) const IPADDRESS_NOEXCEPT {
+        return !(*this == rhs);
+    }
+
+#ifdef IPADDRESS_HAS_SPACESHIP_OPERATOR
+
+    /**
+     * Compares two addresses using the three-way comparison operator (spaceship operator).
+     *
+     * @param[in] rhs The right-hand side address for comparison.
+     * @return A value of type `std::strong_ordering` that represents the result of the comparison.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE std::strong_ordering operator<=>(const ip_address_compact& rhs) const IPADDRESS_NOEXCEPT {
+        if (const auto result = _version <=> rhs._version; result == std::strong_ordering::equivalent) {
+            return _bytes <=> rhs._bytes;
+        } else {
+            return result;
+        }
+    }
+
+#else // !IPADDRESS_HAS_SPACESHIP_OPERATOR
+
+    /**
+     * Checks if one address is less than another.
+     *
+     * @param[in] rhs The right-hand side address for comparison.
+     * @return `true` if the left-hand side address is less than the right-hand side, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool operator<(const ip_address_compact& rhs) const IPADDRESS_NOEXCEPT {
+        return _version != rhs._version ? _version < rhs._version : _bytes < rhs._bytes;
+    }
+
+    /**
+     * Checks if one address is greater than another.
+     *
+     * @param[in] rhs The right-hand side address for comparison.
+     * @return `true` if the left-hand side address is greater than the right-hand side, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool operator>(const ip_address_compact& rhs) const IPADDRESS_NOEXCEPT {
+        return rhs < *this;
+    }
+
+    /**
+     * Checks if one address is less than or equal to another.
+     *
+     * @param[in] rhs The right-hand side address for comparison.
+     * @return `true` if the left-hand side address is less than or equal to the right-hand side, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool operator<=(const ip_address_compact& rhs) const IPADDRESS_NOEXCEPT {
+        return !(rhs < *this);
+    }
+
+    /**
+     * Checks if one address is greater than or equal to another.
+     *
+     * @param[in] rhs The right-hand side address for comparison.
+     * @return `true` if the left-hand side address is greater than or equal to the right-hand side, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool operator>=(const ip_address_compact& rhs) const IPADDRESS_NOEXCEPT {
+        return !(*this < rhs);
+    }
+
+#endif // !IPADDRESS_HAS_SPACESHIP_OPERATOR
+
+private:
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE ipv4_address ipv4() const IPADDRESS_NOEXCEPT {
+        return ipv4_address(base_type_ipv4 { _bytes[0], _bytes[1], _bytes[2], _bytes[3] });
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE ipv6_address ipv6() const IPADDRESS_NOEXCEPT {
+        return ipv6_address(_bytes);
+    }
+
+    base_type_ipv6 _bytes {};
+    uint8_t _version = uint8_t(ip_version::V4);
+}; // ip_address_compact
+
+static_assert(sizeof(ipv6_address_compact) == 16, "ipv6_address_compact must hold only the address bytes");
+static_assert(sizeof(ip_address_compact) == 17, "ip_address_compact must hold only the address bytes and version");
+
+} // namespace IPADDRESS_NAMESPACE
+
+#ifndef IPADDRESS_NO_OVERLOAD_STD
+
+namespace std {
+
+template <>
+struct hash<IPADDRESS_NAMESPACE::ipv6_address_compact> {
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE size_t operator()(const IPADDRESS_NAMESPACE::ipv6_address_compact& ip) const IPADDRESS_NOEXCEPT {
+        return ip.hash();
+    }
+};
+
+template <>
+struct hash<IPADDRESS_NAMESPACE::ip_address_compact> {
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE size_t operator()(const IPADDRESS_NAMESPACE::ip_address_compact& ip) const IPADDRESS_NOEXCEPT {
+        return ip.hash();
+    }
+};
+
+IPADDRESS_EXPORT IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE void swap(IPADDRESS_NAMESPACE::ipv6_address_compact& ip1, IPADDRESS_NAMESPACE::ipv6_address_compact& ip2) IPADDRESS_NOEXCEPT {
+    ip1.swap(ip2);
+}
+
+IPADDRESS_EXPORT IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE void swap(IPADDRESS_NAMESPACE::ip_address_compact& ip1, IPADDRESS_NAMESPACE::ip_address_compact& ip2) IPADDRESS_NOEXCEPT {
+    ip1.swap(ip2);
+}
+
+IPADDRESS_EXPORT IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE std::string to_string(const IPADDRESS_NAMESPACE::ipv6_address_compact& ip) {
+    return ip.to_string();
+}
+
+IPADDRESS_EXPORT IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE std::string to_string(const IPADDRESS_NAMESPACE::ip_address_compact& ip) {
+    return ip.to_string();
+}
+
+IPADDRESS_EXPORT IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE std::wstring to_wstring(const IPADDRESS_NAMESPACE::ipv6_address_compact& ip) {
+    return ip.to_wstring();
+}
+
+IPADDRESS_EXPORT IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE std::wstring to_wstring(const IPADDRESS_NAMESPACE::ip_address_compact& ip) {
+    return ip.to_wstring();
+}
+
+IPADDRESS_EXPORT template <typename T>
+IPADDRESS_FORCE_INLINE std::basic_ostream<T, std::char_traits<T>>& operator<<(std::basic_ostream<T, std::char_traits<T>>& stream, const IPADDRESS_NAMESPACE::ipv6_address_compact& ip) {
+    return stream << ip.to_address();
+}
+
+IPADDRESS_EXPORT template <typename T>
+IPADDRESS_FORCE_INLINE std::basic_ostream<T, std::char_traits<T>>& operator<<(std::basic_ostream<T, std::char_traits<T>>& stream, const IPADDRESS_NAMESPACE::ip_address_compact& ip) {
+    return stream << ip.to_address();
+}
+
+} // namespace std
+
+#endif // IPADDRESS_NO_OVERLOAD_STD
+
+#endif // IPADDRESS_IP_COMPACT_ADDRESS_HPP
@@ -0,0 +1,476 @@
+/**
+ * @file      ip-concurrent-prefix-table.hpp
+ * @brief     Longest-prefix-match table with wait-free readers
+ * @author    Vladimir Shaleev
+ * @copyright MIT License
+ *
+ * This file defines the ip_concurrent_prefix_table class template, a longest-prefix-match table
+ * for workloads where many threads perform lookups while another thread applies route updates.
+ * The table publishes immutable, fully built ip_prefix_table snapshots through an atomic pointer.
+ * Readers pin the current snapshot with a couple of atomic operations and never wait for writers;
+ * writers prepare a new snapshot in a transaction and publish it in a single step. A replaced
+ * snapshot is freed once no reader can still be using it, which is tracked with epochs announced
+ * by the readers.
+ */
+
+#ifndef IPADDRESS_IP_CONCURRENT_PREFIX_TABLE_HPP
+#define IPADDRESS_IP_CONCURRENT_PREFIX_TABLE_HPP
+
+#include "ip-prefix-table.hpp"
+
+#ifndef IPADDRESS_MODULE
+#  include <new>
+#  include <mutex>
+#  include <atomic>
+#  include <memory>
+#endif
+
+namespace IPADDRESS_NAMESPACE {
+
+namespace internal {
+
+// The epoch in which a reader loaded the snapshot it is using, or zero while the reader is idle.
+// Every slot occupies a cache line of its own, so that readers on different cores do not share one
+struct alignas(64) epoch_slot {
+    std::atomic<uint64_t> epoch{0};
+    std::atomic<bool> used{false};
+    epoch_slot* next{};
+#ifndef __cpp_aligned_new
+    void* storage{};
+#endif
+};
+
+static_assert(sizeof(epoch_slot) == 64, "epoch_slot must fill exactly one cache line");
+
+// Before C++17 a new-expression does not honor alignments above that of max_align_t,
+// so the slot is placed at the first cache line boundary of a larger allocation
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE epoch_slot* new_epoch_slot() {
+#ifdef __cpp_aligned_new
+    return new epoch_slot();
+#else
+    auto* storage = ::operator new(sizeof(epoch_slot) + alignof(epoch_slot) - 1);
+    const auto address = (reinterpret_cast<uintptr_t>(storage) + alignof(epoch_slot) - 1) & ~uintptr_t(alignof(epoch_slot) - 1);
+    auto* slot = new (reinterpret_cast<void*>(address)) epoch_slot();
+    slot->storage = storage;
+    return slot;
+#endif
+}
+
+IPADDRESS_FORCE_INLINE void delete_epoch_slot(epoch_slot* slot) IPADDRESS_NOEXCEPT {
+#ifdef __cpp_aligned_new
+    delete slot;
+#else
+    auto* storage = slot->storage;
+    slot->~epoch_slot();
+    ::operator delete(storage);
+#endif
+}
+
+// Epoch-based reclamation. A reader announces the current epoch before loading a shared pointer
+// and clears it when done. A writer that replaces the pointer advances the epoch; the replaced
+// object is no longer reachable by any reader once every announced epoch is at least the advanced
+// one. All the operations on the epochs and on the shared pointer are sequentially consistent,
+// which is what makes a reader that announced an older epoch visible to the writer's scan.
+class epoch_domain {
+public:
+    static constexpr uint64_t none = ~uint64_t(0);
+
+    epoch_domain() = default;
+
+    epoch_domain(const epoch_domain&) = delete;
+
+    epoch_domain& operator=(const epoch_domain&) = delete;
+
+    IPADDRESS_FORCE_INLINE ~epoch_domain() {
+        auto* slot = _slots.load();
+        while (slot) {
+            auto* next = slot->next;
+            delete_epoch_slot(slot);
+            slot = next;
+        }
+    }
+
+    // Slots are never freed while the domain is alive, so a released slot is reused by the next reader
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE epoch_slot* acquire() {
+        for (auto* slot = _slots.load(); slot; slot = slot->next) {
+            auto used = false;
+            if (!slot->used.load(std::memory_order_relaxed) && slot->used.compare_exchange_strong(used, true)) {
+                return slot;
+            }
+        }
+        auto* slot = new_epoch_slot();
+        slot->used.store(true, std::memory_order_relaxed);
+        slot->next = _slots.load();
+        while (!_slots.compare_exchange_weak(slot->next, slot)) {
+        }
+        return slot;
+    }
+
+    IPADDRESS_FORCE_INLINE void release(epoch_slot* slot) IPADDRESS_NOEXCEPT {
+        slot->epoch.store(0, std::memory_order_release);
+        slot->used.store(false, std::memory_order_release);
+    }
+
+    IPADDRESS_FORCE_INLINE void enter(epoch_slot* slot) IPADDRESS_NOEXCEPT {
+        slot->epoch.store(_epoch.load());
+    }
+
+    IPADDRESS_FORCE_INLINE void leave(epoch_slot* slot) IPADDRESS_NOEXCEPT {
+        slot->epoch.store(0, std::memory_order_release);
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE uint64_t advance() IPADDRESS_NOEXCEPT {
+        return _epoch.fetch_add(1) + 1;
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE uint64_t oldest() const IPADDRESS_NOEXCEPT {
+        auto result = none;
+        for (auto* slot = _slots.load(); slot; slot = slot->next) {
+            const auto epoch = slot->epoch.load();
+            if (epoch != 0 && epoch < result) {
+                result = epoch;
+            }
+        }
+        return result;
+    }
+
+private:
+    std::atomic<uint64_t> _epoch{1};
+    std::atomic<epoch_slot*> _slots{nullptr};
+};
+
+} // namespace IPADDRESS_NAMESPACE::internal
+
+/**
+ * A longest-prefix-match table that can be queried by many threads while it is being updated.
+ *
+ * The table holds an immutable, fully built ip_prefix_table snapshot. Lookups go through a
+ * reader, one per thread, which pins the current snapshot without locks or waiting: a lookup
+ * thread is never delayed by updates or by other lookup threads. Updates are made in a
+ * transaction, which copies the current snapshot, applies a batch of insertions and removals,
+ * builds the lookup structure and publishes the result atomically. Transactions are serialized
+ * with each other, and readers see either all of the changes of a transaction or none.
+ *
+ * Every transaction copies and rebuilds the table, so updates should be grouped: a transaction
+ * per batch of route changes rather than per change. A replaced snapshot is freed by a later
+ * transaction, or by reclaim(), once every reader that could have pinned it has released it.
+ *
+ * @code{.cpp}
+ *   ip_concurrent_prefix_table<ipv4_network, int> table;
+ *
+ *   // control thread
+ *   auto transaction = table.update();
+ *   transaction.insert(ipv4_network::parse("10.0.0.0/8"), 1);
+ *   transaction.erase(ipv4_network::parse("192.168.0.0/16"));
+ *   transaction.commit();
+ *
+ *   // each worker thread
+ *   auto reader = table.make_reader();
+ *   for (const auto& batch : packets) {
+ *       const auto snapshot = reader.pin();
+ *       for (const auto& packet : batch) {
+ *           const auto* match = snapshot->longest_match(packet.destination);
+ *           // ...
+ *       }
+ *   }
+ * @endcode
+ * @tparam Net the network type: ipv4_network, ipv6_network or ip_network.
+ * @tparam Value the type of values associated with networks.
+ * @remark Readers and transactions must not outlive the table.
+ * @sa ip_prefix_table
+ */
+IPADDRESS_EXPORT template <typename Net, typename Value>
+class ip_concurrent_prefix_table {
+public:
+    using table_type   = ip_prefix_table<Net, Value>; /**< The type of the table snapshots. */
+    using network_type = Net; /**< The network type used as key. */
+    using address_type = typename Net::ip_address_type; /**< The address type used for lookups. */
+    using mapped_type  = Value; /**< The type of values associated with networks. */
+    using value_type   = std::pair<network_type, mapped_type>; /**< The type of stored entries. */
+    using size_type    = size_t; /**< An unsigned integer type. */
+
+    /**
+     * A pinned table snapshot.
+     *
+     * The snapshot stays valid, and does not change, until the object is destroyed. Pointers to
+     * entries returned by its lookups are valid for the same time.
+     */
+    class snapshot {
+    public:
+        /**
+         * Move constructor.
+         *
+         * @param[in,out] other the snapshot to move from.
+         */
+        IPADDRESS_FORCE_INLINE snapshot(snapshot&& other) IPADDRESS_NOEXCEPT : _domain(other._domain), _slot(other._slot), _table(other._table) {
+            other._slot = nullptr;
+        }
+
+        snapshot(const snapshot&) = delete;
+
+        snapshot& operator=(const snapshot&) = delete;
+
+        snapshot& operator=(snapshot&&) = delete;
+
+        /**
+         * Releases the snapshot.
+         */
+        IPADDRESS_FORCE_INLINE ~snapshot() {
+            if (_slot) {
+                _domain->leave(_slot);
+            }
+        }
+
+        /**
+         * Returns the pinned table.
+         *
+         * @return A reference to the table.
+         */
+        IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE const table_type& operator*() const IPADDRESS_NOEXCEPT {
+            return *_table;
+        }
+
+        /**
+         * Accesses the pinned table.
+         *
+         * @return A pointer to the table.
+         */
+        IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE const table_type* operator->() const IPADDRESS_NOEXCEPT {
+            return _table;
+        }
+
+    private:
+        friend class ip_concurrent_prefix_table;
+
+        IPADDRESS_FORCE_INLINE snapshot(internal::epoch_domain* domain, internal::epoch_slot* slot, const table_type* table) IPADDRESS_NOEXCEPT
+            : _domain(domain), _slot(slot), _table(table) {
+        }
+
+        internal::epoch_domain* _domain;
+        internal::epoch_slot* _slot;
+        const table_type* _table;
+    };
+
+    /**
+     * A handle through which one thread performs lookups.
+     *
+     * A reader is not thread-safe: each lookup thread needs its own reader, and a reader holds
+     * at most one snapshot at a time. Creating a reader may allocate, pinning never does.
+     */
+    class reader {
+    public:
+        /**
+         * Move constructor.
+         *
+         * @param[in,out] other the reader to move from.
+         */
+        IPADDRESS_FORCE_INLINE reader(reader&& other) IPADDRESS_NOEXCEPT : _owner(other._owner), _slot(other._slot) {
+            other._slot = nullptr;
+        }
+
+        reader(const reader&) = delete;
+
+        reader& operator=(const reader&) = delete;
+
+        reader& operator=(reader&&) = delete;
+
+        /**
+         * Unregisters the reader.
+         */
+        IPADDRESS_FORCE_INLINE ~reader() {
+            if (_slot) {
+                _owner->_domain.release(_slot);
+            }
+        }
+
+        /**
+         * Pins the current table snapshot.
+         *
+         * This is wait-free. The snapshot should be held for a batch of lookups rather than a
+         * single one, and released before the reader pins again.
+         *
+         * @return The pinned snapshot.
+         */
+        IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE snapshot pin() const IPADDRESS_NOEXCEPT {
+            auto& domain = _owner->_domain;
+            domain.enter(_slot);
+            return snapshot(&domain, _slot, _owner->_current.load());
+        }
+
+    private:
+        friend class ip_concurrent_prefix_table;
+
+        IPADDRESS_FORCE_INLINE explicit reader(ip_concurrent_prefix_table* owner) : _owner(owner), _slot(owner->_domain.acquire()) {
+        }
+
+        ip_concurrent_prefix_table* _owner;
+        internal::epoch_slot* _slot;
+    };
+
+    /**
+     * A batch of modifications applied to the table atomically.
+     *
+     * The transaction holds the update lock of the table from its creation until it is committed
+     * or destroyed, and works on a private copy of the table. A transaction destroyed without
+     * a commit leaves the table unchanged.
+     */
+    class transaction {
+    public:
+        /**
+         * Move constructor.
+         *
+         * @param[in,out] other the transaction to move from.
+         */
+        IPADDRESS_FORCE_INLINE transaction(transaction&& other) IPADDRESS_NOEXCEPT
+            : _owner(other._owner), _lock(std::move(other._lock)), _table(std::move(other._table)) {
+        }
+
+        transaction(const transaction&) = delete;
+
+        transaction& operator=(const transaction&) = delete;
+
+        transaction& operator=(transaction&&) = delete;
+
+        /**
+         * Inserts a network with the associated value, or replaces the value if the network is already present.
+         *
+         * @param[in] network the network to insert.
+         * @param[in] value the value associated with the network.
+         * @return `true` if a new network was inserted, `false` if the value of an existing one was replaced.
+         */
+        IPADDRESS_FORCE_INLINE bool insert(const network_type& network, const mapped_type& value) {
+            return _table->insert(network, value);
+        }
+
+        /**
+         * Removes a network from the table.
+         *
+         * @param[in] network the network to remove.
+         * @return `true` if the network was found and removed, `false` otherwise.
+         */
+        IPADDRESS_FORCE_INLINE bool erase(const network_type& network) {
+            return _table->erase(network);
+        }
+
+        /**
+         * Removes all networks from the table.
+         */
+        IPADDRESS_FORCE_INLINE void clear() {
+            _table->clear();
+        }
+
+        /**
+         * Returns the table as modified so far by the transaction.
+         *
+         * @return A reference to the table.
+         */
+        IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE const table_type& table() const IPADDRESS_NOEXCEPT {
+            return *_table;
+        }
+
+        /**
+         * Builds the modified table and makes it visible to the readers.
+         *
+         * The snapshots pinned before the commit are not affected. The transaction cannot be
+         * modified after it has been committed, and committing it again does nothing.
+         */
+        IPADDRESS_FORCE_INLINE void commit() {
+            if (!_table) {
+                return;
+            }
+            _table->build();
+            _owner->publish(_table.release());
+            _lock.unlock();
+        }
+
+    private:
+        friend class ip_concurrent_prefix_table;
+
+        IPADDRESS_FORCE_INLINE explicit transaction(ip_concurrent_prefix_table* owner)
+            : _owner(owner), _lock(owner->_update_mutex), _table(new table_type(*owner->_current.load())) {
+        }
+
+        ip_concurrent_prefix_table* _owner;
+        std::unique_lock<std::mutex> _lock;
+        std::unique_ptr<table_type> _table;
+    };
+
+    /**
+     * Default constructor. Creates an empty table.
+     */
+    IPADDRESS_FORCE_INLINE ip_concurrent_prefix_table() : _current(new table_type()) {
+    }
+
+    ip_concurrent_prefix_table(const ip_concurrent_prefix_table&) = delete;
+
+    ip_concurrent_prefix_table& operator=(const ip_concurrent_prefix_table&) = delete;
+
+    /**
+     * Destroys the table and all the snapshots.
+     */
+    IPADDRESS_FORCE_INLINE ~ip_concurrent_prefix_table() {
+        delete _current.load();
+        for (const auto& retired : _retired) {
+            delete retired.first;
+        }
+    }
+
+    /**
+     * Creates a reader for the calling thread.
+     *
+     * @return The reader.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE reader make_reader() {
+        return reader(this);
+    }
+
+    /**
+     * Starts a transaction.
+     *
+     * Blocks while another transaction is in progress.
+     *
+     * @return The transaction.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE transaction update() {
+        return transaction(this);
+    }
+
+    /**
+     * Frees the replaced snapshots that no reader can still be using.
+     *
+     * Transactions do this on commit; calling it explicitly releases memory held by the
+     * snapshots retired since the last commit once their readers have moved on.
+     */
+    IPADDRESS_FORCE_INLINE void reclaim() {
+        std::lock_guard<std::mutex> lock(_update_mutex);
+        reclaim_retired();
+    }
+
+private:
+    IPADDRESS_FORCE_INLINE void publish(table_type* table) {
+        auto* old = _current.exchange(table);
+        _retired.emplace_back(old, _domain.advance());
+        reclaim_retired();
+    }
+
+    IPADDRESS_FORCE_INLINE void reclaim_retired() {
+        const auto oldest = _domain.oldest();
+        auto last = std::remove_if(_retired.begin(), _retired.end(), [oldest](const std::pair<table_type*, uint64_t>& retired) {
+            if (retired.second <= oldest) {
+                delete retired.first;
+                return true;
+            }
+            return false;
+        });
+        _retired.erase(last, _retired.end());
+    }
+
+    internal::epoch_domain _domain;
+    std::atomic<table_type*> _current;
+    std::mutex _update_mutex;
+    std::vector<std::pair<table_type*, uint64_t>> _retired;
+};
+
+} // namespace IPADDRESS_NAMESPACE
+
+#endif // IPADDRESS_IP_CONCURRENT_PREFIX_TABLE_HPP
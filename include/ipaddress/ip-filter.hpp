@@ -0,0 +1,647 @@
+/**
+ * @file      ip-filter.hpp
+ * @brief     Approximate membership filters for IP addresses and networks
+ * @author    Vladimir Shaleev
+ * @copyright MIT License
+ *
+ * This file defines ip_bloom_filter and ip_xor_filter, compact probabilistic sets that answer
+ * whether an address may be in a list such as a threat-intel blocklist. A filter never misses
+ * an address that was added, but reports a small fraction of other addresses as present, in
+ * exchange for a few bits per entry: a blocklist of millions of addresses fits in the L2 cache
+ * of a core, and the exact set only needs to be consulted for the rare positive answers.
+ *
+ * Filters built from networks are prefix-aware: networks are stored as the addresses or the /24
+ * (IPv4) or /48 (IPv6) prefixes they consist of, so a lookup tests both the address and its
+ * covering prefix.
+ */
+
+#ifndef IPADDRESS_IP_FILTER_HPP
+#define IPADDRESS_IP_FILTER_HPP
+
+#include "ip-any-network.hpp"
+#include "hash.hpp"
+
+namespace IPADDRESS_NAMESPACE {
+
+namespace internal {
+
+constexpr size_t filter_ipv4_prefixlen = 24;
+constexpr size_t filter_ipv6_prefixlen = 48;
+
+// A network shorter than the filter prefix is stored as all the prefixes it covers;
+// above this many, the filter would be filled with a single entry
+constexpr size_t filter_max_expansion_bits = 16;
+
+// The hashes of addresses and of prefixes are taken over different inputs, so that
+// an address and a prefix with the same bits, or an IPv4 address and the IPv6 address
+// with the same low bits, are different keys
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE uint64_t filter_hash_v4(uint32_t address) IPADDRESS_NOEXCEPT {
+    return strong_hash(uint64_t(address));
+}
+
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE uint64_t filter_hash_v4_prefix(uint32_t address) IPADDRESS_NOEXCEPT {
+    return strong_hash(uint64_t(address & 0xFFFFFF00) | (uint64_t(1) << 32));
+}
+
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE uint64_t filter_hash_v6(const uint128_t& address) IPADDRESS_NOEXCEPT {
+    return strong_hash(address.upper() ^ 0xC2B2AE3D27D4EB4FULL, address.lower());
+}
+
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE uint64_t filter_hash_v6_prefix(const uint128_t& address) IPADDRESS_NOEXCEPT {
+    return strong_hash(address.upper() & 0xFFFFFFFFFFFF0000ULL, 0x9E3779B97F4A7C15ULL);
+}
+
+// Maps the values a filter is built from to 64-bit keys, and a queried address to the
+// keys that have to be tested: the address itself and, for network filters, its prefix
+template <typename>
+struct filter_traits;
+
+template <>
+struct filter_traits<ipv4_address> {
+    using address_type = ipv4_address;
+
+    static constexpr size_t probes = 1;
+
+    IPADDRESS_FORCE_INLINE static void keys(const ipv4_address& address, std::vector<uint64_t>& out, error_code& /*code*/) {
+        out.push_back(filter_hash_v4(address.to_uint()));
+    }
+
+    IPADDRESS_FORCE_INLINE static void probe(const ipv4_address& address, uint64_t* out) IPADDRESS_NOEXCEPT {
+        out[0] = filter_hash_v4(address.to_uint());
+    }
+};
+
+template <>
+struct filter_traits<ipv6_address> {
+    using address_type = ipv6_address;
+
+    static constexpr size_t probes = 1;
+
+    IPADDRESS_FORCE_INLINE static void keys(const ipv6_address& address, std::vector<uint64_t>& out, error_code& /*code*/) {
+        out.push_back(filter_hash_v6(address.to_uint()));
+    }
+
+    IPADDRESS_FORCE_INLINE static void probe(const ipv6_address& address, uint64_t* out) IPADDRESS_NOEXCEPT {
+        out[0] = filter_hash_v6(address.to_uint());
+    }
+};
+
+template <>
+struct filter_traits<ip_address> {
+    using address_type = ip_address;
+
+    static constexpr size_t probes = 1;
+
+    IPADDRESS_FORCE_INLINE static void keys(const ip_address& address, std::vector<uint64_t>& out, error_code& /*code*/) {
+        out.push_back(address.is_v4() ? filter_hash_v4(address.to_uint32()) : filter_hash_v6(address.to_uint128()));
+    }
+
+    IPADDRESS_FORCE_INLINE static void probe(const ip_address& address, uint64_t* out) IPADDRESS_NOEXCEPT {
+        out[0] = address.is_v4() ? filter_hash_v4(address.to_uint32()) : filter_hash_v6(address.to_uint128());
+    }
+};
+
+template <>
+struct filter_traits<ipv4_network> {
+    using address_type = ipv4_address;
+
+    static constexpr size_t probes = 2;
+
+    IPADDRESS_FORCE_INLINE static void keys(const ipv4_network& network, std::vector<uint64_t>& out, error_code& code) {
+        const auto address = network.network_address().to_uint();
+        const auto prefixlen = network.prefixlen();
+        if (prefixlen > filter_ipv4_prefixlen) {
+            const auto count = uint32_t(1) << (ipv4_network::base_max_prefixlen - prefixlen);
+            for (uint32_t i = 0; i < count; ++i) {
+                out.push_back(filter_hash_v4(address + i));
+            }
+        } else if (prefixlen == filter_ipv4_prefixlen) {
+            out.push_back(filter_hash_v4_prefix(address));
+        } else if (filter_ipv4_prefixlen - prefixlen > filter_max_expansion_bits) {
+            code = error_code::network_too_large;
+        } else {
+            const auto count = uint32_t(1) << (filter_ipv4_prefixlen - prefixlen);
+            for (uint32_t i = 0; i < count; ++i) {
+                out.push_back(filter_hash_v4_prefix(address + (i << (ipv4_network::base_max_prefixlen - filter_ipv4_prefixlen))));
+            }
+        }
+    }
+
+    IPADDRESS_FORCE_INLINE static void probe(const ipv4_address& address, uint64_t* out) IPADDRESS_NOEXCEPT {
+        out[0] = filter_hash_v4(address.to_uint());
+        out[1] = filter_hash_v4_prefix(address.to_uint());
+    }
+};
+
+template <>
+struct filter_traits<ipv6_network> {
+    using address_type = ipv6_address;
+
+    static constexpr size_t probes = 2;
+
+    IPADDRESS_FORCE_INLINE static void keys(const ipv6_network& network, std::vector<uint64_t>& out, error_code& code) {
+        const auto address = network.network_address().to_uint();
+        const auto prefixlen = network.prefixlen();
+        if (prefixlen == ipv6_network::base_max_prefixlen) {
+            out.push_back(filter_hash_v6(address));
+        } else if (prefixlen >= filter_ipv6_prefixlen) {
+            out.push_back(filter_hash_v6_prefix(address));
+        } else if (filter_ipv6_prefixlen - prefixlen > filter_max_expansion_bits) {
+            code = error_code::network_too_large;
+        } else {
+            const auto count = uint64_t(1) << (filter_ipv6_prefixlen - prefixlen);
+            for (uint64_t i = 0; i < count; ++i) {
+                const auto upper = address.upper() + (i << (64 - filter_ipv6_prefixlen));
+                out.push_back(filter_hash_v6_prefix(uint128_t(upper, 0)));
+            }
+        }
+    }
+
+    IPADDRESS_FORCE_INLINE static void probe(const ipv6_address& address, uint64_t* out) IPADDRESS_NOEXCEPT {
+        const auto value = address.to_uint();
+        out[0] = filter_hash_v6(value);
+        out[1] = filter_hash_v6_prefix(value);
+    }
+};
+
+template <>
+struct filter_traits<ip_network> {
+    using address_type = ip_address;
+
+    static constexpr size_t probes = 2;
+
+    IPADDRESS_FORCE_INLINE static void keys(const ip_network& network, std::vector<uint64_t>& out, error_code& code) {
+        if (network.is_v4()) {
+            filter_traits<ipv4_network>::keys(network.v4().value(), out, code);
+        } else {
+            filter_traits<ipv6_network>::keys(network.v6().value(), out, code);
+        }
+    }
+
+    IPADDRESS_FORCE_INLINE static void probe(const ip_address& address, uint64_t* out) IPADDRESS_NOEXCEPT {
+        if (address.is_v4()) {
+            filter_traits<ipv4_network>::probe(ipv4_address::from_uint(address.to_uint32()), out);
+        } else {
+            filter_traits<ipv6_network>::probe(ipv6_address::from_uint(address.to_uint128()), out);
+        }
+    }
+};
+
+template <typename T, typename It>
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE std::vector<uint64_t> filter_keys(It first, It last, error_code& code) {
+    std::vector<uint64_t> keys;
+    for (; first != last; ++first) {
+        filter_traits<T>::keys(*first, keys, code);
+        if (code != error_code::no_error) {
+            return {};
+        }
+    }
+    return keys;
+}
+
+// Split block Bloom filter: a key sets one bit in each of the eight 32-bit lanes of a single
+// 256-bit block, so a lookup touches one cache line and has no data-dependent branches.
+// The bit positions come from the low half of the hash multiplied by eight odd constants;
+// the lanes are held in pairs in 64-bit words, which halves the number of loads and tests.
+IPADDRESS_FORCE_INLINE void bloom_block_masks(uint32_t key, uint64_t* masks) IPADDRESS_NOEXCEPT {
+    masks[0] = (uint64_t(1) << ((key * 0x47b6137bU) >> 27)) | (uint64_t(1) << (32 + ((key * 0x44974d91U) >> 27)));
+    masks[1] = (uint64_t(1) << ((key * 0x8824ad5bU) >> 27)) | (uint64_t(1) << (32 + ((key * 0xa2b7289dU) >> 27)));
+    masks[2] = (uint64_t(1) << ((key * 0x705495c7U) >> 27)) | (uint64_t(1) << (32 + ((key * 0x2df1424bU) >> 27)));
+    masks[3] = (uint64_t(1) << ((key * 0x9efc4947U) >> 27)) | (uint64_t(1) << (32 + ((key * 0x5c6bfb31U) >> 27)));
+}
+
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_t bloom_block_index(uint64_t hash, size_t blocks) IPADDRESS_NOEXCEPT {
+    return size_t(((hash >> 32) * uint64_t(blocks)) >> 32);
+}
+
+// Xor filter with three hash positions, one in each third of the fingerprint array.
+// A key is present if the xor of its three fingerprints equals its own fingerprint.
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_t xor_filter_slot(uint64_t hash, size_t index, size_t block_length) IPADDRESS_NOEXCEPT {
+    const auto rotated = index == 0 ? hash : (hash << (21 * index)) | (hash >> (64 - 21 * index));
+    return size_t((uint64_t(uint32_t(rotated)) * uint64_t(block_length)) >> 32) + index * block_length;
+}
+
+template <typename Fingerprint>
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE Fingerprint xor_filter_fingerprint(uint64_t hash) IPADDRESS_NOEXCEPT {
+    return Fingerprint(hash ^ (hash >> 32));
+}
+
+// Builds the filter by peeling: a slot used by a single key fixes that key, which is removed
+// from its other slots, and so on until every key is placed. The fingerprints are then
+// assigned in the reverse order, each key taking the one slot nobody assigned after it.
+// Peeling fails with a small probability, in which case the keys are rehashed with another seed.
+template <typename Fingerprint>
+IPADDRESS_FORCE_INLINE void xor_filter_build(std::vector<uint64_t>& keys, std::vector<Fingerprint>& fingerprints, size_t& block_length, uint64_t& seed) {
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    const auto size = keys.size();
+    block_length = (32 + size * 123 / 100) / 3 + 1;
+    const auto capacity = block_length * 3;
+
+    std::vector<uint64_t> masks(capacity);
+    std::vector<uint32_t> counts(capacity);
+    std::vector<size_t> queue;
+    std::vector<std::pair<uint64_t, size_t>> stack;
+    queue.reserve(capacity);
+    stack.reserve(size);
+    for (seed = 0x243F6A8885A308D3ULL;; seed = strong_hash(seed)) {
+        std::fill(masks.begin(), masks.end(), uint64_t(0));
+        std::fill(counts.begin(), counts.end(), uint32_t(0));
+        queue.clear();
+        stack.clear();
+        for (const auto key : keys) {
+            const auto hash = strong_hash(key + seed);
+            for (size_t j = 0; j < 3; ++j) {
+                const auto slot = xor_filter_slot(hash, j, block_length);
+                masks[slot] ^= hash;
+                ++counts[slot];
+            }
+        }
+        for (size_t i = 0; i < capacity; ++i) {
+            if (counts[i] == 1) {
+                queue.push_back(i);
+            }
+        }
+        while (!queue.empty()) {
+            const auto i = queue.back();
+            queue.pop_back();
+            if (counts[i] != 1) {
+                continue;
+            }
+            const auto hash = masks[i];
+            stack.emplace_back(hash, i);
+            for (size_t j = 0; j < 3; ++j) {
+                const auto slot = xor_filter_slot(hash, j, block_length);
+                masks[slot] ^= hash;
+                if (--counts[slot] == 1) {
+                    queue.push_back(slot);
+                }
+            }
+        }
+        if (stack.size() == size) {
+            break;
+        }
+    }
+
+    fingerprints.assign(capacity, Fingerprint(0));
+    for (auto it = stack.rbegin(); it != stack.rend(); ++it) {
+        const auto hash = it->first;
+        fingerprints[it->second] = Fingerprint(xor_filter_fingerprint<Fingerprint>(hash)
+            ^ fingerprints[xor_filter_slot(hash, 0, block_length)]
+            ^ fingerprints[xor_filter_slot(hash, 1, block_length)]
+            ^ fingerprints[xor_filter_slot(hash, 2, block_length)]);
+    }
+}
+
+} // namespace IPADDRESS_NAMESPACE::internal
+
+/**
+ * A blocked Bloom filter of IP addresses or networks.
+ *
+ * Every entry sets eight bits in a single 256-bit block, so a lookup reads one cache line.
+ * With the default 10 bits per entry about 1.3% of the addresses that were not added are
+ * reported as present; more bits per entry lower this rate. The filter is built in bulk
+ * from a range of addresses or networks.
+ *
+ * When built from networks (ipv4_network, ipv6_network or ip_network), an IPv4 network longer
+ * than /24 is stored as its addresses, a /28 as sixteen of them, and a shorter network as the
+ * /24 prefixes it consists of, a /20 as sixteen of them. IPv6 networks are stored likewise as
+ * /48 prefixes, except host routes, which are stored as addresses, and the networks from /49
+ * to /127, which are too large to enumerate and are stored as the /48 prefix covering them:
+ * such a network matches every address of its /48. Networks shorter than /8 for IPv4 or /32
+ * for IPv6 are rejected. A lookup then tests the address and its /24 or /48 prefix.
+ *
+ * @code{.cpp}
+ *   const ip_bloom_filter<ipv4_network> filter(blocklist.begin(), blocklist.end());
+ *   if (filter.contains(client) && exact_blocklist.contains(client)) {
+ *       reject(client);
+ *   }
+ * @endcode
+ * @tparam T the type of the entries: ipv4_address, ipv6_address, ip_address, ipv4_network, ipv6_network or ip_network.
+ * @remark The scope id of IPv6 addresses is not taken into account.
+ * @sa ip_xor_filter
+ */
+IPADDRESS_EXPORT template <typename T>
+class ip_bloom_filter {
+public:
+    using value_type   = T; /**< The type of the entries. */
+    using address_type = typename internal::filter_traits<T>::address_type; /**< The type of the addresses to look up. */
+    using size_type    = size_t; /**< An unsigned integer type. */
+
+    /**
+     * Default constructor. Creates an empty filter.
+     */
+    ip_bloom_filter() = default;
+
+    /**
+     * Creates a filter from a range of entries.
+     *
+     * @tparam It the type of the iterator.
+     * @param[in] first the beginning of the range of entries.
+     * @param[in] last the end of the range of entries.
+     * @param[in] bits_per_entry the number of filter bits per entry.
+     * @throw logic_error Raise if a network is too large to be stored as /24 or /48 prefixes.
+     */
+    template <typename It>
+    IPADDRESS_FORCE_INLINE ip_bloom_filter(It first, It last, size_t bits_per_entry = 10) {
+        assign(first, last, bits_per_entry);
+    }
+
+    /**
+     * Replaces the contents of the filter with a range of entries.
+     *
+     * @tparam It the type of the iterator.
+     * @param[in] first the beginning of the range of entries.
+     * @param[in] last the end of the range of entries.
+     * @param[in] bits_per_entry the number of filter bits per entry.
+     * @param[out] code an error_code object that will be set if an error occurs; the filter is left empty in this case.
+     */
+    template <typename It>
+    IPADDRESS_FORCE_INLINE void assign(It first, It last, size_t bits_per_entry, error_code& code) {
+        code = error_code::no_error;
+        clear();
+        const auto keys = internal::filter_keys<T>(first, last, code);
+        if (code != error_code::no_error || keys.empty()) {
+            return;
+        }
+        _blocks = std::max<size_t>((keys.size() * bits_per_entry + 255) / 256, 1);
+        _words.assign(_blocks * 4, 0);
+        _size = keys.size();
+        for (const auto key : keys) {
+            uint64_t masks[4];
+            internal::bloom_block_masks(uint32_t(key), masks);
+            auto* block = _words.data() + internal::bloom_block_index(key, _blocks) * 4;
+            for (size_t i = 0; i < 4; ++i) {
+                block[i] |= masks[i];
+            }
+        }
+    }
+
+    /**
+     * Replaces the contents of the filter with a range of entries, using 10 bits per entry.
+     *
+     * @tparam It the type of the iterator.
+     * @param[in] first the beginning of the range of entries.
+     * @param[in] last the end of the range of entries.
+     * @param[out] code an error_code object that will be set if an error occurs; the filter is left empty in this case.
+     */
+    template <typename It>
+    IPADDRESS_FORCE_INLINE void assign(It first, It last, error_code& code) {
+        assign(first, last, 10, code);
+    }
+
+    /**
+     * Replaces the contents of the filter with a range of entries.
+     *
+     * @tparam It the type of the iterator.
+     * @param[in] first the beginning of the range of entries.
+     * @param[in] last the end of the range of entries.
+     * @param[in] bits_per_entry the number of filter bits per entry.
+     * @throw logic_error Raise if a network is too large to be stored as /24 or /48 prefixes.
+     */
+    template <typename It>
+    IPADDRESS_FORCE_INLINE void assign(It first, It last, size_t bits_per_entry = 10) {
+        error_code code = error_code::no_error;
+        assign(first, last, bits_per_entry, code);
+        if (code != error_code::no_error) {
+            raise_error(code, 0, "", 0);
+        }
+    }
+
+    /**
+     * Returns the number of keys in the filter.
+     *
+     * This is the number of entries, except that a network stored as several addresses or
+     * prefixes counts as the number of them.
+     *
+     * @return The number of keys.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_type size() const IPADDRESS_NOEXCEPT {
+        return _size;
+    }
+
+    /**
+     * Checks whether the filter has no entries.
+     *
+     * @return `true` if the filter is empty, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool empty() const IPADDRESS_NOEXCEPT {
+        return _size == 0;
+    }
+
+    /**
+     * Returns the size of the filter data in bytes.
+     *
+     * @return The number of bytes.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_type size_in_bytes() const IPADDRESS_NOEXCEPT {
+        return _words.size() * sizeof(uint64_t);
+    }
+
+    /**
+     * Removes all entries and releases the memory.
+     */
+    IPADDRESS_FORCE_INLINE void clear() IPADDRESS_NOEXCEPT {
+        std::vector<uint64_t>().swap(_words);
+        _blocks = 0;
+        _size = 0;
+    }
+
+    /**
+     * Checks whether an address may be in the filter.
+     *
+     * @param[in] address the address to look up.
+     * @return `false` if the address was definitely not added, `true` if it probably was.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool contains(const address_type& address) const IPADDRESS_NOEXCEPT {
+        if (_blocks == 0) {
+            return false;
+        }
+        uint64_t keys[traits::probes];
+        traits::probe(address, keys);
+        for (size_t p = 0; p < traits::probes; ++p) {
+            uint64_t masks[4];
+            internal::bloom_block_masks(uint32_t(keys[p]), masks);
+            const auto* block = _words.data() + internal::bloom_block_index(keys[p], _blocks) * 4;
+            uint64_t missing = 0;
+            for (size_t i = 0; i < 4; ++i) {
+                missing |= masks[i] & ~block[i];
+            }
+            if (missing == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    using traits = internal::filter_traits<T>;
+
+    std::vector<uint64_t> _words;
+    size_t _blocks{};
+    size_t _size{};
+};
+
+/**
+ * An xor filter of IP addresses or networks.
+ *
+ * The filter stores one fingerprint per slot in an array of about 1.23 slots per entry, and a
+ * lookup xors three fingerprints. With 8-bit fingerprints about 0.4% of the addresses that were
+ * not added are reported as present, at under 10 bits per entry; 16-bit fingerprints lower this
+ * rate to about 0.0015%. Compared with ip_bloom_filter, the filter is smaller for the same
+ * accuracy but is built in bulk only and a lookup reads three cache lines instead of one.
+ *
+ * Networks are stored in the same way as in ip_bloom_filter: as addresses or /24 prefixes for
+ * IPv4, and as /48 prefixes for IPv6, where the networks from /49 to /127 match their whole /48.
+ *
+ * @code{.cpp}
+ *   const ip_xor_filter<ip_address> filter(blocklist.begin(), blocklist.end());
+ *   if (filter.contains(client) && exact_blocklist.contains(client)) {
+ *       reject(client);
+ *   }
+ * @endcode
+ * @tparam T the type of the entries: ipv4_address, ipv6_address, ip_address, ipv4_network, ipv6_network or ip_network.
+ * @tparam Fingerprint the unsigned integer type of the fingerprints, uint8_t or uint16_t.
+ * @remark The scope id of IPv6 addresses is not taken into account.
+ * @sa ip_bloom_filter
+ */
+IPADDRESS_EXPORT template <typename T, typename Fingerprint = uint8_t>
+class ip_xor_filter {
+public:
+    using value_type   = T; /**< The type of the entries. */
+    using address_type = typename internal::filter_traits<T>::address_type; /**< The type of the addresses to look up. */
+    using size_type    = size_t; /**< An unsigned integer type. */
+
+    /**
+     * Default constructor. Creates an empty filter.
+     */
+    ip_xor_filter() = default;
+
+    /**
+     * Creates a filter from a range of entries.
+     *
+     * @tparam It the type of the iterator.
+     * @param[in] first the beginning of the range of entries.
+     * @param[in] last the end of the range of entries.
+     * @throw logic_error Raise if a network is too large to be stored as /24 or /48 prefixes.
+     */
+    template <typename It>
+    IPADDRESS_FORCE_INLINE ip_xor_filter(It first, It last) {
+        assign(first, last);
+    }
+
+    /**
+     * Replaces the contents of the filter with a range of entries.
+     *
+     * @tparam It the type of the iterator.
+     * @param[in] first the beginning of the range of entries.
+     * @param[in] last the end of the range of entries.
+     * @param[out] code an error_code object that will be set if an error occurs; the filter is left empty in this case.
+     */
+    template <typename It>
+    IPADDRESS_FORCE_INLINE void assign(It first, It last, error_code& code) {
+        code = error_code::no_error;
+        clear();
+        auto keys = internal::filter_keys<T>(first, last, code);
+        if (code != error_code::no_error || keys.empty()) {
+            return;
+        }
+        internal::xor_filter_build(keys, _fingerprints, _block_length, _seed);
+        _size = keys.size();
+    }
+
+    /**
+     * Replaces the contents of the filter with a range of entries.
+     *
+     * @tparam It the type of the iterator.
+     * @param[in] first the beginning of the range of entries.
+     * @param[in] last the end of the range of entries.
+     * @throw logic_error Raise if a network is too large to be stored as /24 or /48 prefixes.
+     */
+    template <typename It>
+    IPADDRESS_FORCE_INLINE void assign(It first, It last) {
+        error_code code = error_code::no_error;
+        assign(first, last, code);
+        if (code != error_code::no_error) {
+            raise_error(code, 0, "", 0);
+        }
+    }
+
+    /**
+     * Returns the number of distinct keys in the filter.
+     *
+     * This is the number of distinct entries, except that a network stored as several addresses
+     * or prefixes counts as the number of them.
+     *
+     * @return The number of keys.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_type size() const IPADDRESS_NOEXCEPT {
+        return _size;
+    }
+
+    /**
+     * Checks whether the filter has no entries.
+     *
+     * @return `true` if the filter is empty, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool empty() const IPADDRESS_NOEXCEPT {
+        return _size == 0;
+    }
+
+    /**
+     * Returns the size of the filter data in bytes.
+     *
+     * @return The number of bytes.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_type size_in_bytes() const IPADDRESS_NOEXCEPT {
+        return _fingerprints.size() * sizeof(Fingerprint);
+    }
+
+    /**
+     * Removes all entries and releases the memory.
+     */
+    IPADDRESS_FORCE_INLINE void clear() IPADDRESS_NOEXCEPT {
+        std::vector<Fingerprint>().swap(_fingerprints);
+        _block_length = 0;
+        _seed = 0;
+        _size = 0;
+    }
+
+    /**
+     * Checks whether an address may be in the filter.
+     *
+     * @param[in] address the address to look up.
+     * @return `false` if the address was definitely not added, `true` if it probably was.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool contains(const address_type& address) const IPADDRESS_NOEXCEPT {
+        if (_size == 0) {
+            return false;
+        }
+        uint64_t keys[traits::probes];
+        traits::probe(address, keys);
+        for (size_t p = 0; p < traits::probes; ++p) {
+            const auto hash = internal::strong_hash(keys[p] + _seed);
+            const auto fingerprint = Fingerprint(internal::xor_filter_fingerprint<Fingerprint>(hash)
+                ^ _fingerprints[internal::xor_filter_slot(hash, 0, _block_length)]
+                ^ _fingerprints[internal::xor_filter_slot(hash, 1, _block_length)]
+                ^ _fingerprints[internal::xor_filter_slot(hash, 2, _block_length)]);
+            if (fingerprint == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    using traits = internal::filter_traits<T>;
+
+    std::vector<Fingerprint> _fingerprints;
+    size_t _block_length{};
+    uint64_t _seed{};
+    size_t _size{};
+};
+
+} // namespace IPADDRESS_NAMESPACE
+
+#endif // IPADDRESS_IP_FILTER_HPP
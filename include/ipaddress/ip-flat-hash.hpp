@@ -0,0 +1,634 @@
+/**
+ * @file      ip-flat-hash.hpp
+ * @brief     Open-addressing hash set and map keyed by IP addresses
+ * @author    Vladimir Shaleev
+ * @copyright MIT License
+ *
+ * This file defines the ip_flat_set and ip_flat_map class templates, hash containers that
+ * store all entries in a single flat array instead of one node per entry. The layout follows
+ * SwissTable: next to the slots there is an array of control bytes, one per slot, holding
+ * 7 bits of the hash of a full slot or a marker of an empty or deleted one. A lookup compares
+ * the control bytes of a group of 16 slots at once (with SSE2 where available) and touches
+ * the slots only for the candidates whose control byte matches.
+ *
+ * Addresses are stored as raw integers: 4 bytes for ipv4_address and 16 bytes for
+ * ipv6_address and ip_address. For ip_address, the IP version takes the lowest bit of
+ * the control byte, so the key itself needs no extra storage.
+ */
+
+#ifndef IPADDRESS_IP_FLAT_HASH_HPP
+#define IPADDRESS_IP_FLAT_HASH_HPP
+
+#include "ip-any-address.hpp"
+#include "bits.hpp"
+
+namespace IPADDRESS_NAMESPACE {
+
+namespace internal {
+
+enum flat_ctrl : uint8_t {
+    flat_empty = 0x80,
+    flat_deleted = 0xFE
+};
+
+// Bit masks over the 16 control bytes of a group: bit i is set if byte i matches
+struct flat_group {
+    static constexpr size_t width = 16;
+
+#ifdef IPADDRESS_SSE2
+    IPADDRESS_FORCE_INLINE explicit flat_group(const uint8_t* ctrl) IPADDRESS_NOEXCEPT : _ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE uint32_t match(uint8_t h2) const IPADDRESS_NOEXCEPT {
+        return uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(_ctrl, _mm_set1_epi8(char(h2)))));
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE uint32_t match_empty() const IPADDRESS_NOEXCEPT {
+        return match(flat_empty);
+    }
+
+    // Empty and deleted bytes are the only ones with the sign bit set
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE uint32_t match_free() const IPADDRESS_NOEXCEPT {
+        return uint32_t(_mm_movemask_epi8(_ctrl));
+    }
+
+private:
+    __m128i _ctrl;
+#else
+    IPADDRESS_FORCE_INLINE explicit flat_group(const uint8_t* ctrl) IPADDRESS_NOEXCEPT : _ctrl(ctrl) {
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE uint32_t match(uint8_t h2) const IPADDRESS_NOEXCEPT {
+        uint32_t result = 0;
+        for (size_t i = 0; i < width; ++i) {
+            result |= uint32_t(_ctrl[i] == h2) << i;
+        }
+        return result;
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE uint32_t match_empty() const IPADDRESS_NOEXCEPT {
+        return match(flat_empty);
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE uint32_t match_free() const IPADDRESS_NOEXCEPT {
+        uint32_t result = 0;
+        for (size_t i = 0; i < width; ++i) {
+            result |= uint32_t(_ctrl[i] >> 7) << i;
+        }
+        return result;
+    }
+
+private:
+    const uint8_t* _ctrl;
+#endif
+};
+
+template <typename>
+struct flat_hash_traits;
+
+template <>
+struct flat_hash_traits<ipv4_address> {
+    using key_type = uint32_t;
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE key_type key(const ipv4_address& address) IPADDRESS_NOEXCEPT {
+        return address.to_uint();
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE uint64_t hash(const key_type& key) IPADDRESS_NOEXCEPT {
+        return strong_hash(key);
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE uint8_t h2(uint64_t hash, const ipv4_address& /*address*/) IPADDRESS_NOEXCEPT {
+        return uint8_t(hash >> 57);
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE ipv4_address address(const key_type& key, uint8_t /*ctrl*/) IPADDRESS_NOEXCEPT {
+        return ipv4_address::from_uint(key);
+    }
+};
+
+template <>
+struct flat_hash_traits<ipv6_address> {
+    using key_type = uint128_t;
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE key_type key(const ipv6_address& address) IPADDRESS_NOEXCEPT {
+        return address.to_uint();
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE uint64_t hash(const key_type& key) IPADDRESS_NOEXCEPT {
+        return strong_hash(key.upper(), key.lower());
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE uint8_t h2(uint64_t hash, const ipv6_address& /*address*/) IPADDRESS_NOEXCEPT {
+        return uint8_t(hash >> 57);
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE ipv6_address address(const key_type& key, uint8_t /*ctrl*/) IPADDRESS_NOEXCEPT {
+        return ipv6_address::from_uint(key);
+    }
+};
+
+template <>
+struct flat_hash_traits<ip_address> {
+    using key_type = uint128_t;
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE key_type key(const ip_address& address) IPADDRESS_NOEXCEPT {
+        return address.is_v4() ? uint128_t(address.to_uint32()) : address.to_uint128();
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE uint64_t hash(const key_type& key) IPADDRESS_NOEXCEPT {
+        return key.upper() == 0 ? strong_hash(key.lower()) : strong_hash(key.upper(), key.lower());
+    }
+
+    // The lowest bit tells the version, so that 1.2.3.4 and ::102:304 are different keys
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE uint8_t h2(uint64_t hash, const ip_address& address) IPADDRESS_NOEXCEPT {
+        return uint8_t((hash >> 57) & 0x7E) | uint8_t(address.is_v4());
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE ip_address address(const key_type& key, uint8_t ctrl) IPADDRESS_NOEXCEPT {
+        return (ctrl & 1) != 0 ? ip_address(ipv4_address::from_uint(uint32_t(key.lower()))) : ip_address(ipv6_address::from_uint(key));
+    }
+};
+
+template <typename Key>
+struct flat_set_slot {
+    Key key;
+};
+
+template <typename Key, typename Value>
+struct flat_map_slot {
+    Key key;
+    Value value;
+};
+
+// The table shared by ip_flat_set and ip_flat_map. The capacity is zero or a power of two
+// of at least one group, and at most 7/8 of the slots are used, counting deleted ones.
+// Groups are probed in triangular order, which visits every group of the table once.
+template <typename Address, typename Slot>
+class flat_hash_table {
+public:
+    using traits = flat_hash_traits<Address>;
+    using key_type = typename traits::key_type;
+    using slot_type = Slot;
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_t size() const IPADDRESS_NOEXCEPT {
+        return _size;
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_t capacity() const IPADDRESS_NOEXCEPT {
+        return _ctrl.size();
+    }
+
+    IPADDRESS_FORCE_INLINE void clear() IPADDRESS_NOEXCEPT {
+        std::vector<uint8_t>().swap(_ctrl);
+        std::vector<Slot>().swap(_slots);
+        _size = 0;
+        _growth_left = 0;
+    }
+
+    IPADDRESS_FORCE_INLINE void reserve(size_t count) {
+        size_t capacity = flat_group::width;
+        while (capacity / 8 * 7 < count) {
+            capacity *= 2;
+        }
+        if (capacity > this->capacity()) {
+            rehash(capacity);
+        }
+    }
+
+    // Returns the slot of the address, or nullptr if there is none
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE const Slot* find(const Address& address) const IPADDRESS_NOEXCEPT {
+        if (_size == 0) {
+            return nullptr;
+        }
+        const auto key = traits::key(address);
+        const auto hash = traits::hash(key);
+        const auto index = find_index(key, hash, traits::h2(hash, address));
+        return index != npos ? &_slots[index] : nullptr;
+    }
+
+    // Returns the slot of the address and true if it has been added, or
+    // the existing slot and false if the address is already in the table
+    IPADDRESS_FORCE_INLINE std::pair<Slot*, bool> insert(const Address& address) {
+        const auto key = traits::key(address);
+        const auto hash = traits::hash(key);
+        const auto h2 = traits::h2(hash, address);
+        auto index = _size != 0 ? find_index(key, hash, h2) : npos;
+        if (index != npos) {
+            return std::make_pair(&_slots[index], false);
+        }
+        if (_growth_left == 0) {
+            // Grow if live entries take more than half of the usable slots,
+            // otherwise only drop the deleted ones
+            rehash(_size * 2 >= capacity() / 8 * 7 ? std::max(capacity() * 2, size_t(flat_group::width)) : capacity());
+        }
+        index = find_free(hash);
+        if (_ctrl[index] == flat_empty) {
+            --_growth_left;
+        }
+        _ctrl[index] = h2;
+        _slots[index].key = key;
+        ++_size;
+        return std::make_pair(&_slots[index], true);
+    }
+
+    IPADDRESS_FORCE_INLINE bool erase(const Address& address) {
+        if (_size == 0) {
+            return false;
+        }
+        const auto key = traits::key(address);
+        const auto hash = traits::hash(key);
+        const auto index = find_index(key, hash, traits::h2(hash, address));
+        if (index == npos) {
+            return false;
+        }
+        // A group that still has an empty slot has never been full, so no probe
+        // sequence continues past it and the slot can become empty again
+        const flat_group ctrl(&_ctrl[index / flat_group::width * flat_group::width]);
+        if (ctrl.match_empty() != 0) {
+            _ctrl[index] = flat_empty;
+            ++_growth_left;
+        } else {
+            _ctrl[index] = flat_deleted;
+        }
+        _slots[index] = Slot();
+        --_size;
+        return true;
+    }
+
+    template <typename Fn>
+    IPADDRESS_FORCE_INLINE void for_each(Fn&& fn) const {
+        for (size_t i = 0; i < _ctrl.size(); ++i) {
+            if ((_ctrl[i] & 0x80) == 0) {
+                fn(traits::address(_slots[i].key, _ctrl[i]), _slots[i]);
+            }
+        }
+    }
+
+private:
+    static constexpr size_t npos = size_t(-1);
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_t find_index(const key_type& key, uint64_t hash, uint8_t h2) const IPADDRESS_NOEXCEPT {
+        const auto mask = (_ctrl.size() / flat_group::width) - 1;
+        auto group = size_t(hash) & mask;
+        for (size_t step = 1; ; ++step) {
+            const auto offset = group * flat_group::width;
+            const flat_group ctrl(&_ctrl[offset]);
+            for (auto match = ctrl.match(h2); match != 0; match &= match - 1) {
+                const auto index = offset + countr_zero(match);
+                if (_slots[index].key == key) {
+                    return index;
+                }
+            }
+            if (ctrl.match_empty() != 0) {
+                return npos;
+            }
+            group = (group + step) & mask;
+        }
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_t find_free(uint64_t hash) const IPADDRESS_NOEXCEPT {
+        const auto mask = (_ctrl.size() / flat_group::width) - 1;
+        auto group = size_t(hash) & mask;
+        for (size_t step = 1; ; ++step) {
+            const auto offset = group * flat_group::width;
+            const auto free = flat_group(&_ctrl[offset]).match_free();
+            if (free != 0) {
+                return offset + countr_zero(free);
+            }
+            group = (group + step) & mask;
+        }
+    }
+
+    void rehash(size_t capacity) {
+        std::vector<uint8_t> ctrl(capacity, uint8_t(flat_empty));
+        std::vector<Slot> slots(capacity);
+        ctrl.swap(_ctrl);
+        slots.swap(_slots);
+        _growth_left = capacity / 8 * 7 - _size;
+        for (size_t i = 0; i < ctrl.size(); ++i) {
+            if ((ctrl[i] & 0x80) == 0) {
+                const auto index = find_free(traits::hash(slots[i].key));
+                _ctrl[index] = ctrl[i];
+                _slots[index] = std::move(slots[i]);
+            }
+        }
+    }
+
+    std::vector<uint8_t> _ctrl;
+    std::vector<Slot> _slots;
+    size_t _size = 0;
+    size_t _growth_left = 0;
+};
+
+} // namespace IPADDRESS_NAMESPACE::internal
+
+/**
+ * A hash set of IP addresses with open addressing.
+ *
+ * Unlike `std::unordered_set`, the set keeps all addresses in one flat array: an IPv4 address
+ * takes 4 bytes and an IPv6 address 16 bytes, plus one control byte, with no allocation per
+ * entry. Insertion, lookup and removal take amortized constant time. Insertion may move the
+ * entries, and the order of iteration is unspecified.
+ *
+ * @code{.cpp}
+ *   ip_flat_set<ip_address> seen;
+ *   seen.insert(ip_address::parse("192.0.2.1"));
+ *   seen.insert(ip_address::parse("2001:db8::1"));
+ *
+ *   std::cout << seen.contains(ip_address::parse("192.0.2.1")) << ' ' << seen.contains(ip_address::parse("::c000:201")) << std::endl;
+ *
+ *   // out:
+ *   // 1 0
+ * @endcode
+ * @tparam Address the address type: ipv4_address, ipv6_address or ip_address.
+ * @remark The scope id of IPv6 addresses is not stored and not taken into account.
+ */
+IPADDRESS_EXPORT template <typename Address>
+class ip_flat_set {
+    using table_type = internal::flat_hash_table<Address, internal::flat_set_slot<typename internal::flat_hash_traits<Address>::key_type>>;
+
+public:
+    using key_type   = Address; /**< The address type. */
+    using value_type = Address; /**< The type of the elements. */
+    using size_type  = size_t; /**< An unsigned integer type. */
+
+    /**
+     * Default constructor. Creates an empty set without allocating memory.
+     */
+    ip_flat_set() = default;
+
+    /**
+     * Creates a set from a range of addresses.
+     *
+     * @tparam It the type of the iterator.
+     * @param[in] first the beginning of the range of addresses.
+     * @param[in] last the end of the range of addresses.
+     */
+    template <typename It>
+    IPADDRESS_FORCE_INLINE ip_flat_set(It first, It last) {
+        for (; first != last; ++first) {
+            insert(*first);
+        }
+    }
+
+    /**
+     * Creates a set from an initializer list of addresses.
+     *
+     * @param[in] addresses the addresses.
+     */
+    IPADDRESS_FORCE_INLINE ip_flat_set(std::initializer_list<key_type> addresses) : ip_flat_set(addresses.begin(), addresses.end()) {
+    }
+
+    /**
+     * Returns the number of addresses in the set.
+     *
+     * @return The number of addresses.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_type size() const IPADDRESS_NOEXCEPT {
+        return _table.size();
+    }
+
+    /**
+     * Checks whether the set has no addresses.
+     *
+     * @return `true` if the set is empty, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool empty() const IPADDRESS_NOEXCEPT {
+        return _table.size() == 0;
+    }
+
+    /**
+     * Returns the number of slots of the set.
+     *
+     * @return The number of slots, of which up to 7/8 can be used.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_type capacity() const IPADDRESS_NOEXCEPT {
+        return _table.capacity();
+    }
+
+    /**
+     * Removes all addresses and releases the memory.
+     */
+    IPADDRESS_FORCE_INLINE void clear() IPADDRESS_NOEXCEPT {
+        _table.clear();
+    }
+
+    /**
+     * Reserves room for a number of addresses, so that they can be inserted without rehashing.
+     *
+     * @param[in] count the number of addresses.
+     */
+    IPADDRESS_FORCE_INLINE void reserve(size_type count) {
+        _table.reserve(count);
+    }
+
+    /**
+     * Adds an address to the set.
+     *
+     * @param[in] address the address to add.
+     * @return `true` if the address has been added, `false` if it was already in the set.
+     */
+    IPADDRESS_FORCE_INLINE bool insert(const key_type& address) {
+        return _table.insert(address).second;
+    }
+
+    /**
+     * Removes an address from the set.
+     *
+     * @param[in] address the address to remove.
+     * @return `true` if the address has been removed, `false` if it was not in the set.
+     */
+    IPADDRESS_FORCE_INLINE bool erase(const key_type& address) {
+        return _table.erase(address);
+    }
+
+    /**
+     * Checks whether the set contains an address.
+     *
+     * @param[in] address the address to look up.
+     * @return `true` if the set contains the address, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool contains(const key_type& address) const IPADDRESS_NOEXCEPT {
+        return _table.find(address) != nullptr;
+    }
+
+    /**
+     * Calls a function for each address of the set.
+     *
+     * @tparam Fn the type of the function, callable as `fn(address)`.
+     * @param[in] fn the function.
+     */
+    template <typename Fn>
+    IPADDRESS_FORCE_INLINE void for_each(Fn&& fn) const {
+        _table.for_each([&fn](const key_type& address, const typename table_type::slot_type& /*slot*/) { fn(address); });
+    }
+
+private:
+    table_type _table;
+};
+
+/**
+ * A hash map from IP addresses to values with open addressing.
+ *
+ * The map keeps each address, stored as a 4 or 16 byte integer, together with its value in
+ * one flat array, plus one control byte per entry, with no allocation per entry. Insertion,
+ * lookup and removal take amortized constant time. Insertion may move the entries, which
+ * invalidates pointers to values, and the order of iteration is unspecified.
+ *
+ * @code{.cpp}
+ *   ip_flat_map<ipv4_address, uint64_t> bytes;
+ *   bytes[ipv4_address::parse("192.0.2.1")] += 1500;
+ *   bytes[ipv4_address::parse("192.0.2.1")] += 40;
+ *
+ *   std::cout << *bytes.find(ipv4_address::parse("192.0.2.1")) << std::endl;
+ *
+ *   // out:
+ *   // 1540
+ * @endcode
+ * @tparam Address the address type: ipv4_address, ipv6_address or ip_address.
+ * @tparam Value the type of the mapped values, which must be default constructible and move assignable.
+ * @remark The scope id of IPv6 addresses is not stored and not taken into account.
+ */
+IPADDRESS_EXPORT template <typename Address, typename Value>
+class ip_flat_map {
+    using table_type = internal::flat_hash_table<Address, internal::flat_map_slot<typename internal::flat_hash_traits<Address>::key_type, Value>>;
+
+public:
+    using key_type    = Address; /**< The address type. */
+    using mapped_type = Value; /**< The type of the mapped values. */
+    using size_type   = size_t; /**< An unsigned integer type. */
+
+    /**
+     * Default constructor. Creates an empty map without allocating memory.
+     */
+    ip_flat_map() = default;
+
+    /**
+     * Returns the number of entries in the map.
+     *
+     * @return The number of entries.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_type size() const IPADDRESS_NOEXCEPT {
+        return _table.size();
+    }
+
+    /**
+     * Checks whether the map has no entries.
+     *
+     * @return `true` if the map is empty, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool empty() const IPADDRESS_NOEXCEPT {
+        return _table.size() == 0;
+    }
+
+    /**
+     * Returns the number of slots of the map.
+     *
+     * @return The number of slots, of which up to 7/8 can be used.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_type capacity() const IPADDRESS_NOEXCEPT {
+        return _table.capacity();
+    }
+
+    /**
+     * Removes all entries and releases the memory.
+     */
+    IPADDRESS_FORCE_INLINE void clear() IPADDRESS_NOEXCEPT {
+        _table.clear();
+    }
+
+    /**
+     * Reserves room for a number of entries, so that they can be inserted without rehashing.
+     *
+     * @param[in] count the number of entries.
+     */
+    IPADDRESS_FORCE_INLINE void reserve(size_type count) {
+        _table.reserve(count);
+    }
+
+    /**
+     * Adds an entry to the map, unless the address is already there.
+     *
+     * @param[in] address the address.
+     * @param[in] value the value associated with the address.
+     * @return `true` if the entry has been added, `false` if the address was already in the map (its value is unchanged).
+     */
+    IPADDRESS_FORCE_INLINE bool insert(const key_type& address, const mapped_type& value) {
+        const auto result = _table.insert(address);
+        if (result.second) {
+            result.first->value = value;
+        }
+        return result.second;
+    }
+
+    /**
+     * Returns the value of an address, adding the address with a default constructed value if it is not in the map.
+     *
+     * @param[in] address the address.
+     * @return A reference to the value.
+     */
+    IPADDRESS_FORCE_INLINE mapped_type& operator[](const key_type& address) {
+        return _table.insert(address).first->value;
+    }
+
+    /**
+     * Removes the entry of an address.
+     *
+     * @param[in] address the address.
+     * @return `true` if the entry has been removed, `false` if the address was not in the map.
+     */
+    IPADDRESS_FORCE_INLINE bool erase(const key_type& address) {
+        return _table.erase(address);
+    }
+
+    /**
+     * Finds the value of an address.
+     *
+     * @param[in] address the address to look up.
+     * @return A pointer to the value, or `nullptr` if the address is not in the map.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE const mapped_type* find(const key_type& address) const IPADDRESS_NOEXCEPT {
+        const auto* slot = _table.find(address);
+        return slot != nullptr ? &slot->value : nullptr;
+    }
+
+    /**
+     * Finds the value of an address.
+     *
+     * @param[in] address the address to look up.
+     * @return A pointer to the value, or `nullptr` if the address is not in the map.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE mapped_type* find(const key_type& address) IPADDRESS_NOEXCEPT {
+        const auto* slot = _table.find(address);
+        return slot != nullptr ? const_cast<mapped_type*>(&slot->value) : nullptr;
+    }
+
+    /**
+     * Checks whether the map contains an address.
+     *
+     * @param[in] address the address to look up.
+     * @return `true` if the map contains the address, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool contains(const key_type& address) const IPADDRESS_NOEXCEPT {
+        return _table.find(address) != nullptr;
+    }
+
+    /**
+     * Calls a function for each entry of the map.
+     *
+     * @tparam Fn the type of the function, callable as `fn(address, value)`.
+     * @param[in] fn the function.
+     */
+    template <typename Fn>
+    IPADDRESS_FORCE_INLINE void for_each(Fn&& fn) const {
+        _table.for_each([&fn](const key_type& address, const typename table_type::slot_type& slot) { fn(address, slot.value); });
+    }
+
+private:
+    table_type _table;
+};
+
+} // namespace IPADDRESS_NAMESPACE
+
+#endif // IPADDRESS_IP_FLAT_HASH_HPP
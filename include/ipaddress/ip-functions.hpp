@@ -5,8 +5,9 @@
  * @copyright MIT License
  * 
  * This file contains functions for processing IP address ranges and networks.
- * It provides functionalities `summarize_address_range`. These utilities
- * enable efficient handling and manipulation of IP address data.
+ * It provides functionalities `summarize_address_range`, `summarize_address_ranges`
+ * and `collapse_addresses`. These utilities enable efficient handling and manipulation
+ * of IP address data.
  */
 
 #ifndef IPADDRESS_IP_FUNCTIONS_HPP
@@ -17,6 +18,9 @@
  
 namespace IPADDRESS_NAMESPACE {
 
+IPADDRESS_EXPORT template <typename>
+class collapse_buffer;
+
 namespace internal {
 
 template <typename T1, typename T2>
@@ -155,6 +159,328 @@ IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE typename summariz
     return { first, last };
 }
 
+template <typename UInt>
+struct collapse_item {
+    UInt address;
+    uint32_t prefixlen;
+};
+
+template <typename>
+struct collapse_traits;
+
+template <>
+struct collapse_traits<ipv4_network> {
+    using uint_type = uint32_t;
+
+    static constexpr size_t key_size = 4;
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE uint_type key(const ipv4_network& net) IPADDRESS_NOEXCEPT {
+        return net.network_address().to_uint();
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE ipv4_network network(ip_version /*version*/, uint_type address, size_t prefixlen) IPADDRESS_NOEXCEPT {
+        error_code code = error_code::no_error;
+        return ipv4_network::from_address(ipv4_address::from_uint(address), code, prefixlen);
+    }
+};
+
+template <>
+struct collapse_traits<ipv6_network> {
+    using uint_type = uint128_t;
+
+    static constexpr size_t key_size = 16;
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE uint_type key(const ipv6_network& net) IPADDRESS_NOEXCEPT {
+        return net.network_address().to_uint();
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE ipv6_network network(ip_version /*version*/, const uint_type& address, size_t prefixlen) IPADDRESS_NOEXCEPT {
+        error_code code = error_code::no_error;
+        return ipv6_network::from_address(ipv6_address::from_uint(address), code, prefixlen);
+    }
+};
+
+template <>
+struct collapse_traits<ip_network> {
+    using uint_type = uint128_t;
+
+    static constexpr size_t key_size = 16;
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE uint_type key(const ip_network& net) IPADDRESS_NOEXCEPT {
+        return net.network_address().to_uint128();
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE ip_network network(ip_version version, const uint_type& address, size_t prefixlen) IPADDRESS_NOEXCEPT {
+        return version == ip_version::V4
+            ? ip_network(collapse_traits<ipv4_network>::network(version, uint32_t(address.lower()), prefixlen))
+            : ip_network(collapse_traits<ipv6_network>::network(version, address, prefixlen));
+    }
+};
+
+// Writes the minimal CIDR cover of [current, last] to out. Each step takes the largest block
+// that is both aligned at current and fits in the rest of the range, so the block size comes
+// from a single trailing zero count and a single bit length instead of a loop over bits.
+template <typename Result, typename Net, typename UInt, typename OutputIt>
+IPADDRESS_FORCE_INLINE OutputIt summarize_range_to(ip_version version, UInt current, UInt last, OutputIt out) {
+    constexpr auto max_prefixlen = size_t(Net::base_max_prefixlen);
+    for (;;) {
+        const auto size = last - current + 1;
+        // The size wraps to zero only when the range is the whole address space
+        auto nbits = size != 0 ? bit_length(size) - 1 : max_prefixlen;
+        const auto align = count_righthand_zero_bits(current, max_prefixlen);
+        if (align < nbits) {
+            nbits = align;
+        }
+        *out = Result(collapse_traits<Net>::network(version, current, max_prefixlen - nbits));
+        ++out;
+        if (nbits == max_prefixlen) {
+            return out;
+        }
+        const auto block_last = current + ((UInt(1) << nbits) - 1);
+        if (block_last == last) {
+            return out;
+        }
+        current = block_last + 1;
+    }
+}
+
+template <typename>
+struct summarize_range_traits;
+
+template <>
+struct summarize_range_traits<ipv4_address> {
+    template <typename OutputIt>
+    static IPADDRESS_FORCE_INLINE OutputIt summarize(const ipv4_address& first, const ipv4_address& last, OutputIt out) {
+        return summarize_range_to<ipv4_network, ipv4_network>(ip_version::V4, first.to_uint(), last.to_uint(), out);
+    }
+};
+
+template <>
+struct summarize_range_traits<ipv6_address> {
+    template <typename OutputIt>
+    static IPADDRESS_FORCE_INLINE OutputIt summarize(const ipv6_address& first, const ipv6_address& last, OutputIt out) {
+        return summarize_range_to<ipv6_network, ipv6_network>(ip_version::V6, first.to_uint(), last.to_uint(), out);
+    }
+};
+
+template <>
+struct summarize_range_traits<ip_address> {
+    template <typename OutputIt>
+    static IPADDRESS_FORCE_INLINE OutputIt summarize(const ip_address& first, const ip_address& last, OutputIt out) {
+        return first.version() == ip_version::V4
+            ? summarize_range_to<ip_network, ipv4_network>(ip_version::V4, uint32_t(first.to_uint128().lower()), uint32_t(last.to_uint128().lower()), out)
+            : summarize_range_to<ip_network, ipv6_network>(ip_version::V6, first.to_uint128(), last.to_uint128(), out);
+    }
+};
+
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_t collapse_key_byte(uint32_t value, size_t index) IPADDRESS_NOEXCEPT {
+    return size_t(uint8_t(value >> (index << 3)));
+}
+
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_t collapse_key_byte(const uint128_t& value, size_t index) IPADDRESS_NOEXCEPT {
+    return index < 8
+        ? size_t(uint8_t(value.lower() >> (index << 3)))
+        : size_t(uint8_t(value.upper() >> ((index - 8) << 3)));
+}
+
+template <typename UInt>
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool collapse_item_less(const collapse_item<UInt>& lhs, const collapse_item<UInt>& rhs) IPADDRESS_NOEXCEPT {
+    return lhs.address < rhs.address || (lhs.address == rhs.address && lhs.prefixlen < rhs.prefixlen);
+}
+
+// Sorts items by (address, prefixlen) with an LSD radix sort: the prefix length is the
+// least significant digit, followed by the address bytes from the lowest to the highest.
+// All histograms are collected in a single read pass, and a pass is skipped entirely
+// when every item has the same digit (e.g. the zero tail of IPv6 /48 prefixes).
+// Small inputs are handed to std::sort, for which the histograms would be pure overhead.
+// Returns whichever of the two arrays holds the sorted items.
+template <size_t KeySize, typename UInt>
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE collapse_item<UInt>* collapse_sort(collapse_item<UInt>* items, collapse_item<UInt>* temp, size_t size, size_t* counts) IPADDRESS_NOEXCEPT {
+    constexpr size_t digits = KeySize + 1;
+    if (size < 256) {
+        std::sort(items, items + size, collapse_item_less<UInt>);
+        return items;
+    }
+    std::fill(counts, counts + digits * 256, size_t(0));
+    for (size_t i = 0; i < size; ++i) {
+        const auto& item = items[i];
+        ++counts[item.prefixlen];
+        for (size_t b = 0; b < KeySize; ++b) {
+            ++counts[(b + 1) * 256 + collapse_key_byte(item.address, b)];
+        }
+    }
+    auto* src = items;
+    auto* dst = temp;
+    for (size_t digit = 0; digit < digits; ++digit) {
+        auto* count = counts + digit * 256;
+        const auto first_digit = digit == 0 ? size_t(src->prefixlen) : collapse_key_byte(src->address, digit - 1);
+        if (count[first_digit] == size) {
+            continue;
+        }
+        size_t offset = 0;
+        for (size_t i = 0; i < 256; ++i) {
+            const auto n = count[i];
+            count[i] = offset;
+            offset += n;
+        }
+        for (size_t i = 0; i < size; ++i) {
+            const auto& item = src[i];
+            const auto d = digit == 0 ? size_t(item.prefixlen) : collapse_key_byte(item.address, digit - 1);
+            dst[count[d]++] = item;
+        }
+        std::swap(src, dst);
+    }
+    return src;
+}
+
+template <size_t KeySize, typename UInt>
+IPADDRESS_FORCE_INLINE void collapse_sort(std::vector<collapse_item<UInt>>& items, std::vector<collapse_item<UInt>>& temp, std::vector<size_t>& counts) {
+    temp.resize(items.size());
+    counts.resize((KeySize + 1) * 256);
+    if (collapse_sort<KeySize>(items.data(), temp.data(), items.size(), counts.data()) != items.data()) {
+        items.swap(temp);
+    }
+}
+
+// Collapses items sorted by (address, prefixlen) in place. The collapsed prefix is kept as
+// a stack at the front of the array: an item covered by the top of the stack is dropped,
+// otherwise it is pushed and merged with its sibling below as long as one exists.
+// Since the input is sorted, a sibling can only ever be the element right below the top.
+template <typename UInt>
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_t collapse_sorted(collapse_item<UInt>* items, size_t size, uint32_t max_prefixlen) IPADDRESS_NOEXCEPT {
+    size_t top = 0;
+    for (size_t i = 0; i < size; ++i) {
+        const auto item = items[i];
+        if (top != 0) {
+            const auto& prev = items[top - 1];
+            if (prev.prefixlen == 0 || ((prev.address ^ item.address) >> (max_prefixlen - prev.prefixlen)) == 0) {
+                continue;
+            }
+        }
+        items[top++] = item;
+        while (top >= 2) {
+            auto& lhs = items[top - 2];
+            const auto& rhs = items[top - 1];
+            if (lhs.prefixlen != rhs.prefixlen || rhs.prefixlen == 0) {
+                break;
+            }
+            const auto bit = UInt(1) << (max_prefixlen - rhs.prefixlen);
+            if ((lhs.address & bit) != 0 || (lhs.address | bit) != rhs.address) {
+                break;
+            }
+            --lhs.prefixlen;
+            --top;
+        }
+    }
+    return top;
+}
+
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE uint32_t collapse_key_low(uint32_t value) IPADDRESS_NOEXCEPT {
+    return value;
+}
+
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE uint32_t collapse_key_low(const uint128_t& value) IPADDRESS_NOEXCEPT {
+    return uint32_t(value.lower());
+}
+
+// Below this many items per thread, starting threads costs more than it saves
+constexpr size_t parallel_min_partition_size = 16384;
+
+// Runs task(0) .. task(count - 1) one after another on the calling thread. The overloads
+// in parallel.hpp pass a runner that spreads the tasks over several threads instead.
+struct serial_runner {
+    template <typename Task>
+    IPADDRESS_FORCE_INLINE void operator()(size_t count, const Task& task) const {
+        for (size_t i = 0; i < count; ++i) {
+            task(i);
+        }
+    }
+};
+
+constexpr size_t collapse_buckets_count = 1 << 16;
+
+// Scatters the items into temp by bucket and returns the offset of every bucket, followed by
+// the size. The buckets are cut on the 16 bits that follow the prefix common to all items,
+// so that the split is fine enough even for feeds concentrated in a single block.
+template <typename UInt>
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE std::vector<size_t> collapse_buckets(const collapse_item<UInt>* items, collapse_item<UInt>* temp, size_t size, uint32_t max_prefixlen) {
+    UInt diff = 0;
+    for (size_t i = 0; i < size; ++i) {
+        diff |= items[i].address ^ items[0].address;
+    }
+    uint32_t common = 0;
+    while (common < max_prefixlen - 16 && ((diff >> (max_prefixlen - 1 - common)) & 1) == 0) {
+        ++common;
+    }
+    const auto shift = max_prefixlen - 16 - common;
+
+    std::vector<size_t> offsets(collapse_buckets_count + 1, 0);
+    for (size_t i = 0; i < size; ++i) {
+        ++offsets[(collapse_key_low(items[i].address >> shift) & 0xFFFF) + 1];
+    }
+    for (size_t i = 1; i <= collapse_buckets_count; ++i) {
+        offsets[i] += offsets[i - 1];
+    }
+    std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < size; ++i) {
+        temp[next[collapse_key_low(items[i].address >> shift) & 0xFFFF]++] = items[i];
+    }
+    return offsets;
+}
+
+// Groups the buckets into at most the given number of consecutive ranges with about
+// size / partitions items each and returns the indices of the first bucket of every range,
+// followed by the number of buckets.
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE std::vector<size_t> collapse_bucket_bounds(const std::vector<size_t>& offsets, size_t partitions) {
+    const auto size = offsets.back();
+    std::vector<size_t> bounds(1, 0);
+    for (size_t i = 1, part = 1; i < collapse_buckets_count && part < partitions; ++i) {
+        if (offsets[i] >= size * part / partitions) {
+            if (offsets[i] != offsets[bounds.back()]) {
+                bounds.push_back(i);
+            }
+            ++part;
+        }
+    }
+    bounds.push_back(collapse_buckets_count);
+    return bounds;
+}
+
+// Splits the items into address ranges and collapses the ranges on separate threads.
+// The ranges are made of whole buckets, and each range is sorted and collapsed on its own; since the ranges are ordered, concatenating
+// their results keeps the order and a final sweep merges what crosses the range boundaries
+// (prefixes shorter than the cut and siblings on both sides of it). The minimal cover
+// of a set of prefixes is unique, so the result is the same as the serial one.
+template <size_t KeySize, typename Runner, typename UInt>
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_t collapse_parallel(std::vector<collapse_item<UInt>>& items, std::vector<collapse_item<UInt>>& temp, uint32_t max_prefixlen, size_t partitions) {
+    temp.resize(items.size());
+    const auto offsets = collapse_buckets(items.data(), temp.data(), items.size(), max_prefixlen);
+    const auto bounds = collapse_bucket_bounds(offsets, partitions);
+
+    const auto count = bounds.size() - 1;
+    std::vector<collapse_item<UInt>*> results(count);
+    std::vector<size_t> sizes(count);
+    Runner{}(count, [&](size_t index) {
+        const auto first = offsets[bounds[index]];
+        const auto length = offsets[bounds[index + 1]] - first;
+        std::vector<size_t> counts((KeySize + 1) * 256);
+        auto* sorted = collapse_sort<KeySize>(temp.data() + first, items.data() + first, length, counts.data());
+        results[index] = sorted;
+        sizes[index] = collapse_sorted(sorted, length, max_prefixlen);
+    });
+
+    // A range sorted back into items only moves left, and not at all while nothing
+    // before it has shrunk; std::copy does not allow the destination to be the source.
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (results[i] != items.data() + total) {
+            std::copy(results[i], results[i] + sizes[i], items.data() + total);
+        }
+        total += sizes[i];
+    }
+    return collapse_sorted(items.data(), total, max_prefixlen);
+}
+
 template <size_t N, typename It>
 IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE auto fixed_collapse_addresses(It first, It last, error_code& code) IPADDRESS_NOEXCEPT
     -> fixed_vector<typename std::iterator_traits<It>::value_type, N> {
@@ -250,100 +576,55 @@ IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE auto fixed_collap
     return result;
 }
 
-template <typename Result, typename It>
-IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE Result runtime_collapse_addresses(It first, It last, error_code& code) IPADDRESS_NOEXCEPT {
+template <typename Result, typename Runner, typename It>
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE Result runtime_collapse_addresses(It first, It last, collapse_buffer<typename std::iterator_traits<It>::value_type>& buffer, size_t threads, error_code& code) IPADDRESS_NOEXCEPT {
     using network_type = typename std::iterator_traits<It>::value_type;
-    using address_type = typename network_type::ip_address_type;
+    using traits = collapse_traits<network_type>;
 
     Result result;
     if (first == last) {
         return result;
     }
-    
+
     const auto version = first->version();
-    const auto max_prefixlen = version == ip_version::V4
+    const auto max_prefixlen = uint32_t(version == ip_version::V4
         ? ipv4_network::base_max_prefixlen
-        : ipv6_network::base_max_prefixlen;
-
-    std::vector<network_type> nets;
-    std::set<address_type> ips;
-    std::map<network_type, network_type> subnets;
+        : ipv6_network::base_max_prefixlen);
 
+    auto& items = buffer._items;
+    items.clear();
     for (auto it = first; it != last; ++it) {
         const auto& net = *it;
         if (net.version() != version) {
             code = error_code::invalid_version;
             return {};
         }
-        if (net.prefixlen() != max_prefixlen) {
-            nets.emplace_back(net);
-        } else {
-            const auto network_address = net.network_address();
-            ips.insert(network_address);
-        }
+        items.push_back({ traits::key(net), uint32_t(net.prefixlen()) });
     }
-    if (!ips.empty()) {
-        auto it = ips.begin();
-        auto first = *it;
-        auto last = *it++;
-        auto lastUint = (typename network_type::uint_type) last;
-        for (; it != ips.end(); ++it) {
-            const auto ipUint = (typename network_type::uint_type) *it;
-            if (ipUint != lastUint + 1) {
-                auto range = summarize_address_range(first, last, code);
-                if (code != error_code::no_error) {
-                    return {};
-                }
-                for (const auto& net : range) {
-                    nets.emplace_back(net);
-                }
-                first = *it;
-            }
-            last = *it;
-            lastUint = ipUint;
-        }
-        auto range = summarize_address_range(first, last, code);
-        if (code != error_code::no_error) {
-            return {};
-        }
-        for (const auto& net : range) {
-            nets.emplace_back(net);
-        }
-    }
-    while (!nets.empty()) {
-        const auto net = nets.back();
-        const auto supernet = net.supernet();
-        nets.pop_back();
-        auto existing = subnets.find(supernet);
-        if (existing != subnets.end()) {
-            subnets.erase(existing);
-            nets.emplace_back(supernet);
-        } else {
-            subnets.emplace(std::make_pair(supernet, net));
-        }
+
+    const auto partitions = threads < items.size() / parallel_min_partition_size ? threads : items.size() / parallel_min_partition_size;
+
+    size_t size = 0;
+    if (partitions > 1) {
+        size = collapse_parallel<traits::key_size, Runner>(items, buffer._temp, max_prefixlen, partitions);
+    } else {
+        collapse_sort<traits::key_size>(items, buffer._temp, buffer._counts);
+        size = collapse_sorted(items.data(), items.size(), max_prefixlen);
     }
-    if (!subnets.empty()) {
-        std::vector<network_type> subnet_values;
-        subnet_values.reserve(subnets.size());
-        for (auto it = subnets.begin(); it != subnets.end(); ++it) {
-            subnet_values.emplace_back(it->second);
-        }
-        std::sort(subnet_values.begin(), subnet_values.end());
-        auto it = subnet_values.begin();
-        auto last = *it;
-        result.emplace_back(last);
-        ++it;
-        for (; it != subnet_values.end(); ++it) {
-            if (last.broadcast_address() >= it->broadcast_address()) {
-                continue;
-            }
-            last = *it;
-            result.emplace_back(last);
-        }
+
+    result.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+        result.emplace_back(traits::network(version, items[i].address, items[i].prefixlen));
     }
     return result;
 }
 
+template <typename Result, typename It>
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE Result runtime_collapse_addresses(It first, It last, error_code& code) IPADDRESS_NOEXCEPT {
+    collapse_buffer<typename std::iterator_traits<It>::value_type> buffer;
+    return runtime_collapse_addresses<Result, serial_runner>(first, last, buffer, 1, code);
+}
+
 template <size_t N, typename It>
 IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE auto collapse_addresses(It first, It last, error_code& code) IPADDRESS_NOEXCEPT
     -> fixed_vector<typename std::iterator_traits<It>::value_type, N> {
@@ -361,8 +642,291 @@ IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE auto collapse_add
         : runtime_collapse_addresses<result_type>(first, last, code);
 }
 
+template <typename>
+struct sort_traits;
+
+template <>
+struct sort_traits<ipv4_address> {
+    using uint_type = uint32_t;
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE ip_version version(const ipv4_address& /*address*/) IPADDRESS_NOEXCEPT {
+        return ip_version::V4;
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE collapse_item<uint_type> item(const ipv4_address& address) IPADDRESS_NOEXCEPT {
+        return { address.to_uint(), 0 };
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE bool has_scope(const ipv4_address& /*address*/) IPADDRESS_NOEXCEPT {
+        return false;
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE ipv4_address value(ip_version /*version*/, const collapse_item<uint_type>& item) IPADDRESS_NOEXCEPT {
+        return ipv4_address::from_uint(item.address);
+    }
+};
+
+template <>
+struct sort_traits<ipv6_address> {
+    using uint_type = uint128_t;
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE ip_version version(const ipv6_address& /*address*/) IPADDRESS_NOEXCEPT {
+        return ip_version::V6;
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE collapse_item<uint_type> item(const ipv6_address& address) IPADDRESS_NOEXCEPT {
+        return { address.to_uint(), 0 };
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE bool has_scope(const ipv6_address& address) IPADDRESS_NOEXCEPT {
+        return address.get_scope_id().has_string();
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE ipv6_address value(ip_version /*version*/, const collapse_item<uint_type>& item) IPADDRESS_NOEXCEPT {
+        return ipv6_address::from_uint(item.address);
+    }
+};
+
+template <>
+struct sort_traits<ip_address> {
+    using uint_type = uint128_t;
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE ip_version version(const ip_address& address) IPADDRESS_NOEXCEPT {
+        return address.version();
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE collapse_item<uint_type> item(const ip_address& address) IPADDRESS_NOEXCEPT {
+        return { address.to_uint128(), 0 };
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE bool has_scope(const ip_address& address) IPADDRESS_NOEXCEPT {
+        return address.get_scope_id().has_string();
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE ip_address value(ip_version version, const collapse_item<uint_type>& item) IPADDRESS_NOEXCEPT {
+        return version == ip_version::V4
+            ? ip_address(ipv4_address::from_uint(uint32_t(item.address.lower())))
+            : ip_address(ipv6_address::from_uint(item.address));
+    }
+};
+
+template <typename Net>
+struct sort_network_traits {
+    using uint_type = typename collapse_traits<Net>::uint_type;
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE ip_version version(const Net& net) IPADDRESS_NOEXCEPT {
+        return net.version();
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE collapse_item<uint_type> item(const Net& net) IPADDRESS_NOEXCEPT {
+        return { collapse_traits<Net>::key(net), uint32_t(net.prefixlen()) };
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE bool has_scope(const Net& net) IPADDRESS_NOEXCEPT {
+        return sort_traits<typename Net::ip_address_type>::has_scope(net.network_address());
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE Net value(ip_version version, const collapse_item<uint_type>& item) IPADDRESS_NOEXCEPT {
+        return collapse_traits<Net>::network(version, item.address, item.prefixlen);
+    }
+};
+
+template <>
+struct sort_traits<ipv4_network> : sort_network_traits<ipv4_network> {
+};
+
+template <>
+struct sort_traits<ipv6_network> : sort_network_traits<ipv6_network> {
+};
+
+template <>
+struct sort_traits<ip_network> : sort_network_traits<ip_network> {
+};
+
+// Sorts items in place with an MSD radix sort that adapts to the data: every level splits
+// on the 8 bits below the highest bit in which the addresses still differ, so constant
+// parts of the keys cost nothing. Items with equal addresses are ordered by prefix length,
+// and small groups are left to std::sort.
+template <typename UInt>
+void sort_bucket(collapse_item<UInt>* items, collapse_item<UInt>* temp, size_t size) {
+    if (size <= 32) {
+        std::sort(items, items + size, collapse_item_less<UInt>);
+        return;
+    }
+    UInt diff = 0;
+    for (size_t i = 1; i < size; ++i) {
+        diff |= items[i].address ^ items[0].address;
+    }
+    if (diff == 0) {
+        std::sort(items, items + size, collapse_item_less<UInt>);
+        return;
+    }
+    const auto top = uint32_t(bit_length(diff));
+    const auto shift = top > 8 ? top - 8 : 0;
+
+    size_t offsets[257] = {};
+    for (size_t i = 0; i < size; ++i) {
+        ++offsets[(collapse_key_low(items[i].address >> shift) & 0xFF) + 1];
+    }
+    for (size_t i = 1; i <= 256; ++i) {
+        offsets[i] += offsets[i - 1];
+    }
+    size_t next[256];
+    std::copy(offsets, offsets + 256, next);
+    for (size_t i = 0; i < size; ++i) {
+        temp[next[collapse_key_low(items[i].address >> shift) & 0xFF]++] = items[i];
+    }
+    std::copy(temp, temp + size, items);
+    for (size_t i = 0; i < 256; ++i) {
+        const auto length = offsets[i + 1] - offsets[i];
+        if (length > 1) {
+            sort_bucket(items + offsets[i], temp + offsets[i], length);
+        }
+    }
+}
+
+// Above this many items, the IPv4 LSD sort falls behind the bucketed MSD sort
+constexpr size_t sort_lsd_max_size = 1 << 21;
+
+// Sorts a block of items of a single IP version. Large blocks are first scattered into
+// buckets as for collapsing, which leaves every bucket small enough to be sorted in cache
+// and gives the threads independent work: since the buckets are ordered, sorting each
+// of them in place sorts the whole block. On a single thread, IPv4 blocks that are not
+// much larger than the cache are sorted with the LSD sort, which needs only four passes
+// for them. Returns whichever of the two arrays holds the sorted items.
+template <typename Runner, typename UInt>
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE const collapse_item<UInt>* sort_block(collapse_item<UInt>* items, collapse_item<UInt>* temp, size_t size, uint32_t max_prefixlen, size_t threads) {
+    const auto partitions = threads < size / parallel_min_partition_size ? threads : size / parallel_min_partition_size;
+    if (partitions <= 1 && size < sort_lsd_max_size && max_prefixlen == ipv4_network::base_max_prefixlen) {
+        size_t counts[5 * 256];
+        return collapse_sort<4>(items, temp, size, counts);
+    }
+    if (size < collapse_buckets_count) {
+        sort_bucket(items, temp, size);
+        return items;
+    }
+    const auto offsets = collapse_buckets(items, temp, size, max_prefixlen);
+    const auto bounds = collapse_bucket_bounds(offsets, partitions);
+    Runner{}(bounds.size() - 1, [&](size_t index) {
+        for (size_t bucket = bounds[index]; bucket < bounds[index + 1]; ++bucket) {
+            const auto first = offsets[bucket];
+            sort_bucket(temp + first, items + first, offsets[bucket + 1] - first);
+        }
+    });
+    return temp;
+}
+
+// Sorts the values by their numeric keys. The keys are gathered into (address, prefixlen)
+// items with IPv4 values packed at the front and IPv6 values at the back, so that each
+// version is radix sorted on its own and the result keeps the IPv4-before-IPv6 order of
+// operator<. The scope id takes part in the ordering of IPv6 addresses but is not part of
+// the key, so inputs that carry scope ids are left to the comparison sort.
+template <typename Runner, typename It>
+IPADDRESS_FORCE_INLINE void sort_addresses(It first, It last, size_t threads) {
+    using value_type = typename std::iterator_traits<It>::value_type;
+    using traits = sort_traits<value_type>;
+    using item_type = collapse_item<typename traits::uint_type>;
+
+    const auto size = size_t(std::distance(first, last));
+    if (size < 2) {
+        return;
+    }
+
+    std::vector<item_type> items(size);
+    size_t lower = 0;
+    size_t upper = size;
+    for (auto it = first; it != last; ++it) {
+        const auto& value = *it;
+        if (traits::has_scope(value)) {
+            std::sort(first, last);
+            return;
+        }
+        if (traits::version(value) == ip_version::V4) {
+            items[lower++] = traits::item(value);
+        } else {
+            items[--upper] = traits::item(value);
+        }
+    }
+
+    std::vector<item_type> temp(size);
+    const auto* ipv4 = sort_block<Runner>(items.data(), temp.data(), lower, uint32_t(ipv4_network::base_max_prefixlen), threads);
+    const auto* ipv6 = sort_block<Runner>(items.data() + lower, temp.data() + lower, size - lower, uint32_t(ipv6_network::base_max_prefixlen), threads);
+
+    auto it = first;
+    for (size_t i = 0; i < lower; ++i, ++it) {
+        *it = traits::value(ip_version::V4, ipv4[i]);
+    }
+    for (size_t i = 0; i < size - lower; ++i, ++it) {
+        *it = traits::value(ip_version::V6, ipv6[i]);
+    }
+}
+
 } // namespace IPADDRESS_NAMESPACE::internal
 
+/**
+ * Reusable scratch memory for collapsing networks.
+ * 
+ * `collapse_addresses` converts the input networks into a flat array of (address, prefix length)
+ * pairs, sorts it and merges neighbours in place. By default this memory is allocated on every
+ * call; passing the same buffer to consecutive calls lets them reuse the allocations, which
+ * matters when large prefix lists are collapsed over and over again.
+ * 
+ * Example:
+ * @code{.cpp}
+ *   collapse_buffer<ipv4_network> buffer;
+ *   buffer.reserve(feed.size());
+ *   for (;;) {
+ *       const auto collapsed = collapse_addresses(feed.begin(), feed.end(), buffer);
+ *       // ...
+ *   }
+ * @endcode
+ * 
+ * @tparam Net The type of the IP network (ipv4_network, ipv6_network or ip_network).
+ */
+IPADDRESS_EXPORT template <typename Net>
+class collapse_buffer final {
+public:
+    using value_type = Net; /**< The type of the networks collapsed with this buffer. */
+
+    /**
+     * Reserves memory for collapsing the specified number of networks.
+     * 
+     * @param[in] count The number of networks.
+     */
+    IPADDRESS_FORCE_INLINE void reserve(size_t count) {
+        _items.reserve(count);
+        _temp.reserve(count);
+    }
+
+    /**
+     * Retrieves the number of networks that can be collapsed without reallocation.
+     * 
+     * @return The capacity of the buffer.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_t capacity() const IPADDRESS_NOEXCEPT {
+        return _items.capacity() < _temp.capacity() ? _items.capacity() : _temp.capacity();
+    }
+
+    /**
+     * Releases the memory held by the buffer.
+     */
+    IPADDRESS_FORCE_INLINE void clear() IPADDRESS_NOEXCEPT {
+        std::vector<item_type>().swap(_items);
+        std::vector<item_type>().swap(_temp);
+        std::vector<size_t>().swap(_counts);
+    }
+
+private:
+    using item_type = internal::collapse_item<typename internal::collapse_traits<Net>::uint_type>;
+
+    template <typename Result, typename Runner, typename It>
+    friend Result internal::runtime_collapse_addresses(It first, It last, collapse_buffer<typename std::iterator_traits<It>::value_type>& buffer, size_t threads, error_code& code) IPADDRESS_NOEXCEPT;
+
+    std::vector<item_type> _items;
+    std::vector<item_type> _temp;
+    std::vector<size_t> _counts;
+};
+
 /**
  * Summarizes an IP address range into the smallest set of contiguous network blocks.
  *
@@ -458,6 +1022,93 @@ IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE auto summarize_ad
     return result;
 }
 
+/**
+ * Summarizes many IP address ranges into network blocks at once.
+ *
+ * For every `(first, last)` pair of the input, writes the minimal list of networks covering
+ * that range to \a out, in ascending order, exactly as summarize_address_range() would.
+ * The networks are produced directly into the output without constructing an iterator per
+ * range, which makes this the preferred way to convert large range files such as GeoIP or
+ * ASN databases. A single IPv4 range yields at most 62 networks and an IPv6 range at most 254,
+ * which bounds the size of a preallocated output buffer.
+ *
+ * Example:
+ * @code{.cpp}
+ *   const std::pair<ipv4_address, ipv4_address> ranges[] = {
+ *       { ipv4_address::parse("192.0.2.0"), ipv4_address::parse("192.0.2.130") },
+ *       { ipv4_address::parse("198.51.100.0"), ipv4_address::parse("198.51.100.255") } };
+ *
+ *   std::vector<ipv4_network> nets;
+ *   error_code code{};
+ *   summarize_address_ranges(std::begin(ranges), std::end(ranges), std::back_inserter(nets), code);
+ *   if (code == error_code::no_error) {
+ *       for (const auto& net : nets) {
+ *           std::cout << net << std::endl;
+ *       }
+ *   }
+ *
+ *   // out:
+ *   // 192.0.2.0/25
+ *   // 192.0.2.128/31
+ *   // 192.0.2.130/32
+ *   // 198.51.100.0/24
+ * @endcode
+ *
+ * @tparam InputIt The type of the input iterator. Its value type holds the first and last addresses of a range
+ *                 in the `first` and `second` members, like std::pair of ipv4_address, ipv6_address or ip_address.
+ * @tparam OutputIt The type of the output iterator accepting the corresponding network type.
+ * @param[in] first The beginning of the range of address pairs.
+ * @param[in] last The end of the range of address pairs.
+ * @param[out] out The beginning of the destination.
+ * @param[out] code A reference to an `error_code` object that will be set if the operation is not possible.
+ * @return The output iterator past the last written network. If an error occurs, processing stops at
+ *         the offending pair and the networks of the preceding pairs remain written.
+ */
+IPADDRESS_EXPORT template <typename InputIt, typename OutputIt>
+IPADDRESS_FORCE_INLINE OutputIt summarize_address_ranges(InputIt first, InputIt last, OutputIt out, error_code& code) {
+    using address_type = typename std::decay<decltype(first->first)>::type;
+    using traits = internal::summarize_range_traits<address_type>;
+
+    code = error_code::no_error;
+    for (; first != last; ++first) {
+        const auto& lower = first->first;
+        const auto& upper = first->second;
+        if (lower.version() != upper.version()) {
+            code = error_code::invalid_version;
+            return out;
+        }
+        if (lower > upper) {
+            code = error_code::last_address_must_be_greater_than_first;
+            return out;
+        }
+        out = traits::summarize(lower, upper, out);
+    }
+    return out;
+}
+
+/**
+ * Summarizes many IP address ranges into network blocks at once.
+ *
+ * Behaves like summarize_address_ranges(InputIt, InputIt, OutputIt, error_code&), but reports errors with exceptions.
+ *
+ * @tparam InputIt The type of the input iterator over pairs of addresses.
+ * @tparam OutputIt The type of the output iterator accepting the corresponding network type.
+ * @param[in] first The beginning of the range of address pairs.
+ * @param[in] last The end of the range of address pairs.
+ * @param[out] out The beginning of the destination.
+ * @return The output iterator past the last written network.
+ * @throw logic_error Thrown with a message corresponding to the error code.
+ */
+IPADDRESS_EXPORT template <typename InputIt, typename OutputIt>
+IPADDRESS_FORCE_INLINE OutputIt summarize_address_ranges(InputIt first, InputIt last, OutputIt out) {
+    error_code code = error_code::no_error;
+    out = summarize_address_ranges(first, last, out, code);
+    if (code != error_code::no_error) {
+        raise_error(code, 0, "", 0);
+    }
+    return out;
+}
+
 /**
  * Collapses a collection of IP networks into the smallest set of contiguous networks.
  * 
@@ -783,6 +1434,77 @@ IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE auto collapse_add
     return std::move(result);
 }
 
+/**
+ * Collapses a collection of IP networks into the smallest set of contiguous networks using caller-provided scratch memory.
+ * 
+ * Behaves like collapse_addresses(It, It, error_code&), but keeps its working memory in \a buffer,
+ * so repeated calls with the same buffer do not reallocate it.
+ * 
+ * @tparam It The type of the iterator.
+ * @param[in] first The beginning of the range of IP networks to be collapsed.
+ * @param[in] last The end of the range of IP networks to be collapsed.
+ * @param[in,out] buffer The scratch memory reused between calls.
+ * @param[out] code A reference to an `error_code` object that will be set if the operation is not possible.
+ * @return A container of collapsed networks.
+ */
+IPADDRESS_EXPORT template <typename It>
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE auto collapse_addresses(It first, It last, collapse_buffer<typename std::iterator_traits<It>::value_type>& buffer, error_code& code) IPADDRESS_NOEXCEPT
+    -> std::vector<typename std::iterator_traits<It>::value_type> {
+    return internal::runtime_collapse_addresses<std::vector<typename std::iterator_traits<It>::value_type>, internal::serial_runner>(first, last, buffer, 1, code);
+}
+
+/**
+ * Collapses a collection of IP networks into the smallest set of contiguous networks using caller-provided scratch memory.
+ * 
+ * Behaves like collapse_addresses(It, It), but keeps its working memory in \a buffer,
+ * so repeated calls with the same buffer do not reallocate it.
+ * 
+ * @tparam It The type of the iterator.
+ * @param[in] first The beginning of the range of IP networks to be collapsed.
+ * @param[in] last The end of the range of IP networks to be collapsed.
+ * @param[in,out] buffer The scratch memory reused between calls.
+ * @return A container of collapsed networks.
+ * @throw logic_error Thrown with a message corresponding to the error code.
+ */
+IPADDRESS_EXPORT template <typename It>
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE auto collapse_addresses(It first, It last, collapse_buffer<typename std::iterator_traits<It>::value_type>& buffer) IPADDRESS_NOEXCEPT_WHEN_NO_EXCEPTIONS
+    -> std::vector<typename std::iterator_traits<It>::value_type> {
+    error_code code = error_code::no_error;
+    auto result = collapse_addresses(first, last, buffer, code);
+    if (code != error_code::no_error) {
+        raise_error(code, 0, "", 0);
+    }
+    return result;
+}
+
+/**
+ * Sorts a range of IP addresses or networks in ascending order.
+ * 
+ * The result is the same as that of `std::sort` with `operator<`: addresses are ordered by
+ * their numeric value, networks by network address and then by prefix length, and for
+ * ip_address and ip_network all IPv4 values precede the IPv6 ones. Instead of comparing
+ * elements, the function runs a radix sort over the address bytes, which takes linear time
+ * and is several times faster on large inputs. Ranges that contain IPv6 values with a scope id
+ * are sorted with `std::sort`, since the scope id is not part of the numeric key.
+ * 
+ * Example:
+ * @code{.cpp}
+ *   std::vector<ip_network> nets = load_prefixes();
+ *   sort_addresses(nets.begin(), nets.end());
+ *   nets.erase(std::unique(nets.begin(), nets.end()), nets.end());
+ * @endcode
+ * 
+ * @tparam RandomIt The type of the iterator.
+ * @param[in,out] first The beginning of the range of IP addresses or networks to be sorted.
+ * @param[in,out] last The end of the range of IP addresses or networks to be sorted.
+ * @remark The name differs from `std::sort` on purpose: an unqualified `sort` call on standard
+ *         container iterators would otherwise find both functions through argument-dependent lookup.
+ */
+IPADDRESS_EXPORT template <typename RandomIt>
+IPADDRESS_FORCE_INLINE void sort_addresses(RandomIt first, RandomIt last) {
+    internal::sort_addresses<internal::serial_runner>(first, last, 1);
+}
+
 } // namespace IPADDRESS_NAMESPACE
 
 #endif // IPADDRESS_IP_FUNCTIONS_HPP
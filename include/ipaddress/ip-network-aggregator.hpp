@@ -0,0 +1,499 @@
+/**
+ * @file      ip-network-aggregator.hpp
+ * @brief     Incrementally maintained collapsed set of IP networks
+ * @author    Vladimir Shaleev
+ * @copyright MIT License
+ *
+ * This file defines the ip_network_aggregator class template, which keeps the result of
+ * collapse_addresses up to date while networks are inserted and erased one at a time.
+ * Networks are stored in a binary trie in which every node knows whether the address space
+ * below it is fully covered and how many collapsed networks its subtree yields, so that an
+ * update only has to revisit the nodes on the path of the changed prefix.
+ */
+
+#ifndef IPADDRESS_IP_NETWORK_AGGREGATOR_HPP
+#define IPADDRESS_IP_NETWORK_AGGREGATOR_HPP
+
+#include "ip-prefix-table.hpp"
+
+namespace IPADDRESS_NAMESPACE {
+
+namespace internal {
+
+// Keeps the first offset bits of the key, sets the bit at offset and clears the rest.
+IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE prefix_key prefix_key_child(const prefix_key& key, size_t offset, uint32_t bit) IPADDRESS_NOEXCEPT {
+    return offset < 64
+        ? prefix_key { (key.hi & ~(~uint64_t(0) >> offset)) | (uint64_t(bit) << (63 - offset)), 0 }
+        : prefix_key { key.hi, (key.lo & ~(~uint64_t(0) >> (offset - 64))) | (uint64_t(bit) << (127 - offset)) };
+}
+
+// A node is full when the whole address space below it is covered, i.e. when the prefix
+// itself was inserted or both halves are full. The collapsed set is formed by the full
+// nodes without a full ancestor, and cover counts them in the subtree of every node.
+class aggregate_trie {
+public:
+    static constexpr uint32_t npos = 0xFFFFFFFF;
+
+    IPADDRESS_FORCE_INLINE aggregate_trie() : _nodes(1) {
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_t size() const IPADDRESS_NOEXCEPT {
+        return _nodes[0].cover;
+    }
+
+    IPADDRESS_FORCE_INLINE void clear() {
+        _nodes.assign(1, node());
+        _free.clear();
+    }
+
+    IPADDRESS_FORCE_INLINE void insert(const prefix_key& key, size_t prefixlen) {
+        uint32_t path[129];
+        uint32_t index = 0;
+        for (size_t depth = 0; depth < prefixlen; ++depth) {
+            path[depth] = index;
+            const auto bit = prefix_key_bit(key, depth);
+            auto child = _nodes[index].child[bit];
+            if (child == npos) {
+                child = allocate_node();
+                _nodes[index].child[bit] = child;
+            }
+            index = child;
+        }
+        ++_nodes[index].count;
+        path[prefixlen] = index;
+        update(path, prefixlen);
+    }
+
+    IPADDRESS_FORCE_INLINE bool erase(const prefix_key& key, size_t prefixlen) {
+        uint32_t path[129];
+        uint32_t index = 0;
+        for (size_t depth = 0; depth < prefixlen; ++depth) {
+            path[depth] = index;
+            index = _nodes[index].child[prefix_key_bit(key, depth)];
+            if (index == npos) {
+                return false;
+            }
+        }
+        if (_nodes[index].count == 0) {
+            return false;
+        }
+        --_nodes[index].count;
+        auto depth = prefixlen;
+        for (; depth > 0; --depth) {
+            const auto& current = _nodes[index];
+            if (current.count != 0 || current.child[0] != npos || current.child[1] != npos) {
+                break;
+            }
+            const auto parent = path[depth - 1];
+            _nodes[parent].child[prefix_key_bit(key, depth - 1)] = npos;
+            _free.push_back(index);
+            index = parent;
+        }
+        path[depth] = index;
+        update(path, depth);
+        return true;
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool contains(const prefix_key& key, size_t max_prefixlen) const IPADDRESS_NOEXCEPT {
+        uint32_t index = 0;
+        for (size_t depth = 0;; ++depth) {
+            const auto& current = _nodes[index];
+            if (current.full) {
+                return true;
+            }
+            if (depth == max_prefixlen) {
+                return false;
+            }
+            index = current.child[prefix_key_bit(key, depth)];
+            if (index == npos) {
+                return false;
+            }
+        }
+    }
+
+    // Moves (key, prefixlen) to the first collapsed network in address order.
+    // Returns false if there is none.
+    IPADDRESS_FORCE_INLINE bool first(prefix_key& key, size_t& prefixlen) const IPADDRESS_NOEXCEPT {
+        if (_nodes[0].cover == 0) {
+            return false;
+        }
+        key = prefix_key { 0, 0 };
+        prefixlen = 0;
+        descend(0, key, prefixlen);
+        return true;
+    }
+
+    // Moves (key, prefixlen) from a collapsed network to the next one in address order.
+    // Returns false if it was the last one.
+    IPADDRESS_FORCE_INLINE bool next(prefix_key& key, size_t& prefixlen) const IPADDRESS_NOEXCEPT {
+        uint32_t path[129];
+        uint32_t index = 0;
+        for (size_t depth = 0; depth < prefixlen; ++depth) {
+            path[depth] = index;
+            index = _nodes[index].child[prefix_key_bit(key, depth)];
+        }
+        for (auto depth = prefixlen; depth > 0; --depth) {
+            const auto& parent = _nodes[path[depth - 1]];
+            if (prefix_key_bit(key, depth - 1) == 0 && parent.child[1] != npos) {
+                key = prefix_key_child(key, depth - 1, 1);
+                prefixlen = depth;
+                descend(parent.child[1], key, prefixlen);
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    struct node {
+        uint32_t child[2] { npos, npos };
+        uint32_t count {};
+        uint32_t cover {};
+        bool full {};
+    };
+
+    IPADDRESS_FORCE_INLINE uint32_t allocate_node() {
+        if (!_free.empty()) {
+            const auto index = _free.back();
+            _free.pop_back();
+            _nodes[index] = node();
+            return index;
+        }
+        _nodes.emplace_back();
+        return uint32_t(_nodes.size() - 1);
+    }
+
+    // Every node that is kept in the trie has a full node below it, since empty
+    // leaves are removed on erase, so the leftmost full node is always found.
+    IPADDRESS_FORCE_INLINE void descend(uint32_t index, prefix_key& key, size_t& prefixlen) const IPADDRESS_NOEXCEPT {
+        while (!_nodes[index].full) {
+            const auto bit = _nodes[index].child[0] != npos ? 0 : 1;
+            key = prefix_key_child(key, prefixlen, uint32_t(bit));
+            index = _nodes[index].child[bit];
+            ++prefixlen;
+        }
+    }
+
+    IPADDRESS_FORCE_INLINE void update(const uint32_t* path, size_t depth) IPADDRESS_NOEXCEPT {
+        for (auto i = depth + 1; i > 0; --i) {
+            auto& current = _nodes[path[i - 1]];
+            const auto* lhs = current.child[0] != npos ? &_nodes[current.child[0]] : nullptr;
+            const auto* rhs = current.child[1] != npos ? &_nodes[current.child[1]] : nullptr;
+            const auto full = current.count != 0 || (lhs && rhs && lhs->full && rhs->full);
+            const auto cover = full ? 1 : (lhs ? lhs->cover : 0) + (rhs ? rhs->cover : 0);
+            if (i <= depth && full == current.full && cover == current.cover) {
+                break;
+            }
+            current.full = full;
+            current.cover = cover;
+        }
+    }
+
+    std::vector<node> _nodes;
+    std::vector<uint32_t> _free;
+};
+
+template <typename Net>
+struct aggregator_traits;
+
+template <>
+struct aggregator_traits<ipv4_network> : prefix_table_traits<ipv4_network> {
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE ipv4_network network(size_t /*trie*/, const prefix_key& key, size_t prefixlen) IPADDRESS_NOEXCEPT {
+        error_code code = error_code::no_error;
+        return ipv4_network::from_address(ipv4_address::from_uint(uint32_t(key.hi >> 32)), code, prefixlen);
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE size_t max_prefixlen(size_t /*trie*/) IPADDRESS_NOEXCEPT {
+        return ipv4_address::base_max_prefixlen;
+    }
+};
+
+template <>
+struct aggregator_traits<ipv6_network> : prefix_table_traits<ipv6_network> {
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE ipv6_network network(size_t /*trie*/, const prefix_key& key, size_t prefixlen) IPADDRESS_NOEXCEPT {
+        error_code code = error_code::no_error;
+        return ipv6_network::from_address(ipv6_address::from_uint(uint128_t(key.hi, key.lo)), code, prefixlen);
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE size_t max_prefixlen(size_t /*trie*/) IPADDRESS_NOEXCEPT {
+        return ipv6_address::base_max_prefixlen;
+    }
+};
+
+template <>
+struct aggregator_traits<ip_network> : prefix_table_traits<ip_network> {
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE ip_network network(size_t trie, const prefix_key& key, size_t prefixlen) IPADDRESS_NOEXCEPT {
+        return trie == 0
+            ? ip_network(aggregator_traits<ipv4_network>::network(trie, key, prefixlen))
+            : ip_network(aggregator_traits<ipv6_network>::network(trie, key, prefixlen));
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE size_t max_prefixlen(size_t trie) IPADDRESS_NOEXCEPT {
+        return trie == 0 ? ipv4_address::base_max_prefixlen : ipv6_address::base_max_prefixlen;
+    }
+};
+
+} // namespace IPADDRESS_NAMESPACE::internal
+
+/**
+ * Maintains the collapsed form of a changing collection of IP networks.
+ *
+ * The aggregator holds a multiset of networks and, at any moment, exposes the same sorted list
+ * of networks that collapse_addresses would produce for it. Inserting or erasing a network costs
+ * O(prefix length), independent of the number of networks held, which makes the aggregator suitable
+ * for following route churn without recollapsing the entire table on every change.
+ *
+ * Networks are counted: a network inserted twice stays in the result until it has been erased twice.
+ * Erasing only removes previously inserted networks; it does not carve address space out of larger ones.
+ * The scope id of IPv6 addresses is not taken into account.
+ *
+ * @code{.cpp}
+ *   ip_network_aggregator<ipv4_network> aggregator;
+ *   aggregator.insert(ipv4_network::parse("192.0.2.0/25"));
+ *   aggregator.insert(ipv4_network::parse("192.0.2.128/25"));
+ *   for (const auto& net : aggregator) {
+ *       std::cout << net << std::endl; // 192.0.2.0/24
+ *   }
+ *   aggregator.erase(ipv4_network::parse("192.0.2.0/25"));
+ *   for (const auto& net : aggregator) {
+ *       std::cout << net << std::endl; // 192.0.2.128/25
+ *   }
+ * @endcode
+ * @tparam Net the network type: ipv4_network, ipv6_network or ip_network.
+ */
+IPADDRESS_EXPORT template <typename Net>
+class ip_network_aggregator {
+    using traits = internal::aggregator_traits<Net>;
+
+public:
+    using network_type = Net; /**< The network type. */
+    using address_type = typename Net::ip_address_type; /**< The address type of the networks. */
+    using value_type   = Net; /**< The type of the collapsed networks. */
+    using size_type    = size_t; /**< An unsigned integer type. */
+
+    /**
+     * A forward iterator over the collapsed networks in ascending order.
+     *
+     * The iterator is invalidated by any modification of the aggregator.
+     */
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag; /**< The category of the iterator. */
+        using value_type        = Net; /**< The type of the values iterated over. */
+        using difference_type   = std::ptrdiff_t; /**< The type representing the difference between two iterators. */
+        using pointer           = const value_type*; /**< The pointer type of the iterated values. */
+        using reference         = const value_type&; /**< The reference type of the iterated values. */
+
+        /**
+         * Default constructor.
+         */
+        const_iterator() = default;
+
+        /**
+         * Dereference operator.
+         *
+         * @return A reference to the current network.
+         */
+        IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE reference operator*() const IPADDRESS_NOEXCEPT {
+            return _current;
+        }
+
+        /**
+         * Member access operator.
+         *
+         * @return A pointer to the current network.
+         */
+        IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE pointer operator->() const IPADDRESS_NOEXCEPT {
+            return &_current;
+        }
+
+        /**
+         * Pre-increment operator.
+         *
+         * @return A reference to the incremented iterator.
+         */
+        IPADDRESS_FORCE_INLINE const_iterator& operator++() IPADDRESS_NOEXCEPT {
+            if (!_tries[_trie].next(_key, _prefixlen)) {
+                ++_trie;
+                seek();
+            } else {
+                _current = traits::network(_trie, _key, _prefixlen);
+            }
+            return *this;
+        }
+
+        /**
+         * Post-increment operator.
+         *
+         * @return The iterator before the increment.
+         */
+        IPADDRESS_FORCE_INLINE const_iterator operator++(int) IPADDRESS_NOEXCEPT {
+            auto tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        /**
+         * Checks if two iterators are equal.
+         *
+         * @param[in] other The iterator to compare with.
+         * @return `true` if both iterators point to the same network, `false` otherwise.
+         */
+        IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool operator==(const const_iterator& other) const IPADDRESS_NOEXCEPT {
+            return _trie == other._trie && (_trie == traits::tries || (_prefixlen == other._prefixlen && _key.hi == other._key.hi && _key.lo == other._key.lo));
+        }
+
+        /**
+         * Checks if two iterators are not equal.
+         *
+         * @param[in] other The iterator to compare with.
+         * @return `true` if the iterators point to different networks, `false` otherwise.
+         */
+        IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool operator!=(const const_iterator& other) const IPADDRESS_NOEXCEPT {
+            return !(*this == other);
+        }
+
+    private:
+        friend class ip_network_aggregator;
+
+        IPADDRESS_FORCE_INLINE const_iterator(const internal::aggregate_trie* tries, size_t trie) IPADDRESS_NOEXCEPT : _tries(tries), _trie(trie) {
+            seek();
+        }
+
+        IPADDRESS_FORCE_INLINE void seek() IPADDRESS_NOEXCEPT {
+            for (; _trie < traits::tries; ++_trie) {
+                if (_tries[_trie].first(_key, _prefixlen)) {
+                    _current = traits::network(_trie, _key, _prefixlen);
+                    return;
+                }
+            }
+        }
+
+        const internal::aggregate_trie* _tries{};
+        size_t _trie{traits::tries};
+        internal::prefix_key _key{};
+        size_t _prefixlen{};
+        value_type _current{};
+    };
+
+    using iterator = const_iterator; /**< Iterator over the collapsed networks. */
+
+    /**
+     * Returns the number of networks in the collapsed result.
+     *
+     * @return The number of collapsed networks.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_type size() const IPADDRESS_NOEXCEPT {
+        size_type result = 0;
+        for (const auto& trie : _tries) {
+            result += trie.size();
+        }
+        return result;
+    }
+
+    /**
+     * Checks whether the aggregator holds no networks.
+     *
+     * @return `true` if the aggregator is empty, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool empty() const IPADDRESS_NOEXCEPT {
+        return size() == 0;
+    }
+
+    /**
+     * Returns an iterator to the first collapsed network.
+     *
+     * @return An iterator to the lowest collapsed network.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE const_iterator begin() const IPADDRESS_NOEXCEPT {
+        return const_iterator(_tries, 0);
+    }
+
+    /**
+     * Returns an iterator past the last collapsed network.
+     *
+     * @return An iterator past the highest collapsed network.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE const_iterator end() const IPADDRESS_NOEXCEPT {
+        return const_iterator(_tries, traits::tries);
+    }
+
+    /**
+     * Removes all networks from the aggregator.
+     */
+    IPADDRESS_FORCE_INLINE void clear() {
+        for (auto& trie : _tries) {
+            trie.clear();
+        }
+    }
+
+    /**
+     * Adds a network to the aggregator.
+     *
+     * @param[in] network the network to add.
+     */
+    IPADDRESS_FORCE_INLINE void insert(const network_type& network) {
+        const auto& address = network.network_address();
+        _tries[traits::index(address)].insert(traits::key(address), network.prefixlen());
+    }
+
+    /**
+     * Adds a range of networks to the aggregator.
+     *
+     * @tparam It the type of the iterator.
+     * @param[in] first the beginning of the range of networks.
+     * @param[in] last the end of the range of networks.
+     */
+    template <typename It>
+    IPADDRESS_FORCE_INLINE void insert(It first, It last) {
+        for (; first != last; ++first) {
+            insert(*first);
+        }
+    }
+
+    /**
+     * Removes one occurrence of a previously added network.
+     *
+     * @param[in] network the network to remove.
+     * @return `true` if the network was found and removed, `false` otherwise.
+     */
+    IPADDRESS_FORCE_INLINE bool erase(const network_type& network) {
+        const auto& address = network.network_address();
+        return _tries[traits::index(address)].erase(traits::key(address), network.prefixlen());
+    }
+
+    /**
+     * Removes one occurrence of each network in a range.
+     *
+     * @tparam It the type of the iterator.
+     * @param[in] first the beginning of the range of networks.
+     * @param[in] last the end of the range of networks.
+     * @return The number of networks that were found and removed.
+     */
+    template <typename It>
+    IPADDRESS_FORCE_INLINE size_type erase(It first, It last) {
+        size_type result = 0;
+        for (; first != last; ++first) {
+            result += erase(*first) ? 1 : 0;
+        }
+        return result;
+    }
+
+    /**
+     * Checks whether an address is covered by the networks held by the aggregator.
+     *
+     * @param[in] address the address to check.
+     * @return `true` if one of the collapsed networks contains the address, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool contains(const address_type& address) const IPADDRESS_NOEXCEPT {
+        const auto trie = traits::index(address);
+        return _tries[trie].contains(traits::key(address), traits::max_prefixlen(trie));
+    }
+
+private:
+    internal::aggregate_trie _tries[traits::tries];
+};
+
+} // namespace IPADDRESS_NAMESPACE
+
+#endif // IPADDRESS_IP_NETWORK_AGGREGATOR_HPP
@@ -573,6 +573,38 @@ public:
         return is_subnet_of(other, *this);
     }
 
+    /**
+     * Converts the network to a character sequence.
+     * 
+     * Writes the network address and the prefix length into the range [\a first, \a last)
+     * without allocating memory, similar to `std::to_chars`. No null terminator is written.
+     * If the range is too small, nothing is written and `nullptr` is returned.
+     * 
+     * @param[out] first The beginning of the output range.
+     * @param[in] last The end of the output range.
+     * @param[in] fmt The format to use for the string representation. *Defaults to format::compressed*.
+     * @return A pointer one past the last character written, or `nullptr` if the range is too small.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE char* to_chars(char* first, char* last, format fmt = format::compressed) const IPADDRESS_NOEXCEPT {
+        char res[ip_address_type::base_max_string_len + 5]{};
+        auto len = size_t(_network_address.to_chars(res, res + sizeof(res), fmt) - res);
+        res[len++] = '/';
+        if (_prefixlen >= 100) {
+            res[len++] = char('0' + _prefixlen / 100);
+        }
+        if (_prefixlen >= 10) {
+            res[len++] = char('0' + _prefixlen / 10 % 10);
+        }
+        res[len++] = char('0' + _prefixlen % 10);
+        if (size_t(last - first) < len) {
+            return nullptr;
+        }
+        for (size_t i = 0; i < len; ++i) {
+            first[i] = res[i];
+        }
+        return first + len;
+    }
+
     /**
      * Converts the network to a string representation.
      * 
@@ -583,7 +615,8 @@ public:
      * @return A string representation of the network.
      */
     IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE std::string to_string(format fmt = format::compressed) const {
-        return _network_address.to_string(fmt) + '/' + std::to_string(_prefixlen);
+        char res[ip_address_type::base_max_string_len + 5]{};
+        return std::string(res, to_chars(res, res + sizeof(res), fmt));
     }
 
     /**
@@ -953,6 +986,113 @@ public:
         return exclude_network_sequence<ip_network_base<Base>>(lhs, rhs);
     }
 
+    /**
+     * Computes the network definitions resulting from removing a collection of networks from this one.
+     *
+     * Unlike chaining the single-network overload, the excluded networks are sorted once and
+     * the gaps between them are summarized in a single sweep, so the cost grows as O(n log n)
+     * in the number of excluded networks. Excluded networks may overlap or repeat.
+     *
+     * @code{.cpp}
+     *   constexpr auto a = ipv4_network::parse("192.0.2.0/24");
+     *   const ipv4_network b[] = { ipv4_network::parse("192.0.2.64/26"), ipv4_network::parse("192.0.2.1/32") };
+     *
+     *   for (const auto& net : a.address_exclude(std::begin(b), std::end(b))) {
+     *      std::cout << net << std::endl;
+     *   }
+     *
+     *   // out:
+     *   // 192.0.2.0/32
+     *   // 192.0.2.2/31
+     *   // 192.0.2.4/30
+     *   // 192.0.2.8/29
+     *   // 192.0.2.16/28
+     *   // 192.0.2.32/27
+     *   // 192.0.2.128/25
+     * @endcode
+     * @tparam It The type of the iterator over the networks to exclude.
+     * @param[in] first The beginning of the range of networks to exclude.
+     * @param[in] last The end of the range of networks to exclude.
+     * @return The minimal list of networks covering the remaining addresses, in ascending order.
+     * @throw logic_error Raise if any of the networks is not completely contained in this network.
+     */
+    template <typename It>
+    IPADDRESS_NODISCARD_WHEN_NO_EXCEPTIONS IPADDRESS_FORCE_INLINE std::vector<ip_network_base<Base>> address_exclude(It first, It last) const IPADDRESS_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+        error_code code = error_code::no_error;
+        auto result = address_exclude(first, last, code);
+        if (code != error_code::no_error) {
+            raise_error(code, 0, "", 0);
+        }
+        return result;
+    }
+
+    /**
+     * Computes the network definitions resulting from removing a collection of networks from this one, with error handling.
+     *
+     * @code{.cpp}
+     *   constexpr auto a = ipv4_network::parse("192.0.2.0/24");
+     *   const ipv4_network b[] = { ipv4_network::parse("192.0.2.0/25"), ipv4_network::parse("192.0.2.192/26") };
+     *
+     *   auto err = error_code::no_error;
+     *   auto networks = a.address_exclude(std::begin(b), std::end(b), err);
+     *
+     *   if (err == error_code::no_error) {
+     *       for (const auto& net : networks) {
+     *          std::cout << net << std::endl;
+     *       }
+     *   }
+     *
+     *   // out:
+     *   // 192.0.2.128/26
+     * @endcode
+     * @tparam It The type of the iterator over the networks to exclude.
+     * @param[in] first The beginning of the range of networks to exclude.
+     * @param[in] last The end of the range of networks to exclude.
+     * @param[out] code An error_code object that will be set if an error occurs during the operation.
+     * @return The minimal list of networks covering the remaining addresses, in ascending order, or an empty list if an error occurs.
+     */
+    template <typename It>
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE std::vector<ip_network_base<Base>> address_exclude(It first, It last, error_code& code) const {
+        code = error_code::no_error;
+        const auto lhs = Base::remove_scope_id(*this);
+
+        std::vector<std::pair<uint_type, uint_type>> ranges;
+        for (; first != last; ++first) {
+            const auto rhs = Base::remove_scope_id(*first);
+            if (!rhs.subnet_of(lhs)) {
+                code = error_code::not_contained_network;
+                return {};
+            }
+            ranges.emplace_back(rhs.network_address().to_uint(), rhs.broadcast_address().to_uint());
+        }
+        std::sort(ranges.begin(), ranges.end(), [](const std::pair<uint_type, uint_type>& a, const std::pair<uint_type, uint_type>& b) {
+            return a.first < b.first;
+        });
+
+        std::vector<ip_network_base<Base>> result;
+        const auto append = [&result](const uint_type& from, const uint_type& to) {
+            for (const auto& net : summarize_sequence<ip_network_base<Base>>(ip_address_type::from_uint(from), ip_address_type::from_uint(to))) {
+                result.push_back(net);
+            }
+        };
+        auto cursor = lhs.network_address().to_uint();
+        const auto end = lhs.broadcast_address().to_uint();
+        for (const auto& range : ranges) {
+            if (range.second < cursor) {
+                continue;
+            }
+            if (cursor < range.first) {
+                append(cursor, range.first - 1);
+            }
+            if (range.second == end) {
+                return result;
+            }
+            cursor = range.second + 1;
+        }
+        append(cursor, end);
+        return result;
+    }
+
     /**
      * Generates a sequence of subnets from this network.
      * 
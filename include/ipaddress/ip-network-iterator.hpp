@@ -15,10 +15,33 @@
 #define IPADDRESS_IP_NETWORK_ITERATOR_HPP
 
 #include "config.hpp"
+#include "bits.hpp"
 #include "ip-address-iterator.hpp"
 
 namespace IPADDRESS_NAMESPACE {
 
+namespace internal {
+
+IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE size_t bit_length(uint32_t value) IPADDRESS_NOEXCEPT {
+    return 64 - countl_zero(uint64_t(value));
+}
+
+IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE size_t bit_length(const uint128_t& value) IPADDRESS_NOEXCEPT {
+    return value.upper() != 0 ? 128 - countl_zero(value.upper()) : 64 - countl_zero(value.lower());
+}
+
+IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE size_t count_righthand_zero_bits(uint32_t value, size_t bits) IPADDRESS_NOEXCEPT {
+    const size_t count = value != 0 ? countr_zero(uint64_t(value)) : bits;
+    return count < bits ? count : bits;
+}
+
+IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE size_t count_righthand_zero_bits(const uint128_t& value, size_t bits) IPADDRESS_NOEXCEPT {
+    const size_t count = value.lower() != 0 ? countr_zero(value.lower()) : value.upper() != 0 ? 64 + countr_zero(value.upper()) : bits;
+    return count < bits ? count : bits;
+}
+
+} // namespace IPADDRESS_NAMESPACE::internal
+
 /**
  * An iterator for traversing IP addresses within a network range.
  * 
@@ -774,38 +797,11 @@ public:
     }
 
 private:
-    IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE size_t bit_length(uint_type bits) IPADDRESS_NOEXCEPT {
-        size_t count = 0;
-        while (bits != 0) {
-            ++count;
-            bits >>= 1;
-        }
-        return count;
-    }
-
-    IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE size_t count_righthand_zero_bits(uint_type number, size_t bits) IPADDRESS_NOEXCEPT {
-        if (number == 0) {
-            return bits;
-        } else {
-            number = (~number & (number - 1));
-            size_t count = 0;
-            while (number != 0) {
-                count += size_t(number & 0x1);
-                number >>= 1;
-            }
-            if (bits < count) {
-                return bits;
-            } else {
-                return count;
-            }
-        }
-    }
-
     IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE void compute_network() IPADDRESS_NOEXCEPT {
         constexpr auto max_prefixlen = ip_address_type::base_max_prefixlen;
 
-        auto nbits = count_righthand_zero_bits(_current, max_prefixlen);
-        auto nbits_max = bit_length(_last - _current + 1) - 1;
+        auto nbits = internal::count_righthand_zero_bits(_current, max_prefixlen);
+        auto nbits_max = internal::bit_length(_last - _current + 1) - 1;
         _nbits = nbits < nbits_max ? nbits : nbits_max;
 
         const auto prefixlen = max_prefixlen - _nbits;
@@ -7,7 +7,8 @@
  * This file contains arrays of ipv4_network and ipv6_network objects representing
  * reserved IP address ranges, such as private networks and multicast addresses.
  * These constants are used to facilitate the identification and handling of these
- * special address ranges in network-related operations.
+ * special address ranges in network-related operations. At compile time they are
+ * also turned into lookup tables, which classify an address with a single lookup.
  */
 
 #ifndef IPADDRESS_IP_NETWORKS_HPP
@@ -261,6 +262,217 @@ IPADDRESS_NODISCARD constexpr IPADDRESS_FORCE_INLINE int array_size(const T (&)[
     return N;
 }
 
+// Rule kinds used while building the classifiers, on top of the address_flags bits
+enum : uint32_t {
+    classifier_flags = 0xFF,
+    classifier_private_exception = 0x100,
+    classifier_not_global = 0x200
+};
+
+struct classifier_rule {
+    uint8_t bytes[16];
+    size_t prefixlen;
+    uint32_t kinds;
+};
+
+template <size_t N>
+struct classifier_rules {
+    classifier_rule rules[N];
+    size_t count;
+
+    template <typename Net>
+    IPADDRESS_CONSTEXPR void add(const Net& net, uint32_t kinds) IPADDRESS_NOEXCEPT {
+        auto& rule = rules[count++];
+        const auto& bytes = net.network_address().bytes();
+        for (size_t i = 0; i < bytes.size(); ++i) {
+            rule.bytes[i] = bytes[i];
+        }
+        rule.prefixlen = net.prefixlen();
+        rule.kinds = kinds;
+    }
+
+    template <typename Net, int M>
+    IPADDRESS_CONSTEXPR void add(const Net (&nets)[M], uint32_t kinds) IPADDRESS_NOEXCEPT {
+        for (int i = 0; i < M; ++i) {
+            add(nets[i], kinds);
+        }
+    }
+};
+
+// A multibit trie with a stride of one byte. Each entry holds either the address flags
+// of the whole block, the index of a child node, or a request to fall back to the scan
+// of the networks when the block can not be resolved within Depth bytes or Nodes nodes.
+template <size_t Depth, size_t Nodes>
+struct classifier {
+    static constexpr uint16_t node_flag = 0x8000;
+    static constexpr uint16_t scan_flag = 0x4000;
+    static constexpr uint16_t index_mask = 0x3FFF;
+
+    uint16_t nodes[Nodes][256];
+    size_t size;
+
+    template <size_t N>
+    IPADDRESS_CONSTEXPR explicit classifier(const classifier_rules<N>& rules) IPADDRESS_NOEXCEPT : nodes(), size(1) {
+        size_t indices[N] = {};
+        for (size_t i = 0; i < rules.count; ++i) {
+            indices[i] = i;
+        }
+        build(rules, indices, rules.count, 0, 0, 0);
+    }
+
+    // Whether every block is resolved by the nodes without falling back to the scan,
+    // and none of the nodes is left unused
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR bool exact() const IPADDRESS_NOEXCEPT {
+        if (size != Nodes) {
+            return false;
+        }
+        for (size_t n = 0; n < size; ++n) {
+            for (size_t e = 0; e < 256; ++e) {
+                if ((nodes[n][e] & scan_flag) != 0) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    template <typename Bytes>
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE uint16_t lookup(const Bytes& bytes) const IPADDRESS_NOEXCEPT {
+        auto entry = nodes[0][bytes[0]];
+        for (size_t i = 1; (entry & node_flag) != 0; ++i) {
+            entry = nodes[entry & index_mask][bytes[i]];
+        }
+        return entry;
+    }
+
+private:
+    IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR uint16_t flags_of(uint32_t kinds) IPADDRESS_NOEXCEPT {
+        auto flags = kinds & classifier_flags;
+        if ((kinds & classifier_private_exception) != 0) {
+            flags &= ~uint32_t(address_flags::is_private);
+        }
+        if ((flags & uint32_t(address_flags::is_private)) == 0 && (kinds & classifier_not_global) == 0) {
+            flags |= uint32_t(address_flags::is_global);
+        }
+        return uint16_t(flags);
+    }
+
+    template <size_t N>
+    IPADDRESS_CONSTEXPR void build(const classifier_rules<N>& rules, const size_t* indices, size_t count, uint32_t base, size_t node, size_t depth) IPADDRESS_NOEXCEPT {
+        // Rules covering the whole block of the node are already folded into base, so
+        // each of the remaining rules either covers a range of entries or splits a single
+        // entry. The kinds are first accumulated in the entries themselves, which start
+        // zeroed, and then replaced with the final values.
+        auto& entries = nodes[node];
+        const auto bits = depth * 8;
+        for (size_t r = 0; r < count; ++r) {
+            const auto& rule = rules.rules[indices[r]];
+            const auto byte = rule.bytes[depth];
+            if (rule.prefixlen - bits > 8) {
+                entries[byte] |= node_flag;
+            } else {
+                const auto width = size_t(1) << (8 - (rule.prefixlen - bits));
+                const auto first = byte & ~(width - 1);
+                for (size_t e = first; e < first + width; ++e) {
+                    entries[e] |= uint16_t(rule.kinds);
+                }
+            }
+        }
+        const auto fill = flags_of(base);
+        for (size_t e = 0; e < 256; ++e) {
+            const auto kinds = entries[e];
+            if (kinds == 0) {
+                entries[e] = fill;
+            } else if ((kinds & node_flag) == 0) {
+                entries[e] = flags_of(base | kinds);
+            } else if (depth + 1 < Depth && size < Nodes) {
+                size_t selected[N] = {};
+                size_t selected_count = 0;
+                for (size_t r = 0; r < count; ++r) {
+                    const auto& rule = rules.rules[indices[r]];
+                    if (rule.prefixlen - bits > 8 && rule.bytes[depth] == e) {
+                        selected[selected_count++] = indices[r];
+                    }
+                }
+                const auto child = size++;
+                entries[e] = uint16_t(node_flag | child);
+                build(rules, selected, selected_count, base | (kinds & ~uint32_t(node_flag)), child, depth + 1);
+            } else {
+                entries[e] = scan_flag;
+            }
+        }
+    }
+};
+
+IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR inline classifier_rules<22> ipv4_classifier_rules() IPADDRESS_NOEXCEPT {
+    classifier_rules<22> result{};
+    result.add(nets::ipv4_private_networks, uint32_t(address_flags::is_private));
+    result.add(nets::ipv4_private_networks_exceptions, classifier_private_exception);
+    result.add(nets::ipv4_is_public_network, classifier_not_global);
+    result.add(nets::ipv4_reserved_network, uint32_t(address_flags::is_reserved));
+    result.add(nets::ipv4_is_multicast, uint32_t(address_flags::is_multicast));
+    result.add(nets::ipv4_is_loopback, uint32_t(address_flags::is_loopback));
+    result.add(nets::ipv4_is_link_local, uint32_t(address_flags::is_link_local));
+    result.add(ipv4_network::parse("0.0.0.0/32"), uint32_t(address_flags::is_unspecified));
+    return result;
+}
+
+IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR inline classifier_rules<36> ipv6_classifier_rules() IPADDRESS_NOEXCEPT {
+    classifier_rules<36> result{};
+    result.add(nets::ipv6_private_networks, uint32_t(address_flags::is_private));
+    result.add(nets::ipv6_private_networks_exceptions, classifier_private_exception);
+    result.add(nets::ipv6_reserved_networks, uint32_t(address_flags::is_reserved));
+    result.add(nets::ipv6_is_multicast, uint32_t(address_flags::is_multicast));
+    result.add(nets::ipv6_is_link_local, uint32_t(address_flags::is_link_local));
+    result.add(nets::ipv6_is_site_local, uint32_t(address_flags::is_site_local));
+    result.add(ipv6_network::parse("::1/128"), uint32_t(address_flags::is_loopback));
+    result.add(ipv6_network::parse("::/128"), uint32_t(address_flags::is_unspecified));
+    return result;
+}
+
+// The node counts are exactly what the rules require, so every block is resolved
+// by the tables and the scan of the networks is never reached in practice. This is
+// checked at compile time where the classifiers are built as constant expressions.
+using ipv4_classifier = classifier<4, 17>;
+using ipv6_classifier = classifier<16, 47>;
+
+template <typename>
+struct classifiers {
+#if __cpp_constexpr >= 201304L
+    static constexpr ipv4_classifier ipv4 = ipv4_classifier(ipv4_classifier_rules());
+    static constexpr ipv6_classifier ipv6 = ipv6_classifier(ipv6_classifier_rules());
+#endif
+};
+
+#if __cpp_constexpr >= 201304L
+template <typename T>
+constexpr ipv4_classifier classifiers<T>::ipv4;
+
+template <typename T>
+constexpr ipv6_classifier classifiers<T>::ipv6;
+
+static_assert(classifiers<int>::ipv4.exact(), "ipv4_classifier node count does not match the rules");
+static_assert(classifiers<int>::ipv6.exact(), "ipv6_classifier node count does not match the rules");
+#endif
+
+IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE const ipv4_classifier& get_ipv4_classifier() IPADDRESS_NOEXCEPT {
+#if __cpp_constexpr >= 201304L
+    return classifiers<int>::ipv4;
+#else
+    static const ipv4_classifier table(ipv4_classifier_rules());
+    return table;
+#endif
+}
+
+IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE const ipv6_classifier& get_ipv6_classifier() IPADDRESS_NOEXCEPT {
+#if __cpp_constexpr >= 201304L
+    return classifiers<int>::ipv6;
+#else
+    static const ipv6_classifier table(ipv6_classifier_rules());
+    return table;
+#endif
+}
+
 template <typename>
 struct props;
 
@@ -329,7 +541,32 @@ struct props<ipv6_network> {
 
 template <>
 struct props<ipv4_address> {
+    IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE address_flags classify(const ipv4_address& ip) IPADDRESS_NOEXCEPT {
+        const auto entry = get_ipv4_classifier().lookup(ip.bytes());
+        return (entry & ipv4_classifier::scan_flag) != 0 ? scan(ip) : address_flags(entry);
+    }
+
     IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool is_private(const ipv4_address& ip) IPADDRESS_NOEXCEPT {
+        return (classify(ip) & address_flags::is_private) != address_flags::none;
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool is_global(const ipv4_address& ip) IPADDRESS_NOEXCEPT {
+        return (classify(ip) & address_flags::is_global) != address_flags::none;
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE address_flags scan(const ipv4_address& ip) IPADDRESS_NOEXCEPT {
+        auto flags = address_flags::none;
+        flags |= scan_private(ip) ? address_flags::is_private : address_flags::none;
+        flags |= scan_global(ip) ? address_flags::is_global : address_flags::none;
+        flags |= is_reserved(ip) ? address_flags::is_reserved : address_flags::none;
+        flags |= is_multicast(ip) ? address_flags::is_multicast : address_flags::none;
+        flags |= is_loopback(ip) ? address_flags::is_loopback : address_flags::none;
+        flags |= is_link_local(ip) ? address_flags::is_link_local : address_flags::none;
+        flags |= ip.is_unspecified() ? address_flags::is_unspecified : address_flags::none;
+        return flags;
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool scan_private(const ipv4_address& ip) IPADDRESS_NOEXCEPT {
         auto ip_private = false;
         constexpr auto count = array_size(nets::ipv4_private_networks);
         for (int i = 0; i < count; ++i) {
@@ -350,8 +587,8 @@ struct props<ipv4_address> {
         return ip_private;
     }
 
-    IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool is_global(const ipv4_address& ip) IPADDRESS_NOEXCEPT {
-        return !nets::ipv4_is_public_network.contains(ip) && !is_private(ip);
+    IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool scan_global(const ipv4_address& ip) IPADDRESS_NOEXCEPT {
+        return !nets::ipv4_is_public_network.contains(ip) && !scan_private(ip);
     }
 
     IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool is_multicast(const ipv4_address& ip) IPADDRESS_NOEXCEPT {
@@ -373,7 +610,53 @@ struct props<ipv4_address> {
 
 template <>
 struct props<ipv6_address> {
+    IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE address_flags classify(const ipv6_address& ip) IPADDRESS_NOEXCEPT {
+        const auto entry = get_ipv6_classifier().lookup(ip.bytes());
+        if ((entry & ipv6_classifier::scan_flag) != 0) {
+            return scan(ip);
+        }
+        if (is_ipv4_mapped(ip)) {
+            // Whether an IPv4-mapped address is private or global is decided by the IPv4 address
+            const auto mask = address_flags::is_private | address_flags::is_global;
+            return (address_flags(entry) & ~mask) | (ip.ipv4_mapped()->classify() & mask);
+        }
+        return address_flags(entry);
+    }
+
     IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool is_private(const ipv6_address& ip) IPADDRESS_NOEXCEPT {
+        const auto entry = get_ipv6_classifier().lookup(ip.bytes());
+        return (entry & ipv6_classifier::scan_flag) != 0 || is_ipv4_mapped(ip) ? scan_private(ip) : (entry & uint16_t(address_flags::is_private)) != 0;
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool is_global(const ipv6_address& ip) IPADDRESS_NOEXCEPT {
+        const auto entry = get_ipv6_classifier().lookup(ip.bytes());
+        return (entry & ipv6_classifier::scan_flag) != 0 || is_ipv4_mapped(ip) ? scan_global(ip) : (entry & uint16_t(address_flags::is_global)) != 0;
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool is_reserved(const ipv6_address& ip) IPADDRESS_NOEXCEPT {
+        const auto entry = get_ipv6_classifier().lookup(ip.bytes());
+        return (entry & ipv6_classifier::scan_flag) != 0 ? scan_reserved(ip) : (entry & uint16_t(address_flags::is_reserved)) != 0;
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool is_ipv4_mapped(const ipv6_address& ip) IPADDRESS_NOEXCEPT {
+        const auto& b = ip.bytes();
+        return b[10] == 0xFF && b[11] == 0xFF;
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE address_flags scan(const ipv6_address& ip) IPADDRESS_NOEXCEPT {
+        auto flags = address_flags::none;
+        flags |= scan_private(ip) ? address_flags::is_private : address_flags::none;
+        flags |= scan_global(ip) ? address_flags::is_global : address_flags::none;
+        flags |= scan_reserved(ip) ? address_flags::is_reserved : address_flags::none;
+        flags |= is_multicast(ip) ? address_flags::is_multicast : address_flags::none;
+        flags |= is_loopback(ip) ? address_flags::is_loopback : address_flags::none;
+        flags |= is_link_local(ip) ? address_flags::is_link_local : address_flags::none;
+        flags |= nets::ipv6_is_site_local.contains(ip) ? address_flags::is_site_local : address_flags::none;
+        flags |= ip.is_unspecified() ? address_flags::is_unspecified : address_flags::none;
+        return flags;
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool scan_private(const ipv6_address& ip) IPADDRESS_NOEXCEPT {
         const auto ipv4 = ip.ipv4_mapped();
         if (ipv4) {
             return ipv4->is_private();
@@ -399,19 +682,19 @@ struct props<ipv6_address> {
         return ip_private;
     }
 
-    IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool is_global(const ipv6_address& ip) IPADDRESS_NOEXCEPT {
+    IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool scan_global(const ipv6_address& ip) IPADDRESS_NOEXCEPT {
         const auto ipv4 = ip.ipv4_mapped();
         if (ipv4) {
             return ipv4->is_global();
         }
-        return !is_private(ip);
+        return !scan_private(ip);
     }
 
     IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool is_multicast(const ipv6_address& ip) IPADDRESS_NOEXCEPT {
         return nets::ipv6_is_multicast.contains(ip);
     }
 
-    IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool is_reserved(const ipv6_address& ip) IPADDRESS_NOEXCEPT {
+    IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool scan_reserved(const ipv6_address& ip) IPADDRESS_NOEXCEPT {
         constexpr auto count = array_size(nets::ipv6_reserved_networks);
         for (int i = 0; i < count; ++i) {
             if (nets::ipv6_reserved_networks[i].contains(ip)) {
@@ -446,6 +729,11 @@ IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool ip_network_b
     return internal::props<ip_network_base<Base>>::is_global(*this);
 }
 
+template <typename Base>
+IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE address_flags ip_address_base<Base>::classify() const IPADDRESS_NOEXCEPT {
+    return internal::props<ip_address_base<Base>>::classify(*this);
+}
+
 template <typename Base>
 IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool ip_address_base<Base>::is_private() const IPADDRESS_NOEXCEPT {
     return internal::props<ip_address_base<Base>>::is_private(*this);
@@ -481,6 +769,20 @@ IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool ipv6_address
     return internal::nets::ipv6_is_site_local.contains(address);
 }
 
+IPADDRESS_FORCE_INLINE void ipv4_address_base::classify_many(const ip_address_base<ipv4_address_base>* addresses, size_t count, uint8_t* flags) IPADDRESS_NOEXCEPT {
+    for (size_t i = 0; i < count; ++i) {
+        flags[i] = uint8_t(internal::props<ipv4_address>::classify(addresses[i]));
+    }
+}
+
+IPADDRESS_FORCE_INLINE void ipv4_address_base::classify_many(const uint32_t* addresses, size_t count, uint8_t* flags) IPADDRESS_NOEXCEPT {
+    for (size_t i = 0; i < count; ++i) {
+        base_type bytes;
+        std::memcpy(bytes.data(), addresses + i, sizeof(uint32_t));
+        flags[i] = uint8_t(internal::props<ipv4_address>::classify(ipv4_address(bytes)));
+    }
+}
+
 } // namespace IPADDRESS_NAMESPACE
 
 #endif // IPADDRESS_IP_NETWORKS_HPP
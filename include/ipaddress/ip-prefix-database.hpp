@@ -0,0 +1,597 @@
+/**
+ * @file      ip-prefix-database.hpp
+ * @brief     Immutable on-disk database of IP prefixes
+ * @author    Vladimir Shaleev
+ * @copyright MIT License
+ *
+ * This file defines a versioned binary format for tables of IPv4 and IPv6 prefixes with
+ * associated values, together with ip_prefix_database_writer, which produces it, and
+ * ip_prefix_database, which answers exact and longest-prefix-match queries directly on the
+ * encoded bytes. Longest-prefix matches are precomputed at write time as a sorted list of
+ * disjoint address intervals, so a lookup is a binary search over a flat array and the reader
+ * never copies or parses the data. Combined with mapped_file from mapped-file.hpp, a database
+ * file is mapped into memory in constant time and its pages are shared by all processes that use it.
+ */
+
+#ifndef IPADDRESS_IP_PREFIX_DATABASE_HPP
+#define IPADDRESS_IP_PREFIX_DATABASE_HPP
+
+#include "ip-any-network.hpp"
+
+namespace IPADDRESS_NAMESPACE {
+
+namespace internal {
+
+// File layout, all integers in the byte order of the writer (recorded in the header):
+//
+//   header                     64 bytes
+//   v4 exact keys              uint64_t[v4_count]          (address << 8 | prefixlen), sorted
+//   v4 interval starts         uint32_t[v4_intervals]      sorted, the first one is 0
+//   v4 interval payloads       uint32_t[v4_intervals]      value index or npos
+//   v6 exact keys              uint64_t[v6_count * 3]      (hi, lo, prefixlen), sorted
+//   v6 interval starts         uint64_t[v6_intervals * 2]  (hi, lo), sorted, the first one is 0
+//   v6 interval payloads       uint32_t[v6_intervals]      value index or npos
+//   values                     Value[v4_count + v6_count]  in the order of the exact keys
+//
+// Every section starts at a multiple of 16 bytes.
+struct prefix_database_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t value_size;
+    uint64_t v4_count;
+    uint64_t v4_intervals;
+    uint64_t v6_count;
+    uint64_t v6_intervals;
+    uint64_t size;
+};
+
+struct prefix_database_format {
+    static constexpr uint32_t version = 1;
+    static constexpr uint32_t byte_order = 0x01020304;
+    static constexpr uint32_t npos = 0xFFFFFFFF;
+    static constexpr size_t alignment = 16;
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE const char* magic() IPADDRESS_NOEXCEPT {
+        return "IPPFXDB";
+    }
+};
+
+struct prefix_database_layout {
+    size_t v4_keys;
+    size_t v4_starts;
+    size_t v4_payloads;
+    size_t v6_keys;
+    size_t v6_starts;
+    size_t v6_payloads;
+    size_t values;
+    size_t size;
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE size_t align(size_t offset) IPADDRESS_NOEXCEPT {
+        return (offset + prefix_database_format::alignment - 1) & ~(prefix_database_format::alignment - 1);
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE prefix_database_layout compute(const prefix_database_header& header) IPADDRESS_NOEXCEPT {
+        prefix_database_layout layout{};
+        layout.v4_keys = align(sizeof(prefix_database_header));
+        layout.v4_starts = align(layout.v4_keys + size_t(header.v4_count) * 8);
+        layout.v4_payloads = align(layout.v4_starts + size_t(header.v4_intervals) * 4);
+        layout.v6_keys = align(layout.v4_payloads + size_t(header.v4_intervals) * 4);
+        layout.v6_starts = align(layout.v6_keys + size_t(header.v6_count) * 24);
+        layout.v6_payloads = align(layout.v6_starts + size_t(header.v6_intervals) * 16);
+        layout.values = align(layout.v6_payloads + size_t(header.v6_intervals) * 4);
+        layout.size = layout.values + size_t(header.v4_count + header.v6_count) * size_t(header.value_size);
+        return layout;
+    }
+
+    // Checks the counts read from a header against the size of the data before compute() is
+    // used on them, so that the offsets of a corrupt or hostile file cannot wrap around.
+    // Payload indices are 32-bit and npos is reserved, which also bounds the counts
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE bool fits(const prefix_database_header& header, size_t size) IPADDRESS_NOEXCEPT {
+        const uint64_t limit = prefix_database_format::npos;
+        if (header.v4_count >= limit || header.v6_count >= limit || header.v4_count + header.v6_count >= limit ||
+            header.v4_intervals > limit || header.v6_intervals > limit) {
+            return false;
+        }
+        const uint64_t sections[][2] = {
+            { header.v4_count, 8 },
+            { header.v4_intervals, 4 },
+            { header.v4_intervals, 4 },
+            { header.v6_count, 24 },
+            { header.v6_intervals, 16 },
+            { header.v6_intervals, 4 },
+            { header.v4_count + header.v6_count, header.value_size } };
+        const auto total = uint64_t(size);
+        uint64_t offset = sizeof(prefix_database_header);
+        for (const auto& section : sections) {
+            offset = (offset + prefix_database_format::alignment - 1) & ~uint64_t(prefix_database_format::alignment - 1);
+            if (offset > total || (section[0] != 0 && section[1] > (total - offset) / section[0])) {
+                return false;
+            }
+            offset += section[0] * section[1];
+        }
+        return offset == total;
+    }
+};
+
+template <typename UInt>
+struct prefix_database_item {
+    UInt address;
+    uint32_t prefixlen;
+    uint32_t index;
+};
+
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE uint32_t prefix_database_hostmask(uint32_t /*type*/, uint32_t prefixlen) IPADDRESS_NOEXCEPT {
+    return prefixlen == 0 ? 0xFFFFFFFF : (uint32_t(1) << (32 - prefixlen)) - 1;
+}
+
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE uint128_t prefix_database_hostmask(const uint128_t& /*type*/, uint32_t prefixlen) IPADDRESS_NOEXCEPT {
+    return prefixlen == 0 ? ~uint128_t(0) : (uint128_t(1) << (128 - prefixlen)) - 1;
+}
+
+// Sorts the items by (address, prefixlen) and keeps the last inserted one of equal prefixes
+template <typename UInt>
+IPADDRESS_FORCE_INLINE void prefix_database_unique(std::vector<prefix_database_item<UInt>>& items) {
+    std::sort(items.begin(), items.end(), [](const prefix_database_item<UInt>& lhs, const prefix_database_item<UInt>& rhs) {
+        return lhs.address < rhs.address || (lhs.address == rhs.address && (lhs.prefixlen < rhs.prefixlen || (lhs.prefixlen == rhs.prefixlen && lhs.index > rhs.index)));
+    });
+    items.erase(std::unique(items.begin(), items.end(), [](const prefix_database_item<UInt>& lhs, const prefix_database_item<UInt>& rhs) {
+        return lhs.address == rhs.address && lhs.prefixlen == rhs.prefixlen;
+    }), items.end());
+}
+
+// Splits the address space into intervals, each labelled with the most specific prefix
+// covering it. Since the items are sorted by (address, prefixlen), every prefix comes after
+// the prefixes containing it, and the prefixes still open form a stack of nested ranges.
+// The payload of a prefix is base plus its position in the items.
+template <typename UInt>
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE std::vector<std::pair<UInt, uint32_t>> prefix_database_intervals(const std::vector<prefix_database_item<UInt>>& items, uint32_t base) {
+    std::vector<std::pair<UInt, uint32_t>> intervals;
+    const auto emit = [&intervals](const UInt& start, uint32_t payload) {
+        if (!intervals.empty() && intervals.back().first == start) {
+            intervals.pop_back();
+        }
+        if (intervals.empty() || intervals.back().second != payload) {
+            intervals.emplace_back(start, payload);
+        }
+    };
+
+    std::vector<std::pair<UInt, uint32_t>> stack;
+    const auto pop = [&stack, &emit]() {
+        const auto end = stack.back().first;
+        stack.pop_back();
+        if (end != ~UInt(0)) {
+            emit(end + 1, stack.empty() ? uint32_t(prefix_database_format::npos) : stack.back().second);
+        }
+    };
+
+    emit(UInt(0), uint32_t(prefix_database_format::npos));
+    for (size_t i = 0; i < items.size(); ++i) {
+        const auto& item = items[i];
+        while (!stack.empty() && stack.back().first < item.address) {
+            pop();
+        }
+        emit(item.address, base + uint32_t(i));
+        stack.emplace_back(item.address | prefix_database_hostmask(UInt(0), item.prefixlen), base + uint32_t(i));
+    }
+    while (!stack.empty()) {
+        pop();
+    }
+    return intervals;
+}
+
+IPADDRESS_FORCE_INLINE void prefix_database_store(char* data, uint32_t value) IPADDRESS_NOEXCEPT {
+    std::memcpy(data, &value, sizeof(value));
+}
+
+IPADDRESS_FORCE_INLINE void prefix_database_store(char* data, uint64_t value) IPADDRESS_NOEXCEPT {
+    std::memcpy(data, &value, sizeof(value));
+}
+
+IPADDRESS_FORCE_INLINE void prefix_database_store(char* data, const uint128_t& value) IPADDRESS_NOEXCEPT {
+    prefix_database_store(data, value.upper());
+    prefix_database_store(data + 8, value.lower());
+}
+
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool prefix_database_less(uint64_t hi, uint64_t lo, const uint64_t* key) IPADDRESS_NOEXCEPT {
+    return hi < key[0] || (hi == key[0] && lo < key[1]);
+}
+
+} // namespace IPADDRESS_NAMESPACE::internal
+
+/**
+ * Builds the binary representation of a prefix database.
+ *
+ * Networks of both IP versions are collected with insert() and encoded with serialize()
+ * or write(). If the same network is inserted more than once, the last value is kept.
+ * The resulting bytes can be stored in a file and later queried with ip_prefix_database.
+ *
+ * @code{.cpp}
+ *   ip_prefix_database_writer<uint32_t> writer;
+ *   writer.insert(ipv4_network::parse("10.0.0.0/8"), 1);
+ *   writer.insert(ipv4_network::parse("10.1.0.0/16"), 2);
+ *   writer.insert(ipv6_network::parse("2001:db8::/32"), 3);
+ *
+ *   std::ofstream file("prefixes.db", std::ios::binary);
+ *   writer.write(file);
+ * @endcode
+ * @tparam Value the type of values associated with networks. It must be trivially copyable,
+ *               since the reader returns pointers to values stored in the encoded bytes.
+ */
+IPADDRESS_EXPORT template <typename Value>
+class ip_prefix_database_writer {
+    static_assert(std::is_trivially_copyable<Value>::value, "The values of a prefix database must be trivially copyable.");
+
+public:
+    using mapped_type = Value; /**< The type of values associated with networks. */
+    using size_type   = size_t; /**< An unsigned integer type. */
+
+    /**
+     * Adds an IPv4 network with the associated value.
+     *
+     * @param[in] network the network.
+     * @param[in] value the value associated with the network.
+     */
+    IPADDRESS_FORCE_INLINE void insert(const ipv4_network& network, const Value& value) {
+        _v4.push_back(internal::prefix_database_item<uint32_t> { network.network_address().to_uint(), uint32_t(network.prefixlen()), uint32_t(_values.size()) });
+        _values.push_back(value);
+    }
+
+    /**
+     * Adds an IPv6 network with the associated value.
+     *
+     * @param[in] network the network.
+     * @param[in] value the value associated with the network.
+     */
+    IPADDRESS_FORCE_INLINE void insert(const ipv6_network& network, const Value& value) {
+        _v6.push_back(internal::prefix_database_item<uint128_t> { network.network_address().to_uint(), uint32_t(network.prefixlen()), uint32_t(_values.size()) });
+        _values.push_back(value);
+    }
+
+    /**
+     * Adds a network with the associated value.
+     *
+     * @param[in] network the network.
+     * @param[in] value the value associated with the network.
+     */
+    IPADDRESS_FORCE_INLINE void insert(const ip_network& network, const Value& value) {
+        if (network.version() == ip_version::V4) {
+            insert(network.v4().value(), value);
+        } else {
+            insert(network.v6().value(), value);
+        }
+    }
+
+    /**
+     * Adds a range of `(network, value)` pairs, such as the entries of an ip_prefix_table.
+     *
+     * @tparam It the type of the iterator.
+     * @param[in] first the beginning of the range of entries.
+     * @param[in] last the end of the range of entries.
+     */
+    template <typename It>
+    IPADDRESS_FORCE_INLINE void insert(It first, It last) {
+        for (; first != last; ++first) {
+            insert(first->first, first->second);
+        }
+    }
+
+    /**
+     * Returns the number of inserted networks, including repeated ones.
+     *
+     * @return The number of inserted networks.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_type size() const IPADDRESS_NOEXCEPT {
+        return _values.size();
+    }
+
+    /**
+     * Removes all inserted networks.
+     */
+    IPADDRESS_FORCE_INLINE void clear() IPADDRESS_NOEXCEPT {
+        _v4.clear();
+        _v6.clear();
+        _values.clear();
+    }
+
+    /**
+     * Encodes the inserted networks.
+     *
+     * @return The bytes of the database.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE std::vector<char> serialize() const {
+        auto v4 = _v4;
+        auto v6 = _v6;
+        internal::prefix_database_unique(v4);
+        internal::prefix_database_unique(v6);
+        const auto intervals4 = internal::prefix_database_intervals(v4, 0);
+        const auto intervals6 = internal::prefix_database_intervals(v6, uint32_t(v4.size()));
+
+        internal::prefix_database_header header{};
+        std::memcpy(header.magic, internal::prefix_database_format::magic(), sizeof(header.magic));
+        header.version = internal::prefix_database_format::version;
+        header.byte_order = internal::prefix_database_format::byte_order;
+        header.value_size = sizeof(Value);
+        header.v4_count = v4.size();
+        header.v4_intervals = intervals4.size();
+        header.v6_count = v6.size();
+        header.v6_intervals = intervals6.size();
+        const auto layout = internal::prefix_database_layout::compute(header);
+        header.size = layout.size;
+
+        std::vector<char> data(layout.size, 0);
+        std::memcpy(data.data(), &header, sizeof(header));
+        for (size_t i = 0; i < v4.size(); ++i) {
+            internal::prefix_database_store(&data[layout.v4_keys + i * 8], (uint64_t(v4[i].address) << 8) | v4[i].prefixlen);
+            std::memcpy(&data[layout.values + i * sizeof(Value)], &_values[v4[i].index], sizeof(Value));
+        }
+        for (size_t i = 0; i < intervals4.size(); ++i) {
+            internal::prefix_database_store(&data[layout.v4_starts + i * 4], intervals4[i].first);
+            internal::prefix_database_store(&data[layout.v4_payloads + i * 4], intervals4[i].second);
+        }
+        for (size_t i = 0; i < v6.size(); ++i) {
+            internal::prefix_database_store(&data[layout.v6_keys + i * 24], v6[i].address);
+            internal::prefix_database_store(&data[layout.v6_keys + i * 24 + 16], uint64_t(v6[i].prefixlen));
+            std::memcpy(&data[layout.values + (v4.size() + i) * sizeof(Value)], &_values[v6[i].index], sizeof(Value));
+        }
+        for (size_t i = 0; i < intervals6.size(); ++i) {
+            internal::prefix_database_store(&data[layout.v6_starts + i * 16], intervals6[i].first);
+            internal::prefix_database_store(&data[layout.v6_payloads + i * 4], intervals6[i].second);
+        }
+        return data;
+    }
+
+    /**
+     * Encodes the inserted networks into a stream.
+     *
+     * @param[out] out the stream, which should be opened in binary mode.
+     */
+    IPADDRESS_FORCE_INLINE void write(std::ostream& out) const {
+        const auto data = serialize();
+        out.write(data.data(), std::streamsize(data.size()));
+    }
+
+private:
+    std::vector<internal::prefix_database_item<uint32_t>> _v4;
+    std::vector<internal::prefix_database_item<uint128_t>> _v6;
+    std::vector<Value> _values;
+};
+
+/**
+ * A read-only view of a prefix database produced by ip_prefix_database_writer.
+ *
+ * The database is queried in place: opening it only validates the header, and lookups
+ * binary-search the encoded arrays and return pointers to the stored values. The memory
+ * must stay valid and unchanged for as long as the database is used. It is typically
+ * a file mapped with mapped_file (see mapped-file.hpp), which makes opening a large database instantaneous and
+ * lets all processes share a single copy of it in the page cache.
+ *
+ * @code{.cpp}
+ *   const mapped_file file("prefixes.db");
+ *   const ip_prefix_database<uint32_t> db(file.data(), file.size());
+ *
+ *   const auto* value = db.longest_match(ipv4_address::parse("10.1.2.3"));
+ *   std::cout << (value ? *value : 0) << std::endl;
+ *
+ *   // out:
+ *   // 2
+ * @endcode
+ * @tparam Value the type of values associated with networks, the same as used by the writer.
+ */
+IPADDRESS_EXPORT template <typename Value>
+class ip_prefix_database {
+    static_assert(std::is_trivially_copyable<Value>::value, "The values of a prefix database must be trivially copyable.");
+
+public:
+    using mapped_type = Value; /**< The type of values associated with networks. */
+    using size_type   = size_t; /**< An unsigned integer type. */
+
+    /**
+     * Default constructor. Creates an empty database.
+     */
+    ip_prefix_database() = default;
+
+    /**
+     * Opens a database stored in memory.
+     *
+     * @param[in] data the beginning of the database, aligned to at least 16 bytes.
+     * @param[in] size the size of the database in bytes.
+     * @throw logic_error Raise if the data is not a valid database for this value type.
+     */
+    IPADDRESS_FORCE_INLINE ip_prefix_database(const void* data, size_t size) {
+        open(data, size);
+    }
+
+    /**
+     * Opens a database stored in memory.
+     *
+     * The header and the total size are checked; the contents of the sections are trusted.
+     *
+     * @param[in] data the beginning of the database, aligned to at least 16 bytes.
+     * @param[in] size the size of the database in bytes.
+     * @param[out] code an error_code object that will be set if the data is not a valid database for this value type;
+     *                  the database is left empty in this case.
+     */
+    IPADDRESS_FORCE_INLINE void open(const void* data, size_t size, error_code& code) IPADDRESS_NOEXCEPT {
+        code = error_code::no_error;
+        *this = ip_prefix_database();
+
+        internal::prefix_database_header header{};
+        const auto* bytes = static_cast<const char*>(data);
+        if (data == nullptr || size < sizeof(header) || (reinterpret_cast<uintptr_t>(data) & (internal::prefix_database_format::alignment - 1)) != 0) {
+            code = error_code::invalid_database;
+            return;
+        }
+        std::memcpy(&header, bytes, sizeof(header));
+        if (std::memcmp(header.magic, internal::prefix_database_format::magic(), sizeof(header.magic)) != 0 ||
+            header.version != internal::prefix_database_format::version ||
+            header.byte_order != internal::prefix_database_format::byte_order ||
+            header.value_size != sizeof(Value) ||
+            header.size != size ||
+            !internal::prefix_database_layout::fits(header, size)) {
+            code = error_code::invalid_database;
+            return;
+        }
+
+        const auto layout = internal::prefix_database_layout::compute(header);
+        _v4_count = size_t(header.v4_count);
+        _v4_intervals = size_t(header.v4_intervals);
+        _v6_count = size_t(header.v6_count);
+        _v6_intervals = size_t(header.v6_intervals);
+        _v4_keys = reinterpret_cast<const uint64_t*>(bytes + layout.v4_keys);
+        _v4_starts = reinterpret_cast<const uint32_t*>(bytes + layout.v4_starts);
+        _v4_payloads = reinterpret_cast<const uint32_t*>(bytes + layout.v4_payloads);
+        _v6_keys = reinterpret_cast<const uint64_t*>(bytes + layout.v6_keys);
+        _v6_starts = reinterpret_cast<const uint64_t*>(bytes + layout.v6_starts);
+        _v6_payloads = reinterpret_cast<const uint32_t*>(bytes + layout.v6_payloads);
+        _values = reinterpret_cast<const Value*>(bytes + layout.values);
+    }
+
+    /**
+     * Opens a database stored in memory.
+     *
+     * @param[in] data the beginning of the database, aligned to at least 16 bytes.
+     * @param[in] size the size of the database in bytes.
+     * @throw logic_error Raise if the data is not a valid database for this value type.
+     */
+    IPADDRESS_FORCE_INLINE void open(const void* data, size_t size) IPADDRESS_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+        error_code code = error_code::no_error;
+        open(data, size, code);
+        if (code != error_code::no_error) {
+            raise_error(code, 0, "", 0);
+        }
+    }
+
+    /**
+     * Returns the number of networks in the database.
+     *
+     * @return The number of networks.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_type size() const IPADDRESS_NOEXCEPT {
+        return _v4_count + _v6_count;
+    }
+
+    /**
+     * Checks whether the database contains no networks.
+     *
+     * @return `true` if the database is empty, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool empty() const IPADDRESS_NOEXCEPT {
+        return size() == 0;
+    }
+
+    /**
+     * Finds the value of the most specific network containing an IPv4 address.
+     *
+     * @param[in] address the address to look up.
+     * @return A pointer to the value, or `nullptr` if no network contains the address.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE const Value* longest_match(const ipv4_address& address) const IPADDRESS_NOEXCEPT {
+        const auto value = address.to_uint();
+        const auto it = std::upper_bound(_v4_starts, _v4_starts + _v4_intervals, value);
+        return it != _v4_starts ? value_at(_v4_payloads[it - _v4_starts - 1]) : nullptr;
+    }
+
+    /**
+     * Finds the value of the most specific network containing an IPv6 address.
+     *
+     * @param[in] address the address to look up.
+     * @return A pointer to the value, or `nullptr` if no network contains the address.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE const Value* longest_match(const ipv6_address& address) const IPADDRESS_NOEXCEPT {
+        const auto value = address.to_uint();
+        const auto hi = value.upper();
+        const auto lo = value.lower();
+        size_t first = 0;
+        size_t count = _v6_intervals;
+        while (count > 0) {
+            const auto half = count / 2;
+            if (!internal::prefix_database_less(hi, lo, _v6_starts + (first + half) * 2)) {
+                first += half + 1;
+                count -= half + 1;
+            } else {
+                count = half;
+            }
+        }
+        return first != 0 ? value_at(_v6_payloads[first - 1]) : nullptr;
+    }
+
+    /**
+     * Finds the value of the most specific network containing an IP address.
+     *
+     * @param[in] address the address to look up.
+     * @return A pointer to the value, or `nullptr` if no network contains the address.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE const Value* longest_match(const ip_address& address) const IPADDRESS_NOEXCEPT {
+        return address.is_v4() ? longest_match(ipv4_address::from_uint(address.to_uint32())) : longest_match(ipv6_address::from_uint(address.to_uint128()));
+    }
+
+    /**
+     * Finds the value associated with exactly this IPv4 network.
+     *
+     * @param[in] network the network to look up.
+     * @return A pointer to the value, or `nullptr` if the network is not in the database.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE const Value* find(const ipv4_network& network) const IPADDRESS_NOEXCEPT {
+        const auto key = (uint64_t(network.network_address().to_uint()) << 8) | uint64_t(network.prefixlen());
+        const auto it = std::lower_bound(_v4_keys, _v4_keys + _v4_count, key);
+        return it != _v4_keys + _v4_count && *it == key ? &_values[it - _v4_keys] : nullptr;
+    }
+
+    /**
+     * Finds the value associated with exactly this IPv6 network.
+     *
+     * @param[in] network the network to look up.
+     * @return A pointer to the value, or `nullptr` if the network is not in the database.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE const Value* find(const ipv6_network& network) const IPADDRESS_NOEXCEPT {
+        const auto value = network.network_address().to_uint();
+        const uint64_t key[3] = { value.upper(), value.lower(), uint64_t(network.prefixlen()) };
+        const auto less = [](const uint64_t* lhs, const uint64_t* rhs) {
+            return lhs[0] < rhs[0] || (lhs[0] == rhs[0] && (lhs[1] < rhs[1] || (lhs[1] == rhs[1] && lhs[2] < rhs[2])));
+        };
+        size_t first = 0;
+        size_t count = _v6_count;
+        while (count > 0) {
+            const auto half = count / 2;
+            if (less(_v6_keys + (first + half) * 3, key)) {
+                first += half + 1;
+                count -= half + 1;
+            } else {
+                count = half;
+            }
+        }
+        return first != _v6_count && !less(key, _v6_keys + first * 3) ? &_values[_v4_count + first] : nullptr;
+    }
+
+    /**
+     * Finds the value associated with exactly this network.
+     *
+     * @param[in] network the network to look up.
+     * @return A pointer to the value, or `nullptr` if the network is not in the database.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE const Value* find(const ip_network& network) const IPADDRESS_NOEXCEPT {
+        return network.version() == ip_version::V4 ? find(network.v4().value()) : find(network.v6().value());
+    }
+
+private:
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE const Value* value_at(uint32_t payload) const IPADDRESS_NOEXCEPT {
+        return payload < _v4_count + _v6_count ? &_values[payload] : nullptr;
+    }
+
+    size_t _v4_count{};
+    size_t _v4_intervals{};
+    size_t _v6_count{};
+    size_t _v6_intervals{};
+    const uint64_t* _v4_keys{};
+    const uint32_t* _v4_starts{};
+    const uint32_t* _v4_payloads{};
+    const uint64_t* _v6_keys{};
+    const uint64_t* _v6_starts{};
+    const uint32_t* _v6_payloads{};
+    const Value* _values{};
+};
+
+} // namespace IPADDRESS_NAMESPACE
+
+#endif // IPADDRESS_IP_PREFIX_DATABASE_HPP
@@ -0,0 +1,538 @@
+/**
+ * @file      ip-prefix-table.hpp
+ * @brief     Longest-prefix-match table for IP networks
+ * @author    Vladimir Shaleev
+ * @copyright MIT License
+ *
+ * This file defines the ip_prefix_table class template, an associative container that maps
+ * networks to values and answers longest-prefix-match queries for addresses. Prefixes are
+ * kept in a binary trie, from which a compressed multibit lookup structure in the style of
+ * Poptrie (a direct-pointing array for the leading 16 bits followed by 64-way nodes indexed
+ * with population counts) is built. The same structure is used for IPv4 and IPv6, and the
+ * table specialized for ip_network holds one structure per IP version.
+ */
+
+#ifndef IPADDRESS_IP_PREFIX_TABLE_HPP
+#define IPADDRESS_IP_PREFIX_TABLE_HPP
+
+#include "ip-any-network.hpp"
+#include "bits.hpp"
+
+namespace IPADDRESS_NAMESPACE {
+
+namespace internal {
+
+struct prefix_key {
+    uint64_t hi;
+    uint64_t lo;
+};
+
+IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE prefix_key make_prefix_key(const ipv4_address& address) IPADDRESS_NOEXCEPT {
+    return prefix_key { uint64_t(address.to_uint()) << 32, 0 };
+}
+
+IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE prefix_key make_prefix_key(const ipv6_address& address) IPADDRESS_NOEXCEPT {
+    const auto& bytes = address.bytes();
+    uint64_t hi = 0;
+    uint64_t lo = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        hi = (hi << 8) | bytes[i];
+        lo = (lo << 8) | bytes[i + 8];
+    }
+    return prefix_key { hi, lo };
+}
+
+IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE uint64_t prefix_key_window(const prefix_key& key, size_t offset) IPADDRESS_NOEXCEPT {
+    return offset == 0 ? key.hi
+        : offset < 64 ? (key.hi << offset) | (key.lo >> (64 - offset))
+        : offset < 128 ? key.lo << (offset - 64)
+        : 0;
+}
+
+IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE uint32_t prefix_key_bits(const prefix_key& key, size_t offset, size_t count) IPADDRESS_NOEXCEPT {
+    return uint32_t(prefix_key_window(key, offset) >> (64 - count));
+}
+
+IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE uint32_t prefix_key_bit(const prefix_key& key, size_t offset) IPADDRESS_NOEXCEPT {
+    return offset < 64 ? uint32_t(key.hi >> (63 - offset)) & 1 : uint32_t(key.lo >> (127 - offset)) & 1;
+}
+
+class prefix_trie {
+public:
+    static constexpr uint32_t npos = 0xFFFFFFFF;
+
+    IPADDRESS_FORCE_INLINE prefix_trie() : _rib(1) {
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool empty() const IPADDRESS_NOEXCEPT {
+        return _count == 0;
+    }
+
+    IPADDRESS_FORCE_INLINE void clear() {
+        _rib.assign(1, rib_node());
+        _rib_free.clear();
+        _direct.clear();
+        _nodes.clear();
+        _leaves.clear();
+        _count = 0;
+        _dirty = false;
+    }
+
+    IPADDRESS_FORCE_INLINE uint32_t insert(const prefix_key& key, size_t prefixlen, uint32_t payload) {
+        uint32_t index = 0;
+        for (size_t depth = 0; depth < prefixlen; ++depth) {
+            const auto bit = prefix_key_bit(key, depth);
+            auto child = _rib[index].child[bit];
+            if (child == npos) {
+                child = allocate_node();
+                _rib[index].child[bit] = child;
+            }
+            index = child;
+        }
+        const auto old = _rib[index].payload;
+        _rib[index].payload = payload;
+        _count += old == npos ? 1 : 0;
+        _dirty = true;
+        return old;
+    }
+
+    IPADDRESS_FORCE_INLINE uint32_t erase(const prefix_key& key, size_t prefixlen) {
+        uint32_t path[129];
+        uint32_t index = 0;
+        for (size_t depth = 0; depth < prefixlen; ++depth) {
+            path[depth] = index;
+            index = _rib[index].child[prefix_key_bit(key, depth)];
+            if (index == npos) {
+                return npos;
+            }
+        }
+        const auto old = _rib[index].payload;
+        if (old == npos) {
+            return npos;
+        }
+        _rib[index].payload = npos;
+        for (auto depth = prefixlen; depth > 0; --depth) {
+            const auto& node = _rib[index];
+            if (node.payload != npos || node.child[0] != npos || node.child[1] != npos) {
+                break;
+            }
+            const auto parent = path[depth - 1];
+            _rib[parent].child[prefix_key_bit(key, depth - 1)] = npos;
+            _rib_free.push_back(index);
+            index = parent;
+        }
+        --_count;
+        _dirty = true;
+        return old;
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE uint32_t find(const prefix_key& key, size_t prefixlen) const IPADDRESS_NOEXCEPT {
+        uint32_t index = 0;
+        for (size_t depth = 0; depth < prefixlen && index != npos; ++depth) {
+            index = _rib[index].child[prefix_key_bit(key, depth)];
+        }
+        return index != npos ? _rib[index].payload : npos;
+    }
+
+    template <typename Fn>
+    IPADDRESS_FORCE_INLINE void matches(const prefix_key& key, size_t max_prefixlen, Fn&& fn) const {
+        uint32_t index = 0;
+        for (size_t depth = 0; index != npos; ++depth) {
+            const auto& node = _rib[index];
+            if (node.payload != npos) {
+                fn(node.payload);
+            }
+            if (depth == max_prefixlen) {
+                break;
+            }
+            index = node.child[prefix_key_bit(key, depth)];
+        }
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE uint32_t longest_match(const prefix_key& key) const IPADDRESS_NOEXCEPT {
+        if (_direct.empty()) {
+            return npos;
+        }
+        const auto entry = _direct[size_t(key.hi >> (64 - direct_bits))];
+        if ((entry & node_flag) == 0) {
+            return entry - 1;
+        }
+        auto index = entry & ~node_flag;
+        for (size_t offset = direct_bits;; offset += stride) {
+            const auto& node = _nodes[index];
+            const auto bit = uint64_t(1) << prefix_key_bits(key, offset, stride);
+            const auto mask = bit | (bit - 1);
+            if ((node.vector & bit) == 0) {
+                return _leaves[node.base0 + popcount(node.leafvec & mask) - 1] - 1;
+            }
+            index = node.base1 + popcount(node.vector & mask) - 1;
+        }
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool dirty() const IPADDRESS_NOEXCEPT {
+        return _dirty;
+    }
+
+    IPADDRESS_FORCE_INLINE void build() {
+        _direct.clear();
+        _nodes.clear();
+        _leaves.clear();
+        if (_count != 0) {
+            std::vector<slot> slots(size_t(1) << direct_bits);
+            expand(0, direct_bits, npos, 0, slots.data());
+            _direct.resize(slots.size());
+            for (size_t i = 0; i < slots.size(); ++i) {
+                if (is_internal(slots[i])) {
+                    const auto index = uint32_t(_nodes.size());
+                    _nodes.emplace_back();
+                    build_node(index, slots[i]);
+                    _direct[i] = index | node_flag;
+                } else {
+                    _direct[i] = slots[i].best + 1;
+                }
+            }
+        }
+        _dirty = false;
+    }
+
+private:
+    static constexpr size_t direct_bits = 16;
+    static constexpr size_t stride = 6;
+    static constexpr uint32_t node_flag = 0x80000000;
+
+    struct rib_node {
+        uint32_t child[2] { npos, npos };
+        uint32_t payload { npos };
+    };
+
+    struct fib_node {
+        uint64_t vector;
+        uint64_t leafvec;
+        uint32_t base0;
+        uint32_t base1;
+    };
+
+    struct slot {
+        uint32_t node;
+        uint32_t best;
+    };
+
+    IPADDRESS_FORCE_INLINE uint32_t allocate_node() {
+        if (!_rib_free.empty()) {
+            const auto index = _rib_free.back();
+            _rib_free.pop_back();
+            _rib[index] = rib_node();
+            return index;
+        }
+        _rib.emplace_back();
+        return uint32_t(_rib.size() - 1);
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool is_internal(const slot& s) const IPADDRESS_NOEXCEPT {
+        return s.node != npos && (_rib[s.node].child[0] != npos || _rib[s.node].child[1] != npos);
+    }
+
+    void expand(uint32_t node, size_t bits, uint32_t best, uint32_t prefix, slot* out) const {
+        if (node != npos && _rib[node].payload != npos) {
+            best = _rib[node].payload;
+        }
+        if (bits == 0) {
+            out[prefix] = slot { node, best };
+        } else if (node == npos) {
+            const auto first = prefix << bits;
+            const auto last = (prefix + 1) << bits;
+            for (auto i = first; i < last; ++i) {
+                out[i] = slot { npos, best };
+            }
+        } else {
+            expand(_rib[node].child[0], bits - 1, best, prefix << 1, out);
+            expand(_rib[node].child[1], bits - 1, best, (prefix << 1) | 1, out);
+        }
+    }
+
+    void build_node(uint32_t index, const slot& parent) {
+        slot slots[size_t(1) << stride];
+        expand(parent.node, stride, parent.best, 0, slots);
+
+        fib_node node {};
+        node.base0 = uint32_t(_leaves.size());
+        node.base1 = uint32_t(_nodes.size());
+
+        auto previous = npos;
+        auto has_leaf = false;
+        for (size_t i = 0; i < (size_t(1) << stride); ++i) {
+            if (is_internal(slots[i])) {
+                node.vector |= uint64_t(1) << i;
+            } else if (!has_leaf || slots[i].best != previous) {
+                node.leafvec |= uint64_t(1) << i;
+                _leaves.push_back(slots[i].best + 1);
+                previous = slots[i].best;
+                has_leaf = true;
+            }
+        }
+
+        _nodes.resize(node.base1 + popcount(node.vector));
+        _nodes[index] = node;
+
+        auto child = node.base1;
+        for (size_t i = 0; i < (size_t(1) << stride); ++i) {
+            if (is_internal(slots[i])) {
+                build_node(child++, slots[i]);
+            }
+        }
+    }
+
+    std::vector<rib_node> _rib;
+    std::vector<uint32_t> _rib_free;
+    std::vector<uint32_t> _direct;
+    std::vector<fib_node> _nodes;
+    std::vector<uint32_t> _leaves;
+    size_t _count{};
+    bool _dirty{};
+};
+
+template <typename Net>
+struct prefix_table_traits;
+
+template <>
+struct prefix_table_traits<ipv4_network> {
+    static constexpr size_t tries = 1;
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE size_t index(const ipv4_address&) IPADDRESS_NOEXCEPT {
+        return 0;
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE prefix_key key(const ipv4_address& address) IPADDRESS_NOEXCEPT {
+        return make_prefix_key(address);
+    }
+};
+
+template <>
+struct prefix_table_traits<ipv6_network> {
+    static constexpr size_t tries = 1;
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE size_t index(const ipv6_address&) IPADDRESS_NOEXCEPT {
+        return 0;
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE prefix_key key(const ipv6_address& address) IPADDRESS_NOEXCEPT {
+        return make_prefix_key(address);
+    }
+};
+
+template <>
+struct prefix_table_traits<ip_network> {
+    static constexpr size_t tries = 2;
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE size_t index(const ip_address& address) IPADDRESS_NOEXCEPT {
+        return address.is_v4() ? 0 : 1;
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE prefix_key key(const ip_address& address) IPADDRESS_NOEXCEPT {
+        if (address.is_v4()) {
+            return prefix_key { uint64_t(address.to_uint32()) << 32, 0 };
+        }
+        const auto value = address.to_uint128();
+        return prefix_key { value.upper(), value.lower() };
+    }
+};
+
+} // namespace IPADDRESS_NAMESPACE::internal
+
+/**
+ * A container that maps IP networks to values and performs longest-prefix-match lookups.
+ *
+ * The ip_prefix_table stores networks together with associated values and answers the question
+ * "which of the stored networks is the most specific one containing this address" in a small,
+ * bounded number of memory accesses, independent of the number of stored prefixes. It is intended
+ * for routing and classification workloads, where large prefix sets (such as a full BGP table)
+ * are queried at high rates and modified comparatively rarely.
+ *
+ * Modifications are applied to a binary trie, and build() must be called after a batch of
+ * modifications to rebuild the compressed lookup structure used by longest_match(). Lookups
+ * never modify the table, so a built table can be queried from several threads concurrently.
+ * find() and all_matches() read the binary trie and do not require build(). The scope id of
+ * IPv6 addresses is not taken into account.
+ *
+ * @tparam Net the network type: ipv4_network, ipv6_network or ip_network.
+ * @tparam Value the type of values associated with networks.
+ */
+IPADDRESS_EXPORT template <typename Net, typename Value>
+class ip_prefix_table {
+public:
+    using network_type    = Net; /**< The network type used as key. */
+    using address_type    = typename Net::ip_address_type; /**< The address type used for lookups. */
+    using mapped_type     = Value; /**< The type of values associated with networks. */
+    using value_type      = std::pair<network_type, mapped_type>; /**< The type of stored entries. */
+    using size_type       = size_t; /**< An unsigned integer type. */
+    using const_iterator  = typename std::vector<value_type>::const_iterator; /**< Iterator over stored entries. */
+
+    /**
+     * Returns the number of networks in the table.
+     *
+     * @return The number of stored networks.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_type size() const IPADDRESS_NOEXCEPT {
+        return _entries.size();
+    }
+
+    /**
+     * Checks whether the table contains no networks.
+     *
+     * @return `true` if the table is empty, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool empty() const IPADDRESS_NOEXCEPT {
+        return _entries.empty();
+    }
+
+    /**
+     * Returns an iterator to the first stored entry.
+     *
+     * Entries are not ordered, and erasing a network may change the position of another entry.
+     *
+     * @return An iterator to the first entry.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE const_iterator begin() const IPADDRESS_NOEXCEPT {
+        return _entries.begin();
+    }
+
+    /**
+     * Returns an iterator past the last stored entry.
+     *
+     * @return An iterator past the last entry.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE const_iterator end() const IPADDRESS_NOEXCEPT {
+        return _entries.end();
+    }
+
+    /**
+     * Removes all networks from the table.
+     */
+    IPADDRESS_FORCE_INLINE void clear() {
+        _entries.clear();
+        for (auto& trie : _tries) {
+            trie.clear();
+        }
+    }
+
+    /**
+     * Inserts a network with the associated value, or replaces the value if the network is already present.
+     *
+     * @code{.cpp}
+     *   ip_prefix_table<ipv4_network, int> table;
+     *   table.insert(ipv4_network::parse("10.0.0.0/8"), 1);
+     *   table.insert(ipv4_network::parse("10.1.0.0/16"), 2);
+     * @endcode
+     * @param[in] network the network to insert.
+     * @param[in] value the value associated with the network.
+     * @return `true` if a new network was inserted, `false` if the value of an existing one was replaced.
+     */
+    IPADDRESS_FORCE_INLINE bool insert(const network_type& network, const mapped_type& value) {
+        const auto& address = network.network_address();
+        const auto key = traits::key(address);
+        auto& trie = _tries[traits::index(address)];
+        const auto payload = trie.find(key, network.prefixlen());
+        if (payload != internal::prefix_trie::npos) {
+            _entries[payload].second = value;
+            return false;
+        }
+        trie.insert(key, network.prefixlen(), uint32_t(_entries.size()));
+        _entries.emplace_back(network, value);
+        return true;
+    }
+
+    /**
+     * Removes a network from the table.
+     *
+     * @param[in] network the network to remove.
+     * @return `true` if the network was found and removed, `false` otherwise.
+     */
+    IPADDRESS_FORCE_INLINE bool erase(const network_type& network) {
+        const auto& address = network.network_address();
+        const auto payload = _tries[traits::index(address)].erase(traits::key(address), network.prefixlen());
+        if (payload == internal::prefix_trie::npos) {
+            return false;
+        }
+        const auto last = uint32_t(_entries.size() - 1);
+        if (payload != last) {
+            _entries[payload] = std::move(_entries[last]);
+            const auto& moved = _entries[payload].first.network_address();
+            _tries[traits::index(moved)].insert(traits::key(moved), _entries[payload].first.prefixlen(), payload);
+        }
+        _entries.pop_back();
+        return true;
+    }
+
+    /**
+     * Finds the entry stored for exactly the given network.
+     *
+     * @param[in] network the network to look up.
+     * @return A pointer to the entry, or `nullptr` if the network is not in the table.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE const value_type* find(const network_type& network) const IPADDRESS_NOEXCEPT {
+        const auto& address = network.network_address();
+        return entry(_tries[traits::index(address)].find(traits::key(address), network.prefixlen()));
+    }
+
+    /**
+     * Finds the most specific network containing the address.
+     *
+     * @code{.cpp}
+     *   const auto* match = table.longest_match(ipv4_address::parse("10.1.2.3"));
+     *   if (match) {
+     *       std::cout << match->first << " -> " << match->second << std::endl; // 10.1.0.0/16 -> 2
+     *   }
+     * @endcode
+     * @param[in] address the address to look up.
+     * @return A pointer to the matching entry, or `nullptr` if no stored network contains the address.
+     * @remark build() must be called after the last modification of the table. Otherwise the lookup
+     *         asserts in debug builds and returns `nullptr` in release builds.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE const value_type* longest_match(const address_type& address) const IPADDRESS_NOEXCEPT {
+        const auto& trie = _tries[traits::index(address)];
+        assert(!trie.dirty() && "ip_prefix_table::build() must be called after modifications");
+        return trie.dirty() ? nullptr : entry(trie.longest_match(traits::key(address)));
+    }
+
+    /**
+     * Finds all networks containing the address.
+     *
+     * @param[in] address the address to look up.
+     * @return Pointers to the matching entries, ordered from the least to the most specific network.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE std::vector<const value_type*> all_matches(const address_type& address) const {
+        std::vector<const value_type*> result;
+        _tries[traits::index(address)].matches(traits::key(address), address.size() * 8, [this, &result](uint32_t payload) {
+            result.push_back(&_entries[payload]);
+        });
+        return result;
+    }
+
+    /**
+     * Builds the lookup structure used by longest_match().
+     *
+     * Must be called after a batch of modifications and before the next longest_match().
+     * Only the parts of the table that were modified are rebuilt.
+     */
+    IPADDRESS_FORCE_INLINE void build() {
+        for (auto& trie : _tries) {
+            if (trie.dirty()) {
+                trie.build();
+            }
+        }
+    }
+
+private:
+    using traits = internal::prefix_table_traits<network_type>;
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE const value_type* entry(uint32_t payload) const IPADDRESS_NOEXCEPT {
+        return payload != internal::prefix_trie::npos ? &_entries[payload] : nullptr;
+    }
+
+    internal::prefix_trie _tries[traits::tries];
+    std::vector<value_type> _entries;
+};
+
+} // namespace IPADDRESS_NAMESPACE
+
+#endif // IPADDRESS_IP_PREFIX_TABLE_HPP
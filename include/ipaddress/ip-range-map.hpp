@@ -0,0 +1,335 @@
+/**
+ * @file      ip-range-map.hpp
+ * @brief     Map from IP address ranges to values
+ * @author    Vladimir Shaleev
+ * @copyright MIT License
+ *
+ * This file defines the ip_range_map class template, an immutable associative container that
+ * maps disjoint address ranges to values, as found in GeoIP and ASN databases. The map is built
+ * in bulk and stores the range bounds as plain integers in Eytzinger (breadth-first) order, with
+ * the values kept in a separate array. A lookup is a branch-free descent over a compact key array
+ * whose first levels stay in cache, instead of chasing the nodes of a balanced tree.
+ */
+
+#ifndef IPADDRESS_IP_RANGE_MAP_HPP
+#define IPADDRESS_IP_RANGE_MAP_HPP
+
+#include "ip-any-network.hpp"
+#include "eytzinger.hpp"
+
+namespace IPADDRESS_NAMESPACE {
+
+namespace internal {
+
+template <typename UInt>
+struct range_entry {
+    UInt first;
+    UInt last;
+    size_t index;
+};
+
+// Ranges laid out in Eytzinger order, see eytzinger.hpp. The search runs over the last addresses, which are sorted as well since the ranges are disjoint.
+template <typename UInt>
+struct range_layout {
+    std::vector<UInt> last;
+    std::vector<UInt> first;
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_t size() const IPADDRESS_NOEXCEPT {
+        return last.empty() ? 0 : last.size() - 1;
+    }
+
+    // Returns the slot of the range containing the value, or 0 if there is none
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_t find(const UInt& value) const IPADDRESS_NOEXCEPT {
+        const auto k = eytzinger_lower_bound(eytzinger_descend(last.data(), size(), value));
+        return k != 0 && first[k] <= value ? k : 0;
+    }
+
+    IPADDRESS_FORCE_INLINE void clear() IPADDRESS_NOEXCEPT {
+        std::vector<UInt>().swap(last);
+        std::vector<UInt>().swap(first);
+    }
+};
+
+// Sorts the entries by their first address, checks that they are disjoint and arranges
+// them in Eytzinger order. Returns the input indexes of the entries in that order.
+template <typename UInt>
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE std::vector<size_t> range_layout_build(range_layout<UInt>& layout, std::vector<range_entry<UInt>>& entries, error_code& code) {
+    const auto less = [](const range_entry<UInt>& lhs, const range_entry<UInt>& rhs) {
+        return lhs.first < rhs.first;
+    };
+    if (!std::is_sorted(entries.begin(), entries.end(), less)) {
+        std::sort(entries.begin(), entries.end(), less);
+    }
+    for (size_t i = 1; i < entries.size(); ++i) {
+        if (entries[i].first <= entries[i - 1].last) {
+            code = error_code::overlapping_ranges;
+            return {};
+        }
+    }
+
+    const auto n = entries.size();
+    layout.last.resize(n + 1);
+    layout.first.resize(n + 1);
+    std::vector<size_t> order(n + 1);
+    eytzinger_build(n, [&](size_t i, size_t k) {
+        layout.last[k] = entries[i].last;
+        layout.first[k] = entries[i].first;
+        order[k] = entries[i].index;
+    });
+    return order;
+}
+
+template <typename>
+struct range_map_traits;
+
+template <>
+struct range_map_traits<ipv4_address> {
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE bool is_v4(const ipv4_address& /*address*/) IPADDRESS_NOEXCEPT {
+        return true;
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE uint32_t to_v4(const ipv4_address& address) IPADDRESS_NOEXCEPT {
+        return address.to_uint();
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE uint128_t to_v6(const ipv4_address& /*address*/) IPADDRESS_NOEXCEPT {
+        return 0;
+    }
+};
+
+template <>
+struct range_map_traits<ipv6_address> {
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE bool is_v4(const ipv6_address& /*address*/) IPADDRESS_NOEXCEPT {
+        return false;
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE uint32_t to_v4(const ipv6_address& /*address*/) IPADDRESS_NOEXCEPT {
+        return 0;
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE uint128_t to_v6(const ipv6_address& address) IPADDRESS_NOEXCEPT {
+        return address.to_uint();
+    }
+};
+
+template <>
+struct range_map_traits<ip_address> {
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE bool is_v4(const ip_address& address) IPADDRESS_NOEXCEPT {
+        return address.is_v4();
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE uint32_t to_v4(const ip_address& address) IPADDRESS_NOEXCEPT {
+        return address.to_uint32();
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE uint128_t to_v6(const ip_address& address) IPADDRESS_NOEXCEPT {
+        return address.to_uint128();
+    }
+};
+
+} // namespace IPADDRESS_NAMESPACE::internal
+
+/**
+ * An immutable map from disjoint IP address ranges to values.
+ *
+ * The map is built in bulk from `((first, last), value)` pairs, for example the entries of a
+ * `std::map<std::pair<ipv4_address, ipv4_address>, Value>` or the rows of a GeoIP file, and
+ * answers which range, if any, contains a given address in O(log n). IPv4 and IPv6 ranges may
+ * be mixed in one map. Range bounds are stored as 32-bit and 128-bit integers in Eytzinger
+ * order, and the values are stored in a separate array, so for small values an IPv4 range
+ * costs little more than its two bounds.
+ *
+ * @code{.cpp}
+ *   const std::vector<std::pair<std::pair<ipv4_address, ipv4_address>, std::string>> rows = {
+ *       { { ipv4_address::parse("1.0.0.0"), ipv4_address::parse("1.0.0.255") }, "AU" },
+ *       { { ipv4_address::parse("1.0.1.0"), ipv4_address::parse("1.0.3.255") }, "CN" } };
+ *
+ *   const ip_range_map<std::string> geo(rows.begin(), rows.end());
+ *   const auto* country = geo.find(ipv4_address::parse("1.0.2.7"));
+ *   std::cout << (country ? *country : "unknown") << std::endl;
+ *
+ *   // out:
+ *   // CN
+ * @endcode
+ * @tparam Value the type of the mapped values.
+ * @remark The scope id of IPv6 addresses is not taken into account.
+ */
+IPADDRESS_EXPORT template <typename Value>
+class ip_range_map {
+public:
+    using mapped_type = Value; /**< The type of the mapped values. */
+    using size_type   = size_t; /**< An unsigned integer type. */
+
+    /**
+     * Default constructor. Creates an empty map.
+     */
+    ip_range_map() = default;
+
+    /**
+     * Creates a map from a range of `((first, last), value)` pairs.
+     *
+     * @tparam It the type of the iterator.
+     * @param[in] first the beginning of the range of entries.
+     * @param[in] last the end of the range of entries.
+     * @throw logic_error Raise if a range has addresses of different versions, its first address
+     *                    is greater than its last one, or two ranges overlap.
+     */
+    template <typename It>
+    IPADDRESS_FORCE_INLINE ip_range_map(It first, It last) {
+        assign(first, last);
+    }
+
+    /**
+     * Replaces the contents of the map with a range of `((first, last), value)` pairs.
+     *
+     * The entries are expected to be sorted by their first address, which is the order of
+     * typical range files; unsorted input is accepted but sorted first.
+     *
+     * @tparam It the type of the iterator.
+     * @param[in] first the beginning of the range of entries.
+     * @param[in] last the end of the range of entries.
+     * @param[out] code an error_code object that will be set if an error occurs; the map is left empty in this case.
+     */
+    template <typename It>
+    IPADDRESS_FORCE_INLINE void assign(It first, It last, error_code& code) {
+        using address_type = typename std::decay<decltype(first->first.first)>::type;
+        using traits = internal::range_map_traits<address_type>;
+
+        code = error_code::no_error;
+        clear();
+
+        std::vector<Value> values;
+        std::vector<internal::range_entry<uint32_t>> entries4;
+        std::vector<internal::range_entry<uint128_t>> entries6;
+        for (; first != last; ++first) {
+            const auto& lower = first->first.first;
+            const auto& upper = first->first.second;
+            if (lower.version() != upper.version()) {
+                code = error_code::invalid_version;
+                return;
+            }
+            if (lower > upper) {
+                code = error_code::last_address_must_be_greater_than_first;
+                return;
+            }
+            if (traits::is_v4(lower)) {
+                entries4.push_back(internal::range_entry<uint32_t> { traits::to_v4(lower), traits::to_v4(upper), values.size() });
+            } else {
+                entries6.push_back(internal::range_entry<uint128_t> { traits::to_v6(lower), traits::to_v6(upper), values.size() });
+            }
+            values.push_back(first->second);
+        }
+
+        const auto order4 = internal::range_layout_build(_v4, entries4, code);
+        const auto order6 = code == error_code::no_error ? internal::range_layout_build(_v6, entries6, code) : std::vector<size_t>();
+        if (code != error_code::no_error) {
+            clear();
+            return;
+        }
+        _values.reserve(values.size());
+        for (size_t k = 1; k < order4.size(); ++k) {
+            _values.push_back(std::move(values[order4[k]]));
+        }
+        for (size_t k = 1; k < order6.size(); ++k) {
+            _values.push_back(std::move(values[order6[k]]));
+        }
+    }
+
+    /**
+     * Replaces the contents of the map with a range of `((first, last), value)` pairs.
+     *
+     * @tparam It the type of the iterator.
+     * @param[in] first the beginning of the range of entries.
+     * @param[in] last the end of the range of entries.
+     * @throw logic_error Raise if a range has addresses of different versions, its first address
+     *                    is greater than its last one, or two ranges overlap.
+     */
+    template <typename It>
+    IPADDRESS_FORCE_INLINE void assign(It first, It last) {
+        error_code code = error_code::no_error;
+        assign(first, last, code);
+        if (code != error_code::no_error) {
+            raise_error(code, 0, "", 0);
+        }
+    }
+
+    /**
+     * Returns the number of ranges in the map.
+     *
+     * @return The number of ranges.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_type size() const IPADDRESS_NOEXCEPT {
+        return _values.size();
+    }
+
+    /**
+     * Checks whether the map has no ranges.
+     *
+     * @return `true` if the map is empty, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool empty() const IPADDRESS_NOEXCEPT {
+        return _values.empty();
+    }
+
+    /**
+     * Removes all ranges and releases the memory.
+     */
+    IPADDRESS_FORCE_INLINE void clear() IPADDRESS_NOEXCEPT {
+        _v4.clear();
+        _v6.clear();
+        std::vector<Value>().swap(_values);
+    }
+
+    /**
+     * Finds the value of the range containing an IPv4 address.
+     *
+     * @param[in] address the address to look up.
+     * @return A pointer to the value, or `nullptr` if no range contains the address.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE const Value* find(const ipv4_address& address) const IPADDRESS_NOEXCEPT {
+        const auto k = _v4.find(address.to_uint());
+        return k != 0 ? &_values[k - 1] : nullptr;
+    }
+
+    /**
+     * Finds the value of the range containing an IPv6 address.
+     *
+     * @param[in] address the address to look up.
+     * @return A pointer to the value, or `nullptr` if no range contains the address.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE const Value* find(const ipv6_address& address) const IPADDRESS_NOEXCEPT {
+        const auto k = _v6.find(address.to_uint());
+        return k != 0 ? &_values[_v4.size() + k - 1] : nullptr;
+    }
+
+    /**
+     * Finds the value of the range containing an IP address.
+     *
+     * @param[in] address the address to look up.
+     * @return A pointer to the value, or `nullptr` if no range contains the address.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE const Value* find(const ip_address& address) const IPADDRESS_NOEXCEPT {
+        return address.is_v4() ? find(ipv4_address::from_uint(address.to_uint32())) : find(ipv6_address::from_uint(address.to_uint128()));
+    }
+
+    /**
+     * Checks whether any range contains an address.
+     *
+     * @tparam Ip the address type: ipv4_address, ipv6_address or ip_address.
+     * @param[in] address the address to look up.
+     * @return `true` if a range contains the address, `false` otherwise.
+     */
+    template <typename Ip>
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool contains(const Ip& address) const IPADDRESS_NOEXCEPT {
+        return find(address) != nullptr;
+    }
+
+private:
+    internal::range_layout<uint32_t> _v4;
+    internal::range_layout<uint128_t> _v6;
+    std::vector<Value> _values;
+};
+
+} // namespace IPADDRESS_NAMESPACE
+
+#endif // IPADDRESS_IP_RANGE_MAP_HPP
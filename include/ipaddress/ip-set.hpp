@@ -0,0 +1,693 @@
+/**
+ * @file      ip-set.hpp
+ * @brief     Set of IP addresses with union, intersection and difference
+ * @author    Vladimir Shaleev
+ * @copyright MIT License
+ *
+ * This file defines the ip_set class template, which stores an arbitrary set of IP addresses
+ * as sorted, disjoint and non-adjacent intervals of integers. Set algebra is performed with
+ * a single merge pass over the interval lists of both operands, so combining sets of millions
+ * of networks takes time linear in the number of intervals. The set is presented to the user
+ * as the minimal list of networks that covers it, produced on the fly by summarize_address_range.
+ */
+
+#ifndef IPADDRESS_IP_SET_HPP
+#define IPADDRESS_IP_SET_HPP
+
+#include "ip-functions.hpp"
+
+namespace IPADDRESS_NAMESPACE {
+
+namespace internal {
+
+template <typename UInt>
+struct ip_interval {
+    UInt first;
+    UInt last;
+};
+
+template <typename UInt>
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool operator==(const ip_interval<UInt>& lhs, const ip_interval<UInt>& rhs) IPADDRESS_NOEXCEPT {
+    return lhs.first == rhs.first && lhs.last == rhs.last;
+}
+
+template <typename UInt>
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool operator!=(const ip_interval<UInt>& lhs, const ip_interval<UInt>& rhs) IPADDRESS_NOEXCEPT {
+    return !(lhs == rhs);
+}
+
+template <typename UInt>
+using ip_intervals = std::vector<ip_interval<UInt>>;
+
+template <typename UInt>
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE UInt interval_hostmask(size_t prefixlen, size_t max_prefixlen) IPADDRESS_NOEXCEPT {
+    return prefixlen == 0 ? ~UInt(0) : (UInt(1) << (max_prefixlen - prefixlen)) - UInt(1);
+}
+
+// Appends an interval that does not start before the last one, joining it
+// with the last interval when the two overlap or touch.
+template <typename UInt>
+IPADDRESS_FORCE_INLINE void interval_append(ip_intervals<UInt>& result, const ip_interval<UInt>& item) {
+    if (!result.empty()) {
+        auto& back = result.back();
+        if (back.last == ~UInt(0) || item.first <= back.last + UInt(1)) {
+            if (back.last < item.last) {
+                back.last = item.last;
+            }
+            return;
+        }
+    }
+    result.push_back(item);
+}
+
+template <size_t KeySize, typename UInt>
+IPADDRESS_FORCE_INLINE void interval_build(ip_intervals<UInt>& result, std::vector<collapse_item<UInt>>& items, size_t max_prefixlen) {
+    std::vector<collapse_item<UInt>> temp;
+    std::vector<size_t> counts;
+    collapse_sort<KeySize>(items, temp, counts);
+    result.clear();
+    for (const auto& item : items) {
+        interval_append(result, ip_interval<UInt> { item.address, item.address | interval_hostmask<UInt>(item.prefixlen, max_prefixlen) });
+    }
+}
+
+template <typename UInt>
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE ip_intervals<UInt> interval_union(const ip_intervals<UInt>& lhs, const ip_intervals<UInt>& rhs) {
+    ip_intervals<UInt> result;
+    result.reserve(lhs.size() + rhs.size());
+    size_t i = 0;
+    size_t j = 0;
+    while (i < lhs.size() && j < rhs.size()) {
+        interval_append(result, lhs[i].first < rhs[j].first ? lhs[i++] : rhs[j++]);
+    }
+    for (; i < lhs.size(); ++i) {
+        interval_append(result, lhs[i]);
+    }
+    for (; j < rhs.size(); ++j) {
+        interval_append(result, rhs[j]);
+    }
+    return result;
+}
+
+// Pieces of the intersection are always separated by a gap of one of the
+// operands, so they come out disjoint and non-adjacent without extra work.
+template <typename UInt>
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE ip_intervals<UInt> interval_intersection(const ip_intervals<UInt>& lhs, const ip_intervals<UInt>& rhs) {
+    ip_intervals<UInt> result;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < lhs.size() && j < rhs.size()) {
+        const auto& first = lhs[i].first < rhs[j].first ? rhs[j].first : lhs[i].first;
+        const auto& last = lhs[i].last < rhs[j].last ? lhs[i].last : rhs[j].last;
+        if (first <= last) {
+            result.push_back(ip_interval<UInt> { first, last });
+        }
+        if (lhs[i].last < rhs[j].last) {
+            ++i;
+        } else {
+            ++j;
+        }
+    }
+    return result;
+}
+
+template <typename UInt>
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE ip_intervals<UInt> interval_difference(const ip_intervals<UInt>& lhs, const ip_intervals<UInt>& rhs) {
+    ip_intervals<UInt> result;
+    size_t j = 0;
+    for (const auto& item : lhs) {
+        auto first = item.first;
+        auto covered = false;
+        while (j < rhs.size() && rhs[j].last < first) {
+            ++j;
+        }
+        for (; j < rhs.size() && rhs[j].first <= item.last; ++j) {
+            if (first < rhs[j].first) {
+                result.push_back(ip_interval<UInt> { first, rhs[j].first - UInt(1) });
+            }
+            if (item.last <= rhs[j].last) {
+                covered = true;
+                break;
+            }
+            first = rhs[j].last + UInt(1);
+        }
+        if (!covered) {
+            result.push_back(ip_interval<UInt> { first, item.last });
+        }
+    }
+    return result;
+}
+
+template <typename UInt>
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE ip_intervals<UInt> interval_symmetric_difference(const ip_intervals<UInt>& lhs, const ip_intervals<UInt>& rhs) {
+    return interval_difference(interval_union(lhs, rhs), interval_intersection(lhs, rhs));
+}
+
+template <typename UInt>
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE const ip_interval<UInt>* interval_find(const ip_intervals<UInt>& intervals, const UInt& value) IPADDRESS_NOEXCEPT {
+    size_t lo = 0;
+    size_t hi = intervals.size();
+    while (lo < hi) {
+        const auto middle = lo + (hi - lo) / 2;
+        if (value < intervals[middle].first) {
+            hi = middle;
+        } else {
+            lo = middle + 1;
+        }
+    }
+    return lo != 0 && value <= intervals[lo - 1].last ? &intervals[lo - 1] : nullptr;
+}
+
+// Sums the interval lengths, saturating at the maximum of uint128_t since
+// the full IPv6 space holds one address more than it can represent.
+template <typename UInt>
+IPADDRESS_FORCE_INLINE void interval_count(const ip_intervals<UInt>& intervals, uint128_t& result) IPADDRESS_NOEXCEPT {
+    const auto max = ~uint128_t(0);
+    for (const auto& item : intervals) {
+        const auto count = uint128_t(item.last - item.first);
+        if (count == max || max - count - 1 < result) {
+            result = max;
+            return;
+        }
+        result += count + 1;
+    }
+}
+
+template <typename>
+struct ip_set_traits;
+
+template <>
+struct ip_set_traits<ipv4_network> {
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE bool is_v4(const ipv4_address& /*address*/) IPADDRESS_NOEXCEPT {
+        return true;
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE uint32_t to_v4(const ipv4_address& address) IPADDRESS_NOEXCEPT {
+        return address.to_uint();
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE uint128_t to_v6(const ipv4_address& /*address*/) IPADDRESS_NOEXCEPT {
+        return 0;
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE ipv4_address from_v4(uint32_t value) IPADDRESS_NOEXCEPT {
+        return ipv4_address::from_uint(value);
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE ipv4_address from_v6(const uint128_t& /*value*/) IPADDRESS_NOEXCEPT {
+        return ipv4_address(); // never called: the set has no IPv6 intervals
+    }
+};
+
+template <>
+struct ip_set_traits<ipv6_network> {
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE bool is_v4(const ipv6_address& /*address*/) IPADDRESS_NOEXCEPT {
+        return false;
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE uint32_t to_v4(const ipv6_address& /*address*/) IPADDRESS_NOEXCEPT {
+        return 0;
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE uint128_t to_v6(const ipv6_address& address) IPADDRESS_NOEXCEPT {
+        return address.to_uint();
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE ipv6_address from_v4(uint32_t /*value*/) IPADDRESS_NOEXCEPT {
+        return ipv6_address(); // never called: the set has no IPv4 intervals
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE ipv6_address from_v6(const uint128_t& value) IPADDRESS_NOEXCEPT {
+        return ipv6_address::from_uint(value);
+    }
+};
+
+template <>
+struct ip_set_traits<ip_network> {
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE bool is_v4(const ip_address& address) IPADDRESS_NOEXCEPT {
+        return address.is_v4();
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE uint32_t to_v4(const ip_address& address) IPADDRESS_NOEXCEPT {
+        return address.to_uint32();
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE uint128_t to_v6(const ip_address& address) IPADDRESS_NOEXCEPT {
+        return address.to_uint128();
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE ip_address from_v4(uint32_t value) IPADDRESS_NOEXCEPT {
+        return ip_address(ipv4_address::from_uint(value));
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE ip_address from_v6(const uint128_t& value) IPADDRESS_NOEXCEPT {
+        return ip_address(ipv6_address::from_uint(value));
+    }
+};
+
+} // namespace IPADDRESS_NAMESPACE::internal
+
+/**
+ * A set of IP addresses supporting fast set algebra.
+ *
+ * The set is stored as sorted disjoint intervals of addresses, separately for IPv4 and IPv6.
+ * Union, intersection, difference and symmetric difference merge the interval lists of both
+ * operands in a single linear pass. Iterating over the set yields the minimal sorted list of
+ * networks that covers exactly the addresses in the set, computed lazily from the intervals.
+ *
+ * Building a set from a range of networks sorts them with the same radix sort as collapse_addresses.
+ * Single insert and erase operations rebuild the interval list and are therefore linear; when many
+ * networks are added, construct a set from them and combine it in a single operation instead.
+ *
+ * @code{.cpp}
+ *   const auto allow = ip_set<ipv4_network>({ ipv4_network::parse("10.0.0.0/8") });
+ *   const auto deny = ip_set<ipv4_network>({ ipv4_network::parse("10.1.0.0/16"), ipv4_network::parse("10.2.0.0/15") });
+ *   for (const auto& net : allow - deny) {
+ *       std::cout << net << std::endl;
+ *   }
+ *
+ *   // out:
+ *   // 10.0.0.0/16
+ *   // 10.4.0.0/14
+ *   // 10.8.0.0/13
+ *   // 10.16.0.0/12
+ *   // 10.32.0.0/11
+ *   // 10.64.0.0/10
+ *   // 10.128.0.0/9
+ * @endcode
+ * @tparam Net the network type: ipv4_network, ipv6_network or ip_network.
+ * @remark The scope id of IPv6 addresses is not taken into account.
+ */
+IPADDRESS_EXPORT template <typename Net>
+class ip_set {
+    using traits = internal::ip_set_traits<Net>;
+
+public:
+    using network_type = Net; /**< The network type. */
+    using address_type = typename Net::ip_address_type; /**< The address type of the set. */
+    using value_type   = Net; /**< The type of the networks produced by iteration. */
+    using size_type    = size_t; /**< An unsigned integer type. */
+
+    /**
+     * A forward iterator over the minimal networks covering the set, in ascending order.
+     *
+     * The iterator is invalidated by any modification of the set.
+     */
+    class const_iterator {
+        using range_iterator = typename internal::summarize_sequence_type<address_type>::type::const_iterator;
+
+    public:
+        using iterator_category = std::forward_iterator_tag; /**< The category of the iterator. */
+        using value_type        = Net; /**< The type of the values iterated over. */
+        using difference_type   = std::ptrdiff_t; /**< The type representing the difference between two iterators. */
+        using pointer           = const value_type*; /**< The pointer type of the iterated values. */
+        using reference         = const value_type&; /**< The reference type of the iterated values. */
+
+        /**
+         * Default constructor.
+         */
+        const_iterator() = default;
+
+        /**
+         * Dereference operator.
+         *
+         * @return A reference to the current network.
+         */
+        IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE reference operator*() const IPADDRESS_NOEXCEPT {
+            return *_current;
+        }
+
+        /**
+         * Member access operator.
+         *
+         * @return A pointer to the current network.
+         */
+        IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE pointer operator->() const IPADDRESS_NOEXCEPT {
+            return &*_current;
+        }
+
+        /**
+         * Pre-increment operator.
+         *
+         * @return A reference to the incremented iterator.
+         */
+        IPADDRESS_FORCE_INLINE const_iterator& operator++() IPADDRESS_NOEXCEPT {
+            if (++_current == range_iterator()) {
+                ++_index;
+                load();
+            }
+            return *this;
+        }
+
+        /**
+         * Post-increment operator.
+         *
+         * @return The iterator before the increment.
+         */
+        IPADDRESS_FORCE_INLINE const_iterator operator++(int) IPADDRESS_NOEXCEPT {
+            auto tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        /**
+         * Checks if two iterators are equal.
+         *
+         * @param[in] other The iterator to compare with.
+         * @return `true` if both iterators point to the same network, `false` otherwise.
+         */
+        IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool operator==(const const_iterator& other) const IPADDRESS_NOEXCEPT {
+            return _index == other._index && _current == other._current;
+        }
+
+        /**
+         * Checks if two iterators are not equal.
+         *
+         * @param[in] other The iterator to compare with.
+         * @return `true` if the iterators point to different networks, `false` otherwise.
+         */
+        IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool operator!=(const const_iterator& other) const IPADDRESS_NOEXCEPT {
+            return !(*this == other);
+        }
+
+    private:
+        friend class ip_set;
+
+        IPADDRESS_FORCE_INLINE const_iterator(const ip_set* set, size_t index) IPADDRESS_NOEXCEPT : _set(set), _index(index) {
+            load();
+        }
+
+        IPADDRESS_FORCE_INLINE void load() IPADDRESS_NOEXCEPT {
+            const auto v4 = _set->_v4.size();
+            if (_index < v4) {
+                const auto& item = _set->_v4[_index];
+                _current = range_iterator(traits::from_v4(item.first), traits::from_v4(item.last));
+            } else if (_index - v4 < _set->_v6.size()) {
+                const auto& item = _set->_v6[_index - v4];
+                _current = range_iterator(traits::from_v6(item.first), traits::from_v6(item.last));
+            } else {
+                _current = range_iterator();
+            }
+        }
+
+        const ip_set* _set{};
+        size_t _index{};
+        range_iterator _current{};
+    };
+
+    using iterator = const_iterator; /**< Iterator over the networks of the set. */
+
+    /**
+     * Default constructor. Creates an empty set.
+     */
+    ip_set() = default;
+
+    /**
+     * Creates a set containing all addresses of the given networks.
+     *
+     * @tparam It the type of the iterator.
+     * @param[in] first the beginning of the range of networks.
+     * @param[in] last the end of the range of networks.
+     */
+    template <typename It>
+    IPADDRESS_FORCE_INLINE ip_set(It first, It last) {
+        std::vector<internal::collapse_item<uint32_t>> items4;
+        std::vector<internal::collapse_item<uint128_t>> items6;
+        for (; first != last; ++first) {
+            const auto& network = *first;
+            const auto& address = network.network_address();
+            const auto prefixlen = uint32_t(network.prefixlen());
+            if (traits::is_v4(address)) {
+                items4.push_back(internal::collapse_item<uint32_t> { traits::to_v4(address), prefixlen });
+            } else {
+                items6.push_back(internal::collapse_item<uint128_t> { traits::to_v6(address), prefixlen });
+            }
+        }
+        internal::interval_build<4>(_v4, items4, ipv4_address::base_max_prefixlen);
+        internal::interval_build<16>(_v6, items6, ipv6_address::base_max_prefixlen);
+    }
+
+    /**
+     * Creates a set containing all addresses of the given networks.
+     *
+     * @param[in] networks the networks to add.
+     */
+    IPADDRESS_FORCE_INLINE ip_set(std::initializer_list<network_type> networks) : ip_set(networks.begin(), networks.end()) {
+    }
+
+    /**
+     * Returns an iterator to the first network of the set.
+     *
+     * @return An iterator to the lowest network.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE const_iterator begin() const IPADDRESS_NOEXCEPT {
+        return const_iterator(this, 0);
+    }
+
+    /**
+     * Returns an iterator past the last network of the set.
+     *
+     * @return An iterator past the highest network.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE const_iterator end() const IPADDRESS_NOEXCEPT {
+        return const_iterator(this, _v4.size() + _v6.size());
+    }
+
+    /**
+     * Checks whether the set contains no addresses.
+     *
+     * @return `true` if the set is empty, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool empty() const IPADDRESS_NOEXCEPT {
+        return _v4.empty() && _v6.empty();
+    }
+
+    /**
+     * Returns the number of disjoint address ranges the set is made of.
+     *
+     * @return The number of address ranges.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_type ranges_count() const IPADDRESS_NOEXCEPT {
+        return _v4.size() + _v6.size();
+    }
+
+    /**
+     * Returns the number of addresses in the set.
+     *
+     * @return The number of addresses, saturated at the maximum value of uint128_t.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE uint128_t addresses_count() const IPADDRESS_NOEXCEPT {
+        uint128_t result = 0;
+        internal::interval_count(_v4, result);
+        internal::interval_count(_v6, result);
+        return result;
+    }
+
+    /**
+     * Checks whether an address belongs to the set.
+     *
+     * @param[in] address the address to check.
+     * @return `true` if the set contains the address, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool contains(const address_type& address) const IPADDRESS_NOEXCEPT {
+        return traits::is_v4(address)
+            ? internal::interval_find(_v4, traits::to_v4(address)) != nullptr
+            : internal::interval_find(_v6, traits::to_v6(address)) != nullptr;
+    }
+
+    /**
+     * Checks whether all addresses of a network belong to the set.
+     *
+     * @param[in] network the network to check.
+     * @return `true` if the set contains the whole network, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool contains(const network_type& network) const IPADDRESS_NOEXCEPT {
+        const auto& address = network.network_address();
+        if (traits::is_v4(address)) {
+            const auto* item = internal::interval_find(_v4, traits::to_v4(address));
+            return item && traits::to_v4(network.broadcast_address()) <= item->last;
+        }
+        const auto* item = internal::interval_find(_v6, traits::to_v6(address));
+        return item && traits::to_v6(network.broadcast_address()) <= item->last;
+    }
+
+    /**
+     * Removes all addresses from the set.
+     */
+    IPADDRESS_FORCE_INLINE void clear() IPADDRESS_NOEXCEPT {
+        _v4.clear();
+        _v6.clear();
+    }
+
+    /**
+     * Adds the addresses of a network to the set.
+     *
+     * @param[in] network the network to add.
+     * @remark Takes time linear in the size of the set.
+     */
+    IPADDRESS_FORCE_INLINE void insert(const network_type& network) {
+        *this |= ip_set({ network });
+    }
+
+    /**
+     * Removes the addresses of a network from the set.
+     *
+     * @param[in] network the network to remove.
+     * @remark Takes time linear in the size of the set.
+     */
+    IPADDRESS_FORCE_INLINE void erase(const network_type& network) {
+        *this -= ip_set({ network });
+    }
+
+    /**
+     * Computes the union of two sets.
+     *
+     * @param[in] other the other set.
+     * @return A set with the addresses contained in either set.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE ip_set set_union(const ip_set& other) const {
+        return ip_set(internal::interval_union(_v4, other._v4), internal::interval_union(_v6, other._v6));
+    }
+
+    /**
+     * Computes the intersection of two sets.
+     *
+     * @param[in] other the other set.
+     * @return A set with the addresses contained in both sets.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE ip_set set_intersection(const ip_set& other) const {
+        return ip_set(internal::interval_intersection(_v4, other._v4), internal::interval_intersection(_v6, other._v6));
+    }
+
+    /**
+     * Computes the difference of two sets.
+     *
+     * @param[in] other the set of addresses to remove.
+     * @return A set with the addresses of this set that are not contained in the other one.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE ip_set set_difference(const ip_set& other) const {
+        return ip_set(internal::interval_difference(_v4, other._v4), internal::interval_difference(_v6, other._v6));
+    }
+
+    /**
+     * Computes the symmetric difference of two sets.
+     *
+     * @param[in] other the other set.
+     * @return A set with the addresses contained in exactly one of the sets.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE ip_set set_symmetric_difference(const ip_set& other) const {
+        return ip_set(internal::interval_symmetric_difference(_v4, other._v4), internal::interval_symmetric_difference(_v6, other._v6));
+    }
+
+    /**
+     * Union operator.
+     *
+     * @param[in] other the other set.
+     * @return A set with the addresses contained in either set.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE ip_set operator|(const ip_set& other) const {
+        return set_union(other);
+    }
+
+    /**
+     * Intersection operator.
+     *
+     * @param[in] other the other set.
+     * @return A set with the addresses contained in both sets.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE ip_set operator&(const ip_set& other) const {
+        return set_intersection(other);
+    }
+
+    /**
+     * Difference operator.
+     *
+     * @param[in] other the set of addresses to remove.
+     * @return A set with the addresses of this set that are not contained in the other one.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE ip_set operator-(const ip_set& other) const {
+        return set_difference(other);
+    }
+
+    /**
+     * Symmetric difference operator.
+     *
+     * @param[in] other the other set.
+     * @return A set with the addresses contained in exactly one of the sets.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE ip_set operator^(const ip_set& other) const {
+        return set_symmetric_difference(other);
+    }
+
+    /**
+     * Adds the addresses of another set to this set.
+     *
+     * @param[in] other the other set.
+     * @return A reference to this set.
+     */
+    IPADDRESS_FORCE_INLINE ip_set& operator|=(const ip_set& other) {
+        return *this = set_union(other);
+    }
+
+    /**
+     * Keeps only the addresses that are also contained in another set.
+     *
+     * @param[in] other the other set.
+     * @return A reference to this set.
+     */
+    IPADDRESS_FORCE_INLINE ip_set& operator&=(const ip_set& other) {
+        return *this = set_intersection(other);
+    }
+
+    /**
+     * Removes the addresses of another set from this set.
+     *
+     * @param[in] other the other set.
+     * @return A reference to this set.
+     */
+    IPADDRESS_FORCE_INLINE ip_set& operator-=(const ip_set& other) {
+        return *this = set_difference(other);
+    }
+
+    /**
+     * Replaces this set with the symmetric difference with another set.
+     *
+     * @param[in] other the other set.
+     * @return A reference to this set.
+     */
+    IPADDRESS_FORCE_INLINE ip_set& operator^=(const ip_set& other) {
+        return *this = set_symmetric_difference(other);
+    }
+
+    /**
+     * Checks if two sets contain the same addresses.
+     *
+     * @param[in] other the set to compare with.
+     * @return `true` if the sets are equal, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool operator==(const ip_set& other) const IPADDRESS_NOEXCEPT {
+        return _v4 == other._v4 && _v6 == other._v6;
+    }
+
+    /**
+     * Checks if two sets differ.
+     *
+     * @param[in] other the set to compare with.
+     * @return `true` if the sets are not equal, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool operator!=(const ip_set& other) const IPADDRESS_NOEXCEPT {
+        return !(*this == other);
+    }
+
+private:
+    IPADDRESS_FORCE_INLINE ip_set(internal::ip_intervals<uint32_t>&& v4, internal::ip_intervals<uint128_t>&& v6) IPADDRESS_NOEXCEPT
+        : _v4(std::move(v4)), _v6(std::move(v6)) {
+    }
+
+    internal::ip_intervals<uint32_t> _v4;
+    internal::ip_intervals<uint128_t> _v6;
+};
+
+} // namespace IPADDRESS_NAMESPACE
+
+#endif // IPADDRESS_IP_SET_HPP
@@ -0,0 +1,408 @@
+/**
+ * @file      ip-sorted-index.hpp
+ * @brief     Static index of sorted IP addresses
+ * @author    Vladimir Shaleev
+ * @copyright MIT License
+ *
+ * This file defines the ip_sorted_index class template, an immutable set of IP addresses for
+ * read-mostly membership and neighbour queries over large address lists. Like the range bounds
+ * of ip_range_map, the addresses are stored as plain integers in Eytzinger (breadth-first) order:
+ * the first levels of every search share a handful of cache lines, the descent is branch-free,
+ * and the cache line holding the next four levels is prefetched while the current one is compared.
+ * Batched lookups descend a group of queries level by level, so that the cache misses of
+ * different queries overlap instead of adding up. Defining IPADDRESS_NO_PREFETCH turns the
+ * software prefetch off, for targets where the hardware prefetcher already keeps up with it.
+ */
+
+#ifndef IPADDRESS_IP_SORTED_INDEX_HPP
+#define IPADDRESS_IP_SORTED_INDEX_HPP
+
+#include "ip-range-map.hpp"
+#include "eytzinger.hpp"
+
+namespace IPADDRESS_NAMESPACE {
+
+namespace internal {
+
+// Keys laid out in Eytzinger order, see eytzinger.hpp
+template <typename UInt>
+struct sorted_layout {
+    std::vector<UInt> keys;
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_t size() const IPADDRESS_NOEXCEPT {
+        return keys.empty() ? 0 : keys.size() - 1;
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_t descend(const UInt& value) const IPADDRESS_NOEXCEPT {
+        return eytzinger_descend(keys.data(), size(), value);
+    }
+
+    IPADDRESS_FORCE_INLINE void descend(const UInt* values, size_t count, size_t* leaves) const IPADDRESS_NOEXCEPT {
+        eytzinger_descend(keys.data(), size(), values, count, leaves);
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE size_t lower_bound(size_t leaf) IPADDRESS_NOEXCEPT {
+        return eytzinger_lower_bound(leaf);
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE size_t predecessor(size_t leaf) IPADDRESS_NOEXCEPT {
+        return eytzinger_predecessor(leaf);
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_t front() const IPADDRESS_NOEXCEPT {
+        return eytzinger_front(size());
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_t back() const IPADDRESS_NOEXCEPT {
+        return eytzinger_back(size());
+    }
+
+    IPADDRESS_FORCE_INLINE void clear() IPADDRESS_NOEXCEPT {
+        std::vector<UInt>().swap(keys);
+    }
+};
+
+// Sorts and deduplicates the keys and arranges them in Eytzinger order
+template <typename UInt>
+IPADDRESS_FORCE_INLINE void sorted_layout_build(sorted_layout<UInt>& layout, std::vector<UInt>& keys) {
+    if (!std::is_sorted(keys.begin(), keys.end())) {
+        std::sort(keys.begin(), keys.end());
+    }
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    const auto n = keys.size();
+    if (n == 0) {
+        return;
+    }
+    layout.keys.resize(n + 1);
+    eytzinger_build(n, [&](size_t i, size_t k) {
+        layout.keys[k] = keys[i];
+    });
+}
+
+template <typename>
+struct sorted_index_traits;
+
+template <>
+struct sorted_index_traits<ipv4_address> : range_map_traits<ipv4_address> {
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE ipv4_address from_v4(uint32_t value) IPADDRESS_NOEXCEPT {
+        return ipv4_address::from_uint(value);
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE ipv4_address from_v6(const uint128_t& /*value*/) IPADDRESS_NOEXCEPT {
+        return ipv4_address();
+    }
+};
+
+template <>
+struct sorted_index_traits<ipv6_address> : range_map_traits<ipv6_address> {
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE ipv6_address from_v4(uint32_t /*value*/) IPADDRESS_NOEXCEPT {
+        return ipv6_address();
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE ipv6_address from_v6(const uint128_t& value) IPADDRESS_NOEXCEPT {
+        return ipv6_address::from_uint(value);
+    }
+};
+
+template <>
+struct sorted_index_traits<ip_address> : range_map_traits<ip_address> {
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE ip_address from_v4(uint32_t value) IPADDRESS_NOEXCEPT {
+        return ip_address(ipv4_address::from_uint(value));
+    }
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE ip_address from_v6(const uint128_t& value) IPADDRESS_NOEXCEPT {
+        return ip_address(ipv6_address::from_uint(value));
+    }
+};
+
+} // namespace IPADDRESS_NAMESPACE::internal
+
+/**
+ * An immutable sorted set of IP addresses.
+ *
+ * The index is built in bulk from a range of addresses, for example a blocklist or the
+ * addresses seen in a log, and answers membership, lower bound and predecessor queries in
+ * O(log n) with far fewer cache misses than a binary search over a sorted `std::vector`.
+ * The addresses are ordered as by `operator<`, so for ip_address all IPv4 addresses
+ * precede the IPv6 ones. Duplicates are stored once.
+ *
+ * When many addresses are looked up at once, the batched overloads of contains and
+ * lower_bound process them in groups and overlap their memory accesses, which is
+ * several times faster than a loop of single lookups on indexes that do not fit in cache.
+ *
+ * @code{.cpp}
+ *   const std::vector<ipv4_address> addresses = load_blocklist();
+ *   const ip_sorted_index<ipv4_address> index(addresses.begin(), addresses.end());
+ *
+ *   if (index.contains(ipv4_address::parse("192.0.2.1"))) {
+ *       // ...
+ *   }
+ *
+ *   std::vector<char> blocked(queries.size());
+ *   index.contains(queries.begin(), queries.end(), blocked.begin());
+ * @endcode
+ * @tparam Address the type of the addresses: ipv4_address, ipv6_address or ip_address.
+ * @remark The scope id of IPv6 addresses is not taken into account.
+ */
+IPADDRESS_EXPORT template <typename Address>
+class ip_sorted_index {
+public:
+    using value_type = Address; /**< The type of the addresses. */
+    using size_type  = size_t; /**< An unsigned integer type. */
+
+    /**
+     * Default constructor. Creates an empty index.
+     */
+    ip_sorted_index() = default;
+
+    /**
+     * Creates an index from a range of addresses.
+     *
+     * @tparam It the type of the iterator.
+     * @param[in] first the beginning of the range of addresses.
+     * @param[in] last the end of the range of addresses.
+     */
+    template <typename It>
+    IPADDRESS_FORCE_INLINE ip_sorted_index(It first, It last) {
+        assign(first, last);
+    }
+
+    /**
+     * Replaces the contents of the index with a range of addresses.
+     *
+     * The addresses do not have to be sorted or unique, but sorted input is built faster.
+     *
+     * @tparam It the type of the iterator.
+     * @param[in] first the beginning of the range of addresses.
+     * @param[in] last the end of the range of addresses.
+     */
+    template <typename It>
+    IPADDRESS_FORCE_INLINE void assign(It first, It last) {
+        clear();
+        std::vector<uint32_t> keys4;
+        std::vector<uint128_t> keys6;
+        for (; first != last; ++first) {
+            const Address& address = *first;
+            if (traits::is_v4(address)) {
+                keys4.push_back(traits::to_v4(address));
+            } else {
+                keys6.push_back(traits::to_v6(address));
+            }
+        }
+        internal::sorted_layout_build(_v4, keys4);
+        internal::sorted_layout_build(_v6, keys6);
+    }
+
+    /**
+     * Returns the number of addresses in the index.
+     *
+     * @return The number of addresses.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_type size() const IPADDRESS_NOEXCEPT {
+        return _v4.size() + _v6.size();
+    }
+
+    /**
+     * Checks whether the index has no addresses.
+     *
+     * @return `true` if the index is empty, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool empty() const IPADDRESS_NOEXCEPT {
+        return size() == 0;
+    }
+
+    /**
+     * Removes all addresses and releases the memory.
+     */
+    IPADDRESS_FORCE_INLINE void clear() IPADDRESS_NOEXCEPT {
+        _v4.clear();
+        _v6.clear();
+    }
+
+    /**
+     * Checks whether the index contains an address.
+     *
+     * @param[in] address the address to look up.
+     * @return `true` if the address is in the index, `false` otherwise.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool contains(const Address& address) const IPADDRESS_NOEXCEPT {
+        if (traits::is_v4(address)) {
+            const auto value = traits::to_v4(address);
+            return contains_v4(_v4.descend(value), value);
+        }
+        const auto value = traits::to_v6(address);
+        return contains_v6(_v6.descend(value), value);
+    }
+
+    /**
+     * Finds the smallest address in the index that is not less than the given one.
+     *
+     * @param[in] address the address to look up.
+     * @return The found address, or an empty optional if all addresses are less than the given one.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE optional<Address> lower_bound(const Address& address) const IPADDRESS_NOEXCEPT {
+        return traits::is_v4(address)
+            ? lower_bound_v4(_v4.descend(traits::to_v4(address)))
+            : lower_bound_v6(_v6.descend(traits::to_v6(address)));
+    }
+
+    /**
+     * Finds the greatest address in the index that is less than the given one.
+     *
+     * @param[in] address the address to look up.
+     * @return The found address, or an empty optional if no address is less than the given one.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE optional<Address> predecessor(const Address& address) const IPADDRESS_NOEXCEPT {
+        return traits::is_v4(address)
+            ? predecessor_v4(_v4.descend(traits::to_v4(address)))
+            : predecessor_v6(_v6.descend(traits::to_v6(address)));
+    }
+
+    /**
+     * Checks which of a range of addresses are in the index.
+     *
+     * Writes one `bool` per address to \a out. The addresses are looked up in groups whose
+     * memory accesses overlap, which pays off when the index does not fit in cache.
+     *
+     * @tparam InputIt the type of the input iterator.
+     * @tparam OutputIt the type of the output iterator.
+     * @param[in] first the beginning of the range of addresses to look up.
+     * @param[in] last the end of the range of addresses to look up.
+     * @param[out] out the beginning of the destination range.
+     * @return Output iterator to the element past the last element written.
+     */
+    template <typename InputIt, typename OutputIt>
+    IPADDRESS_FORCE_INLINE OutputIt contains(InputIt first, InputIt last, OutputIt out) const {
+        return lookup(first, last, out, contains_result());
+    }
+
+    /**
+     * Finds the lower bounds of a range of addresses.
+     *
+     * Writes one `optional<Address>` per address to \a out, as lower_bound(const Address&) does.
+     * The addresses are looked up in groups whose memory accesses overlap, which pays off when
+     * the index does not fit in cache.
+     *
+     * @tparam InputIt the type of the input iterator.
+     * @tparam OutputIt the type of the output iterator.
+     * @param[in] first the beginning of the range of addresses to look up.
+     * @param[in] last the end of the range of addresses to look up.
+     * @param[out] out the beginning of the destination range.
+     * @return Output iterator to the element past the last element written.
+     */
+    template <typename InputIt, typename OutputIt>
+    IPADDRESS_FORCE_INLINE OutputIt lower_bound(InputIt first, InputIt last, OutputIt out) const {
+        return lookup(first, last, out, lower_bound_result());
+    }
+
+private:
+    using traits = internal::sorted_index_traits<Address>;
+
+    // Enough queries to keep the memory system busy, few enough for the state to stay in registers and L1
+    static constexpr size_t batch_size = 32;
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool contains_v4(size_t leaf, uint32_t value) const IPADDRESS_NOEXCEPT {
+        const auto k = _v4.lower_bound(leaf);
+        return k != 0 && _v4.keys[k] == value;
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool contains_v6(size_t leaf, const uint128_t& value) const IPADDRESS_NOEXCEPT {
+        const auto k = _v6.lower_bound(leaf);
+        return k != 0 && _v6.keys[k] == value;
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE optional<Address> lower_bound_v4(size_t leaf) const IPADDRESS_NOEXCEPT {
+        const auto k = _v4.lower_bound(leaf);
+        if (k != 0) {
+            return traits::from_v4(_v4.keys[k]);
+        }
+        // Every IPv6 address is greater than any IPv4 one
+        const auto front = _v6.front();
+        return front != 0 ? optional<Address>(traits::from_v6(_v6.keys[front])) : optional<Address>();
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE optional<Address> lower_bound_v6(size_t leaf) const IPADDRESS_NOEXCEPT {
+        const auto k = _v6.lower_bound(leaf);
+        return k != 0 ? optional<Address>(traits::from_v6(_v6.keys[k])) : optional<Address>();
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE optional<Address> predecessor_v4(size_t leaf) const IPADDRESS_NOEXCEPT {
+        const auto k = _v4.predecessor(leaf);
+        return k != 0 ? optional<Address>(traits::from_v4(_v4.keys[k])) : optional<Address>();
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE optional<Address> predecessor_v6(size_t leaf) const IPADDRESS_NOEXCEPT {
+        const auto k = _v6.predecessor(leaf);
+        if (k != 0) {
+            return traits::from_v6(_v6.keys[k]);
+        }
+        // Every IPv4 address is less than any IPv6 one
+        const auto back = _v4.back();
+        return back != 0 ? optional<Address>(traits::from_v4(_v4.keys[back])) : optional<Address>();
+    }
+
+    struct contains_result {
+        IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool v4(const ip_sorted_index& index, size_t leaf, uint32_t value) const IPADDRESS_NOEXCEPT {
+            return index.contains_v4(leaf, value);
+        }
+
+        IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool v6(const ip_sorted_index& index, size_t leaf, const uint128_t& value) const IPADDRESS_NOEXCEPT {
+            return index.contains_v6(leaf, value);
+        }
+    };
+
+    struct lower_bound_result {
+        IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE optional<Address> v4(const ip_sorted_index& index, size_t leaf, uint32_t /*value*/) const IPADDRESS_NOEXCEPT {
+            return index.lower_bound_v4(leaf);
+        }
+
+        IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE optional<Address> v6(const ip_sorted_index& index, size_t leaf, const uint128_t& /*value*/) const IPADDRESS_NOEXCEPT {
+            return index.lower_bound_v6(leaf);
+        }
+    };
+
+    // Splits every group of queries by version, descends each part as a whole and writes
+    // the results back in the order of the queries
+    template <typename InputIt, typename OutputIt, typename Result>
+    IPADDRESS_FORCE_INLINE OutputIt lookup(InputIt first, InputIt last, OutputIt out, Result result) const {
+        uint32_t values4[batch_size];
+        uint128_t values6[batch_size];
+        size_t leaves4[batch_size];
+        size_t leaves6[batch_size];
+        bool is_v4[batch_size];
+        while (first != last) {
+            size_t count = 0;
+            size_t count4 = 0;
+            size_t count6 = 0;
+            for (; first != last && count < batch_size; ++first, ++count) {
+                const Address& address = *first;
+                is_v4[count] = traits::is_v4(address);
+                if (is_v4[count]) {
+                    values4[count4++] = traits::to_v4(address);
+                } else {
+                    values6[count6++] = traits::to_v6(address);
+                }
+            }
+            _v4.descend(values4, count4, leaves4);
+            _v6.descend(values6, count6, leaves6);
+            for (size_t i = 0, i4 = 0, i6 = 0; i < count; ++i, ++out) {
+                if (is_v4[i]) {
+                    *out = result.v4(*this, leaves4[i4], values4[i4]);
+                    ++i4;
+                } else {
+                    *out = result.v6(*this, leaves6[i6], values6[i6]);
+                    ++i6;
+                }
+            }
+        }
+        return out;
+    }
+
+    internal::sorted_layout<uint32_t> _v4;
+    internal::sorted_layout<uint128_t> _v6;
+};
+
+} // namespace IPADDRESS_NAMESPACE
+
+#endif // IPADDRESS_IP_SORTED_INDEX_HPP
@@ -17,8 +17,19 @@
 #include "ipv6-network.hpp"
 #include "ip-networks.hpp"
 #include "ip-any-address.hpp"
+#include "ip-compact-address.hpp"
 #include "ip-any-network.hpp"
 #include "ip-functions.hpp"
+#include "ip-prefix-table.hpp"
+#include "ip-concurrent-prefix-table.hpp"
+#include "ip-network-aggregator.hpp"
+#include "ip-set.hpp"
+#include "ip-range-map.hpp"
+#include "ip-prefix-database.hpp"
+#include "ip-binary.hpp"
+#include "ip-flat-hash.hpp"
+#include "ip-sorted-index.hpp"
+#include "ip-filter.hpp"
 
 /**
  * @namespace ipaddress
@@ -14,6 +14,7 @@
 #define IPADDRESS_IPV4_ADDRESS_HPP
 
 #include "base-v4.hpp"
+#include "simd.hpp"
 
 namespace IPADDRESS_NAMESPACE {
 
@@ -82,6 +83,132 @@ public:
      */
     IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE ipv6_address ipv6_mapped() const IPADDRESS_NOEXCEPT;
 
+    /**
+     * Parses a batch of IPv4 addresses.
+     *
+     * This function is intended for bulk input such as log ingestion. Well-formed dotted-quad
+     * strings are converted by a vectorized kernel when the target supports SSSE3 (and
+     * IPADDRESS_NO_SIMD is not defined); any string rejected by the kernel is passed to the
+     * regular parser, so the results and error codes are exactly the same as those of parse().
+     *
+     * @code{.cpp}
+     *   const std::string_view lines[] = { "192.168.0.1", "10.0.0.256", "8.8.8.8" };
+     *   ipv4_address addresses[3];
+     *   error_code codes[3];
+     *
+     *   const auto parsed = ipv4_address::parse_many(lines, 3, addresses, codes);
+     *
+     *   std::cout << parsed << std::endl; // 2
+     *   std::cout << (codes[1] == error_code::octet_exceeded_255) << std::endl; // 1
+     * @endcode
+     * @tparam Str the string type, such as std::string_view or std::string.
+     * @param[in] addresses pointer to the strings to parse.
+     * @param[in] count number of strings to parse.
+     * @param[out] out pointer to the storage for \a count parsed addresses. Addresses that fail to parse are set to `0.0.0.0`.
+     * @param[out] codes pointer to the storage for \a count error codes, or `nullptr` if error codes are not needed.
+     * @return The number of addresses parsed without errors.
+     */
+    template <typename Str>
+    static IPADDRESS_FORCE_INLINE size_t parse_many(const Str* addresses, size_t count, ip_address_base<ipv4_address_base>* out, error_code* codes = nullptr) IPADDRESS_NOEXCEPT {
+        size_t parsed = 0;
+        for (size_t i = 0; i < count; ++i) {
+            auto code = error_code::no_error;
+            out[i] = parse_chars(addresses[i].data(), addresses[i].size(), code);
+            parsed += code == error_code::no_error ? 1 : 0;
+            if (codes) {
+                codes[i] = code;
+            }
+        }
+        return parsed;
+    }
+
+    /**
+     * Formats a batch of IPv4 addresses.
+     *
+     * Writes the addresses one after another into the range [\a first, \a last), each of them
+     * followed by \a separator: `'\n'` gives line-oriented output for CSV exporters, and `'\0'`
+     * gives a sequence of null-terminated strings. No memory is allocated. A range of
+     * `count * (base_max_string_len + 1)` characters is always large enough.
+     *
+     * @code{.cpp}
+     *   const ipv4_address addresses[] = { ipv4_address::parse("192.168.0.1"), ipv4_address::parse("8.8.8.8") };
+     *   char buffer[2 * (ipv4_address::base_max_string_len + 1)];
+     *
+     *   const auto end = ipv4_address::format_many(addresses, 2, buffer, buffer + sizeof(buffer));
+     *
+     *   std::cout << std::string(buffer, end);
+     *
+     *   // out:
+     *   // 192.168.0.1
+     *   // 8.8.8.8
+     * @endcode
+     * @param[in] addresses pointer to the addresses to format.
+     * @param[in] count number of addresses to format.
+     * @param[out] first the beginning of the output range.
+     * @param[in] last the end of the output range.
+     * @param[in] separator the character written after each address. Defaults to `'\n'`.
+     * @return A pointer one past the last character written, or `nullptr` if the range is too small to hold all addresses.
+     *         In that case nothing is written to the range.
+     */
+    static IPADDRESS_FORCE_INLINE char* format_many(const ip_address_base<ipv4_address_base>* addresses, size_t count, char* first, char* last, char separator = '\n') IPADDRESS_NOEXCEPT {
+        if (size_t(last - first) / (base_max_string_len + 1) < count) {
+            size_t required = 0;
+            for (size_t i = 0; i < count; ++i) {
+                required += ip_string_length(addresses[i].bytes()) + 1;
+            }
+            if (required > size_t(last - first)) {
+                return nullptr;
+            }
+        }
+        for (size_t i = 0; i < count; ++i) {
+            if (size_t(last - first) > base_max_string_len) {
+                first = ip_to_chars(addresses[i].bytes(), first);
+            } else {
+                // ip_to_chars writes past the end of the address, which may not fit in the range
+                char res[base_max_string_len + 1] = {};
+                const auto length = size_t(ip_to_chars(addresses[i].bytes(), res) - res);
+                first = std::copy(res, res + length, first);
+            }
+            *first++ = separator;
+        }
+        return first;
+    }
+
+    /**
+     * Classifies a batch of IPv4 addresses.
+     *
+     * This function is intended for filtering batches of addresses, for example from packet
+     * captures. For each address one byte with the `address_flags` of the address is written,
+     * which is the same value as returned by classify() for that address.
+     *
+     * @code{.cpp}
+     *   const ipv4_address addresses[] = { ipv4_address::parse("192.168.0.1"), ipv4_address::parse("8.8.8.8") };
+     *   uint8_t flags[2];
+     *
+     *   ipv4_address::classify_many(addresses, 2, flags);
+     *
+     *   std::cout << ((address_flags(flags[0]) & address_flags::is_private) != address_flags::none) << std::endl; // 1
+     *   std::cout << ((address_flags(flags[1]) & address_flags::is_global) != address_flags::none) << std::endl; // 1
+     * @endcode
+     * @param[in] addresses pointer to the addresses to classify.
+     * @param[in] count number of addresses to classify.
+     * @param[out] flags pointer to the storage for \a count bytes of flags.
+     */
+    static IPADDRESS_FORCE_INLINE void classify_many(const ip_address_base<ipv4_address_base>* addresses, size_t count, uint8_t* flags) IPADDRESS_NOEXCEPT;
+
+    /**
+     * Classifies a batch of IPv4 addresses given as raw 32-bit values.
+     *
+     * Each value holds the 4 bytes of an address in **network byte order** (big-endian), as they
+     * appear in a packet header, so that addresses can be classified without being converted
+     * first. Otherwise the same as the overload for ipv4_address.
+     *
+     * @param[in] addresses pointer to the addresses to classify, in network byte order.
+     * @param[in] count number of addresses to classify.
+     * @param[out] flags pointer to the storage for \a count bytes of flags.
+     */
+    static IPADDRESS_FORCE_INLINE void classify_many(const uint32_t* addresses, size_t count, uint8_t* flags) IPADDRESS_NOEXCEPT;
+
 protected:
     IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE ipv4_address_base() IPADDRESS_NOEXCEPT = default;
 
@@ -93,7 +220,7 @@ protected:
     }
 
     IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE size_t hash(const base_type& bytes) IPADDRESS_NOEXCEPT {
-        return internal::calc_hash(0, size_t(bytes[0]), size_t(bytes[1]), size_t(bytes[2]), size_t(bytes[3]));
+        return internal::hash_sum(0, size_t(internal::load_be32(bytes.data())));
     }
 
     IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool equals(const ip_address_base<ipv4_address_base>& lhs, const ip_address_base<ipv4_address_base>& rhs) IPADDRESS_NOEXCEPT {
@@ -113,9 +240,26 @@ protected:
 #endif // IPADDRESS_HAS_SPACESHIP_OPERATOR
 
 private:
+    template <typename T>
+    static IPADDRESS_FORCE_INLINE ip_address_base<ipv4_address_base> parse_chars(const T* str, size_t size, error_code& code) IPADDRESS_NOEXCEPT {
+        uint32_t index = 0;
+        return ip_from_string(str, str + size, code, index);
+    }
+
+    static IPADDRESS_FORCE_INLINE ip_address_base<ipv4_address_base> parse_chars(const char* str, size_t size, error_code& code) IPADDRESS_NOEXCEPT {
+    #ifdef IPADDRESS_SSSE3
+        base_type bytes {};
+        if (internal::ipv4_from_chars_ssse3(str, size, bytes.data())) {
+            return ip_address_base<ipv4_address_base>(bytes);
+        }
+    #endif // IPADDRESS_SSSE3
+        uint32_t index = 0;
+        return ip_from_string(str, str + size, code, index);
+    }
+
     template <typename>
     friend class ip_network_base;
-    
+
     base_type _bytes{};
 }; // ipv4_address_base
 
@@ -721,15 +721,16 @@ public:
     IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE ip_address_base<ipv6_address_base> from_uint(uint_type ip) IPADDRESS_NOEXCEPT {
         ip_address_base<ipv6_address_base> result;
         auto& bytes = result._data.bytes;
-        int shift = 0;
-        int inc = 8;
+        const auto upper = ip.upper();
+        const auto lower = ip.lower();
         if (is_little_endian()) {
-            shift = 56;
-            inc = -8;
-        }
-        for (int i = 0, s = shift; i < 8; ++i, s += inc) {
-            bytes[i] = uint8_t(ip.upper() >> s);
-            bytes[i + 8] = uint8_t(ip.lower() >> s);
+            internal::store_be64(bytes.data(), upper);
+            internal::store_be64(bytes.data() + 8, lower);
+        } else {
+            for (int i = 0; i < 8; ++i) {
+                bytes[i] = uint8_t(upper >> (i * 8));
+                bytes[i + 8] = uint8_t(lower >> (i * 8));
+            }
         }
         return result;
     }
@@ -744,15 +745,14 @@ public:
         const auto& bytes = _data.bytes;
         uint64_t upper = 0;
         uint64_t lower = 0;
-        int shift = 0;
-        int inc = 8;
         if (is_little_endian()) {
-            shift = 56;
-            inc = -8;
-        }
-        for (int i = 0, s = shift; i < 8; ++i, s += inc) {
-            upper |= uint64_t(bytes[i]) << s;
-            lower |= uint64_t(bytes[i + 8]) << s;
+            upper = internal::load_be64(bytes.data());
+            lower = internal::load_be64(bytes.data() + 8);
+        } else {
+            for (int i = 0; i < 8; ++i) {
+                upper |= uint64_t(bytes[i]) << (i * 8);
+                lower |= uint64_t(bytes[i + 8]) << (i * 8);
+            }
         }
         return uint_type(upper, lower);
     }
@@ -846,16 +846,14 @@ protected:
     }
 
     IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE size_t hash(const base_type& bytes) const IPADDRESS_NOEXCEPT {
-        return internal::calc_hash(
+        return internal::hash_sum(
         #if IPADDRESS_IPV6_SCOPE_MAX_LENGTH > 0
             _data.scope_id.hash(),
         #else // IPADDRESS_IPV6_SCOPE_MAX_LENGTH <= 0
             0,
         #endif // IPADDRESS_IPV6_SCOPE_MAX_LENGTH <= 0
-            size_t(bytes[0]), size_t(bytes[1]), size_t(bytes[2]), size_t(bytes[3]), 
-            size_t(bytes[4]), size_t(bytes[5]), size_t(bytes[6]), size_t(bytes[7]), 
-            size_t(bytes[8]), size_t(bytes[9]), size_t(bytes[10]), size_t(bytes[11]), 
-            size_t(bytes[12]), size_t(bytes[13]), size_t(bytes[14]), size_t(bytes[15]));
+            internal::load_be64(bytes.data()),
+            internal::load_be64(bytes.data() + 8));
     }
 
     IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE bool equals(const ip_address_base<ipv6_address_base>& lhs, const ip_address_base<ipv6_address_base>& rhs) IPADDRESS_NOEXCEPT {
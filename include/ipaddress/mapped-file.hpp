@@ -0,0 +1,213 @@
+/**
+ * @file      mapped-file.hpp
+ * @brief     Read-only memory mapping of files
+ * @author    Vladimir Shaleev
+ * @copyright MIT License
+ *
+ * This file defines mapped_file, which maps a file into memory, typically to open an
+ * ip_prefix_database without reading it. The class needs the operating system headers
+ * (<windows.h> or the POSIX mmap headers), so this file is not included by ipaddress.hpp
+ * and has to be included explicitly where mapped files are used.
+ */
+
+#ifndef IPADDRESS_MAPPED_FILE_HPP
+#define IPADDRESS_MAPPED_FILE_HPP
+
+#include "errors.hpp"
+
+#ifndef IPADDRESS_MODULE
+#  if defined(_WIN32)
+#    ifndef NOMINMAX
+#      define NOMINMAX
+#      define IPADDRESS_UNDEF_NOMINMAX
+#    endif
+#    include <windows.h>
+#    ifdef IPADDRESS_UNDEF_NOMINMAX
+#      undef NOMINMAX
+#      undef IPADDRESS_UNDEF_NOMINMAX
+#    endif
+#  else
+#    include <fcntl.h>
+#    include <unistd.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#  endif
+#endif
+
+namespace IPADDRESS_NAMESPACE {
+
+/**
+ * A file mapped read-only into memory.
+ *
+ * The contents of the file are loaded on demand by the operating system and shared with
+ * every other process mapping the same file. The mapping is released when the object is
+ * destroyed, so any view of the data, such as ip_prefix_database, must not outlive it.
+ */
+IPADDRESS_EXPORT class mapped_file {
+public:
+    /**
+     * Default constructor. Creates an object without a mapping.
+     */
+    mapped_file() = default;
+
+    /**
+     * Maps a file into memory.
+     *
+     * @param[in] path the path of the file.
+     * @throw error Raise if the file cannot be opened or mapped.
+     */
+    IPADDRESS_FORCE_INLINE explicit mapped_file(const char* path) {
+        open(path);
+    }
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    /**
+     * Move constructor.
+     *
+     * @param[in,out] other the object to take the mapping from.
+     */
+    IPADDRESS_FORCE_INLINE mapped_file(mapped_file&& other) IPADDRESS_NOEXCEPT : _data(other._data), _size(other._size) {
+        other._data = nullptr;
+        other._size = 0;
+    }
+
+    /**
+     * Move assignment operator.
+     *
+     * @param[in,out] other the object to take the mapping from.
+     * @return A reference to this object.
+     */
+    IPADDRESS_FORCE_INLINE mapped_file& operator=(mapped_file&& other) IPADDRESS_NOEXCEPT {
+        if (this != &other) {
+            close();
+            std::swap(_data, other._data);
+            std::swap(_size, other._size);
+        }
+        return *this;
+    }
+
+    /**
+     * Destructor. Releases the mapping.
+     */
+    IPADDRESS_FORCE_INLINE ~mapped_file() {
+        close();
+    }
+
+    /**
+     * Maps a file into memory, releasing the previous mapping.
+     *
+     * @param[in] path the path of the file.
+     * @param[out] code an error_code object that will be set if the file cannot be opened or mapped.
+     */
+    IPADDRESS_FORCE_INLINE void open(const char* path, error_code& code) IPADDRESS_NOEXCEPT {
+        code = error_code::no_error;
+        close();
+#if defined(_WIN32)
+        const auto file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            code = error_code::cannot_map_file;
+            return;
+        }
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(file, &size)) {
+            CloseHandle(file);
+            code = error_code::cannot_map_file;
+            return;
+        }
+        if (size.QuadPart != 0) {
+            const auto mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            _data = mapping != nullptr ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+            if (mapping != nullptr) {
+                CloseHandle(mapping);
+            }
+            if (_data == nullptr) {
+                CloseHandle(file);
+                code = error_code::cannot_map_file;
+                return;
+            }
+            _size = size_t(size.QuadPart);
+        }
+        CloseHandle(file);
+#else
+        const auto file = ::open(path, O_RDONLY);
+        if (file < 0) {
+            code = error_code::cannot_map_file;
+            return;
+        }
+        struct stat info{};
+        if (::fstat(file, &info) != 0) {
+            ::close(file);
+            code = error_code::cannot_map_file;
+            return;
+        }
+        if (info.st_size != 0) {
+            auto* data = ::mmap(nullptr, size_t(info.st_size), PROT_READ, MAP_SHARED, file, 0);
+            if (data == MAP_FAILED) {
+                ::close(file);
+                code = error_code::cannot_map_file;
+                return;
+            }
+            _data = data;
+            _size = size_t(info.st_size);
+        }
+        ::close(file);
+#endif
+    }
+
+    /**
+     * Maps a file into memory, releasing the previous mapping.
+     *
+     * @param[in] path the path of the file.
+     * @throw error Raise if the file cannot be opened or mapped.
+     */
+    IPADDRESS_FORCE_INLINE void open(const char* path) IPADDRESS_NOEXCEPT_WHEN_NO_EXCEPTIONS {
+        error_code code = error_code::no_error;
+        open(path, code);
+        if (code != error_code::no_error) {
+            raise_error(code, 0, "", 0);
+        }
+    }
+
+    /**
+     * Releases the mapping.
+     */
+    IPADDRESS_FORCE_INLINE void close() IPADDRESS_NOEXCEPT {
+        if (_data != nullptr) {
+#if defined(_WIN32)
+            UnmapViewOfFile(_data);
+#else
+            ::munmap(_data, _size);
+#endif
+        }
+        _data = nullptr;
+        _size = 0;
+    }
+
+    /**
+     * Returns the beginning of the mapped contents, aligned to a page boundary.
+     *
+     * @return A pointer to the contents, or `nullptr` if nothing is mapped or the file is empty.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE const void* data() const IPADDRESS_NOEXCEPT {
+        return _data;
+    }
+
+    /**
+     * Returns the size of the mapped contents.
+     *
+     * @return The size of the file in bytes.
+     */
+    IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE size_t size() const IPADDRESS_NOEXCEPT {
+        return _size;
+    }
+
+private:
+    void* _data{};
+    size_t _size{};
+};
+
+} // namespace IPADDRESS_NAMESPACE
+
+#endif // IPADDRESS_MAPPED_FILE_HPP
@@ -0,0 +1,142 @@
+/**
+ * @file      parallel.hpp
+ * @brief     Multi-threaded collapsing and sorting of IP networks
+ * @author    Vladimir Shaleev
+ * @copyright MIT License
+ *
+ * This file defines the overloads of `collapse_addresses` and `sort_addresses` that take
+ * a number of threads. They start `std::thread` objects and require the program to be linked
+ * with the platform thread library (for example Threads::Threads in CMake), so this file
+ * is not included by ipaddress.hpp and has to be included explicitly where they are used.
+ */
+
+#ifndef IPADDRESS_PARALLEL_HPP
+#define IPADDRESS_PARALLEL_HPP
+
+#include "ip-functions.hpp"
+
+#ifndef IPADDRESS_MODULE
+#  include <thread>
+#endif
+
+namespace IPADDRESS_NAMESPACE {
+
+namespace internal {
+
+// Runs task(0) .. task(count - 1) concurrently, task(0) on the calling thread.
+// If a thread cannot be started, the tasks left without one run on the calling thread.
+template <typename Task>
+IPADDRESS_FORCE_INLINE void parallel_run(size_t count, const Task& task) {
+    std::vector<std::thread> threads;
+    size_t started = 1;
+#ifndef IPADDRESS_NO_EXCEPTIONS
+    try {
+#endif
+        threads.reserve(count - 1);
+        for (; started < count; ++started) {
+            threads.emplace_back(task, started);
+        }
+#ifndef IPADDRESS_NO_EXCEPTIONS
+    } catch (...) { // NOLINT(bugprone-empty-catch): out of threads, fall back to the calling one
+    }
+#endif
+    task(0);
+    for (size_t i = started; i < count; ++i) {
+        task(i);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+struct thread_runner {
+    template <typename Task>
+    IPADDRESS_FORCE_INLINE void operator()(size_t count, const Task& task) const {
+        parallel_run(count, task);
+    }
+};
+
+} // namespace IPADDRESS_NAMESPACE::internal
+
+/**
+ * Collapses a collection of IP networks into the smallest set of contiguous networks using several threads.
+ * 
+ * The networks are split into address ranges that are sorted and collapsed concurrently,
+ * after which the partial results are stitched together at the range boundaries. The result
+ * is identical to that of the single-threaded collapse_addresses(It, It, error_code&).
+ * Inputs too small to benefit from threads are collapsed on the calling thread.
+ * 
+ * Example:
+ * @code{.cpp}
+ *   error_code code{};
+ *   const auto collapsed = collapse_addresses(feed.begin(), feed.end(), 8, code);
+ * @endcode
+ * 
+ * @tparam It The type of the iterator.
+ * @param[in] first The beginning of the range of IP networks to be collapsed.
+ * @param[in] last The end of the range of IP networks to be collapsed.
+ * @param[in] threads The maximum number of threads to use, including the calling one. If 0, `std::thread::hardware_concurrency()` is used.
+ * @param[out] code A reference to an `error_code` object that will be set if the operation is not possible.
+ * @return A container of collapsed networks.
+ */
+IPADDRESS_EXPORT template <typename It>
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE auto collapse_addresses(It first, It last, size_t threads, error_code& code) IPADDRESS_NOEXCEPT
+    -> std::vector<typename std::iterator_traits<It>::value_type> {
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+    }
+    collapse_buffer<typename std::iterator_traits<It>::value_type> buffer;
+    return internal::runtime_collapse_addresses<std::vector<typename std::iterator_traits<It>::value_type>, internal::thread_runner>(first, last, buffer, threads, code);
+}
+
+/**
+ * Collapses a collection of IP networks into the smallest set of contiguous networks using several threads.
+ * 
+ * Behaves like collapse_addresses(It, It, size_t, error_code&), but reports errors with exceptions.
+ * 
+ * @tparam It The type of the iterator.
+ * @param[in] first The beginning of the range of IP networks to be collapsed.
+ * @param[in] last The end of the range of IP networks to be collapsed.
+ * @param[in] threads The maximum number of threads to use, including the calling one. If 0, `std::thread::hardware_concurrency()` is used.
+ * @return A container of collapsed networks.
+ * @throw logic_error Thrown with a message corresponding to the error code.
+ */
+IPADDRESS_EXPORT template <typename It>
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE auto collapse_addresses(It first, It last, size_t threads) IPADDRESS_NOEXCEPT_WHEN_NO_EXCEPTIONS
+    -> std::vector<typename std::iterator_traits<It>::value_type> {
+    error_code code = error_code::no_error;
+    auto result = collapse_addresses(first, last, threads, code);
+    if (code != error_code::no_error) {
+        raise_error(code, 0, "", 0);
+    }
+    return result;
+}
+
+/**
+ * Sorts a range of IP addresses or networks in ascending order using several threads.
+ * 
+ * The values are split into address ranges that are sorted concurrently. The result is
+ * identical to that of the single-threaded sort_addresses(RandomIt, RandomIt).
+ * Inputs too small to benefit from threads are sorted on the calling thread.
+ * 
+ * Example:
+ * @code{.cpp}
+ *   sort_addresses(addresses.begin(), addresses.end(), 8);
+ * @endcode
+ * 
+ * @tparam RandomIt The type of the iterator.
+ * @param[in,out] first The beginning of the range of IP addresses or networks to be sorted.
+ * @param[in,out] last The end of the range of IP addresses or networks to be sorted.
+ * @param[in] threads The maximum number of threads to use, including the calling one. If 0, `std::thread::hardware_concurrency()` is used.
+ */
+IPADDRESS_EXPORT template <typename RandomIt>
+IPADDRESS_FORCE_INLINE void sort_addresses(RandomIt first, RandomIt last, size_t threads) {
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+    }
+    internal::sort_addresses<internal::thread_runner>(first, last, threads);
+}
+
+} // namespace IPADDRESS_NAMESPACE
+
+#endif // IPADDRESS_PARALLEL_HPP
@@ -0,0 +1,137 @@
+/**
+ * @file      simd.hpp
+ * @brief     SIMD kernels for text processing of IP addresses
+ * @author    Vladimir Shaleev
+ * @copyright MIT License
+ *
+ * This header contains vectorized kernels used by the batch APIs of the library.
+ * Kernels only handle well-formed input and report anything else as not handled,
+ * so that callers can fall back to the scalar implementation, which remains the
+ * single source of truth for error codes. The kernels are compiled only when the
+ * target supports the required instruction set and IPADDRESS_NO_SIMD is not defined.
+ */
+
+#ifndef IPADDRESS_SIMD_HPP
+#define IPADDRESS_SIMD_HPP
+
+#include "config.hpp"
+
+namespace IPADDRESS_NAMESPACE {
+
+namespace internal {
+
+#ifdef IPADDRESS_SSSE3
+
+struct ipv4_pattern {
+    uint8_t shuffle[16];
+    uint16_t key;
+    uint16_t leading;
+};
+
+struct ipv4_pattern_table {
+    // The key of a well-formed dotted-quad is the mask of dot positions combined with
+    // the bit just past the end of the string. Each of the 81 possible keys (octets of
+    // 1 to 3 characters) maps to a pattern through a perfect multiplicative hash.
+    static constexpr uint32_t hash_multiplier = 0x86E5B70DU;
+
+    ipv4_pattern patterns[81];
+    uint8_t index[256];
+
+    IPADDRESS_NODISCARD static IPADDRESS_FORCE_INLINE uint32_t hash(uint32_t key) IPADDRESS_NOEXCEPT {
+        return (key * hash_multiplier) >> 24;
+    }
+
+    ipv4_pattern_table() IPADDRESS_NOEXCEPT : patterns(), index() {
+        std::memset(index, 0xFF, sizeof(index));
+        for (size_t i = 0; i < 81; ++i) {
+            const size_t lengths[4] = { i / 27 + 1, i / 9 % 3 + 1, i / 3 % 3 + 1, i % 3 + 1 };
+            auto& pattern = patterns[i];
+            size_t start = 0;
+            for (size_t octet = 0; octet < 4; ++octet) {
+                // Each octet is placed into its own 32-bit lane as [hundreds, tens, ones, 0]
+                const auto pad = 3 - lengths[octet];
+                for (size_t k = 0; k < 3; ++k) {
+                    pattern.shuffle[octet * 4 + k] = k < pad ? 0x80 : uint8_t(start + k - pad);
+                }
+                pattern.shuffle[octet * 4 + 3] = 0x80;
+                if (lengths[octet] > 1) {
+                    pattern.leading |= uint16_t(1U << start);
+                }
+                start += lengths[octet] + 1;
+                pattern.key |= uint16_t(1U << (start - 1));
+            }
+            index[hash(pattern.key)] = uint8_t(i);
+        }
+    }
+};
+
+IPADDRESS_NODISCARD inline const ipv4_pattern_table& get_ipv4_pattern_table() IPADDRESS_NOEXCEPT {
+    static const ipv4_pattern_table table;
+    return table;
+}
+
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE __m128i load_chars_ssse3(const char* str, size_t size) IPADDRESS_NOEXCEPT {
+    // Loads 4 to 16 characters without reading outside of the string; the remaining
+    // lanes are zero. Overlapping word loads avoid a store-forwarding stall of a
+    // copy through a stack buffer.
+    uint64_t lo = 0;
+    uint64_t hi = 0;
+    if (size >= 8) {
+        std::memcpy(&lo, str, 8);
+        std::memcpy(&hi, str + size - 8, 8);
+        hi = size > 8 ? hi >> ((16 - size) * 8) : 0;
+    } else {
+        uint32_t first = 0;
+        uint32_t last = 0;
+        std::memcpy(&first, str, 4);
+        std::memcpy(&last, str + size - 4, 4);
+        lo = first | (uint64_t(last) << ((size - 4) * 8));
+    }
+    return _mm_set_epi64x(int64_t(hi), int64_t(lo));
+}
+
+IPADDRESS_NODISCARD IPADDRESS_FORCE_INLINE bool ipv4_from_chars_ssse3(const char* str, size_t size, uint8_t* bytes) IPADDRESS_NOEXCEPT {
+    if (size < 7 || size > 15) {
+        return false;
+    }
+
+    const auto input = load_chars_ssse3(str, size);
+    const auto digits = _mm_sub_epi8(input, _mm_set1_epi8('0'));
+    const auto is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits);
+    const auto is_dot = _mm_cmpeq_epi8(input, _mm_set1_epi8('.'));
+    const auto is_zero = _mm_cmpeq_epi8(input, _mm_set1_epi8('0'));
+
+    const auto valid = (1U << size) - 1;
+    const auto dots = uint32_t(_mm_movemask_epi8(is_dot));
+    const auto key = dots | (1U << size);
+    const auto& table = get_ipv4_pattern_table();
+    const auto index = table.index[ipv4_pattern_table::hash(key)];
+    if (index == 0xFF) {
+        return false;
+    }
+    const auto& pattern = table.patterns[index];
+    if (pattern.key != key || ((dots | uint32_t(_mm_movemask_epi8(is_digit))) & valid) != valid || (uint32_t(_mm_movemask_epi8(is_zero)) & pattern.leading) != 0) {
+        return false;
+    }
+
+    const auto mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern.shuffle));
+    const auto shuffled = _mm_shuffle_epi8(digits, mask);
+    const auto weights = _mm_setr_epi8(100, 10, 1, 0, 100, 10, 1, 0, 100, 10, 1, 0, 100, 10, 1, 0);
+    const auto octets = _mm_madd_epi16(_mm_maddubs_epi16(shuffled, weights), _mm_set1_epi16(1));
+    if (_mm_movemask_epi8(_mm_cmpgt_epi32(octets, _mm_set1_epi32(255))) != 0) {
+        return false;
+    }
+
+    const auto packed = _mm_packus_epi16(_mm_packs_epi32(octets, octets), octets);
+    const auto value = uint32_t(_mm_cvtsi128_si32(packed));
+    std::memcpy(bytes, &value, 4);
+    return true;
+}
+
+#endif // IPADDRESS_SSSE3
+
+} // namespace IPADDRESS_NAMESPACE::internal
+
+} // namespace IPADDRESS_NAMESPACE
+
+#endif // IPADDRESS_SIMD_HPP
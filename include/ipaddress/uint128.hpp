@@ -8,6 +8,9 @@
  * It is designed to fill the gap in the C++ standard, which does not natively support
  * 128-bit integers across all platforms. Unlike compiler-specific extensions like `__int128`,
  * `uint128_t` ensures compatibility and portability across different compilers and architectures.
+ * When `IPADDRESS_UINT128_NATIVE` is defined and the compiler provides `unsigned __int128`
+ * (GCC and Clang on 64-bit targets), arithmetic, shifts and division are delegated to it;
+ * the portable implementation is used otherwise.
  * The implementation is inspired by the algorithms used in the .NET framework's 
  * [UInt128](https://source.dot.net/#System.Private.CoreLib/src/libraries/System.Private.CoreLib/src/System/UInt128.cs),
  * providing a reliable foundation for arithmetic operations and other integer-related functionalities.
@@ -841,9 +844,13 @@ public:
      * @return A new `uint128_t` instance representing the sum.
      */
     IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE uint128_t operator+(const uint128_t& other) const IPADDRESS_NOEXCEPT {
+    #ifdef IPADDRESS_HAS_INT128
+        return from_native(to_native() + other.to_native());
+    #else // !IPADDRESS_HAS_INT128
         const uint64_t lower = _lower + other._lower;
         const uint64_t carry = lower < _lower ? 1 : 0;
         return { _upper + other._upper + carry, lower };
+    #endif // !IPADDRESS_HAS_INT128
     }
     
     /**
@@ -855,9 +862,13 @@ public:
      * @return A new `uint128_t` instance representing the difference.
      */
     IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE uint128_t operator-(const uint128_t& other) const IPADDRESS_NOEXCEPT {
+    #ifdef IPADDRESS_HAS_INT128
+        return from_native(to_native() - other.to_native());
+    #else // !IPADDRESS_HAS_INT128
         const uint64_t lower = _lower - other._lower;
         const uint64_t borrow = lower > _lower ? 1 : 0;
         return { _upper - other._upper - borrow, lower };
+    #endif // !IPADDRESS_HAS_INT128
     }
 
     /**
@@ -869,10 +880,14 @@ public:
      * @return A new `uint128_t` instance representing the product.
      */
     IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE uint128_t operator*(const uint128_t& other) const IPADDRESS_NOEXCEPT {
+    #ifdef IPADDRESS_HAS_INT128
+        return from_native(to_native() * other.to_native());
+    #else // !IPADDRESS_HAS_INT128
         uint64_t lower = 0;
         uint64_t upper = big_mul(_lower, other._lower, lower);
         upper += (_upper * other._lower) + (_lower * other._upper);
         return { upper, lower };
+    #endif // !IPADDRESS_HAS_INT128
     }
     
     /**
@@ -896,8 +911,12 @@ public:
      * @return A new `uint128_t` instance representing the remainder.
      */
     IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE uint128_t operator%(const uint128_t& other) const IPADDRESS_NOEXCEPT {
+    #ifdef IPADDRESS_HAS_INT128
+        return other ? from_native(to_native() % other.to_native()) : *this;
+    #else // !IPADDRESS_HAS_INT128
         const auto quotient = divide(*this, other);
         return *this - quotient * other;
+    #endif // !IPADDRESS_HAS_INT128
     }
 
     /**
@@ -950,6 +969,11 @@ public:
         if (!shift) {
             return *this;
         }
+    #ifdef IPADDRESS_HAS_INT128
+        if (shift > 0 && shift < 128) {
+            return from_native(to_native() << shift);
+        }
+    #endif // IPADDRESS_HAS_INT128
         if (shift >= 64 && shift <= 128) {
             return { _lower << (shift - 64), 0 };
         }
@@ -973,6 +997,11 @@ public:
         if (!shift) {
             return *this;
         }
+    #ifdef IPADDRESS_HAS_INT128
+        if (shift > 0 && shift < 128) {
+            return from_native(to_native() >> shift);
+        }
+    #endif // IPADDRESS_HAS_INT128
         if (shift >= 64 && shift <= 128) {
             return { 0, _upper >> (shift - 64) };
         }
@@ -1275,7 +1304,24 @@ private:
         return uint64_t(ah) * bh + (t >> 32) + (tl >> 32);
     }
 
+#ifdef IPADDRESS_HAS_INT128
+
+    __extension__ typedef unsigned __int128 native_type;
+
+    IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE uint128_t from_native(native_type value) IPADDRESS_NOEXCEPT {
+        return { uint64_t(value >> 64), uint64_t(value) };
+    }
+
+    IPADDRESS_NODISCARD IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE native_type to_native() const IPADDRESS_NOEXCEPT {
+        return (native_type(_upper) << 64) | _lower;
+    }
+
+#endif // IPADDRESS_HAS_INT128
+
     IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE uint128_t divide(const uint128_t& lhs, const uint128_t& rhs) IPADDRESS_NOEXCEPT {
+    #ifdef IPADDRESS_HAS_INT128
+        return rhs ? from_native(lhs.to_native() / rhs.to_native()) : uint128_t();
+    #else // !IPADDRESS_HAS_INT128
         if (rhs._upper == 0) {
             if (rhs._lower == 0) {
                 return {};
@@ -1291,6 +1337,7 @@ private:
         }
 
         return divide_slow(lhs, rhs);
+    #endif // !IPADDRESS_HAS_INT128
     }
 
     IPADDRESS_NODISCARD static IPADDRESS_CONSTEXPR IPADDRESS_FORCE_INLINE uint128_t divide_slow(const uint128_t& quotient, const uint128_t& divisor) IPADDRESS_NOEXCEPT {
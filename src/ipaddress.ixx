@@ -16,9 +16,26 @@ module;
 #include <iterator>
 #include <algorithm>
 #include <stdexcept>
+#include <mutex>
+#include <atomic>
+#include <new>
+#include <memory>
+#include <thread>
 #include <type_traits>
 #include <string_view>
 
+#if defined(_WIN32)
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <unistd.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#endif
+
 #if __has_include(<compare>)
 #  include <compare>
 #endif
@@ -27,6 +44,14 @@ module;
 #  include <bit>
 #endif
 
+#if !defined(IPADDRESS_NO_SIMD) && (defined(__SSSE3__) || (defined(_MSC_VER) && defined(__AVX__)))
+#  include <tmmintrin.h>
+#endif
+
+#if !defined(IPADDRESS_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#  include <emmintrin.h>
+#endif
+
 export module ipaddress;
 
 #define IPADDRESS_MODULE
@@ -40,6 +65,8 @@ export module ipaddress;
 #endif
 
 #include <ipaddress/ipaddress.hpp>
+#include <ipaddress/mapped-file.hpp>
+#include <ipaddress/parallel.hpp>
 
 #if defined(_MSC_VER)
 #  pragma warning(default:5244)
@@ -1,5 +1,7 @@
 #include <map>
+#include <random>
 #include <vector>
+#include <algorithm>
 #include <unordered_map>
 #include <sstream>
 #include <gtest/gtest.h>
@@ -9,6 +11,7 @@
 import ipaddress;
 #else
 #include <ipaddress/ipaddress.hpp>
+#include <ipaddress/parallel.hpp>
 #endif
 
 using namespace testing;
@@ -411,6 +414,8 @@ INSTANTIATE_TEST_SUITE_P(
         std::make_tuple("127.0.0.", error_code::empty_octet, "empty octet 0 in address 127.0.0."),
         std::make_tuple("127.0.0.1/24", error_code::octet_has_invalid_symbol, "in octet 0 of address 127.0.0.1/24 has invalid symbol"),
         std::make_tuple("127.0.0.1271", error_code::octet_more_3_characters, "in octet 0 of address 127.0.0.1271 more 3 characters"),
+        std::make_tuple("192.168.100.1000", error_code::octet_more_3_characters, "in octet 0 of address 192.168.100.1000 more 3 characters"),
+        std::make_tuple("1.2.3.4.5.6.7.8.9", error_code::part_is_more_4_chars, "in part 0 of address 1.2.3.4.5.6.7.8.9 more 4 characters"),
         std::make_tuple("192.168.0.999", error_code::octet_exceeded_255, "octet 0 of address 192.168.0.999 exceeded 255"),
         std::make_tuple("1.2.3.040", error_code::leading_0_are_not_permitted, "leading zeros are not permitted in octet 0 of address 1.2.3.040"),
         std::make_tuple("FEDC:9878%scope", error_code::least_3_parts, "least 3 parts in address FEDC:9878%scope"),
@@ -583,6 +588,27 @@ TEST(ip_address, to_string) {
     ASSERT_EQ(ss_compressed_upper_2.str(), expected_compressed_upper_2);
 }
 
+TEST(ip_address, to_chars) {
+    const auto ip1 = ip_address::parse("127.240.0.1");
+    const auto ip2 = ip_address::parse("fe80::1ff:fe23:4567:890a%eth2");
+
+    char buffer[64] = {};
+    char* end = ip1.to_chars(buffer, buffer + sizeof(buffer));
+    ASSERT_NE(end, nullptr);
+    ASSERT_EQ(std::string(buffer, end), "127.240.0.1");
+    end = ip2.to_chars(buffer, buffer + sizeof(buffer), format::full);
+    ASSERT_NE(end, nullptr);
+    ASSERT_EQ(std::string(buffer, end), "fe80:0000:0000:0000:01ff:fe23:4567:890a%eth2");
+    end = ip2.to_chars(buffer, buffer + sizeof(buffer), format::compact);
+    ASSERT_NE(end, nullptr);
+    ASSERT_EQ(std::string(buffer, end), "fe80:0:0:0:1ff:fe23:4567:890a%eth2");
+    end = ip2.to_chars(buffer, buffer + sizeof(buffer));
+    ASSERT_NE(end, nullptr);
+    ASSERT_EQ(std::string(buffer, end), "fe80::1ff:fe23:4567:890a%eth2");
+    ASSERT_EQ(ip1.to_chars(buffer, buffer + 10), nullptr);
+    ASSERT_EQ(ip2.to_chars(buffer, buffer + 28), nullptr);
+}
+
 TEST(ip_address, to_wstring) {
     IPADDRESS_CONSTEXPR auto ip1 = ip_address::parse("127.240.0.1");
     IPADDRESS_CONSTEXPR auto ip2 = ip_address::parse("fe80::1ff:fe23:4567:890a%eth2");
@@ -709,10 +735,10 @@ TEST(ip_address, Hash) {
     IPADDRESS_CONSTEXPR auto hash3 = hash_functor(ip1);
     IPADDRESS_CONSTEXPR auto hash4 = hash_functor(ip2);
 
-    ASSERT_EQ(hash1, sizeof(size_t) == 8 ? 2753421670903790749ULL : 4009513643U);
-    ASSERT_EQ(hash2, sizeof(size_t) == 8 ? 6222153021643990098ULL : 1539407693U);
-    ASSERT_EQ(hash3, sizeof(size_t) == 8 ? 2753421670903790749ULL : 4009513643U);
-    ASSERT_EQ(hash4, sizeof(size_t) == 8 ? 6222153021643990098ULL : 1539407693U);
+    ASSERT_EQ(hash1, sizeof(size_t) == 8 ? 575171939555596715ULL : 2242336204U);
+    ASSERT_EQ(hash2, sizeof(size_t) == 8 ? 245662094094632270ULL : 1392502674U);
+    ASSERT_EQ(hash3, sizeof(size_t) == 8 ? 575171939555596715ULL : 2242336204U);
+    ASSERT_EQ(hash4, sizeof(size_t) == 8 ? 245662094094632270ULL : 1392502674U);
 }
 
 TEST(ip_address, Containers) {
@@ -929,6 +955,20 @@ TEST(ip_address, is_prop) {
     ASSERT_FALSE(ip36);
 }
 
+TEST(ip_address, classify) {
+    IPADDRESS_CONSTEXPR auto flags1 = ip_address::parse("127.0.0.1").classify();
+    IPADDRESS_CONSTEXPR auto flags2 = ip_address::parse("8.8.8.8").classify();
+    IPADDRESS_CONSTEXPR auto flags3 = ip_address::parse("fe80::1").classify();
+    IPADDRESS_CONSTEXPR auto flags4 = ip_address::parse("2a00:1450:4001::1").classify();
+
+    ASSERT_EQ(flags1, address_flags::is_private | address_flags::is_loopback);
+    ASSERT_EQ(flags2, address_flags::is_global);
+    ASSERT_EQ(flags3, address_flags::is_private | address_flags::is_link_local);
+    ASSERT_EQ(flags4, address_flags::is_global);
+    ASSERT_EQ(flags1 & ~address_flags::is_loopback, address_flags::is_private);
+    ASSERT_EQ(flags3 ^ address_flags::is_link_local, address_flags::is_private);
+}
+
 TEST(ip_address, literals) {
     IPADDRESS_CONSTEXPR auto ip1 = "127.128.128.255"_ip;
     IPADDRESS_CONSTEXPR auto ip2 = "2001:db8::1"_ip;
@@ -1000,3 +1040,73 @@ TEST(ip_address, summarize_address_range) {
     ASSERT_EQ(range_net_1, ip_network::parse("192.0.2.128/31"));
     ASSERT_EQ(range_net_2, ip_network::parse("192.0.2.130/32"));
 }
+
+TEST(ip_address, summarize_address_ranges) {
+    const std::pair<ip_address, ip_address> ranges[] = {
+        { ip_address::parse("192.0.2.0"), ip_address::parse("192.0.2.130") },
+        { ip_address::parse("2001:db8::"), ip_address::parse("2001:db8::2") } };
+    std::vector<ip_network> actual;
+    summarize_address_ranges(std::begin(ranges), std::end(ranges), std::back_inserter(actual));
+    ASSERT_EQ(actual, (std::vector<ip_network>{
+        ip_network::parse("192.0.2.0/25"), ip_network::parse("192.0.2.128/31"), ip_network::parse("192.0.2.130/32"),
+        ip_network::parse("2001:db8::/127"), ip_network::parse("2001:db8::2/128") }));
+
+    const std::pair<ip_address, ip_address> mixed[] = { { ip_address::parse("192.0.2.0"), ip_address::parse("2001:db8::") } };
+    error_code err = error_code::no_error;
+    summarize_address_ranges(std::begin(mixed), std::end(mixed), std::back_inserter(actual), err);
+    ASSERT_EQ(err, error_code::invalid_version);
+}
+
+TEST(ip_address, sort_addresses) {
+    std::mt19937_64 rng(2024);
+    std::vector<ipv4_address> ipv4;
+    std::vector<ipv6_address> ipv6;
+    std::vector<ip_address> ips;
+    for (size_t i = 0; i < 100000; ++i) {
+        const auto value = rng();
+        ipv4.push_back(ipv4_address::from_uint(uint32_t(value) & 0xC0A8FFFF));
+        ipv6.push_back(ipv6_address::from_uint(uint128_t(0x20010db800000000ULL | (value >> 48), value % 1000)));
+        ips.push_back(value % 3 == 0 ? ip_address(ipv6.back()) : ip_address(ipv4.back()));
+    }
+    ips.push_back(ip_address::parse("::"));
+    ips.push_back(ip_address::parse("0.0.0.0"));
+    ips.push_back(ip_address::parse("ffff:ffff:ffff:ffff:ffff:ffff:ffff:ffff"));
+
+    for (const size_t threads : { 1, 4 }) {
+        auto expected_ipv4 = ipv4;
+        auto actual_ipv4 = ipv4;
+        std::sort(expected_ipv4.begin(), expected_ipv4.end());
+        sort_addresses(actual_ipv4.begin(), actual_ipv4.end(), threads);
+        ASSERT_EQ(actual_ipv4, expected_ipv4);
+
+        auto expected_ipv6 = ipv6;
+        auto actual_ipv6 = ipv6;
+        std::sort(expected_ipv6.begin(), expected_ipv6.end());
+        sort_addresses(actual_ipv6.begin(), actual_ipv6.end(), threads);
+        ASSERT_EQ(actual_ipv6, expected_ipv6);
+
+        auto expected_ips = ips;
+        auto actual_ips = ips;
+        std::sort(expected_ips.begin(), expected_ips.end());
+        sort_addresses(actual_ips.begin(), actual_ips.end(), threads);
+        ASSERT_EQ(actual_ips, expected_ips);
+    }
+
+    std::vector<ip_address> small = { ip_address::parse("2001:db8::1"), ip_address::parse("10.0.0.2"), ip_address::parse("::a00:1"), ip_address::parse("10.0.0.1") };
+    sort_addresses(small.begin(), small.end());
+    ASSERT_EQ(small, (std::vector<ip_address>{ ip_address::parse("10.0.0.1"), ip_address::parse("10.0.0.2"), ip_address::parse("::a00:1"), ip_address::parse("2001:db8::1") }));
+
+    std::vector<ip_address> empty;
+    sort_addresses(empty.begin(), empty.end());
+    ASSERT_TRUE(empty.empty());
+}
+
+TEST(ip_address, sort_addresses_scope_id) {
+    std::vector<ip_address> ips = {
+        ip_address::parse("fe80::1%2"), ip_address::parse("fe80::1%1"), ip_address::parse("10.0.0.1"), ip_address::parse("fe80::1") };
+    auto expected = ips;
+    std::sort(expected.begin(), expected.end());
+    sort_addresses(ips.begin(), ips.end());
+    ASSERT_EQ(ips, expected);
+    ASSERT_EQ(ips[0].to_string(), "10.0.0.1");
+}
@@ -0,0 +1,233 @@
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#ifdef IPADDRESS_TEST_MODULE
+import ipaddress;
+#else
+#include <ipaddress/ipaddress.hpp>
+#endif
+
+using namespace testing;
+using namespace ipaddress;
+
+template <typename T>
+static std::vector<uint8_t> encode(const T& value) {
+    std::vector<uint8_t> result(max_binary_size<T>());
+    result.resize(size_t(encode_binary(value, result.data()) - result.data()));
+    return result;
+}
+
+template <typename T>
+static T decode(const std::vector<uint8_t>& data) {
+    T result;
+    const auto* end = decode_binary(data.data(), data.data() + data.size(), result);
+    EXPECT_EQ(end, data.data() + data.size());
+    return result;
+}
+
+TEST(ip_binary, EncodeAddress) {
+    EXPECT_THAT(encode(ipv4_address::parse("192.168.0.1")), ElementsAre(0x04, 192, 168, 0, 1));
+    EXPECT_THAT(encode(ip_address::parse("10.0.0.255")), ElementsAre(0x04, 10, 0, 0, 255));
+    EXPECT_THAT(encode(ipv6_address::parse("2001:db8::1")), ElementsAre(0x06, 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1));
+    EXPECT_EQ(encode(ip_address::parse("fe80::1%eth0")), encode(ipv6_address::parse("fe80::1")));
+
+    EXPECT_EQ(decode<ipv4_address>(encode(ipv4_address::parse("192.168.0.1"))), ipv4_address::parse("192.168.0.1"));
+    EXPECT_EQ(decode<ipv6_address>(encode(ipv6_address::parse("2001:db8::1"))), ipv6_address::parse("2001:db8::1"));
+    EXPECT_EQ(decode<ip_address>(encode(ipv4_address::parse("192.168.0.1"))), ip_address::parse("192.168.0.1"));
+    EXPECT_EQ(decode<ip_address>(encode(ipv6_address::parse("2001:db8::1"))), ip_address::parse("2001:db8::1"));
+}
+
+TEST(ip_binary, EncodeNetwork) {
+    EXPECT_THAT(encode(ipv4_network::parse("10.0.0.0/8")), ElementsAre(0x14, 8, 10));
+    EXPECT_THAT(encode(ipv4_network::parse("0.0.0.0/0")), ElementsAre(0x14, 0));
+    EXPECT_THAT(encode(ipv4_network::parse("172.16.0.0/12")), ElementsAre(0x14, 12, 172, 16));
+    EXPECT_THAT(encode(ipv4_network::parse("1.2.3.4/32")), ElementsAre(0x14, 32, 1, 2, 3, 4));
+    EXPECT_THAT(encode(ipv6_network::parse("2001:db8::/32")), ElementsAre(0x16, 32, 0x20, 0x01, 0x0d, 0xb8));
+    EXPECT_THAT(encode(ip_network::parse("2001:db8::/33")), ElementsAre(0x16, 33, 0x20, 0x01, 0x0d, 0xb8, 0));
+    EXPECT_EQ(encode(ip_network::parse("::1/128")).size(), max_binary_size<ip_network>());
+
+    EXPECT_EQ(decode<ipv4_network>(encode(ipv4_network::parse("172.16.0.0/12"))), ipv4_network::parse("172.16.0.0/12"));
+    EXPECT_EQ(decode<ipv6_network>(encode(ipv6_network::parse("2001:db8::/33"))), ipv6_network::parse("2001:db8::/33"));
+    EXPECT_EQ(decode<ip_network>(encode(ipv4_network::parse("0.0.0.0/0"))), ip_network::parse("0.0.0.0/0"));
+    EXPECT_EQ(decode<ip_network>(encode(ipv6_network::parse("::1/128"))), ip_network::parse("::1/128"));
+}
+
+TEST(ip_binary, DecodeError) {
+    const std::vector<std::vector<uint8_t>> invalid = {
+        {},
+        { 0x05, 1, 2, 3, 4 },
+        { 0x04, 1, 2, 3 },
+        { 0x14 },
+        { 0x14, 33, 1, 2, 3, 4, 5 },
+        { 0x14, 12, 172, 17 },
+        { 0x16, 32, 0x20, 0x01, 0x0d },
+        { 0x16, 129, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 } };
+    for (const auto& data : invalid) {
+        error_code err = error_code::no_error;
+        ip_network network;
+        EXPECT_EQ(decode_binary(data.data(), data.data() + data.size(), network, err), data.data());
+        EXPECT_EQ(err, error_code::invalid_encoding);
+    }
+
+    const auto data = encode(ipv6_address::parse("::1"));
+    error_code err = error_code::no_error;
+    ipv4_address address;
+    decode_binary(data.data(), data.data() + data.size(), address, err);
+    EXPECT_EQ(err, error_code::invalid_encoding);
+    ipv6_network network;
+    decode_binary(data.data(), data.data() + data.size(), network, err);
+    EXPECT_EQ(err, error_code::invalid_encoding);
+
+#ifdef IPADDRESS_NO_EXCEPTIONS
+    decode_binary(data.data(), data.data() + data.size(), address);
+#else
+    EXPECT_THAT(
+        [&]() { decode_binary(data.data(), data.data() + data.size(), address); },
+        ThrowsMessage<logic_error>(StrEq("invalid binary encoding")));
+#endif
+}
+
+TEST(ip_binary, Sequence) {
+    const std::vector<ip_network> networks = {
+        ip_network::parse("10.0.0.0/8"),
+        ip_network::parse("2001:db8::/32"),
+        ip_network::parse("192.168.1.0/24"),
+        ip_network::parse("::/0") };
+    std::vector<uint8_t> data(networks.size() * max_binary_size<ip_network>());
+    data.resize(size_t(encode_binary_sequence(networks.begin(), networks.end(), data.data()) - data.data()));
+    EXPECT_EQ(data.size(), 3 + 6 + 5 + 2);
+
+    std::vector<ip_network> decoded;
+    decode_binary_sequence<ip_network>(data.data(), data.data() + data.size(), std::back_inserter(decoded));
+    EXPECT_EQ(decoded, networks);
+
+    error_code err = error_code::no_error;
+    decoded.clear();
+    decode_binary_sequence<ip_network>(data.data(), data.data() + data.size() - 1, std::back_inserter(decoded), err);
+    EXPECT_EQ(err, error_code::invalid_encoding);
+    EXPECT_EQ(decoded.size(), 3);
+}
+
+TEST(ip_binary, SortedAddresses) {
+    const std::vector<ipv4_address> addresses = {
+        ipv4_address::parse("10.0.0.1"),
+        ipv4_address::parse("10.0.0.1"),
+        ipv4_address::parse("10.0.0.2"),
+        ipv4_address::parse("10.0.1.0"),
+        ipv4_address::parse("255.255.255.255") };
+    std::vector<uint8_t> data(max_sorted_binary_size<ipv4_address>(addresses.size()));
+    data.resize(size_t(encode_sorted_binary(addresses.begin(), addresses.end(), data.data()) - data.data()));
+    EXPECT_THAT(data, ElementsAre(5, 0x81, 0x80, 0x80, 0x50, 0, 1, 0xFE, 1, 0xFF, 0xFD, 0xFF, 0xAF, 0x0F));
+
+    std::vector<ipv4_address> decoded;
+    decode_sorted_binary<ipv4_address>(data.data(), data.data() + data.size(), std::back_inserter(decoded));
+    EXPECT_EQ(decoded, addresses);
+
+    const std::vector<ip_address> mixed = {
+        ip_address::parse("10.0.0.1"),
+        ip_address::parse("10.0.0.3"),
+        ip_address::parse("::1"),
+        ip_address::parse("::2"),
+        ip_address::parse("ffff:ffff:ffff:ffff:ffff:ffff:ffff:ffff") };
+    data.resize(max_sorted_binary_size<ip_address>(mixed.size()));
+    data.resize(size_t(encode_sorted_binary(mixed.begin(), mixed.end(), data.data()) - data.data()));
+    EXPECT_EQ(data.size(), 1 + 4 + 1 + 1 + 1 + 1 + 19);
+
+    std::vector<ip_address> decoded_mixed;
+    decode_sorted_binary<ip_address>(data.data(), data.data() + data.size(), std::back_inserter(decoded_mixed));
+    EXPECT_EQ(decoded_mixed, mixed);
+}
+
+TEST(ip_binary, SortedNetworks) {
+    const std::vector<ip_network> networks = {
+        ip_network::parse("10.0.0.0/8"),
+        ip_network::parse("10.0.0.0/16"),
+        ip_network::parse("10.1.0.0/16"),
+        ip_network::parse("2001:db8::/32"),
+        ip_network::parse("2001:db8:1::/48") };
+    std::vector<uint8_t> data(max_sorted_binary_size<ip_network>(networks.size()));
+    data.resize(size_t(encode_sorted_binary(networks.begin(), networks.end(), data.data()) - data.data()));
+
+    std::vector<ip_network> decoded;
+    decode_sorted_binary<ip_network>(data.data(), data.data() + data.size(), std::back_inserter(decoded));
+    EXPECT_EQ(decoded, networks);
+
+    const std::vector<ipv6_network> empty;
+    data.resize(max_sorted_binary_size<ipv6_network>(0));
+    data.resize(size_t(encode_sorted_binary(empty.begin(), empty.end(), data.data()) - data.data()));
+    EXPECT_THAT(data, ElementsAre(0));
+}
+
+TEST(ip_binary, SortedError) {
+    error_code err = error_code::no_error;
+    uint8_t buffer[64];
+
+    const std::vector<ipv4_address> unsorted = { ipv4_address::parse("10.0.0.2"), ipv4_address::parse("10.0.0.1") };
+    encode_sorted_binary(unsorted.begin(), unsorted.end(), buffer, err);
+    EXPECT_EQ(err, error_code::unsorted_sequence);
+
+    const std::vector<ip_address> mixed = { ip_address::parse("::1"), ip_address::parse("10.0.0.1") };
+    encode_sorted_binary(mixed.begin(), mixed.end(), buffer, err);
+    EXPECT_EQ(err, error_code::unsorted_sequence);
+
+    const std::vector<std::vector<uint8_t>> invalid = {
+        {},
+        { 2, 1 },
+        { 1, 0x80 },
+        { 1, 0x80, 0x80, 0x80, 0x80, 0x10 },
+        { 2, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F, 1 },
+        { 1, 1, 0 } };
+    for (const auto& data : invalid) {
+        std::vector<ipv4_address> decoded;
+        decode_sorted_binary<ipv4_address>(data.data(), data.data() + data.size(), std::back_inserter(decoded), err);
+        EXPECT_EQ(err, error_code::invalid_encoding);
+    }
+
+    const std::vector<uint8_t> host_bits = { 1, 1, 8 };
+    std::vector<ipv4_network> decoded;
+    decode_sorted_binary<ipv4_network>(host_bits.data(), host_bits.data() + host_bits.size(), std::back_inserter(decoded), err);
+    EXPECT_EQ(err, error_code::invalid_encoding);
+
+#ifndef IPADDRESS_NO_EXCEPTIONS
+    EXPECT_THAT(
+        [&]() { encode_sorted_binary(unsorted.begin(), unsorted.end(), buffer); },
+        ThrowsMessage<logic_error>(StrEq("sequence is not sorted")));
+#endif
+}
+
+TEST(ip_binary, SortedRandom) {
+    std::mt19937_64 gen(19);
+    std::vector<ip_address> addresses;
+    std::vector<ip_network> networks;
+    for (int i = 0; i < 5000; ++i) {
+        const auto v4 = ipv4_address::from_uint(uint32_t(gen()));
+        const auto v6 = ipv6_address::from_uint(uint128_t(gen(), gen()));
+        addresses.emplace_back(v4);
+        addresses.emplace_back(v6);
+        networks.emplace_back(ipv4_network::from_address(v4, size_t(gen() % 33), false));
+        networks.emplace_back(ipv6_network::from_address(v6, size_t(gen() % 129), false));
+    }
+    std::sort(addresses.begin(), addresses.end());
+    std::sort(networks.begin(), networks.end());
+
+    std::vector<uint8_t> data(max_sorted_binary_size<ip_address>(addresses.size()));
+    data.resize(size_t(encode_sorted_binary(addresses.begin(), addresses.end(), data.data()) - data.data()));
+    std::vector<ip_address> decoded_addresses;
+    decode_sorted_binary<ip_address>(data.data(), data.data() + data.size(), std::back_inserter(decoded_addresses));
+    EXPECT_EQ(decoded_addresses, addresses);
+
+    data.resize(max_sorted_binary_size<ip_network>(networks.size()));
+    data.resize(size_t(encode_sorted_binary(networks.begin(), networks.end(), data.data()) - data.data()));
+    std::vector<ip_network> decoded_networks;
+    decode_sorted_binary<ip_network>(data.data(), data.data() + data.size(), std::back_inserter(decoded_networks));
+    EXPECT_EQ(decoded_networks, networks);
+
+    data.resize(max_binary_size<ip_network>() * networks.size());
+    data.resize(size_t(encode_binary_sequence(networks.begin(), networks.end(), data.data()) - data.data()));
+    decoded_networks.clear();
+    decode_binary_sequence<ip_network>(data.data(), data.data() + data.size(), std::back_inserter(decoded_networks));
+    EXPECT_EQ(decoded_networks, networks);
+}
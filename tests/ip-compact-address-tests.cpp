@@ -0,0 +1,233 @@
+#include <set>
+#include <unordered_set>
+#include <sstream>
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#ifdef IPADDRESS_TEST_MODULE
+import ipaddress;
+#else
+#include <ipaddress/ipaddress.hpp>
+#endif
+
+using namespace testing;
+using namespace ipaddress;
+
+TEST(ipv6_address_compact, Size) {
+    ASSERT_EQ(sizeof(ipv6_address_compact), 16);
+    ASSERT_EQ(sizeof(ip_address_compact), 17);
+}
+
+TEST(ipv6_address_compact, DefaultCtor) {
+    IPADDRESS_CONSTEXPR ipv6_address_compact ip;
+
+    EXPECT_EQ(ip.version(), ip_version::V6);
+    EXPECT_EQ(ip.size(), 16);
+    EXPECT_EQ(ip.to_address(), ipv6_address());
+    EXPECT_TRUE(ip.is_unspecified());
+}
+
+TEST(ipv6_address_compact, CompileTime) {
+#if IPADDRESS_CPP_VERSION >= 14
+    constexpr auto ip = ipv6_address_compact(ipv6_address::parse("fe80::1%eth0"));
+    constexpr auto address = ip.to_address();
+    constexpr auto flags = ip.classify();
+    constexpr auto hash = ip.hash();
+    constexpr auto less = ip < ipv6_address_compact(ipv6_address::parse("fe80::2"));
+
+    ASSERT_EQ(address, ipv6_address::parse("fe80::1"));
+    ASSERT_EQ(flags, address_flags::is_private | address_flags::is_link_local);
+    ASSERT_EQ(hash, ipv6_address::parse("fe80::1").hash());
+    ASSERT_TRUE(less);
+#endif
+}
+
+TEST(ipv6_address_compact, Conversion) {
+    const auto ip = ipv6_address::parse("2001:db8::1%eth0");
+    const auto compact = ipv6_address_compact(ip);
+
+    ASSERT_EQ(compact.bytes(), ip.bytes());
+    ASSERT_EQ(compact.to_uint(), ip.to_uint());
+    ASSERT_EQ(compact.to_address(), ipv6_address::parse("2001:db8::1"));
+    ASSERT_EQ(ipv6_address(compact), ipv6_address::parse("2001:db8::1"));
+    ASSERT_EQ(ipv6_address_compact::from_uint(ip.to_uint()), compact);
+    ASSERT_EQ(compact.to_string(), "2001:db8::1");
+    ASSERT_EQ(compact.to_string(format::full), "2001:0db8:0000:0000:0000:0000:0000:0001");
+    ASSERT_EQ(compact.to_wstring(), L"2001:db8::1");
+    ASSERT_EQ(std::to_string(compact), "2001:db8::1");
+
+    char buffer[64] {};
+    const auto end = compact.to_chars(buffer, buffer + sizeof(buffer));
+    ASSERT_EQ(std::string(buffer, end), "2001:db8::1");
+
+    std::ostringstream ss;
+    ss << compact;
+    ASSERT_EQ(ss.str(), "2001:db8::1");
+}
+
+TEST(ipv6_address_compact, Comparison) {
+    const auto ip1 = ipv6_address_compact(ipv6_address::parse("2001:db8::1"));
+    const auto ip2 = ipv6_address_compact(ipv6_address::parse("2001:db8::2"));
+    const auto ip3 = ipv6_address_compact(ipv6_address::parse("2001:db8::1%1"));
+
+    ASSERT_TRUE(ip1 == ip3);
+    ASSERT_TRUE(ip1 != ip2);
+    ASSERT_TRUE(ip1 < ip2);
+    ASSERT_TRUE(ip2 > ip1);
+    ASSERT_TRUE(ip1 <= ip3);
+    ASSERT_TRUE(ip2 >= ip1);
+    ASSERT_EQ(ip1.hash(), ipv6_address::parse("2001:db8::1").hash());
+    ASSERT_EQ(std::hash<ipv6_address_compact>{}(ip1), ip1.hash());
+
+    std::unordered_set<ipv6_address_compact> set { ip1, ip2, ip3 };
+    ASSERT_EQ(set.size(), 2);
+
+    auto a = ip1;
+    auto b = ip2;
+    std::swap(a, b);
+    ASSERT_EQ(a, ip2);
+    ASSERT_EQ(b, ip1);
+}
+
+TEST(ipv6_address_compact, Classification) {
+    const char* addresses[] = {
+        "::", "::1", "fe80::1", "fec0::1", "fc00::1", "ff02::1", "2001:db8::1", "2a00:1450:4001::1", "::ffff:10.0.0.1", "::ffff:8.8.8.8", "100::1"
+    };
+    for (const auto* str : addresses) {
+        const auto ip = ipv6_address::parse(str);
+        const auto compact = ipv6_address_compact(ip);
+
+        EXPECT_EQ(compact.classify(), ip.classify()) << str;
+        EXPECT_EQ(compact.is_multicast(), ip.is_multicast()) << str;
+        EXPECT_EQ(compact.is_private(), ip.is_private()) << str;
+        EXPECT_EQ(compact.is_global(), ip.is_global()) << str;
+        EXPECT_EQ(compact.is_reserved(), ip.is_reserved()) << str;
+        EXPECT_EQ(compact.is_loopback(), ip.is_loopback()) << str;
+        EXPECT_EQ(compact.is_link_local(), ip.is_link_local()) << str;
+        EXPECT_EQ(compact.is_unspecified(), ip.is_unspecified()) << str;
+        EXPECT_EQ(compact.is_site_local(), ip.is_site_local()) << str;
+        EXPECT_EQ(compact.ipv4_mapped().has_value(), ip.ipv4_mapped().has_value()) << str;
+    }
+}
+
+TEST(ip_address_compact, DefaultCtor) {
+    IPADDRESS_CONSTEXPR ip_address_compact ip;
+
+    EXPECT_EQ(ip.version(), ip_version::V4);
+    EXPECT_EQ(ip.size(), 4);
+    EXPECT_TRUE(ip.is_v4());
+    EXPECT_FALSE(ip.is_v6());
+    EXPECT_EQ(ip.to_address(), ip_address());
+}
+
+TEST(ip_address_compact, CompileTime) {
+#if IPADDRESS_CPP_VERSION >= 14
+    constexpr auto ip1 = ip_address_compact(ip_address::parse("192.168.0.1"));
+    constexpr auto ip2 = ip_address_compact(ip_address::parse("::1"));
+    constexpr auto address1 = ip1.to_address();
+    constexpr auto address2 = ip2.to_address();
+    constexpr auto flags1 = ip1.classify();
+    constexpr auto flags2 = ip2.classify();
+    constexpr auto less = ip1 < ip2;
+
+    ASSERT_EQ(address1, ip_address::parse("192.168.0.1"));
+    ASSERT_EQ(address2, ip_address::parse("::1"));
+    ASSERT_EQ(flags1, address_flags::is_private);
+    ASSERT_EQ(flags2, address_flags::is_private | address_flags::is_reserved | address_flags::is_loopback);
+    ASSERT_TRUE(less);
+#endif
+}
+
+TEST(ip_address_compact, Conversion) {
+    const auto ip1 = ip_address_compact(ip_address::parse("192.168.0.1"));
+    const auto ip2 = ip_address_compact(ip_address::parse("2001:db8::1%eth0"));
+    const auto ip3 = ip_address_compact(ipv6_address_compact(ipv6_address::parse("2001:db8::1")));
+
+    ASSERT_TRUE(ip1.is_v4());
+    ASSERT_TRUE(ip2.is_v6());
+    ASSERT_EQ(ip1.size(), 4);
+    ASSERT_EQ(ip2.size(), 16);
+    ASSERT_EQ(ip1.v4().value(), ipv4_address::parse("192.168.0.1"));
+    ASSERT_FALSE(ip1.v6().has_value());
+    ASSERT_EQ(ip2.v6().value(), ipv6_address::parse("2001:db8::1"));
+    ASSERT_FALSE(ip2.v4().has_value());
+    ASSERT_EQ(ip2, ip3);
+    ASSERT_EQ(ip_address(ip1), ip_address::parse("192.168.0.1"));
+    ASSERT_EQ(ip_address(ip2), ip_address::parse("2001:db8::1"));
+    ASSERT_EQ(ip1.data()[0], 192);
+    ASSERT_EQ(ip1.data()[3], 1);
+    ASSERT_EQ(ip1.to_string(), "192.168.0.1");
+    ASSERT_EQ(ip2.to_string(), "2001:db8::1");
+    ASSERT_EQ(ip2.to_wstring(format::full), L"2001:0db8:0000:0000:0000:0000:0000:0001");
+    ASSERT_EQ(std::to_string(ip1), "192.168.0.1");
+
+    char buffer[64] {};
+    const auto end = ip1.to_chars(buffer, buffer + sizeof(buffer));
+    ASSERT_EQ(std::string(buffer, end), "192.168.0.1");
+
+    std::ostringstream ss;
+    ss << ip1 << ' ' << ip2;
+    ASSERT_EQ(ss.str(), "192.168.0.1 2001:db8::1");
+}
+
+TEST(ip_address_compact, Comparison) {
+    const char* addresses[] = {
+        "255.255.255.255", "0.0.0.0", "10.0.0.1", "10.0.0.2", "::", "::ffff:10.0.0.1", "2001:db8::1", "fe80::1", "ff02::1"
+    };
+    std::set<ip_address> expected;
+    std::set<ip_address_compact> actual;
+    for (const auto* str : addresses) {
+        const auto ip = ip_address::parse(str);
+        const auto compact = ip_address_compact(ip);
+        expected.insert(ip);
+        actual.insert(compact);
+
+        EXPECT_EQ(compact.hash(), ip.hash()) << str;
+        EXPECT_EQ(std::hash<ip_address_compact>{}(compact), ip.hash()) << str;
+    }
+    ASSERT_EQ(expected.size(), actual.size());
+
+    auto it = actual.begin();
+    for (const auto& ip : expected) {
+        EXPECT_EQ(it->to_address(), ip);
+        ++it;
+    }
+
+    const auto ip1 = ip_address_compact(ip_address::parse("0.0.0.0"));
+    const auto ip2 = ip_address_compact(ip_address::parse("::"));
+    ASSERT_TRUE(ip1 != ip2);
+    ASSERT_TRUE(ip1 < ip2);
+    ASSERT_TRUE(ip2 > ip1);
+    ASSERT_TRUE(ip1 <= ip1);
+    ASSERT_TRUE(ip2 >= ip2);
+
+    std::unordered_set<ip_address_compact> set { ip1, ip2, ip1 };
+    ASSERT_EQ(set.size(), 2);
+
+    auto a = ip1;
+    auto b = ip2;
+    std::swap(a, b);
+    ASSERT_EQ(a, ip2);
+    ASSERT_EQ(b, ip1);
+}
+
+TEST(ip_address_compact, Classification) {
+    const char* addresses[] = {
+        "0.0.0.0", "127.0.0.1", "10.1.2.3", "169.254.0.1", "224.0.0.1", "240.0.0.1", "8.8.8.8", "100.64.0.1",
+        "::", "::1", "fe80::1", "fec0::1", "fc00::1", "ff02::1", "2001:db8::1", "::ffff:10.0.0.1"
+    };
+    for (const auto* str : addresses) {
+        const auto ip = ip_address::parse(str);
+        const auto compact = ip_address_compact(ip);
+
+        EXPECT_EQ(compact.classify(), ip.classify()) << str;
+        EXPECT_EQ(compact.is_multicast(), ip.is_multicast()) << str;
+        EXPECT_EQ(compact.is_private(), ip.is_private()) << str;
+        EXPECT_EQ(compact.is_global(), ip.is_global()) << str;
+        EXPECT_EQ(compact.is_reserved(), ip.is_reserved()) << str;
+        EXPECT_EQ(compact.is_loopback(), ip.is_loopback()) << str;
+        EXPECT_EQ(compact.is_link_local(), ip.is_link_local()) << str;
+        EXPECT_EQ(compact.is_unspecified(), ip.is_unspecified()) << str;
+        EXPECT_EQ(compact.is_site_local(), ip.is_site_local()) << str;
+    }
+}
@@ -0,0 +1,147 @@
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#ifdef IPADDRESS_TEST_MODULE
+import ipaddress;
+#else
+#include <ipaddress/ipaddress.hpp>
+#endif
+
+using namespace testing;
+using namespace ipaddress;
+
+TEST(ip_concurrent_prefix_table, Empty) {
+    ip_concurrent_prefix_table<ip_network, int> table;
+    auto reader = table.make_reader();
+    const auto snapshot = reader.pin();
+
+    EXPECT_TRUE(snapshot->empty());
+    EXPECT_EQ(snapshot->longest_match(ip_address::parse("10.0.0.1")), nullptr);
+    EXPECT_EQ(snapshot->longest_match(ip_address::parse("2001:db8::1")), nullptr);
+}
+
+TEST(ip_concurrent_prefix_table, Transactions) {
+    ip_concurrent_prefix_table<ipv4_network, int> table;
+    auto reader = table.make_reader();
+
+    auto transaction = table.update();
+    EXPECT_TRUE(transaction.insert(ipv4_network::parse("10.0.0.0/8"), 1));
+    EXPECT_TRUE(transaction.insert(ipv4_network::parse("10.1.0.0/16"), 2));
+    EXPECT_FALSE(transaction.insert(ipv4_network::parse("10.0.0.0/8"), 3));
+    EXPECT_EQ(transaction.table().size(), 2);
+    {
+        const auto snapshot = reader.pin();
+        EXPECT_TRUE(snapshot->empty());
+    }
+    transaction.commit();
+
+    auto before = reader.pin();
+    EXPECT_EQ(before->size(), 2);
+    EXPECT_EQ(before->longest_match(ipv4_address::parse("10.1.2.3"))->second, 2);
+    EXPECT_EQ(before->longest_match(ipv4_address::parse("10.2.0.1"))->second, 3);
+
+    auto second = table.update();
+    EXPECT_TRUE(second.erase(ipv4_network::parse("10.1.0.0/16")));
+    EXPECT_FALSE(second.erase(ipv4_network::parse("10.1.0.0/16")));
+    second.insert(ipv4_network::parse("192.0.2.0/24"), 4);
+    second.commit();
+    second.commit();
+
+    EXPECT_EQ(before->longest_match(ipv4_address::parse("10.1.2.3"))->second, 2);
+    EXPECT_EQ(before->longest_match(ipv4_address::parse("192.0.2.1")), nullptr);
+    {
+        auto other = table.make_reader();
+        const auto after = other.pin();
+        EXPECT_EQ(after->longest_match(ipv4_address::parse("10.1.2.3"))->second, 3);
+        EXPECT_EQ(after->longest_match(ipv4_address::parse("192.0.2.1"))->second, 4);
+    }
+
+    {
+        auto aborted = table.update();
+        aborted.clear();
+    }
+    auto other = table.make_reader();
+    EXPECT_EQ(other.pin()->size(), 2);
+}
+
+TEST(ip_concurrent_prefix_table, Reclamation) {
+    ip_concurrent_prefix_table<ipv6_network, std::shared_ptr<int>> table;
+    auto reader = table.make_reader();
+    const auto value = std::make_shared<int>(1);
+
+    auto first = table.update();
+    first.insert(ipv6_network::parse("2001:db8::/32"), value);
+    first.commit();
+    EXPECT_EQ(value.use_count(), 2);
+
+    {
+        const auto pinned = reader.pin();
+        auto second = table.update();
+        second.insert(ipv6_network::parse("2001:db8:1::/48"), value);
+        second.commit();
+        EXPECT_EQ(value.use_count(), 4);
+
+        table.reclaim();
+        EXPECT_EQ(value.use_count(), 4);
+        EXPECT_EQ(pinned->size(), 1);
+    }
+    table.reclaim();
+    EXPECT_EQ(value.use_count(), 3);
+
+    auto third = table.update();
+    third.clear();
+    third.commit();
+    EXPECT_EQ(value.use_count(), 1);
+}
+
+TEST(ip_concurrent_prefix_table, ConcurrentReaders) {
+    std::vector<ipv4_network> networks;
+    for (uint32_t i = 0; i < 256; ++i) {
+        networks.push_back(ipv4_network::from_address(ipv4_address::from_uint(0x0A000000 | (i << 16)), 16));
+    }
+    ip_concurrent_prefix_table<ipv4_network, uint32_t> table;
+    std::atomic<bool> done{false};
+    std::atomic<size_t> errors{0};
+
+    std::vector<std::thread> readers;
+    for (size_t t = 0; t < 3; ++t) {
+        readers.emplace_back([&table, &done, &errors, t]() {
+            auto reader = table.make_reader();
+            uint32_t last = 0;
+            while (!done.load()) {
+                const auto snapshot = reader.pin();
+                const auto* first = snapshot->longest_match(ipv4_address::from_uint(0x0A000001 | uint32_t(t << 16)));
+                if (first == nullptr) {
+                    continue;
+                }
+                const auto generation = first->second;
+                for (uint32_t i = 0; i < 256; ++i) {
+                    const auto* match = snapshot->longest_match(ipv4_address::from_uint(0x0A000001 | (i << 16)));
+                    errors += match == nullptr || match->second != generation ? 1 : 0;
+                }
+                errors += generation < last ? 1 : 0;
+                last = generation;
+            }
+        });
+    }
+
+    for (uint32_t generation = 1; generation <= 200; ++generation) {
+        auto transaction = table.update();
+        for (const auto& network : networks) {
+            transaction.insert(network, generation);
+        }
+        transaction.commit();
+    }
+    done = true;
+    for (auto& thread : readers) {
+        thread.join();
+    }
+
+    EXPECT_EQ(errors.load(), 0);
+    auto reader = table.make_reader();
+    EXPECT_EQ(reader.pin()->longest_match(ipv4_address::parse("10.255.0.1"))->second, 200);
+}
@@ -0,0 +1,147 @@
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#ifdef IPADDRESS_TEST_MODULE
+import ipaddress;
+#else
+#include <ipaddress/ipaddress.hpp>
+#endif
+
+using namespace testing;
+using namespace ipaddress;
+
+template <typename Filter>
+static void check_addresses(double max_rate) {
+    std::mt19937 rng(5);
+    std::vector<ipv4_address> addresses;
+    for (size_t i = 0; i < 100000; ++i) {
+        addresses.push_back(ipv4_address::from_uint(uint32_t(rng()) & 0x7FFFFFFF));
+    }
+    const Filter filter(addresses.begin(), addresses.end());
+
+    for (const auto& address : addresses) {
+        ASSERT_TRUE(filter.contains(address));
+    }
+    size_t positives = 0;
+    for (size_t i = 0; i < 100000; ++i) {
+        positives += filter.contains(ipv4_address::from_uint(uint32_t(rng()) | 0x80000000));
+    }
+    EXPECT_LT(double(positives) / 100000, max_rate);
+}
+
+TEST(ip_filter, Empty) {
+    const ip_bloom_filter<ip_address> bloom;
+    const ip_xor_filter<ip_network> xor8;
+
+    EXPECT_TRUE(bloom.empty());
+    EXPECT_EQ(bloom.size(), 0);
+    EXPECT_EQ(bloom.size_in_bytes(), 0);
+    EXPECT_FALSE(bloom.contains(ip_address::parse("10.0.0.1")));
+    EXPECT_TRUE(xor8.empty());
+    EXPECT_FALSE(xor8.contains(ip_address::parse("2001:db8::1")));
+
+    const std::vector<ipv6_address> none;
+    const ip_xor_filter<ipv6_address> filter(none.begin(), none.end());
+    EXPECT_TRUE(filter.empty());
+    EXPECT_FALSE(filter.contains(ipv6_address::parse("::")));
+}
+
+TEST(ip_filter, FalsePositiveRate) {
+    check_addresses<ip_bloom_filter<ipv4_address>>(0.02);
+    check_addresses<ip_xor_filter<ipv4_address>>(0.01);
+    check_addresses<ip_xor_filter<ipv4_address, uint16_t>>(0.0005);
+}
+
+TEST(ip_filter, ZeroBitsPerEntry) {
+    const std::vector<ipv4_address> addresses = { ipv4_address::parse("10.0.0.1"), ipv4_address::parse("10.0.0.2") };
+    const ip_bloom_filter<ipv4_address> filter(addresses.begin(), addresses.end(), 0);
+
+    EXPECT_EQ(filter.size(), 2);
+    EXPECT_EQ(filter.size_in_bytes(), 32);
+    EXPECT_TRUE(filter.contains(ipv4_address::parse("10.0.0.1")));
+    EXPECT_TRUE(filter.contains(ipv4_address::parse("10.0.0.2")));
+}
+
+TEST(ip_filter, MixedVersions) {
+    const std::vector<ip_address> addresses = {
+        ip_address::parse("10.0.0.1"), ip_address::parse("2001:db8::1"), ip_address::parse("10.0.0.1") };
+    const ip_bloom_filter<ip_address> bloom(addresses.begin(), addresses.end(), 16);
+    const ip_xor_filter<ip_address, uint16_t> xor16(addresses.begin(), addresses.end());
+
+    EXPECT_EQ(bloom.size(), 3);
+    EXPECT_EQ(xor16.size(), 2);
+    for (const auto& address : addresses) {
+        EXPECT_TRUE(bloom.contains(address));
+        EXPECT_TRUE(xor16.contains(address));
+    }
+    EXPECT_FALSE(xor16.contains(ip_address::parse("::a00:1")));
+}
+
+TEST(ip_filter, Networks) {
+    const std::vector<ip_network> networks = {
+        ip_network::parse("192.0.2.7/32"),
+        ip_network::parse("198.51.100.128/25"),
+        ip_network::parse("10.16.0.0/22"),
+        ip_network::parse("2001:db8::1/128"),
+        ip_network::parse("2001:db8:1:2::/64"),
+        ip_network::parse("2001:db8:100::/46") };
+    const ip_xor_filter<ip_network, uint16_t> filter(networks.begin(), networks.end());
+
+    EXPECT_EQ(filter.size(), 139);
+    EXPECT_TRUE(filter.contains(ip_address::parse("192.0.2.7")));
+    EXPECT_FALSE(filter.contains(ip_address::parse("192.0.2.8")));
+    EXPECT_TRUE(filter.contains(ip_address::parse("198.51.100.200")));
+    EXPECT_TRUE(filter.contains(ip_address::parse("198.51.100.128")));
+    EXPECT_FALSE(filter.contains(ip_address::parse("198.51.100.127")));
+    EXPECT_FALSE(filter.contains(ip_address::parse("198.51.100.1")));
+    EXPECT_TRUE(filter.contains(ip_address::parse("10.16.0.1")));
+    EXPECT_TRUE(filter.contains(ip_address::parse("10.16.3.255")));
+    EXPECT_FALSE(filter.contains(ip_address::parse("10.16.4.0")));
+    EXPECT_TRUE(filter.contains(ip_address::parse("2001:db8::1")));
+    EXPECT_FALSE(filter.contains(ip_address::parse("2001:db8::2")));
+    EXPECT_TRUE(filter.contains(ip_address::parse("2001:db8:1:ffff::1")));
+    EXPECT_TRUE(filter.contains(ip_address::parse("2001:db8:1:2::1")));
+    EXPECT_TRUE(filter.contains(ip_address::parse("2001:db8:103:1::1")));
+    EXPECT_FALSE(filter.contains(ip_address::parse("2001:db8:104::1")));
+
+    const std::vector<ipv4_network> ipv4 = { ipv4_network::parse("10.0.0.0/8") };
+    const ip_bloom_filter<ipv4_network> bloom(ipv4.begin(), ipv4.end());
+    EXPECT_EQ(bloom.size(), 65536);
+    EXPECT_TRUE(bloom.contains(ipv4_address::parse("10.200.3.4")));
+
+    const std::vector<ipv4_network> hosts = { ipv4_network::parse("192.0.2.8/29") };
+    const ip_xor_filter<ipv4_network, uint16_t> small(hosts.begin(), hosts.end());
+    EXPECT_EQ(small.size(), 8);
+    for (uint32_t i = 0; i < 256; ++i) {
+        EXPECT_EQ(small.contains(ipv4_address::from_uint(0xC0000200 | i)), i >= 8 && i < 16);
+    }
+}
+
+TEST(ip_filter, NetworkTooLarge) {
+    const std::vector<ipv4_network> ipv4 = { ipv4_network::parse("10.0.0.0/24"), ipv4_network::parse("10.0.0.0/7") };
+    const std::vector<ipv6_network> ipv6 = { ipv6_network::parse("2001::/31") };
+
+    error_code code = error_code::no_error;
+    ip_bloom_filter<ipv4_network> bloom;
+    bloom.assign(ipv4.begin(), ipv4.end(), code);
+    EXPECT_EQ(code, error_code::network_too_large);
+    EXPECT_TRUE(bloom.empty());
+
+    ip_xor_filter<ipv6_network> xor8;
+    xor8.assign(ipv6.begin(), ipv6.end(), code);
+    EXPECT_EQ(code, error_code::network_too_large);
+    EXPECT_TRUE(xor8.empty());
+
+#ifdef IPADDRESS_NO_EXCEPTIONS
+    EXPECT_NO_THROW((ip_bloom_filter<ipv4_network>(ipv4.begin(), ipv4.end())));
+#else
+    EXPECT_THAT(
+        [&ipv4]() { ip_bloom_filter<ipv4_network>(ipv4.begin(), ipv4.end()); },
+        ThrowsMessage<logic_error>(StrEq("network is too large")));
+    EXPECT_THAT(
+        [&ipv6]() { ip_xor_filter<ipv6_network>(ipv6.begin(), ipv6.end()); },
+        ThrowsMessage<logic_error>(StrEq("network is too large")));
+#endif
+}
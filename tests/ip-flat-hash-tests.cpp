@@ -0,0 +1,140 @@
+#include <random>
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#ifdef IPADDRESS_TEST_MODULE
+import ipaddress;
+#else
+#include <ipaddress/ipaddress.hpp>
+#endif
+
+using namespace testing;
+using namespace ipaddress;
+
+TEST(ip_flat_set, Empty) {
+    ip_flat_set<ipv4_address> set;
+
+    EXPECT_TRUE(set.empty());
+    EXPECT_EQ(set.size(), 0);
+    EXPECT_EQ(set.capacity(), 0);
+    EXPECT_FALSE(set.contains(ipv4_address::parse("10.0.0.1")));
+    EXPECT_FALSE(set.erase(ipv4_address::parse("10.0.0.1")));
+}
+
+TEST(ip_flat_set, InsertErase) {
+    ip_flat_set<ipv4_address> set { ipv4_address::parse("10.0.0.1"), ipv4_address::parse("10.0.0.2"), ipv4_address::parse("10.0.0.1") };
+
+    EXPECT_EQ(set.size(), 2);
+    EXPECT_TRUE(set.contains(ipv4_address::parse("10.0.0.1")));
+    EXPECT_TRUE(set.contains(ipv4_address::parse("10.0.0.2")));
+    EXPECT_FALSE(set.contains(ipv4_address::parse("10.0.0.3")));
+    EXPECT_FALSE(set.insert(ipv4_address::parse("10.0.0.2")));
+    EXPECT_TRUE(set.insert(ipv4_address::parse("0.0.0.0")));
+    EXPECT_TRUE(set.contains(ipv4_address::parse("0.0.0.0")));
+    EXPECT_TRUE(set.erase(ipv4_address::parse("10.0.0.1")));
+    EXPECT_FALSE(set.erase(ipv4_address::parse("10.0.0.1")));
+    EXPECT_FALSE(set.contains(ipv4_address::parse("10.0.0.1")));
+    EXPECT_EQ(set.size(), 2);
+
+    set.clear();
+    EXPECT_TRUE(set.empty());
+    EXPECT_EQ(set.capacity(), 0);
+    EXPECT_FALSE(set.contains(ipv4_address::parse("10.0.0.2")));
+}
+
+TEST(ip_flat_set, MixedVersions) {
+    ip_flat_set<ip_address> set;
+    set.insert(ip_address::parse("1.2.3.4"));
+    set.insert(ip_address::parse("2001:db8::1"));
+
+    EXPECT_EQ(set.size(), 2);
+    EXPECT_TRUE(set.contains(ip_address::parse("1.2.3.4")));
+    EXPECT_TRUE(set.contains(ip_address::parse("2001:db8::1")));
+    EXPECT_FALSE(set.contains(ip_address::parse("::102:304")));
+    EXPECT_TRUE(set.insert(ip_address::parse("::102:304")));
+    EXPECT_EQ(set.size(), 3);
+
+    std::vector<std::string> actual;
+    set.for_each([&actual](const ip_address& address) { actual.push_back(address.to_string()); });
+    EXPECT_THAT(actual, UnorderedElementsAre("1.2.3.4", "2001:db8::1", "::102:304"));
+}
+
+TEST(ip_flat_set, Reserve) {
+    ip_flat_set<ipv6_address> set;
+    set.reserve(1000);
+    const auto capacity = set.capacity();
+
+    EXPECT_GE(capacity / 8 * 7, 1000);
+    for (uint64_t i = 0; i < 1000; ++i) {
+        set.insert(ipv6_address::from_uint(uint128_t(0x20010db800000000ULL, i)));
+    }
+    EXPECT_EQ(set.size(), 1000);
+    EXPECT_EQ(set.capacity(), capacity);
+}
+
+TEST(ip_flat_set, MatchesUnorderedSet) {
+    std::mt19937 rng(7);
+    ip_flat_set<ip_address> set;
+    std::unordered_set<ip_address> expected;
+    for (size_t i = 0; i < 50000; ++i) {
+        const auto value = uint32_t(rng()) % 4096;
+        const auto address = value % 2 == 0
+            ? ip_address(ipv4_address::from_uint(value))
+            : ip_address(ipv6_address::from_uint(uint128_t(0x20010db800000000ULL, value)));
+        if (rng() % 3 == 0) {
+            EXPECT_EQ(set.erase(address), expected.erase(address) != 0);
+        } else {
+            EXPECT_EQ(set.insert(address), expected.insert(address).second);
+        }
+    }
+    EXPECT_EQ(set.size(), expected.size());
+    for (uint32_t value = 0; value < 4096; ++value) {
+        const auto ipv4 = ip_address(ipv4_address::from_uint(value));
+        const auto ipv6 = ip_address(ipv6_address::from_uint(uint128_t(0x20010db800000000ULL, value)));
+        EXPECT_EQ(set.contains(ipv4), expected.count(ipv4) != 0);
+        EXPECT_EQ(set.contains(ipv6), expected.count(ipv6) != 0);
+    }
+    size_t count = 0;
+    set.for_each([&](const ip_address& address) { count += expected.count(address); });
+    EXPECT_EQ(count, expected.size());
+}
+
+TEST(ip_flat_map, InsertFind) {
+    ip_flat_map<ipv4_address, std::string> map;
+
+    EXPECT_TRUE(map.insert(ipv4_address::parse("192.0.2.1"), "a"));
+    EXPECT_FALSE(map.insert(ipv4_address::parse("192.0.2.1"), "b"));
+    map[ipv4_address::parse("192.0.2.2")] = "c";
+
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_EQ(*map.find(ipv4_address::parse("192.0.2.1")), "a");
+    EXPECT_EQ(*map.find(ipv4_address::parse("192.0.2.2")), "c");
+    EXPECT_EQ(map.find(ipv4_address::parse("192.0.2.3")), nullptr);
+    EXPECT_TRUE(map.contains(ipv4_address::parse("192.0.2.2")));
+
+    *map.find(ipv4_address::parse("192.0.2.1")) += "d";
+    EXPECT_EQ(map[ipv4_address::parse("192.0.2.1")], "ad");
+    EXPECT_TRUE(map.erase(ipv4_address::parse("192.0.2.1")));
+    EXPECT_EQ(map.find(ipv4_address::parse("192.0.2.1")), nullptr);
+    EXPECT_EQ(map.size(), 1);
+}
+
+TEST(ip_flat_map, Counters) {
+    ip_flat_map<ip_address, uint64_t> map;
+    for (uint32_t i = 0; i < 100000; ++i) {
+        map[ip_address(ipv4_address::from_uint(i % 1000))] += 1;
+        map[ip_address(ipv6_address::from_uint(uint128_t(1, i % 500)))] += 2;
+    }
+
+    EXPECT_EQ(map.size(), 1500);
+    EXPECT_EQ(*map.find(ip_address(ipv4_address::from_uint(999))), 100);
+    EXPECT_EQ(*map.find(ip_address(ipv6_address::from_uint(uint128_t(1, 499)))), 400);
+    EXPECT_EQ(map.find(ip_address(ipv4_address::from_uint(1000))), nullptr);
+
+    uint64_t total = 0;
+    map.for_each([&total](const ip_address& /*address*/, uint64_t value) { total += value; });
+    EXPECT_EQ(total, 300000);
+}
@@ -0,0 +1,214 @@
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#ifdef IPADDRESS_TEST_MODULE
+import ipaddress;
+#else
+#include <ipaddress/ipaddress.hpp>
+#endif
+
+using namespace testing;
+using namespace ipaddress;
+
+template <typename Aggregator>
+static std::vector<std::string> aggregator_to_strings(const Aggregator& aggregator) {
+    std::vector<std::string> result;
+    for (const auto& net : aggregator) {
+        result.push_back(net.to_string());
+    }
+    return result;
+}
+
+template <typename Net>
+static std::vector<std::string> collapse_to_strings(const std::vector<Net>& networks) {
+    std::vector<std::string> result;
+    for (const auto& net : collapse_addresses(networks.begin(), networks.end())) {
+        result.push_back(net.to_string());
+    }
+    return result;
+}
+
+TEST(ip_network_aggregator, Empty) {
+    ip_network_aggregator<ipv4_network> aggregator;
+
+    EXPECT_TRUE(aggregator.empty());
+    EXPECT_EQ(aggregator.size(), 0);
+    EXPECT_EQ(aggregator.begin(), aggregator.end());
+    EXPECT_FALSE(aggregator.contains(ipv4_address::parse("10.0.0.1")));
+    EXPECT_FALSE(aggregator.erase(ipv4_network::parse("10.0.0.0/8")));
+}
+
+TEST(ip_network_aggregator, InsertMergesSiblings) {
+    ip_network_aggregator<ipv4_network> aggregator;
+
+    aggregator.insert(ipv4_network::parse("192.0.2.0/26"));
+    EXPECT_THAT(aggregator_to_strings(aggregator), ElementsAre("192.0.2.0/26"));
+
+    aggregator.insert(ipv4_network::parse("192.0.2.128/25"));
+    EXPECT_THAT(aggregator_to_strings(aggregator), ElementsAre("192.0.2.0/26", "192.0.2.128/25"));
+
+    aggregator.insert(ipv4_network::parse("192.0.2.64/26"));
+    EXPECT_THAT(aggregator_to_strings(aggregator), ElementsAre("192.0.2.0/24"));
+    EXPECT_EQ(aggregator.size(), 1);
+
+    aggregator.insert(ipv4_network::parse("192.0.2.10/32"));
+    aggregator.insert(ipv4_network::parse("192.0.3.0/24"));
+    EXPECT_THAT(aggregator_to_strings(aggregator), ElementsAre("192.0.2.0/23"));
+
+    aggregator.insert(ipv4_network::parse("10.0.0.0/8"));
+    aggregator.insert(ipv4_network::parse("255.255.255.255/32"));
+    EXPECT_THAT(aggregator_to_strings(aggregator), ElementsAre("10.0.0.0/8", "192.0.2.0/23", "255.255.255.255/32"));
+    EXPECT_EQ(aggregator.size(), 3);
+}
+
+TEST(ip_network_aggregator, EraseSplitsMerged) {
+    ip_network_aggregator<ipv4_network> aggregator;
+    const std::vector<ipv4_network> networks = {
+        ipv4_network::parse("192.0.2.0/25"),
+        ipv4_network::parse("192.0.2.128/26"),
+        ipv4_network::parse("192.0.2.192/26"),
+        ipv4_network::parse("192.0.2.200/29"),
+    };
+    aggregator.insert(networks.begin(), networks.end());
+    EXPECT_THAT(aggregator_to_strings(aggregator), ElementsAre("192.0.2.0/24"));
+
+    EXPECT_TRUE(aggregator.erase(ipv4_network::parse("192.0.2.192/26")));
+    EXPECT_THAT(aggregator_to_strings(aggregator), ElementsAre("192.0.2.0/25", "192.0.2.128/26", "192.0.2.200/29"));
+
+    EXPECT_FALSE(aggregator.erase(ipv4_network::parse("192.0.2.192/26")));
+    EXPECT_FALSE(aggregator.erase(ipv4_network::parse("192.0.2.0/24")));
+    EXPECT_FALSE(aggregator.erase(ipv4_network::parse("192.0.2.0/26")));
+
+    EXPECT_EQ(aggregator.erase(networks.begin(), networks.end()), 3);
+    EXPECT_TRUE(aggregator.empty());
+    EXPECT_EQ(aggregator.begin(), aggregator.end());
+}
+
+TEST(ip_network_aggregator, Duplicates) {
+    ip_network_aggregator<ipv4_network> aggregator;
+
+    aggregator.insert(ipv4_network::parse("10.0.0.0/8"));
+    aggregator.insert(ipv4_network::parse("10.0.0.0/8"));
+    aggregator.insert(ipv4_network::parse("10.1.0.0/16"));
+    EXPECT_THAT(aggregator_to_strings(aggregator), ElementsAre("10.0.0.0/8"));
+
+    EXPECT_TRUE(aggregator.erase(ipv4_network::parse("10.0.0.0/8")));
+    EXPECT_THAT(aggregator_to_strings(aggregator), ElementsAre("10.0.0.0/8"));
+
+    EXPECT_TRUE(aggregator.erase(ipv4_network::parse("10.0.0.0/8")));
+    EXPECT_THAT(aggregator_to_strings(aggregator), ElementsAre("10.1.0.0/16"));
+}
+
+TEST(ip_network_aggregator, WholeSpace) {
+    ip_network_aggregator<ipv4_network> aggregator;
+
+    aggregator.insert(ipv4_network::parse("0.0.0.0/1"));
+    aggregator.insert(ipv4_network::parse("128.0.0.0/1"));
+    EXPECT_THAT(aggregator_to_strings(aggregator), ElementsAre("0.0.0.0/0"));
+    EXPECT_TRUE(aggregator.contains(ipv4_address::parse("0.0.0.0")));
+    EXPECT_TRUE(aggregator.contains(ipv4_address::parse("255.255.255.255")));
+
+    aggregator.clear();
+    EXPECT_TRUE(aggregator.empty());
+    EXPECT_FALSE(aggregator.contains(ipv4_address::parse("0.0.0.0")));
+}
+
+TEST(ip_network_aggregator, Contains) {
+    ip_network_aggregator<ipv6_network> aggregator;
+
+    aggregator.insert(ipv6_network::parse("2001:db8::/33"));
+    aggregator.insert(ipv6_network::parse("2001:db8:8000::/33"));
+    aggregator.insert(ipv6_network::parse("2001:db9::1/128"));
+
+    EXPECT_THAT(aggregator_to_strings(aggregator), ElementsAre("2001:db8::/32", "2001:db9::1/128"));
+    EXPECT_TRUE(aggregator.contains(ipv6_address::parse("2001:db8:ffff::1")));
+    EXPECT_TRUE(aggregator.contains(ipv6_address::parse("2001:db9::1")));
+    EXPECT_FALSE(aggregator.contains(ipv6_address::parse("2001:db9::2")));
+    EXPECT_FALSE(aggregator.contains(ipv6_address::parse("2001:db7::1")));
+}
+
+TEST(ip_network_aggregator, MixedVersions) {
+    ip_network_aggregator<ip_network> aggregator;
+
+    aggregator.insert(ip_network::parse("2001:db8::/33"));
+    aggregator.insert(ip_network::parse("192.0.2.128/25"));
+    aggregator.insert(ip_network::parse("2001:db8:8000::/33"));
+    aggregator.insert(ip_network::parse("192.0.2.0/25"));
+    aggregator.insert(ip_network::parse("::/128"));
+
+    EXPECT_THAT(aggregator_to_strings(aggregator), ElementsAre("192.0.2.0/24", "::/128", "2001:db8::/32"));
+    EXPECT_EQ(aggregator.size(), 3);
+    EXPECT_TRUE(aggregator.contains(ip_address::parse("192.0.2.1")));
+    EXPECT_TRUE(aggregator.contains(ip_address::parse("::")));
+    EXPECT_FALSE(aggregator.contains(ip_address::parse("0.0.0.0")));
+
+    EXPECT_TRUE(aggregator.erase(ip_network::parse("192.0.2.0/25")));
+    EXPECT_TRUE(aggregator.erase(ip_network::parse("192.0.2.128/25")));
+    EXPECT_THAT(aggregator_to_strings(aggregator), ElementsAre("::/128", "2001:db8::/32"));
+}
+
+TEST(ip_network_aggregator, Iterator) {
+    ip_network_aggregator<ipv4_network> aggregator;
+    aggregator.insert(ipv4_network::parse("10.0.0.0/8"));
+    aggregator.insert(ipv4_network::parse("172.16.0.0/12"));
+
+    auto it = aggregator.begin();
+    EXPECT_EQ(*it, ipv4_network::parse("10.0.0.0/8"));
+    EXPECT_EQ(it->prefixlen(), 8);
+    auto prev = it++;
+    EXPECT_EQ(*prev, ipv4_network::parse("10.0.0.0/8"));
+    EXPECT_EQ(*it, ipv4_network::parse("172.16.0.0/12"));
+    EXPECT_NE(it, aggregator.end());
+    EXPECT_EQ(++it, aggregator.end());
+    EXPECT_EQ(std::distance(aggregator.begin(), aggregator.end()), 2);
+}
+
+TEST(ip_network_aggregator, RandomAgainstCollapse) {
+    std::mt19937 rng(2024);
+    ip_network_aggregator<ipv4_network> aggregator;
+    std::vector<ipv4_network> networks;
+
+    for (size_t round = 0; round < 20; ++round) {
+        for (size_t i = 0; i < 200; ++i) {
+            const auto prefixlen = 20 + rng() % 13;
+            const auto address = ipv4_address::from_uint(0xC0000000 | (uint32_t(rng()) & 0x0000FFFF));
+            const auto net = ipv4_network::from_address(address, prefixlen, false);
+            networks.push_back(net);
+            aggregator.insert(net);
+        }
+        std::shuffle(networks.begin(), networks.end(), rng);
+        for (size_t i = 0; i < 120; ++i) {
+            ASSERT_TRUE(aggregator.erase(networks.back()));
+            networks.pop_back();
+        }
+        ASSERT_EQ(aggregator_to_strings(aggregator), collapse_to_strings(networks)) << "round " << round;
+        ASSERT_EQ(aggregator.size(), collapse_addresses(networks.begin(), networks.end()).size());
+    }
+
+    ASSERT_EQ(aggregator.erase(networks.begin(), networks.end()), networks.size());
+    ASSERT_TRUE(aggregator.empty());
+}
+
+TEST(ip_network_aggregator, RandomAgainstCollapseIpv6) {
+    std::mt19937_64 rng(2024);
+    ip_network_aggregator<ipv6_network> aggregator;
+    std::vector<ipv6_network> networks;
+
+    for (size_t round = 0; round < 10; ++round) {
+        for (size_t i = 0; i < 200; ++i) {
+            const auto prefixlen = 116 + rng() % 13;
+            const auto address = ipv6_address::from_uint(uint128_t(0x20010DB800000000ULL, rng() & 0x3FFF));
+            const auto net = ipv6_network::from_address(address, prefixlen, false);
+            networks.push_back(net);
+            aggregator.insert(net);
+        }
+        std::shuffle(networks.begin(), networks.end(), rng);
+        for (size_t i = 0; i < 120; ++i) {
+            ASSERT_TRUE(aggregator.erase(networks.back()));
+            networks.pop_back();
+        }
+        ASSERT_EQ(aggregator_to_strings(aggregator), collapse_to_strings(networks)) << "round " << round;
+    }
+}
@@ -1,5 +1,7 @@
 #include <map>
+#include <random>
 #include <vector>
+#include <algorithm>
 #include <unordered_map>
 #include <sstream>
 #include <gtest/gtest.h>
@@ -9,6 +11,7 @@
 import ipaddress;
 #else
 #include <ipaddress/ipaddress.hpp>
+#include <ipaddress/parallel.hpp>
 #endif
 
 using namespace testing;
@@ -300,6 +303,18 @@ TEST(ip_network, parse) {
     EXPECT_EQ(actual8_ip.value().network_address().to_uint(), uint128_t::from_string("42540766411282592856904266426630537217").value());
 }
 
+TEST(ip_network, ParseLongIpv4) {
+    error_code err = error_code::no_error;
+    auto actual1 = ip_network::parse("192.168.100.0/000000000000000000000024");
+    auto actual2 = ip_network::parse("192.168.100.0/255.255.255.0", err);
+
+    EXPECT_EQ(err, error_code::no_error);
+    EXPECT_TRUE(actual1.is_v4());
+    EXPECT_TRUE(actual2.is_v4());
+    EXPECT_EQ(actual1, ip_network::parse("192.168.100.0/24"));
+    EXPECT_EQ(actual2, ip_network::parse("192.168.100.0/24"));
+}
+
 using InvalidNetworkParams = TestWithParam<std::tuple<const char*, error_code, const char*>>;
 TEST_P(InvalidNetworkParams, parse) {
     auto expected_address = get<0>(GetParam());
@@ -474,6 +489,25 @@ TEST(ip_network, to_string) {
     ASSERT_EQ(ss_compressed_upper_2.str(), expected_compressed_upper_2);
 }
 
+TEST(ip_network, to_chars) {
+    const auto net1 = ip_network::parse("127.240.0.0/24");
+    const auto net2 = ip_network::parse("fe80::1ff:fe23:4567:890a%eth2");
+
+    char buffer[64] = {};
+    char* end = net1.to_chars(buffer, buffer + sizeof(buffer));
+    ASSERT_NE(end, nullptr);
+    ASSERT_EQ(std::string(buffer, end), "127.240.0.0/24");
+    end = net2.to_chars(buffer, buffer + sizeof(buffer), format::full);
+    ASSERT_NE(end, nullptr);
+    ASSERT_EQ(std::string(buffer, end), "fe80:0000:0000:0000:01ff:fe23:4567:890a%eth2/128");
+    end = net2.to_chars(buffer, buffer + sizeof(buffer));
+    ASSERT_NE(end, nullptr);
+    ASSERT_EQ(std::string(buffer, end), "fe80::1ff:fe23:4567:890a%eth2/128");
+    ASSERT_EQ(net1.to_chars(buffer, buffer + 13), nullptr);
+    ASSERT_EQ(net2.to_chars(buffer, buffer + 32), nullptr);
+    ASSERT_EQ(net2.to_chars(buffer, buffer + 33), buffer + 33);
+}
+
 TEST(ip_network, to_wstring) {
     IPADDRESS_CONSTEXPR auto net1 = ip_network::parse("127.240.0.0/24");
     IPADDRESS_CONSTEXPR auto net2 = ip_network::parse("fe80::1ff:fe23:4567:890a%eth2");
@@ -600,10 +634,10 @@ TEST(ip_network, Hash) {
     IPADDRESS_CONSTEXPR auto hash3 = hash_functor(net1);
     IPADDRESS_CONSTEXPR auto hash4 = hash_functor(net2);
 
-    ASSERT_EQ(hash1, sizeof(size_t) == 8 ? 7623195473821216247ULL : 546525844U);
-    ASSERT_EQ(hash2, sizeof(size_t) == 8 ? 9261008770321846004ULL : 3598479863U);
-    ASSERT_EQ(hash3, sizeof(size_t) == 8 ? 7623195473821216247ULL : 546525844U);
-    ASSERT_EQ(hash4, sizeof(size_t) == 8 ? 9261008770321846004ULL : 3598479863U);
+    ASSERT_EQ(hash1, sizeof(size_t) == 8 ? 13323469935484181642ULL : 261059657U);
+    ASSERT_EQ(hash2, sizeof(size_t) == 8 ? 7179790573618965800ULL : 2267127803U);
+    ASSERT_EQ(hash3, sizeof(size_t) == 8 ? 13323469935484181642ULL : 261059657U);
+    ASSERT_EQ(hash4, sizeof(size_t) == 8 ? 7179790573618965800ULL : 2267127803U);
 }
 
 TEST(ip_network, Containers) {
@@ -977,6 +1011,19 @@ TEST(ip_network, address_exclude) {
     ASSERT_FALSE(exclude_it_ge);
 }
 
+TEST(ip_network, address_exclude_range) {
+    const auto network = ip_network::parse("2001:db8::/126");
+    const ip_network excluded[] = { ip_network::parse("2001:db8::3/128"), ip_network::parse("2001:db8::/128") };
+    const auto actual = network.address_exclude(std::begin(excluded), std::end(excluded));
+    ASSERT_EQ(actual, (std::vector<ip_network>{ ip_network::parse("2001:db8::1/128"), ip_network::parse("2001:db8::2/128") }));
+
+    const ip_network mixed[] = { ip_network::parse("2001:db8::/128"), ip_network::parse("192.0.2.0/32") };
+    error_code err = error_code::no_error;
+    const auto error = network.address_exclude(std::begin(mixed), std::end(mixed), err);
+    ASSERT_EQ(err, error_code::invalid_version);
+    ASSERT_TRUE(error.empty());
+}
+
 TEST(ip_network, collapse_addresses) {
     IPADDRESS_CONSTEXPR std::array<ip_network, 0> arr_empty{};
     IPADDRESS_CONSTEXPR auto collapsed_arr_empty = collapse_addresses(arr_empty);
@@ -1039,6 +1086,71 @@ TEST(ip_network, collapse_addresses) {
     ASSERT_EQ(collapsed_3_3, ip_network::parse("2001:db8::18/127"));
 }
 
+TEST(ip_network, CollapseAddressesBuffer) {
+    std::vector<ip_network> nets;
+    for (uint32_t i = 0; i < 768; ++i) {
+        nets.push_back(ip_network(ipv4_network::from_address(ipv4_address::from_uint(0xC0000200 + ((i * 131) % 768)), 32)));
+    }
+
+    collapse_buffer<ip_network> buffer;
+    const auto collapsed = collapse_addresses(nets.begin(), nets.end(), buffer);
+    ASSERT_EQ(collapsed.size(), 2);
+    ASSERT_EQ(collapsed[0], ip_network::parse("192.0.2.0/23"));
+    ASSERT_EQ(collapsed[1], ip_network::parse("192.0.4.0/24"));
+
+    nets.push_back(ip_network::parse("2001:db8::/32"));
+    error_code code = error_code::no_error;
+    const auto error_collapsed = collapse_addresses(nets.begin(), nets.end(), buffer, code);
+    ASSERT_EQ(code, error_code::invalid_version);
+    ASSERT_TRUE(error_collapsed.empty());
+}
+
+TEST(ip_network, CollapseAddressesThreads) {
+    std::vector<ip_network> nets;
+    uint32_t seed = 2024;
+    for (size_t i = 0; i < 100000; ++i) {
+        seed = seed * 1664525 + 1013904223;
+        const auto address = ipv4_address::from_uint(0xC0000000 | (seed & 0x00FFFFFF));
+        nets.push_back(ip_network(ipv4_network::from_address(address, 24 + (seed >> 24) % 9, false)));
+    }
+
+    const auto expected = collapse_addresses(nets.begin(), nets.end());
+    ASSERT_EQ(collapse_addresses(nets.begin(), nets.end(), 4), expected);
+
+    nets.push_back(ip_network::parse("2001:db8::/32"));
+    error_code code = error_code::no_error;
+    const auto actual = collapse_addresses(nets.begin(), nets.end(), 4, code);
+    ASSERT_EQ(code, error_code::invalid_version);
+    ASSERT_TRUE(actual.empty());
+}
+
+TEST(ip_network, sort_addresses) {
+    std::mt19937_64 rng(2024);
+    std::vector<ip_network> nets;
+    for (size_t i = 0; i < 100000; ++i) {
+        const auto value = rng();
+        if (value % 4 == 0) {
+            const auto address = ipv6_address::from_uint(uint128_t(0x20010db800000000ULL | ((value >> 8) & 0xFFFF), 0));
+            nets.push_back(ip_network(ipv6_network::from_address(address, 32 + (value >> 32) % 33, false)));
+        } else {
+            const auto address = ipv4_address::from_uint(0x0A000000 | ((value >> 8) & 0x00FFFF00));
+            nets.push_back(ip_network(ipv4_network::from_address(address, 8 + (value >> 32) % 25, false)));
+        }
+    }
+
+    auto expected = nets;
+    std::sort(expected.begin(), expected.end());
+    for (const size_t threads : { 1, 4 }) {
+        auto actual = nets;
+        sort_addresses(actual.begin(), actual.end(), threads);
+        ASSERT_EQ(actual, expected);
+    }
+
+    std::vector<ipv4_network> ipv4 = { ipv4_network::parse("10.0.0.0/24"), ipv4_network::parse("10.0.0.0/8"), ipv4_network::parse("0.0.0.0/0") };
+    sort_addresses(ipv4.begin(), ipv4.end());
+    ASSERT_EQ(ipv4, (std::vector<ipv4_network>{ ipv4_network::parse("0.0.0.0/0"), ipv4_network::parse("10.0.0.0/8"), ipv4_network::parse("10.0.0.0/24") }));
+}
+
 using CollapseAddressesErrorNetworkParams = TestWithParam<std::tuple<std::vector<const char*>, error_code, const char*>>;
 TEST_P(CollapseAddressesErrorNetworkParams, collapse_addresses) {
     std::vector<ip_network> vec;
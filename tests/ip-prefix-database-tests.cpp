@@ -0,0 +1,237 @@
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#ifdef IPADDRESS_TEST_MODULE
+import ipaddress;
+#else
+#include <ipaddress/ipaddress.hpp>
+#include <ipaddress/mapped-file.hpp>
+#endif
+
+using namespace testing;
+using namespace ipaddress;
+
+TEST(ip_prefix_database, Empty) {
+    const ip_prefix_database_writer<int> writer;
+    const auto data = writer.serialize();
+    const ip_prefix_database<int> db(data.data(), data.size());
+
+    EXPECT_TRUE(db.empty());
+    EXPECT_EQ(db.size(), 0);
+    EXPECT_EQ(db.longest_match(ipv4_address::parse("10.0.0.1")), nullptr);
+    EXPECT_EQ(db.longest_match(ipv6_address::parse("2001:db8::1")), nullptr);
+    EXPECT_EQ(db.find(ipv4_network::parse("0.0.0.0/0")), nullptr);
+    EXPECT_EQ(db.find(ipv6_network::parse("::/0")), nullptr);
+}
+
+TEST(ip_prefix_database, LongestMatch) {
+    ip_prefix_database_writer<int> writer;
+    writer.insert(ipv4_network::parse("10.0.0.0/8"), 1);
+    writer.insert(ipv4_network::parse("10.1.0.0/16"), 2);
+    writer.insert(ipv4_network::parse("10.1.2.0/24"), 3);
+    writer.insert(ipv4_network::parse("255.255.255.255/32"), 4);
+    writer.insert(ip_network::parse("2001:db8::/32"), 5);
+    writer.insert(ip_network::parse("2001:db8:1::/48"), 6);
+    writer.insert(ipv6_network::parse("ffff:ffff:ffff:ffff:ffff:ffff:ffff:ff00/120"), 7);
+    writer.insert(ipv4_network::parse("10.1.0.0/16"), 8);
+    const auto data = writer.serialize();
+    const ip_prefix_database<int> db(data.data(), data.size());
+
+    EXPECT_EQ(db.size(), 7);
+    EXPECT_EQ(*db.longest_match(ipv4_address::parse("10.0.0.0")), 1);
+    EXPECT_EQ(*db.longest_match(ipv4_address::parse("10.1.0.0")), 8);
+    EXPECT_EQ(*db.longest_match(ipv4_address::parse("10.1.2.3")), 3);
+    EXPECT_EQ(*db.longest_match(ipv4_address::parse("10.1.3.0")), 8);
+    EXPECT_EQ(*db.longest_match(ipv4_address::parse("10.2.0.0")), 1);
+    EXPECT_EQ(*db.longest_match(ipv4_address::parse("10.255.255.255")), 1);
+    EXPECT_EQ(*db.longest_match(ipv4_address::parse("255.255.255.255")), 4);
+    EXPECT_EQ(db.longest_match(ipv4_address::parse("9.255.255.255")), nullptr);
+    EXPECT_EQ(db.longest_match(ipv4_address::parse("11.0.0.0")), nullptr);
+    EXPECT_EQ(db.longest_match(ipv4_address::parse("255.255.255.254")), nullptr);
+    EXPECT_EQ(*db.longest_match(ipv6_address::parse("2001:db8::1")), 5);
+    EXPECT_EQ(*db.longest_match(ip_address::parse("2001:db8:1::1")), 6);
+    EXPECT_EQ(*db.longest_match(ip_address::parse("2001:db8:2::")), 5);
+    EXPECT_EQ(*db.longest_match(ip_address::parse("10.1.2.255")), 3);
+    EXPECT_EQ(*db.longest_match(ipv6_address::parse("ffff:ffff:ffff:ffff:ffff:ffff:ffff:ffff")), 7);
+    EXPECT_EQ(db.longest_match(ipv6_address::parse("2001:db9::")), nullptr);
+    EXPECT_EQ(db.longest_match(ipv6_address::parse("::")), nullptr);
+}
+
+TEST(ip_prefix_database, Find) {
+    ip_prefix_database_writer<int> writer;
+    writer.insert(ipv4_network::parse("10.0.0.0/8"), 1);
+    writer.insert(ipv4_network::parse("10.0.0.0/16"), 2);
+    writer.insert(ipv6_network::parse("2001:db8::/32"), 3);
+    writer.insert(ipv6_network::parse("2001:db8::/48"), 4);
+    const auto data = writer.serialize();
+    const ip_prefix_database<int> db(data.data(), data.size());
+
+    EXPECT_EQ(*db.find(ipv4_network::parse("10.0.0.0/8")), 1);
+    EXPECT_EQ(*db.find(ipv4_network::parse("10.0.0.0/16")), 2);
+    EXPECT_EQ(*db.find(ip_network::parse("2001:db8::/32")), 3);
+    EXPECT_EQ(*db.find(ipv6_network::parse("2001:db8::/48")), 4);
+    EXPECT_EQ(db.find(ipv4_network::parse("10.0.0.0/24")), nullptr);
+    EXPECT_EQ(db.find(ipv4_network::parse("11.0.0.0/8")), nullptr);
+    EXPECT_EQ(db.find(ipv6_network::parse("2001:db8::/33")), nullptr);
+    EXPECT_EQ(db.find(ip_network::parse("10.0.0.0/9")), nullptr);
+}
+
+TEST(ip_prefix_database, InvalidData) {
+    ip_prefix_database_writer<int> writer;
+    writer.insert(ipv4_network::parse("10.0.0.0/8"), 1);
+    auto data = writer.serialize();
+
+    error_code err = error_code::no_error;
+    ip_prefix_database<int> db;
+    db.open(data.data(), data.size(), err);
+    EXPECT_EQ(err, error_code::no_error);
+    EXPECT_EQ(db.size(), 1);
+
+    db.open(data.data(), data.size() - 1, err);
+    EXPECT_EQ(err, error_code::invalid_database);
+    EXPECT_TRUE(db.empty());
+
+    db.open(data.data(), 16, err);
+    EXPECT_EQ(err, error_code::invalid_database);
+
+    db.open(nullptr, 0, err);
+    EXPECT_EQ(err, error_code::invalid_database);
+
+    ip_prefix_database<long long> other;
+    other.open(data.data(), data.size(), err);
+    EXPECT_EQ(err, error_code::invalid_database);
+
+    data[0] = 'X';
+    db.open(data.data(), data.size(), err);
+    EXPECT_EQ(err, error_code::invalid_database);
+
+#ifdef IPADDRESS_NO_EXCEPTIONS
+    db.open(data.data(), data.size());
+    EXPECT_TRUE(db.empty());
+#else
+    EXPECT_THAT(
+        [&data]() { ip_prefix_database<int>(data.data(), data.size()); },
+        ThrowsMessage<logic_error>(StrEq("invalid prefix database")));
+#endif
+}
+
+TEST(ip_prefix_database, OverflowingCounts) {
+    ip_prefix_database_writer<int> writer;
+    writer.insert(ipv6_network::parse("2001:db8::/32"), 1);
+    auto data = writer.serialize();
+
+    const uint64_t v4_count = uint64_t(1) << 61;
+    const uint64_t v6_count = 0 - v4_count;
+    std::memcpy(&data[24], &v4_count, sizeof(v4_count));
+    std::memcpy(&data[40], &v6_count, sizeof(v6_count));
+
+    error_code err = error_code::no_error;
+    ip_prefix_database<int> db;
+    db.open(data.data(), data.size(), err);
+    EXPECT_EQ(err, error_code::invalid_database);
+    EXPECT_TRUE(db.empty());
+    EXPECT_EQ(db.find(ipv6_network::parse("2001:db8::/32")), nullptr);
+
+    const uint64_t too_many = uint64_t(1) << 32;
+    std::memcpy(&data[24], &too_many, sizeof(too_many));
+    std::memcpy(&data[40], &too_many, sizeof(too_many));
+    db.open(data.data(), data.size(), err);
+    EXPECT_EQ(err, error_code::invalid_database);
+}
+
+TEST(ip_prefix_database, MappedFile) {
+    ip_prefix_table<ipv4_network, int> table;
+    table.insert(ipv4_network::parse("192.168.0.0/16"), 1);
+    table.insert(ipv4_network::parse("192.168.1.0/24"), 2);
+
+    ip_prefix_database_writer<int> writer;
+    writer.insert(table.begin(), table.end());
+    writer.insert(ipv6_network::parse("fe80::/10"), 3);
+
+    const std::string path = "ip-prefix-database-tests.db";
+    {
+        std::ofstream file(path, std::ios::binary);
+        writer.write(file);
+    }
+
+    {
+        mapped_file file(path.c_str());
+        const ip_prefix_database<int> db(file.data(), file.size());
+        EXPECT_EQ(db.size(), 3);
+        EXPECT_EQ(*db.longest_match(ipv4_address::parse("192.168.1.1")), 2);
+        EXPECT_EQ(*db.longest_match(ipv4_address::parse("192.168.2.1")), 1);
+        EXPECT_EQ(*db.longest_match(ipv6_address::parse("fe80::1")), 3);
+
+        mapped_file moved(std::move(file));
+        EXPECT_EQ(file.data(), nullptr);
+        EXPECT_NE(moved.data(), nullptr);
+    }
+    std::remove(path.c_str());
+
+    error_code err = error_code::no_error;
+    mapped_file missing;
+    missing.open("ip-prefix-database-tests.missing", err);
+    EXPECT_EQ(err, error_code::cannot_map_file);
+    EXPECT_EQ(missing.data(), nullptr);
+    EXPECT_EQ(missing.size(), 0);
+#ifndef IPADDRESS_NO_EXCEPTIONS
+    EXPECT_THAT(
+        []() { mapped_file("ip-prefix-database-tests.missing"); },
+        ThrowsMessage<error>(StrEq("cannot map file")));
+#endif
+}
+
+TEST(ip_prefix_database, LongestMatchRandom) {
+    std::mt19937 gen(17);
+    ip_prefix_table<ipv4_network, uint32_t> table4;
+    ip_prefix_table<ipv6_network, uint32_t> table6;
+    ip_prefix_database_writer<uint32_t> writer;
+    for (uint32_t i = 0; i < 2000; ++i) {
+        const auto prefixlen4 = size_t(gen() % 25);
+        const auto net4 = ipv4_network::from_address(ipv4_address::from_uint(gen() & 0xF0FFFFFF), prefixlen4, false);
+        table4.insert(net4, i);
+        writer.insert(net4, i);
+
+        const auto prefixlen6 = size_t(gen() % 65);
+        const auto net6 = ipv6_network::from_address(ipv6_address::from_uint(uint128_t(uint64_t(gen()) << 32 | (gen() & 0xF), 0)), prefixlen6, false);
+        table6.insert(net6, i);
+        writer.insert(net6, i);
+    }
+    table4.build();
+    table6.build();
+    const auto data = writer.serialize();
+    const ip_prefix_database<uint32_t> db(data.data(), data.size());
+
+    EXPECT_EQ(db.size(), table4.size() + table6.size());
+    for (const auto& entry : table4) {
+        ASSERT_NE(db.find(entry.first), nullptr);
+        EXPECT_EQ(*db.find(entry.first), entry.second);
+    }
+    for (const auto& entry : table6) {
+        ASSERT_NE(db.find(entry.first), nullptr);
+        EXPECT_EQ(*db.find(entry.first), entry.second);
+    }
+    for (int i = 0; i < 20000; ++i) {
+        const auto address4 = ipv4_address::from_uint(gen() & 0xF0FFFFFF);
+        const auto* expected4 = table4.longest_match(address4);
+        const auto* actual4 = db.longest_match(address4);
+        ASSERT_EQ(actual4 == nullptr, expected4 == nullptr) << address4;
+        if (actual4) {
+            EXPECT_EQ(*actual4, expected4->second) << address4;
+        }
+
+        const auto address6 = ipv6_address::from_uint(uint128_t(uint64_t(gen()) << 32 | (gen() & 0xF), uint64_t(gen())));
+        const auto* expected6 = table6.longest_match(address6);
+        const auto* actual6 = db.longest_match(address6);
+        ASSERT_EQ(actual6 == nullptr, expected6 == nullptr) << address6;
+        if (actual6) {
+            EXPECT_EQ(*actual6, expected6->second) << address6;
+        }
+    }
+}
@@ -0,0 +1,227 @@
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#ifdef IPADDRESS_TEST_MODULE
+import ipaddress;
+#else
+#include <ipaddress/ipaddress.hpp>
+#endif
+
+using namespace testing;
+using namespace ipaddress;
+
+template <typename Table>
+static std::vector<std::string> matches_to_strings(const Table& table, const typename Table::address_type& address) {
+    std::vector<std::string> result;
+    for (const auto* entry : table.all_matches(address)) {
+        result.push_back(entry->first.to_string());
+    }
+    return result;
+}
+
+TEST(ip_prefix_table, Empty) {
+    ip_prefix_table<ipv4_network, int> table;
+
+    EXPECT_TRUE(table.empty());
+    EXPECT_EQ(table.size(), 0);
+    EXPECT_EQ(table.begin(), table.end());
+    EXPECT_EQ(table.longest_match(ipv4_address::parse("10.0.0.1")), nullptr);
+    EXPECT_EQ(table.find(ipv4_network::parse("10.0.0.0/8")), nullptr);
+    EXPECT_TRUE(table.all_matches(ipv4_address::parse("10.0.0.1")).empty());
+}
+
+TEST(ip_prefix_table, InsertAndLongestMatchIpv4) {
+    ip_prefix_table<ipv4_network, int> table;
+
+    EXPECT_TRUE(table.insert(ipv4_network::parse("0.0.0.0/0"), 0));
+    EXPECT_TRUE(table.insert(ipv4_network::parse("10.0.0.0/8"), 8));
+    EXPECT_TRUE(table.insert(ipv4_network::parse("10.1.0.0/16"), 16));
+    EXPECT_TRUE(table.insert(ipv4_network::parse("10.1.2.0/24"), 24));
+    EXPECT_TRUE(table.insert(ipv4_network::parse("10.1.2.3/32"), 32));
+    EXPECT_TRUE(table.insert(ipv4_network::parse("10.1.2.128/25"), 25));
+    EXPECT_FALSE(table.insert(ipv4_network::parse("10.0.0.0/8"), 80));
+    EXPECT_EQ(table.size(), 6);
+    table.build();
+
+    const auto expect_match = [&table](const char* address, int expected) {
+        const auto* match = table.longest_match(ipv4_address::parse(address));
+        ASSERT_NE(match, nullptr) << address;
+        EXPECT_EQ(match->second, expected) << address;
+    };
+    expect_match("192.168.0.1", 0);
+    expect_match("10.200.0.1", 80);
+    expect_match("10.1.200.1", 16);
+    expect_match("10.1.2.1", 24);
+    expect_match("10.1.2.3", 32);
+    expect_match("10.1.2.4", 24);
+    expect_match("10.1.2.200", 25);
+    expect_match("255.255.255.255", 0);
+
+    const auto* found = table.find(ipv4_network::parse("10.1.0.0/16"));
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(found->first, ipv4_network::parse("10.1.0.0/16"));
+    EXPECT_EQ(found->second, 16);
+    EXPECT_EQ(table.find(ipv4_network::parse("10.1.0.0/17")), nullptr);
+}
+
+TEST(ip_prefix_table, AllMatches) {
+    ip_prefix_table<ipv4_network, int> table;
+    table.insert(ipv4_network::parse("10.1.2.0/24"), 24);
+    table.insert(ipv4_network::parse("10.0.0.0/8"), 8);
+    table.insert(ipv4_network::parse("10.1.2.3/32"), 32);
+    table.insert(ipv4_network::parse("11.0.0.0/8"), 11);
+
+    EXPECT_THAT(matches_to_strings(table, ipv4_address::parse("10.1.2.3")), ElementsAre("10.0.0.0/8", "10.1.2.0/24", "10.1.2.3/32"));
+    EXPECT_THAT(matches_to_strings(table, ipv4_address::parse("10.1.3.3")), ElementsAre("10.0.0.0/8"));
+    EXPECT_THAT(matches_to_strings(table, ipv4_address::parse("12.0.0.0")), ElementsAre());
+}
+
+TEST(ip_prefix_table, Erase) {
+    ip_prefix_table<ipv4_network, int> table;
+    table.insert(ipv4_network::parse("10.0.0.0/8"), 8);
+    table.insert(ipv4_network::parse("10.1.0.0/16"), 16);
+    table.insert(ipv4_network::parse("10.1.2.0/24"), 24);
+    table.build();
+
+    EXPECT_EQ(table.longest_match(ipv4_address::parse("10.1.2.3"))->second, 24);
+    EXPECT_TRUE(table.erase(ipv4_network::parse("10.1.2.0/24")));
+    EXPECT_FALSE(table.erase(ipv4_network::parse("10.1.2.0/24")));
+    EXPECT_FALSE(table.erase(ipv4_network::parse("10.2.0.0/16")));
+    table.build();
+    EXPECT_EQ(table.longest_match(ipv4_address::parse("10.1.2.3"))->second, 16);
+    EXPECT_TRUE(table.erase(ipv4_network::parse("10.0.0.0/8")));
+    table.build();
+    EXPECT_EQ(table.size(), 1);
+    EXPECT_EQ(table.find(ipv4_network::parse("10.1.0.0/16"))->second, 16);
+    EXPECT_EQ(table.longest_match(ipv4_address::parse("10.2.0.1")), nullptr);
+
+    table.clear();
+    EXPECT_TRUE(table.empty());
+    EXPECT_EQ(table.longest_match(ipv4_address::parse("10.1.2.3")), nullptr);
+}
+
+TEST(ip_prefix_table, Ipv6) {
+    ip_prefix_table<ipv6_network, std::string> table;
+    table.insert(ipv6_network::parse("::/0"), "default");
+    table.insert(ipv6_network::parse("2001:db8::/32"), "doc");
+    table.insert(ipv6_network::parse("2001:db8:1::/48"), "site");
+    table.insert(ipv6_network::parse("2001:db8:1:0:ffff::/80"), "deep");
+    table.insert(ipv6_network::parse("2001:db8:1::1/128"), "host");
+    table.insert(ipv6_network::parse("2001:db8:1::fffe/127"), "pair");
+    table.build();
+
+    EXPECT_EQ(table.longest_match(ipv6_address::parse("fe80::1"))->second, "default");
+    EXPECT_EQ(table.longest_match(ipv6_address::parse("2001:db8:2::1"))->second, "doc");
+    EXPECT_EQ(table.longest_match(ipv6_address::parse("2001:db8:1::2"))->second, "site");
+    EXPECT_EQ(table.longest_match(ipv6_address::parse("2001:db8:1::1"))->second, "host");
+    EXPECT_EQ(table.longest_match(ipv6_address::parse("2001:db8:1::fffe"))->second, "pair");
+    EXPECT_EQ(table.longest_match(ipv6_address::parse("2001:db8:1::ffff"))->second, "pair");
+    EXPECT_EQ(table.longest_match(ipv6_address::parse("2001:db8:1:0:ffff:1::"))->second, "deep");
+    EXPECT_EQ(table.all_matches(ipv6_address::parse("2001:db8:1::1")).size(), 4);
+}
+
+TEST(ip_prefix_table, MixedVersions) {
+    ip_prefix_table<ip_network, int> table;
+    table.insert(ip_network::parse("0.0.0.0/0"), 4);
+    table.insert(ip_network::parse("192.168.0.0/16"), 16);
+    table.insert(ip_network::parse("::/0"), 6);
+    table.insert(ip_network::parse("2001:db8::/32"), 32);
+    table.build();
+
+    EXPECT_EQ(table.size(), 4);
+    EXPECT_EQ(table.longest_match(ip_address::parse("8.8.8.8"))->second, 4);
+    EXPECT_EQ(table.longest_match(ip_address::parse("192.168.1.1"))->second, 16);
+    EXPECT_EQ(table.longest_match(ip_address::parse("::1"))->second, 6);
+    EXPECT_EQ(table.longest_match(ip_address::parse("2001:db8::1"))->second, 32);
+
+    EXPECT_TRUE(table.erase(ip_network::parse("0.0.0.0/0")));
+    table.build();
+    EXPECT_EQ(table.longest_match(ip_address::parse("8.8.8.8")), nullptr);
+    EXPECT_EQ(table.longest_match(ip_address::parse("::1"))->second, 6);
+    EXPECT_EQ(table.find(ip_network::parse("2001:db8::/32"))->second, 32);
+}
+
+TEST(ip_prefix_table, NotBuilt) {
+    ip_prefix_table<ipv4_network, int> table;
+    table.insert(ipv4_network::parse("10.0.0.0/8"), 8);
+
+    EXPECT_DEBUG_DEATH(EXPECT_EQ(table.longest_match(ipv4_address::parse("10.0.0.1")), nullptr), "build");
+    EXPECT_EQ(table.find(ipv4_network::parse("10.0.0.0/8"))->second, 8);
+    EXPECT_EQ(table.all_matches(ipv4_address::parse("10.0.0.1")).size(), 1);
+    table.build();
+    EXPECT_EQ(table.longest_match(ipv4_address::parse("10.0.0.1"))->second, 8);
+}
+
+template <typename Table, typename Generator>
+static void check_against_linear_scan(Table& table, std::vector<typename Table::network_type>& networks, Generator&& random_address, std::mt19937& rng) {
+    table.build();
+    for (auto i = 0; i < 2000; ++i) {
+        const auto address = random_address();
+        const typename Table::network_type* expected = nullptr;
+        for (const auto& network : networks) {
+            if (network.contains(address) && (!expected || network.prefixlen() > expected->prefixlen())) {
+                expected = &network;
+            }
+        }
+        const auto* actual = table.longest_match(address);
+        if (expected) {
+            ASSERT_NE(actual, nullptr) << address;
+            ASSERT_EQ(actual->first, *expected) << address;
+        } else {
+            ASSERT_EQ(actual, nullptr) << address;
+        }
+    }
+    std::shuffle(networks.begin(), networks.end(), rng);
+    networks.resize(networks.size() / 2);
+}
+
+TEST(ip_prefix_table, RandomizedIpv4) {
+    std::mt19937 rng(12345);
+    std::vector<ipv4_network> networks;
+    ip_prefix_table<ipv4_network, size_t> table;
+    for (auto i = 0; i < 3000; ++i) {
+        const auto prefixlen = size_t(rng() % 33);
+        const auto network = ipv4_network::from_address(ipv4_address::from_uint(uint32_t(rng()) & 0xFF0FFFFF), prefixlen, false);
+        if (table.insert(network, i)) {
+            networks.push_back(network);
+        }
+    }
+    const auto random_address = [&]() { return ipv4_address::from_uint(uint32_t(rng()) & 0xFF0FFFFF); };
+    check_against_linear_scan(table, networks, random_address, rng);
+
+    std::vector<ipv4_network> erased;
+    for (const auto& entry : table) {
+        if (std::find(networks.begin(), networks.end(), entry.first) == networks.end()) {
+            erased.push_back(entry.first);
+        }
+    }
+    for (const auto& network : erased) {
+        ASSERT_TRUE(table.erase(network));
+    }
+    EXPECT_EQ(table.size(), networks.size());
+    check_against_linear_scan(table, networks, random_address, rng);
+}
+
+TEST(ip_prefix_table, RandomizedIpv6) {
+    std::mt19937 rng(54321);
+    std::vector<ipv6_network> networks;
+    ip_prefix_table<ipv6_network, size_t> table;
+    const auto random_address = [&]() {
+        ipv6_address::base_type bytes{};
+        bytes[0] = 0x20;
+        bytes[1] = 0x01;
+        for (size_t i = 2; i < bytes.size(); ++i) {
+            bytes[i] = uint8_t(rng() % 4);
+        }
+        return ipv6_address::from_bytes(bytes);
+    };
+    for (auto i = 0; i < 3000; ++i) {
+        const auto network = ipv6_network::from_address(random_address(), size_t(rng() % 129), false);
+        if (table.insert(network, i)) {
+            networks.push_back(network);
+        }
+    }
+    check_against_linear_scan(table, networks, random_address, rng);
+}
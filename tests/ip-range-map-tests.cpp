@@ -0,0 +1,114 @@
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#ifdef IPADDRESS_TEST_MODULE
+import ipaddress;
+#else
+#include <ipaddress/ipaddress.hpp>
+#endif
+
+using namespace testing;
+using namespace ipaddress;
+
+TEST(ip_range_map, Empty) {
+    ip_range_map<int> map;
+
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.size(), 0);
+    EXPECT_EQ(map.find(ipv4_address::parse("10.0.0.1")), nullptr);
+    EXPECT_EQ(map.find(ipv6_address::parse("2001:db8::1")), nullptr);
+    EXPECT_FALSE(map.contains(ip_address::parse("10.0.0.1")));
+}
+
+TEST(ip_range_map, Find) {
+    const std::map<std::pair<ipv4_address, ipv4_address>, std::string> rows = {
+        { { ipv4_address::parse("1.0.0.0"), ipv4_address::parse("1.0.0.255") }, "AU" },
+        { { ipv4_address::parse("1.0.1.0"), ipv4_address::parse("1.0.3.255") }, "CN" },
+        { { ipv4_address::parse("1.0.8.0"), ipv4_address::parse("1.0.8.0") }, "JP" },
+        { { ipv4_address::parse("255.255.255.0"), ipv4_address::parse("255.255.255.255") }, "ZZ" } };
+    const ip_range_map<std::string> map(rows.begin(), rows.end());
+
+    EXPECT_EQ(map.size(), 4);
+    EXPECT_EQ(*map.find(ipv4_address::parse("1.0.0.0")), "AU");
+    EXPECT_EQ(*map.find(ipv4_address::parse("1.0.0.255")), "AU");
+    EXPECT_EQ(*map.find(ipv4_address::parse("1.0.1.0")), "CN");
+    EXPECT_EQ(*map.find(ipv4_address::parse("1.0.2.7")), "CN");
+    EXPECT_EQ(*map.find(ipv4_address::parse("1.0.8.0")), "JP");
+    EXPECT_EQ(*map.find(ipv4_address::parse("255.255.255.255")), "ZZ");
+    EXPECT_EQ(*map.find(ip_address::parse("1.0.3.255")), "CN");
+    EXPECT_EQ(map.find(ipv4_address::parse("0.255.255.255")), nullptr);
+    EXPECT_EQ(map.find(ipv4_address::parse("1.0.4.0")), nullptr);
+    EXPECT_EQ(map.find(ipv4_address::parse("1.0.8.1")), nullptr);
+    EXPECT_EQ(map.find(ipv6_address::parse("::1.0.0.1")), nullptr);
+}
+
+TEST(ip_range_map, MixedVersions) {
+    const std::vector<std::pair<std::pair<ip_address, ip_address>, int>> rows = {
+        { { ip_address::parse("2001:db8::"), ip_address::parse("2001:db8::ffff") }, 6 },
+        { { ip_address::parse("192.0.2.0"), ip_address::parse("192.0.2.255") }, 4 },
+        { { ip_address::parse("0.0.0.0"), ip_address::parse("0.0.0.0") }, 0 } };
+    const ip_range_map<int> map(rows.begin(), rows.end());
+
+    EXPECT_EQ(map.size(), 3);
+    EXPECT_EQ(*map.find(ipv4_address::parse("192.0.2.1")), 4);
+    EXPECT_EQ(*map.find(ip_address::parse("0.0.0.0")), 0);
+    EXPECT_EQ(*map.find(ipv6_address::parse("2001:db8::1")), 6);
+    EXPECT_EQ(*map.find(ip_address::parse("2001:db8::ffff")), 6);
+    EXPECT_EQ(map.find(ip_address::parse("2001:db8::1:0")), nullptr);
+    EXPECT_EQ(map.find(ip_address::parse("::")), nullptr);
+}
+
+TEST(ip_range_map, Errors) {
+    const std::vector<std::pair<std::pair<ipv4_address, ipv4_address>, int>> overlapping = {
+        { { ipv4_address::parse("10.0.0.0"), ipv4_address::parse("10.0.0.255") }, 1 },
+        { { ipv4_address::parse("10.0.0.255"), ipv4_address::parse("10.0.1.255") }, 2 } };
+    const std::vector<std::pair<std::pair<ipv4_address, ipv4_address>, int>> reversed = {
+        { { ipv4_address::parse("10.0.0.255"), ipv4_address::parse("10.0.0.0") }, 1 } };
+    const std::vector<std::pair<std::pair<ip_address, ip_address>, int>> mixed = {
+        { { ip_address::parse("10.0.0.0"), ip_address::parse("2001:db8::") }, 1 } };
+
+    ip_range_map<int> map;
+    error_code err = error_code::no_error;
+    map.assign(overlapping.begin(), overlapping.end(), err);
+    EXPECT_EQ(err, error_code::overlapping_ranges);
+    EXPECT_TRUE(map.empty());
+    map.assign(reversed.begin(), reversed.end(), err);
+    EXPECT_EQ(err, error_code::last_address_must_be_greater_than_first);
+    map.assign(mixed.begin(), mixed.end(), err);
+    EXPECT_EQ(err, error_code::invalid_version);
+
+#ifndef IPADDRESS_NO_EXCEPTIONS
+    EXPECT_THAT(
+        ([&overlapping]() { ip_range_map<int> map(overlapping.begin(), overlapping.end()); }),
+        ThrowsMessage<logic_error>(StrEq("address ranges overlap")));
+#endif
+}
+
+TEST(ip_range_map, Random) {
+    std::mt19937 rng(2024);
+    std::vector<std::pair<std::pair<ipv6_address, ipv6_address>, size_t>> rows;
+    uint128_t next = uint128_t(0x2001, 0);
+    for (size_t i = 0; i < 5000; ++i) {
+        const auto first = next + (rng() % 4);
+        const auto last = first + (rng() % 16);
+        rows.push_back({ { ipv6_address::from_uint(first), ipv6_address::from_uint(last) }, i });
+        next = last + 1;
+    }
+    std::shuffle(rows.begin(), rows.end(), rng);
+    const ip_range_map<size_t> map(rows.begin(), rows.end());
+    ASSERT_EQ(map.size(), rows.size());
+
+    for (const auto& row : rows) {
+        const auto first = row.first.first.to_uint();
+        const auto last = row.first.second.to_uint();
+        ASSERT_EQ(*map.find(row.first.first), row.second);
+        ASSERT_EQ(*map.find(row.first.second), row.second);
+        ASSERT_EQ(*map.find(ipv6_address::from_uint(first + (last - first) / 2)), row.second);
+        const auto* before = map.find(ipv6_address::from_uint(first - 1));
+        ASSERT_TRUE(before == nullptr || *before != row.second);
+    }
+}
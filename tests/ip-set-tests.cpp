@@ -0,0 +1,218 @@
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#ifdef IPADDRESS_TEST_MODULE
+import ipaddress;
+#else
+#include <ipaddress/ipaddress.hpp>
+#endif
+
+using namespace testing;
+using namespace ipaddress;
+
+template <typename Set>
+static std::vector<std::string> set_to_strings(const Set& set) {
+    std::vector<std::string> result;
+    for (const auto& net : set) {
+        result.push_back(net.to_string());
+    }
+    return result;
+}
+
+TEST(ip_set, Empty) {
+    ip_set<ipv4_network> set;
+
+    EXPECT_TRUE(set.empty());
+    EXPECT_EQ(set.ranges_count(), 0);
+    EXPECT_EQ(set.addresses_count(), 0);
+    EXPECT_EQ(set.begin(), set.end());
+    EXPECT_FALSE(set.contains(ipv4_address::parse("10.0.0.1")));
+    EXPECT_TRUE(set == ip_set<ipv4_network>());
+}
+
+TEST(ip_set, Construct) {
+    const ip_set<ipv4_network> set = {
+        ipv4_network::parse("192.0.2.128/25"),
+        ipv4_network::parse("192.0.2.0/25"),
+        ipv4_network::parse("192.0.2.10/32"),
+        ipv4_network::parse("192.0.3.0/26"),
+        ipv4_network::parse("10.0.0.0/8"),
+        ipv4_network::parse("10.0.0.0/8"),
+    };
+
+    EXPECT_THAT(set_to_strings(set), ElementsAre("10.0.0.0/8", "192.0.2.0/24", "192.0.3.0/26"));
+    EXPECT_EQ(set.ranges_count(), 2);
+    EXPECT_EQ(set.addresses_count(), (1 << 24) + 256 + 64);
+    EXPECT_TRUE(set.contains(ipv4_address::parse("10.255.255.255")));
+    EXPECT_TRUE(set.contains(ipv4_address::parse("192.0.3.63")));
+    EXPECT_FALSE(set.contains(ipv4_address::parse("192.0.3.64")));
+    EXPECT_FALSE(set.contains(ipv4_address::parse("9.255.255.255")));
+    EXPECT_FALSE(set.contains(ipv4_network::parse("192.0.2.0/23")));
+    EXPECT_TRUE(set.contains(ipv4_network::parse("192.0.2.0/24")));
+    EXPECT_TRUE(set.contains(ipv4_network::parse("192.0.2.192/26")));
+    EXPECT_FALSE(set.contains(ipv4_network::parse("192.0.3.0/25")));
+}
+
+TEST(ip_set, Union) {
+    const ip_set<ipv4_network> lhs = { ipv4_network::parse("10.0.0.0/9"), ipv4_network::parse("10.192.0.0/10") };
+    const ip_set<ipv4_network> rhs = { ipv4_network::parse("10.128.0.0/10"), ipv4_network::parse("11.0.0.0/8") };
+
+    EXPECT_THAT(set_to_strings(lhs | rhs), ElementsAre("10.0.0.0/7"));
+    EXPECT_EQ((lhs | rhs).ranges_count(), 1);
+    EXPECT_EQ(lhs | rhs, rhs | lhs);
+    EXPECT_EQ(lhs | ip_set<ipv4_network>(), lhs);
+
+    auto set = lhs;
+    set |= rhs;
+    EXPECT_EQ(set, lhs.set_union(rhs));
+}
+
+TEST(ip_set, Intersection) {
+    const ip_set<ipv4_network> lhs = { ipv4_network::parse("10.0.0.0/8"), ipv4_network::parse("192.168.0.0/16") };
+    const ip_set<ipv4_network> rhs = { ipv4_network::parse("10.1.0.0/16"), ipv4_network::parse("11.0.0.0/8"), ipv4_network::parse("192.168.1.0/24"), ipv4_network::parse("172.16.0.0/12") };
+
+    EXPECT_THAT(set_to_strings(lhs & rhs), ElementsAre("10.1.0.0/16", "192.168.1.0/24"));
+    EXPECT_EQ(lhs & rhs, rhs & lhs);
+    EXPECT_TRUE((lhs & ip_set<ipv4_network>()).empty());
+
+    auto set = lhs;
+    set &= rhs;
+    EXPECT_EQ(set, lhs.set_intersection(rhs));
+}
+
+TEST(ip_set, Difference) {
+    const ip_set<ipv4_network> allow = { ipv4_network::parse("10.0.0.0/8") };
+    const ip_set<ipv4_network> deny = { ipv4_network::parse("10.1.0.0/16"), ipv4_network::parse("10.2.0.0/15") };
+
+    EXPECT_THAT(set_to_strings(allow - deny), ElementsAre(
+        "10.0.0.0/16", "10.4.0.0/14", "10.8.0.0/13", "10.16.0.0/12", "10.32.0.0/11", "10.64.0.0/10", "10.128.0.0/9"));
+    EXPECT_TRUE((deny - allow).empty());
+    EXPECT_EQ(allow - ip_set<ipv4_network>(), allow);
+
+    auto set = allow;
+    set -= deny;
+    EXPECT_EQ(set, allow.set_difference(deny));
+    EXPECT_EQ(set | deny, allow);
+}
+
+TEST(ip_set, SymmetricDifference) {
+    const ip_set<ipv4_network> lhs = { ipv4_network::parse("10.0.0.0/24"), ipv4_network::parse("10.0.1.0/25") };
+    const ip_set<ipv4_network> rhs = { ipv4_network::parse("10.0.1.0/24"), ipv4_network::parse("10.0.2.0/24") };
+
+    EXPECT_THAT(set_to_strings(lhs ^ rhs), ElementsAre("10.0.0.0/24", "10.0.1.128/25", "10.0.2.0/24"));
+    EXPECT_EQ(lhs ^ rhs, rhs ^ lhs);
+    EXPECT_TRUE((lhs ^ lhs).empty());
+
+    auto set = lhs;
+    set ^= rhs;
+    EXPECT_EQ(set, lhs.set_symmetric_difference(rhs));
+}
+
+TEST(ip_set, InsertErase) {
+    ip_set<ipv4_network> set;
+
+    set.insert(ipv4_network::parse("192.0.2.0/25"));
+    set.insert(ipv4_network::parse("192.0.2.128/25"));
+    EXPECT_THAT(set_to_strings(set), ElementsAre("192.0.2.0/24"));
+
+    set.erase(ipv4_network::parse("192.0.2.64/26"));
+    EXPECT_THAT(set_to_strings(set), ElementsAre("192.0.2.0/26", "192.0.2.128/25"));
+
+    set.erase(ipv4_network::parse("0.0.0.0/0"));
+    EXPECT_TRUE(set.empty());
+}
+
+TEST(ip_set, WholeSpace) {
+    const ip_set<ipv4_network> v4 = { ipv4_network::parse("0.0.0.0/0") };
+    EXPECT_THAT(set_to_strings(v4), ElementsAre("0.0.0.0/0"));
+    EXPECT_EQ(v4.addresses_count(), uint128_t(1) << 32);
+    EXPECT_THAT(set_to_strings(v4 - ip_set<ipv4_network>({ ipv4_network::parse("128.0.0.0/1") })), ElementsAre("0.0.0.0/1"));
+    EXPECT_THAT(set_to_strings(v4 - ip_set<ipv4_network>({ ipv4_network::parse("0.0.0.0/1") })), ElementsAre("128.0.0.0/1"));
+
+    const ip_set<ipv6_network> v6 = { ipv6_network::parse("::/1"), ipv6_network::parse("8000::/1") };
+    EXPECT_THAT(set_to_strings(v6), ElementsAre("::/0"));
+    EXPECT_EQ(v6.addresses_count(), ~uint128_t(0));
+    EXPECT_TRUE(v6.contains(ipv6_address::parse("ffff:ffff:ffff:ffff:ffff:ffff:ffff:ffff")));
+
+    const ip_set<ipv6_network> half = { ipv6_network::parse("8000::/1") };
+    EXPECT_EQ(half.addresses_count(), uint128_t(1) << 127);
+    EXPECT_THAT(set_to_strings(v6 ^ half), ElementsAre("::/1"));
+}
+
+TEST(ip_set, MixedVersions) {
+    const ip_set<ip_network> lhs = {
+        ip_network::parse("2001:db8::/32"),
+        ip_network::parse("10.0.0.0/8"),
+        ip_network::parse("::/128"),
+    };
+    const ip_set<ip_network> rhs = {
+        ip_network::parse("2001:db8:8000::/33"),
+        ip_network::parse("0.0.0.0/32"),
+    };
+
+    EXPECT_THAT(set_to_strings(lhs), ElementsAre("10.0.0.0/8", "::/128", "2001:db8::/32"));
+    EXPECT_THAT(set_to_strings(lhs - rhs), ElementsAre("10.0.0.0/8", "::/128", "2001:db8::/33"));
+    EXPECT_THAT(set_to_strings(lhs & rhs), ElementsAre("2001:db8:8000::/33"));
+    EXPECT_THAT(set_to_strings(lhs | rhs), ElementsAre("0.0.0.0/32", "10.0.0.0/8", "::/128", "2001:db8::/32"));
+    EXPECT_EQ(lhs.addresses_count(), (uint128_t(1) << 24) + 1 + (uint128_t(1) << 96));
+    EXPECT_TRUE(lhs.contains(ip_address::parse("::")));
+    EXPECT_FALSE(lhs.contains(ip_address::parse("0.0.0.0")));
+    EXPECT_TRUE(lhs.contains(ip_network::parse("2001:db8:1::/48")));
+}
+
+TEST(ip_set, Iterator) {
+    const ip_set<ipv4_network> set = { ipv4_network::parse("10.0.0.0/8"), ipv4_network::parse("192.0.2.0/25"), ipv4_network::parse("192.0.2.128/26") };
+
+    auto it = set.begin();
+    EXPECT_EQ(*it, ipv4_network::parse("10.0.0.0/8"));
+    EXPECT_EQ(it->prefixlen(), 8);
+    auto prev = it++;
+    EXPECT_EQ(*prev, ipv4_network::parse("10.0.0.0/8"));
+    EXPECT_EQ(*it++, ipv4_network::parse("192.0.2.0/25"));
+    EXPECT_EQ(*it, ipv4_network::parse("192.0.2.128/26"));
+    EXPECT_NE(it, set.end());
+    EXPECT_EQ(++it, set.end());
+    EXPECT_EQ(std::distance(set.begin(), set.end()), 3);
+}
+
+static ip_set<ipv4_network> random_set(std::mt19937& rng, size_t count) {
+    std::vector<ipv4_network> networks;
+    for (size_t i = 0; i < count; ++i) {
+        const auto prefixlen = 20 + rng() % 13;
+        const auto address = ipv4_address::from_uint(0xC0000000 | (uint32_t(rng()) & 0x0000FFFF));
+        networks.push_back(ipv4_network::from_address(address, prefixlen, false));
+    }
+    return ip_set<ipv4_network>(networks.begin(), networks.end());
+}
+
+TEST(ip_set, RandomAgainstMembership) {
+    std::mt19937 rng(2024);
+
+    for (size_t round = 0; round < 20; ++round) {
+        const auto lhs = random_set(rng, 50);
+        const auto rhs = random_set(rng, 50);
+        const auto u = lhs | rhs;
+        const auto i = lhs & rhs;
+        const auto d = lhs - rhs;
+        const auto x = lhs ^ rhs;
+
+        for (uint32_t value = 0xC0000000; value < 0xC0010000; value += 7) {
+            const auto address = ipv4_address::from_uint(value);
+            const auto a = lhs.contains(address);
+            const auto b = rhs.contains(address);
+            ASSERT_EQ(u.contains(address), a || b) << address;
+            ASSERT_EQ(i.contains(address), a && b) << address;
+            ASSERT_EQ(d.contains(address), a && !b) << address;
+            ASSERT_EQ(x.contains(address), a != b) << address;
+        }
+
+        ASSERT_EQ(u.addresses_count() + i.addresses_count(), lhs.addresses_count() + rhs.addresses_count());
+        ASSERT_EQ(x, (lhs - rhs) | (rhs - lhs));
+
+        std::vector<ipv4_network> networks(u.begin(), u.end());
+        ASSERT_EQ(networks, collapse_addresses(networks.begin(), networks.end()));
+        ASSERT_EQ(ip_set<ipv4_network>(networks.begin(), networks.end()), u);
+    }
+}
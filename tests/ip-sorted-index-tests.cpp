@@ -0,0 +1,124 @@
+#include <set>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#ifdef IPADDRESS_TEST_MODULE
+import ipaddress;
+#else
+#include <ipaddress/ipaddress.hpp>
+#endif
+
+using namespace testing;
+using namespace ipaddress;
+
+TEST(ip_sorted_index, Empty) {
+    ip_sorted_index<ip_address> index;
+
+    EXPECT_TRUE(index.empty());
+    EXPECT_EQ(index.size(), 0);
+    EXPECT_FALSE(index.contains(ip_address::parse("10.0.0.1")));
+    EXPECT_FALSE(index.lower_bound(ip_address::parse("10.0.0.1")).has_value());
+    EXPECT_FALSE(index.predecessor(ip_address::parse("2001:db8::1")).has_value());
+
+    const std::vector<ip_address> queries = { ip_address::parse("10.0.0.1"), ip_address::parse("2001:db8::1") };
+    std::vector<char> found(queries.size(), 1);
+    index.contains(queries.begin(), queries.end(), found.begin());
+    EXPECT_THAT(found, ElementsAre(0, 0));
+}
+
+TEST(ip_sorted_index, Lookup) {
+    const std::vector<ipv4_address> addresses = {
+        ipv4_address::parse("192.0.2.7"), ipv4_address::parse("10.0.0.1"), ipv4_address::parse("172.16.0.1"), ipv4_address::parse("10.0.0.1") };
+    const ip_sorted_index<ipv4_address> index(addresses.begin(), addresses.end());
+
+    EXPECT_EQ(index.size(), 3);
+    EXPECT_TRUE(index.contains(ipv4_address::parse("10.0.0.1")));
+    EXPECT_TRUE(index.contains(ipv4_address::parse("192.0.2.7")));
+    EXPECT_FALSE(index.contains(ipv4_address::parse("10.0.0.2")));
+
+    EXPECT_EQ(*index.lower_bound(ipv4_address::parse("0.0.0.0")), ipv4_address::parse("10.0.0.1"));
+    EXPECT_EQ(*index.lower_bound(ipv4_address::parse("172.16.0.1")), ipv4_address::parse("172.16.0.1"));
+    EXPECT_EQ(*index.lower_bound(ipv4_address::parse("172.16.0.2")), ipv4_address::parse("192.0.2.7"));
+    EXPECT_FALSE(index.lower_bound(ipv4_address::parse("192.0.2.8")).has_value());
+
+    EXPECT_FALSE(index.predecessor(ipv4_address::parse("10.0.0.1")).has_value());
+    EXPECT_EQ(*index.predecessor(ipv4_address::parse("172.16.0.1")), ipv4_address::parse("10.0.0.1"));
+    EXPECT_EQ(*index.predecessor(ipv4_address::parse("255.255.255.255")), ipv4_address::parse("192.0.2.7"));
+}
+
+TEST(ip_sorted_index, MixedVersions) {
+    const std::vector<ip_address> addresses = {
+        ip_address::parse("2001:db8::1"), ip_address::parse("10.0.0.1"), ip_address::parse("::a00:1") };
+    const ip_sorted_index<ip_address> index(addresses.begin(), addresses.end());
+
+    EXPECT_EQ(index.size(), 3);
+    EXPECT_TRUE(index.contains(ip_address::parse("10.0.0.1")));
+    EXPECT_TRUE(index.contains(ip_address::parse("::a00:1")));
+    EXPECT_FALSE(index.contains(ip_address::parse("::")));
+
+    EXPECT_EQ(*index.lower_bound(ip_address::parse("10.0.0.2")), ip_address::parse("::a00:1"));
+    EXPECT_EQ(*index.lower_bound(ip_address::parse("::a00:2")), ip_address::parse("2001:db8::1"));
+    EXPECT_EQ(*index.predecessor(ip_address::parse("::")), ip_address::parse("10.0.0.1"));
+    EXPECT_EQ(*index.predecessor(ip_address::parse("2001:db8::1")), ip_address::parse("::a00:1"));
+    EXPECT_FALSE(index.predecessor(ip_address::parse("0.0.0.0")).has_value());
+
+    const std::vector<ip_address> queries = {
+        ip_address::parse("::a00:1"), ip_address::parse("10.0.0.1"), ip_address::parse("10.0.0.2"), ip_address::parse("2001:db8::2") };
+    std::vector<optional<ip_address>> bounds(queries.size());
+    index.lower_bound(queries.begin(), queries.end(), bounds.begin());
+    EXPECT_EQ(*bounds[0], ip_address::parse("::a00:1"));
+    EXPECT_EQ(*bounds[1], ip_address::parse("10.0.0.1"));
+    EXPECT_EQ(*bounds[2], ip_address::parse("::a00:1"));
+    EXPECT_FALSE(bounds[3].has_value());
+}
+
+TEST(ip_sorted_index, MatchesStdSet) {
+    std::mt19937_64 rng(11);
+    for (const size_t size : { 1, 2, 3, 7, 8, 100, 1000, 40000 }) {
+        std::vector<ip_address> addresses;
+        for (size_t i = 0; i < size; ++i) {
+            const auto value = rng() % 100000;
+            addresses.push_back(value % 4 == 0
+                ? ip_address(ipv6_address::from_uint(uint128_t(0x20010db800000000ULL, value)))
+                : ip_address(ipv4_address::from_uint(uint32_t(value))));
+        }
+        const std::set<ip_address> expected(addresses.begin(), addresses.end());
+        const ip_sorted_index<ip_address> index(addresses.begin(), addresses.end());
+        ASSERT_EQ(index.size(), expected.size());
+
+        std::vector<ip_address> queries;
+        for (size_t i = 0; i < 1000; ++i) {
+            const auto value = rng() % 100001;
+            queries.push_back(value % 2 == 0
+                ? ip_address(ipv6_address::from_uint(uint128_t(0x20010db800000000ULL, value)))
+                : ip_address(ipv4_address::from_uint(uint32_t(value))));
+        }
+        std::vector<bool> found(queries.size());
+        index.contains(queries.begin(), queries.end(), found.begin());
+        std::vector<optional<ip_address>> bounds(queries.size());
+        index.lower_bound(queries.begin(), queries.end(), bounds.begin());
+
+        for (size_t i = 0; i < queries.size(); ++i) {
+            const auto& query = queries[i];
+            const auto lower = expected.lower_bound(query);
+            ASSERT_EQ(index.contains(query), lower != expected.end() && *lower == query);
+            ASSERT_EQ(found[i], index.contains(query));
+
+            const auto bound = index.lower_bound(query);
+            ASSERT_EQ(bound.has_value(), lower != expected.end());
+            ASSERT_EQ(bounds[i].has_value(), bound.has_value());
+            if (bound) {
+                ASSERT_EQ(*bound, *lower);
+                ASSERT_EQ(*bounds[i], *lower);
+            }
+
+            const auto prev = index.predecessor(query);
+            ASSERT_EQ(prev.has_value(), lower != expected.begin());
+            if (prev) {
+                ASSERT_EQ(*prev, *std::prev(lower));
+            }
+        }
+    }
+}
@@ -1,4 +1,6 @@
 #include <map>
+#include <cstring>
+#include <random>
 #include <vector>
 #include <unordered_map>
 #include <sstream>
@@ -165,6 +167,11 @@ TEST(ipv4_address, CompileTime) {
     constexpr auto ip27 = ipv4_address::parse("169.255.100.200").is_unspecified();
     ASSERT_TRUE(ip26);
     ASSERT_FALSE(ip27);
+
+    constexpr auto ip26_1 = ipv4_address::parse("192.168.1.1").classify();
+    constexpr auto ip26_2 = ipv4_address::parse("100.64.0.1").classify();
+    ASSERT_EQ(ip26_1, address_flags::is_private);
+    ASSERT_EQ(ip26_2, address_flags::none);
     
     constexpr auto ip28 = ipv4_address::parse("192.168.1.1").ipv6_mapped();
     constexpr auto ip29 = ipv4_address::parse("192.168.1.1").ipv6_mapped().ipv4_mapped().value();
@@ -467,6 +474,121 @@ TEST(ipv4_address, ParseUnexpectedWideChar) {
     PARSE_UNEXPECTED_SYMBOL(L);
 }
 
+TEST(ipv4_address, ParseMany) {
+    const std::string addresses[] = {
+        "0.0.0.0", "255.255.255.255", "192.168.1.1", "1.22.133.4", "100.64.0.0", "127.0.0.1",
+        "", "127.0.0", "42.42.42.42.42", "42..42.42", "127.0.0.", "1.a.2.3", "127.0.0.1/24",
+        "127.0.0.1271", "256.1.1.1", "192.168.0.999", "01.2.3.40", "1.2.3.040", "000.000.000.000"
+    };
+    const auto count = sizeof(addresses) / sizeof(addresses[0]);
+    ipv4_address actual[count];
+    error_code codes[count];
+
+    const auto parsed = ipv4_address::parse_many(addresses, count, actual, codes);
+
+    size_t expected_parsed = 0;
+    for (size_t i = 0; i < count; ++i) {
+        auto expected_code = error_code::no_error;
+        const auto expected = ipv4_address::parse(addresses[i], expected_code);
+        EXPECT_EQ(actual[i], expected) << addresses[i];
+        EXPECT_EQ(codes[i], expected_code) << addresses[i];
+        expected_parsed += expected_code == error_code::no_error ? 1 : 0;
+    }
+    EXPECT_EQ(parsed, expected_parsed);
+    EXPECT_EQ(ipv4_address::parse_many(addresses, count, actual), expected_parsed);
+}
+
+TEST(ipv4_address, ParseManyRandomized) {
+    std::mt19937 rng(42);
+    const char alphabet[] = "0123456789.0123456789..25";
+    std::vector<std::string> addresses;
+    for (auto i = 0; i < 20000; ++i) {
+        std::string str;
+        if (i % 2 == 0) {
+            str = std::to_string(rng() % 300) + "." + std::to_string(rng() % 300) + "." + std::to_string(rng() % 300) + "." + std::to_string(rng() % 300);
+        } else {
+            const auto size = rng() % 17;
+            for (size_t k = 0; k < size; ++k) {
+                str += alphabet[rng() % (sizeof(alphabet) - 1)];
+            }
+        }
+        addresses.push_back(str);
+    }
+    std::vector<ipv4_address> actual(addresses.size());
+    std::vector<error_code> codes(addresses.size());
+
+    ipv4_address::parse_many(addresses.data(), addresses.size(), actual.data(), codes.data());
+
+    for (size_t i = 0; i < addresses.size(); ++i) {
+        auto expected_code = error_code::no_error;
+        const auto expected = ipv4_address::parse(addresses[i], expected_code);
+        ASSERT_EQ(actual[i], expected) << addresses[i];
+        ASSERT_EQ(codes[i], expected_code) << addresses[i];
+    }
+}
+
+TEST(ipv4_address, ToStringAllOctets) {
+    for (uint32_t octet = 0; octet < 256; ++octet) {
+        const auto ip = ipv4_address::from_uint(octet << 24 | (255 - octet) << 16 | octet << 8 | (octet ^ 0x55));
+        const auto expected = std::to_string(octet) + "." + std::to_string(255 - octet) + "." + std::to_string(octet) + "." + std::to_string(octet ^ 0x55);
+        ASSERT_EQ(ip.to_string(), expected);
+    }
+}
+
+TEST(ipv4_address, FormatMany) {
+    const ipv4_address addresses[] = {
+        ipv4_address::parse("0.0.0.0"), ipv4_address::parse("255.255.255.255"), ipv4_address::parse("192.168.1.1"),
+        ipv4_address::parse("1.22.133.4"), ipv4_address::parse("100.64.0.0"), ipv4_address::parse("127.0.0.1")
+    };
+    const auto count = sizeof(addresses) / sizeof(addresses[0]);
+    const std::string expected = "0.0.0.0\n255.255.255.255\n192.168.1.1\n1.22.133.4\n100.64.0.0\n127.0.0.1\n";
+
+    char buffer[count * (ipv4_address::base_max_string_len + 1)] = {};
+    char* end = ipv4_address::format_many(addresses, count, buffer, buffer + sizeof(buffer));
+    ASSERT_NE(end, nullptr);
+    EXPECT_EQ(std::string(buffer, end), expected);
+
+    end = ipv4_address::format_many(addresses, count, buffer, buffer + expected.size());
+    ASSERT_NE(end, nullptr);
+    EXPECT_EQ(std::string(buffer, end), expected);
+    std::fill(buffer, buffer + sizeof(buffer), '#');
+    EXPECT_EQ(ipv4_address::format_many(addresses, count, buffer, buffer + expected.size() - 1), nullptr);
+    EXPECT_EQ(std::string(buffer, sizeof(buffer)), std::string(sizeof(buffer), '#'));
+
+    end = ipv4_address::format_many(addresses, 2, buffer, buffer + sizeof(buffer), '\0');
+    ASSERT_NE(end, nullptr);
+    EXPECT_EQ(std::string(buffer, end), std::string("0.0.0.0\0" "255.255.255.255\0", 24));
+    EXPECT_EQ(ipv4_address::format_many(addresses, 0, buffer, buffer), buffer);
+}
+
+TEST(ipv4_address, ClassifyMany) {
+    std::mt19937 rng(42);
+    std::vector<ipv4_address> addresses;
+    std::vector<uint32_t> raw;
+    for (auto i = 0; i < 1000; ++i) {
+        const auto value = i % 2 == 0 ? uint32_t(rng()) : uint32_t(rng()) & 0xFFFF00FF;
+        const auto ip = ipv4_address::from_uint(value);
+        uint32_t network_order = 0;
+        std::memcpy(&network_order, ip.data(), sizeof(network_order));
+        addresses.push_back(ip);
+        raw.push_back(network_order);
+    }
+    std::vector<uint8_t> flags(addresses.size());
+    std::vector<uint8_t> raw_flags(raw.size());
+
+    ipv4_address::classify_many(addresses.data(), addresses.size(), flags.data());
+    ipv4_address::classify_many(raw.data(), raw.size(), raw_flags.data());
+
+    for (size_t i = 0; i < addresses.size(); ++i) {
+        ASSERT_EQ(address_flags(flags[i]), addresses[i].classify()) << addresses[i];
+        ASSERT_EQ(address_flags(raw_flags[i]), addresses[i].classify()) << addresses[i];
+    }
+
+    uint8_t untouched = 0xFF;
+    ipv4_address::classify_many(addresses.data(), 0, &untouched);
+    EXPECT_EQ(untouched, 0xFF);
+}
+
 TEST(ipv4_address, Comparison) {
     auto ip1 = ipv4_address::parse("127.239.0.1");
     auto ip2 = ipv4_address::parse("127.240.0.1");
@@ -515,6 +637,18 @@ TEST_P(ToStringIpv4Params, to_string) {
     ASSERT_EQ(std::to_string(actual), std::string(expected));
     ASSERT_EQ(ss.str(), std::string(expected));
 }
+TEST_P(ToStringIpv4Params, to_chars) {
+    const auto expected = std::string(GetParam());
+
+    const auto actual = ipv4_address::parse(expected);
+
+    char buffer[ipv4_address::base_max_string_len] = {};
+    char* end = actual.to_chars(buffer, buffer + sizeof(buffer));
+    ASSERT_NE(end, nullptr);
+    ASSERT_EQ(std::string(buffer, end), expected);
+    ASSERT_EQ(actual.to_chars(buffer, buffer + expected.size()), buffer + expected.size());
+    ASSERT_EQ(actual.to_chars(buffer, buffer + expected.size() - 1), nullptr);
+}
 INSTANTIATE_TEST_SUITE_P(
     ipv4_address, ToStringIpv4Params,
     testing::Values(
@@ -604,13 +738,13 @@ TEST(ipv4_address, Hash) {
     auto ip3 = ipv4_address::parse("127.0.0.3");
     auto hash_functor = std::hash<ipv4_address>{};
 
-    ASSERT_EQ(ip1.hash(), sizeof(size_t) == 8 ? 2753421670903790749ULL : 4009513643U);
-    ASSERT_EQ(ip2.hash(), sizeof(size_t) == 8 ? 9476900596348728241ULL : 1628829895U);
-    ASSERT_EQ(ip3.hash(), sizeof(size_t) == 8 ? 5977026382871150005ULL : 778481730U);
+    ASSERT_EQ(ip1.hash(), sizeof(size_t) == 8 ? 575171939555596715ULL : 2242336204U);
+    ASSERT_EQ(ip2.hash(), sizeof(size_t) == 8 ? 9214114593591587948ULL : 2617772447U);
+    ASSERT_EQ(ip3.hash(), sizeof(size_t) == 8 ? 15880774949460593878ULL : 2601717323U);
 
-    ASSERT_EQ(hash_functor(ip1), sizeof(size_t) == 8 ? 2753421670903790749ULL : 4009513643U);
-    ASSERT_EQ(hash_functor(ip2), sizeof(size_t) == 8 ? 9476900596348728241ULL : 1628829895U);
-    ASSERT_EQ(hash_functor(ip3), sizeof(size_t) == 8 ? 5977026382871150005ULL : 778481730U);
+    ASSERT_EQ(hash_functor(ip1), sizeof(size_t) == 8 ? 575171939555596715ULL : 2242336204U);
+    ASSERT_EQ(hash_functor(ip2), sizeof(size_t) == 8 ? 9214114593591587948ULL : 2617772447U);
+    ASSERT_EQ(hash_functor(ip3), sizeof(size_t) == 8 ? 15880774949460593878ULL : 2601717323U);
 }
 
 TEST(ipv4_address, Containers) {
@@ -795,6 +929,49 @@ INSTANTIATE_TEST_SUITE_P(
         std::make_tuple("0.0.0.0", true)
     ));
 
+using ClassifyIpv4Params = TestWithParam<std::tuple<const char*, address_flags>>;
+TEST_P(ClassifyIpv4Params, classify) {
+    const auto expected = std::get<1>(GetParam());
+
+    const auto actual = ipv4_address::parse(std::get<0>(GetParam())).classify();
+
+    ASSERT_EQ(actual, expected);
+}
+INSTANTIATE_TEST_SUITE_P(
+    ipv4_address, ClassifyIpv4Params,
+    testing::Values(
+        std::make_tuple("0.0.0.0", address_flags::is_private | address_flags::is_unspecified),
+        std::make_tuple("0.0.0.1", address_flags::is_private),
+        std::make_tuple("8.8.8.8", address_flags::is_global),
+        std::make_tuple("100.64.0.1", address_flags::none),
+        std::make_tuple("100.128.0.0", address_flags::is_global),
+        std::make_tuple("127.0.0.1", address_flags::is_private | address_flags::is_loopback),
+        std::make_tuple("169.254.100.200", address_flags::is_private | address_flags::is_link_local),
+        std::make_tuple("192.0.0.9", address_flags::is_global),
+        std::make_tuple("192.0.0.170", address_flags::is_private),
+        std::make_tuple("192.0.0.172", address_flags::is_private),
+        std::make_tuple("198.51.100.7", address_flags::is_private),
+        std::make_tuple("198.51.101.7", address_flags::is_global),
+        std::make_tuple("224.0.0.1", address_flags::is_global | address_flags::is_multicast),
+        std::make_tuple("240.0.0.1", address_flags::is_private | address_flags::is_reserved),
+        std::make_tuple("255.255.255.254", address_flags::is_private | address_flags::is_reserved),
+        std::make_tuple("255.255.255.255", address_flags::is_private | address_flags::is_reserved)
+    ));
+
+#ifndef IPADDRESS_TEST_MODULE
+// The classifier tables are checked against the scan of the special-purpose networks they are built from
+TEST(ipv4_address, ClassifyRandomized) {
+    std::mt19937 rng(42);
+    for (auto i = 0; i < 100000; ++i) {
+        // Keep some of the trailing bits only, so that small special-purpose blocks are hit as well
+        const auto value = i % 2 == 0 ? uint32_t(rng()) : uint32_t(rng()) & 0xFFFF00FF;
+        const auto ip = ipv4_address::from_uint(value);
+
+        ASSERT_EQ(ip.classify(), ipaddress::internal::props<ipv4_address>::scan(ip)) << ip;
+    }
+}
+#endif
+
 using Ipv6MappedIpv4Params = TestWithParam<std::tuple<const char*, const char*>>;
 TEST_P(Ipv6MappedIpv4Params, ipv6_mapped) {
     const auto expected = ipv6_address::parse(std::get<1>(GetParam()));
@@ -824,6 +1001,12 @@ TEST_P(SummarizeAddressRangeIpv4AddressParams, summarize_address_range) {
     }
     
     ASSERT_EQ(actual, expected);
+
+    std::vector<ipv4_network> bulk;
+    const std::pair<ipv4_address, ipv4_address> ranges[] = { { first, last }, { first, last } };
+    summarize_address_ranges(std::begin(ranges), std::end(ranges), std::back_inserter(bulk));
+    expected.insert(expected.end(), actual.begin(), actual.end());
+    ASSERT_EQ(bulk, expected);
 }
 INSTANTIATE_TEST_SUITE_P(
     ipv4_address, SummarizeAddressRangeIpv4AddressParams,
@@ -869,3 +1052,46 @@ INSTANTIATE_TEST_SUITE_P(
         std::make_tuple("192.0.2.10", "192.0.2.1", error_code::last_address_must_be_greater_than_first, "last address must be greater than first"),
         std::make_tuple("192.0.2.0", "2001:db8::", error_code::invalid_version, "versions don't match")
     ));
+
+TEST(ipv4_address, SummarizeAddressRangesRandom) {
+    std::mt19937 rng(2024);
+    std::vector<std::pair<ipv4_address, ipv4_address>> ranges;
+    for (size_t i = 0; i < 1000; ++i) {
+        const auto first = uint32_t(rng());
+        const auto last = first + (uint32_t(rng()) >> (rng() % 32));
+        ranges.emplace_back(ipv4_address::from_uint(first), ipv4_address::from_uint(last < first ? 0xFFFFFFFF : last));
+    }
+
+    std::vector<ipv4_network> expected;
+    for (const auto& range : ranges) {
+        for (const auto& net : summarize_address_range(range.first, range.second)) {
+            expected.push_back(net);
+        }
+    }
+    std::vector<ipv4_network> actual(expected.size() + 1);
+    const auto end = summarize_address_ranges(ranges.begin(), ranges.end(), actual.begin());
+    actual.resize(size_t(end - actual.begin()));
+    ASSERT_EQ(actual, expected);
+}
+
+TEST(ipv4_address, SummarizeAddressRangesError) {
+    const std::pair<ipv4_address, ipv4_address> ranges[] = {
+        { ipv4_address::parse("192.0.2.0"), ipv4_address::parse("192.0.2.1") },
+        { ipv4_address::parse("192.0.2.10"), ipv4_address::parse("192.0.2.1") } };
+
+    std::vector<ipv4_network> actual;
+    error_code err = error_code::no_error;
+    summarize_address_ranges(std::begin(ranges), std::end(ranges), std::back_inserter(actual), err);
+    ASSERT_EQ(err, error_code::last_address_must_be_greater_than_first);
+    ASSERT_EQ(actual, std::vector<ipv4_network>{ ipv4_network::parse("192.0.2.0/31") });
+
+#ifdef IPADDRESS_NO_EXCEPTIONS
+    summarize_address_ranges(std::begin(ranges), std::end(ranges), std::back_inserter(actual));
+#elif IPADDRESS_CPP_VERSION >= 14
+    EXPECT_THAT(
+        ([&ranges, &actual]() { summarize_address_ranges(std::begin(ranges), std::end(ranges), std::back_inserter(actual)); }),
+        ThrowsMessage<logic_error>(StrEq("last address must be greater than first")));
+#else
+    ASSERT_THROW(summarize_address_ranges(std::begin(ranges), std::end(ranges), std::back_inserter(actual)), logic_error);
+#endif
+}
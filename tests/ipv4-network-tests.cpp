@@ -1,4 +1,5 @@
 #include <map>
+#include <random>
 #include <vector>
 #include <unordered_map>
 #include <sstream>
@@ -9,6 +10,7 @@
 import ipaddress;
 #else
 #include <ipaddress/ipaddress.hpp>
+#include <ipaddress/parallel.hpp>
 #endif
 
 using namespace testing;
@@ -791,6 +793,18 @@ TEST_P(ToStringNetworkIpv4Params, to_string) {
     ASSERT_EQ(std::to_string(actual), std::string(expected));
     ASSERT_EQ(ss.str(), std::string(expected));
 }
+TEST_P(ToStringNetworkIpv4Params, to_chars) {
+    const auto expected = std::string(std::get<1>(GetParam()));
+
+    const auto actual = ipv4_network::parse(std::get<0>(GetParam()));
+
+    char buffer[32] = {};
+    char* end = actual.to_chars(buffer, buffer + sizeof(buffer));
+    ASSERT_NE(end, nullptr);
+    ASSERT_EQ(std::string(buffer, end), expected);
+    ASSERT_EQ(actual.to_chars(buffer, buffer + expected.size()), buffer + expected.size());
+    ASSERT_EQ(actual.to_chars(buffer, buffer + expected.size() - 1), nullptr);
+}
 INSTANTIATE_TEST_SUITE_P(
     ipv4_network, ToStringNetworkIpv4Params,
     Values(
@@ -881,15 +895,15 @@ TEST(ipv4_network, Hash) {
     auto net4 = ipv4_network::parse("127.0.0.0/16");
     auto hash_functor = std::hash<ipv4_network>{};
 
-    ASSERT_EQ(net1.hash(), sizeof(size_t) == 8 ? 605929542755200525ULL : 2256296057U);
-    ASSERT_EQ(net2.hash(), sizeof(size_t) == 8 ? 605929542755200525ULL : 2256296057U);
-    ASSERT_EQ(net3.hash(), sizeof(size_t) == 8 ? 7623195473821216247ULL : 546525844U);
-    ASSERT_EQ(net4.hash(), sizeof(size_t) == 8 ? 5503161050249481481ULL : 2858631644U);
+    ASSERT_EQ(net1.hash(), sizeof(size_t) == 8 ? 14984290606513558014ULL : 1375679117U);
+    ASSERT_EQ(net2.hash(), sizeof(size_t) == 8 ? 14984290606513558014ULL : 1375679117U);
+    ASSERT_EQ(net3.hash(), sizeof(size_t) == 8 ? 13323469935484181642ULL : 261059657U);
+    ASSERT_EQ(net4.hash(), sizeof(size_t) == 8 ? 2420160266885508566ULL : 504300397U);
 
-    ASSERT_EQ(hash_functor(net1), sizeof(size_t) == 8 ? 605929542755200525ULL : 2256296057U);
-    ASSERT_EQ(hash_functor(net2), sizeof(size_t) == 8 ? 605929542755200525ULL : 2256296057U);
-    ASSERT_EQ(hash_functor(net3), sizeof(size_t) == 8 ? 7623195473821216247ULL : 546525844U);
-    ASSERT_EQ(hash_functor(net4), sizeof(size_t) == 8 ? 5503161050249481481ULL : 2858631644U);
+    ASSERT_EQ(hash_functor(net1), sizeof(size_t) == 8 ? 14984290606513558014ULL : 1375679117U);
+    ASSERT_EQ(hash_functor(net2), sizeof(size_t) == 8 ? 14984290606513558014ULL : 1375679117U);
+    ASSERT_EQ(hash_functor(net3), sizeof(size_t) == 8 ? 13323469935484181642ULL : 261059657U);
+    ASSERT_EQ(hash_functor(net4), sizeof(size_t) == 8 ? 2420160266885508566ULL : 504300397U);
 }
 
 TEST(ipv4_network, Containers) {
@@ -1437,6 +1451,70 @@ INSTANTIATE_TEST_SUITE_P(
         std::make_tuple("192.168.1.128/30", "192.168.1.0/24", error_code::not_contained_network, "network is not a subnet of other")
     ));
 
+using AddressExcludeRangeIpv4NetworkParams = TestWithParam<std::tuple<const char*, std::vector<const char*>, std::vector<const char*>>>;
+TEST_P(AddressExcludeRangeIpv4NetworkParams, address_exclude) {
+    std::vector<ipv4_network> excluded;
+    for (const auto& addr : std::get<1>(GetParam())) {
+        excluded.push_back(ipv4_network::parse(addr));
+    }
+    std::vector<ipv4_network> expected;
+    for (const auto& addr : std::get<2>(GetParam())) {
+        expected.push_back(ipv4_network::parse(addr));
+    }
+
+    const auto network = ipv4_network::parse(std::get<0>(GetParam()));
+    error_code err = error_code::no_error;
+    const auto actual = network.address_exclude(excluded.begin(), excluded.end(), err);
+    ASSERT_EQ(err, error_code::no_error);
+    ASSERT_EQ(actual, expected);
+    ASSERT_EQ(network.address_exclude(excluded.begin(), excluded.end()), expected);
+}
+INSTANTIATE_TEST_SUITE_P(
+    ipv4_network, AddressExcludeRangeIpv4NetworkParams,
+    Values(
+        std::make_tuple("192.0.2.0/28", std::vector<const char*>{}, std::vector<const char*>{ "192.0.2.0/28" }),
+        std::make_tuple("192.0.2.0/28", std::vector<const char*>{ "192.0.2.1/32" }, std::vector<const char*>{ "192.0.2.0/32", "192.0.2.2/31", "192.0.2.4/30", "192.0.2.8/29" }),
+        std::make_tuple("192.0.2.0/28", std::vector<const char*>{ "192.0.2.0/28" }, std::vector<const char*>{}),
+        std::make_tuple("192.0.2.0/24", std::vector<const char*>{ "192.0.2.64/26", "192.0.2.1/32", "192.0.2.64/27", "192.0.2.64/26" }, std::vector<const char*>{ "192.0.2.0/32", "192.0.2.2/31", "192.0.2.4/30", "192.0.2.8/29", "192.0.2.16/28", "192.0.2.32/27", "192.0.2.128/25" }),
+        std::make_tuple("192.0.2.0/24", std::vector<const char*>{ "192.0.2.255/32", "192.0.2.0/32" }, std::vector<const char*>{ "192.0.2.1/32", "192.0.2.2/31", "192.0.2.4/30", "192.0.2.8/29", "192.0.2.16/28", "192.0.2.32/27", "192.0.2.64/26", "192.0.2.128/26", "192.0.2.192/27", "192.0.2.224/28", "192.0.2.240/29", "192.0.2.248/30", "192.0.2.252/31", "192.0.2.254/32" }),
+        std::make_tuple("0.0.0.0/0", std::vector<const char*>{ "0.0.0.0/1", "192.0.0.0/2" }, std::vector<const char*>{ "128.0.0.0/2" }),
+        std::make_tuple("0.0.0.0/0", std::vector<const char*>{ "128.0.0.0/1", "0.0.0.0/1" }, std::vector<const char*>{})
+    ));
+
+TEST(ipv4_network, AddressExcludeRangeError) {
+    const auto network = ipv4_network::parse("192.168.1.0/24");
+    const ipv4_network excluded[] = { ipv4_network::parse("192.168.1.0/25"), ipv4_network::parse("192.168.0.0/16") };
+
+    error_code err = error_code::no_error;
+    const auto actual = network.address_exclude(std::begin(excluded), std::end(excluded), err);
+    ASSERT_EQ(err, error_code::not_contained_network);
+    ASSERT_TRUE(actual.empty());
+
+#ifdef IPADDRESS_NO_EXCEPTIONS
+    ASSERT_TRUE(network.address_exclude(std::begin(excluded), std::end(excluded)).empty());
+#elif IPADDRESS_CPP_VERSION >= 14
+    EXPECT_THAT(
+        ([&network, &excluded]() { (void) network.address_exclude(std::begin(excluded), std::end(excluded)); }),
+        ThrowsMessage<logic_error>(StrEq("network is not a subnet of other")));
+#else
+    ASSERT_THROW((void) network.address_exclude(std::begin(excluded), std::end(excluded)), logic_error);
+#endif
+}
+
+TEST(ipv4_network, AddressExcludeRangeRandom) {
+    std::mt19937 rng(2024);
+    const auto network = ipv4_network::parse("10.0.0.0/16");
+    std::vector<ipv4_network> excluded;
+    for (size_t i = 0; i < 2000; ++i) {
+        const auto address = ipv4_address::from_uint(0x0A000000 | (uint32_t(rng()) & 0xFFFF));
+        excluded.push_back(ipv4_network::from_address(address, 18 + rng() % 15, false));
+    }
+
+    const auto actual = network.address_exclude(excluded.begin(), excluded.end());
+    ASSERT_EQ(actual, collapse_addresses(actual.begin(), actual.end()));
+    ASSERT_EQ(ip_set<ipv4_network>(actual.begin(), actual.end()), ip_set<ipv4_network>({ network }) - ip_set<ipv4_network>(excluded.begin(), excluded.end()));
+}
+
 TEST(ipv4_network, CollapseAddressesOverloads) {
     std::array<ipv4_network, 2> arr = { ipv4_network::parse("192.0.2.0/25"), ipv4_network::parse("192.0.2.128/25") };
     auto collapsed_arr = collapse_addresses(arr);
@@ -1481,6 +1559,56 @@ TEST(ipv4_network, CollapseAddressesOverloads) {
     ASSERT_EQ(collapsed_nets2_0, ipv4_network::parse("192.168.1.0/27"));
 }
 
+TEST(ipv4_network, CollapseAddressesBuffer) {
+    std::vector<ipv4_network> nets;
+    for (uint32_t i = 0; i < 1024; ++i) {
+        nets.push_back(ipv4_network::from_address(ipv4_address::from_uint(0x0A000000 + ((i * 397) % 1024)), 32));
+    }
+    nets.push_back(ipv4_network::parse("10.0.1.0/24"));
+    nets.push_back(ipv4_network::parse("10.0.1.0/24"));
+    nets.push_back(ipv4_network::parse("10.0.8.0/24"));
+
+    collapse_buffer<ipv4_network> buffer;
+    buffer.reserve(nets.size());
+    ASSERT_GE(buffer.capacity(), nets.size());
+
+    const auto collapsed = collapse_addresses(nets.begin(), nets.end(), buffer);
+    ASSERT_EQ(collapsed.size(), 2);
+    ASSERT_EQ(collapsed[0], ipv4_network::parse("10.0.0.0/22"));
+    ASSERT_EQ(collapsed[1], ipv4_network::parse("10.0.8.0/24"));
+    ASSERT_EQ(collapse_addresses(nets.begin(), nets.end()), collapsed);
+
+    nets.erase(nets.begin() + 1);
+    error_code code = error_code::no_error;
+    const auto collapsed_again = collapse_addresses(nets.begin(), nets.end(), buffer, code);
+    ASSERT_EQ(code, error_code::no_error);
+    ASSERT_EQ(collapsed_again, collapse_addresses(nets.begin(), nets.end()));
+
+    buffer.clear();
+    ASSERT_EQ(buffer.capacity(), 0);
+}
+
+TEST(ipv4_network, CollapseAddressesThreads) {
+    std::vector<ipv4_network> nets;
+    uint32_t seed = 2024;
+    for (size_t i = 0; i < 200000; ++i) {
+        seed = seed * 1664525 + 1013904223;
+        const auto prefixlen = 20 + (seed >> 8) % 13;
+        const auto address = ipv4_address::from_uint(0x0A000000 | ((seed >> 4) & 0x000FFFFF));
+        nets.push_back(ipv4_network::from_address(address, prefixlen, false));
+    }
+    nets.push_back(ipv4_network::parse("10.0.0.0/13"));
+    nets.push_back(ipv4_network::parse("192.0.2.0/24"));
+
+    const auto expected = collapse_addresses(nets.begin(), nets.end());
+    for (size_t threads : { 0, 1, 2, 3, 8, 64 }) {
+        error_code code = error_code::no_error;
+        const auto actual = collapse_addresses(nets.begin(), nets.end(), threads, code);
+        ASSERT_EQ(code, error_code::no_error);
+        ASSERT_EQ(actual, expected) << threads;
+    }
+}
+
 using CollapseAddressesIpv4NetworkParams = TestWithParam<std::tuple<std::vector<const char*>, std::vector<const char*>>>;
 TEST_P(CollapseAddressesIpv4NetworkParams, collapse_addresses) {
     std::vector<ipv4_network> expected;
@@ -1508,6 +1636,15 @@ INSTANTIATE_TEST_SUITE_P(
         std::make_tuple(
             std::vector<const char*>{"192.168.1.1/32", "192.168.1.0/32"},
             std::vector<const char*>{"192.168.1.0/31"}),
+        std::make_tuple(
+            std::vector<const char*>{"192.0.2.0/25", "192.0.2.0/25"},
+            std::vector<const char*>{"192.0.2.0/25"}),
+        std::make_tuple(
+            std::vector<const char*>{"10.0.0.1/32", "10.1.0.0/16", "10.0.0.0/8"},
+            std::vector<const char*>{"10.0.0.0/8"}),
+        std::make_tuple(
+            std::vector<const char*>{"128.0.0.0/1", "10.0.0.0/8", "0.0.0.0/1"},
+            std::vector<const char*>{"0.0.0.0/0"}),
         std::make_tuple(
             std::vector<const char*>{"192.168.1.3/32", "192.168.1.0/32", "192.168.1.1/32"},
             std::vector<const char*>{"192.168.1.0/31", "192.168.1.3/32"}),
@@ -1,4 +1,5 @@
 #include <map>
+#include <random>
 #include <vector>
 #include <unordered_map>
 #include <sstream>
@@ -237,6 +238,11 @@ TEST(ipv6_address, CompileTime) {
     ASSERT_TRUE(ip30);
     ASSERT_FALSE(ip31);
 
+    constexpr auto ip31_1 = ipv6_address::parse("2001:db8::1").classify();
+    constexpr auto ip31_2 = ipv6_address::parse("::1").classify();
+    ASSERT_EQ(ip31_1, address_flags::is_private);
+    ASSERT_EQ(ip31_2, address_flags::is_private | address_flags::is_reserved | address_flags::is_loopback);
+
     constexpr auto ipv32 = ipv6_address::parse("::ffff:192.168.1.1").ipv4_mapped();
     constexpr auto ipv33 = ipv6_address::parse("::c0a8:101").ipv4_mapped();
     constexpr auto ipv32_has_value = ipv32.has_value();
@@ -492,7 +498,12 @@ INSTANTIATE_TEST_SUITE_P(
         std::make_tuple("fe80::1ff:fe23:4567:890a%25eth01234567", ipv6_address::base_type{ 0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xff, 0xfe, 0x23, 0x45, 0x67, 0x89, 0x0a }, true, false, "25eth01234567", 0),
         std::make_tuple("fe80::1ff:fe23:4567:890a%3", ipv6_address::base_type{ 0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xff, 0xfe, 0x23, 0x45, 0x67, 0x89, 0x0a }, true, true, "3", 3),
         std::make_tuple("fe80::1ff:fe23:4567:890a%31", ipv6_address::base_type{ 0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xff, 0xfe, 0x23, 0x45, 0x67, 0x89, 0x0a }, true, true, "31", 31),
-        std::make_tuple("1:2:3:4:5:6:42.42.42.1", ipv6_address::base_type{ 0x00, 0x01, 0x00, 0x02, 0x00, 0x03, 0x00, 0x04, 0x00, 0x05, 0x00, 0x06, 0x2A, 0x2A, 0x2A, 0x01 }, false, false, "", 0)
+        std::make_tuple("1:2:3:4:5:6:42.42.42.1", ipv6_address::base_type{ 0x00, 0x01, 0x00, 0x02, 0x00, 0x03, 0x00, 0x04, 0x00, 0x05, 0x00, 0x06, 0x2A, 0x2A, 0x2A, 0x01 }, false, false, "", 0),
+        std::make_tuple("0001:0002:0003:0004:0005:0006:0007:0008%12345", ipv6_address::base_type{ 0x00, 0x01, 0x00, 0x02, 0x00, 0x03, 0x00, 0x04, 0x00, 0x05, 0x00, 0x06, 0x00, 0x07, 0x00, 0x08 }, true, true, "12345", 12345),
+        std::make_tuple("::1:2:3:4:5:6:7", ipv6_address::base_type{ 0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00, 0x03, 0x00, 0x04, 0x00, 0x05, 0x00, 0x06, 0x00, 0x07 }, false, false, "", 0),
+        std::make_tuple("1:2:3:4:5:6:7::", ipv6_address::base_type{ 0x00, 0x01, 0x00, 0x02, 0x00, 0x03, 0x00, 0x04, 0x00, 0x05, 0x00, 0x06, 0x00, 0x07, 0x00, 0x00 }, false, false, "", 0),
+        std::make_tuple("1::2:3:4:5:42.42.42.1%eth0", ipv6_address::base_type{ 0x00, 0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x03, 0x00, 0x04, 0x00, 0x05, 0x2A, 0x2A, 0x2A, 0x01 }, true, false, "eth0", 0),
+        std::make_tuple("::FfFf:42.42.42.1", ipv6_address::base_type{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0x2A, 0x2A, 0x2A, 0x01 }, false, false, "", 0)
     ));
 
 using InvalidAddressIpv6Params = TestWithParam<std::tuple<const char*, error_code, const char*>>;
@@ -535,6 +546,7 @@ INSTANTIATE_TEST_SUITE_P(
         std::make_tuple("10:9:8:7:6:5:4:3:2:1", error_code::most_8_colons_permitted, "most 8 colons permitted in address 10:9:8:7:6:5:4:3:2:1"),
         std::make_tuple("10:9:8:7:6:5:4:3:42.42.42.42", error_code::most_8_colons_permitted, "most 8 colons permitted in address 10:9:8:7:6:5:4:3:42.42.42.42"),
         std::make_tuple("1:2:3:4:5:6:7:42.42.42.42", error_code::most_8_colons_permitted, "most 8 colons permitted in address 1:2:3:4:5:6:7:42.42.42.42"),
+        std::make_tuple("::1:2:3:4:5:42.42.42.42", error_code::most_8_colons_permitted, "most 8 colons permitted in address ::1:2:3:4:5:42.42.42.42"),
         std::make_tuple("10:9:8:7:6:5:4:3:2:1%scope", error_code::most_8_colons_permitted, "most 8 colons permitted in address 10:9:8:7:6:5:4:3:2:1%scope"),
         std::make_tuple("10:9:8:7:6:5:4:3:42.42.42.42%scope", error_code::most_8_colons_permitted, "most 8 colons permitted in address 10:9:8:7:6:5:4:3:42.42.42.42%scope"),
 
@@ -835,6 +847,29 @@ TEST_P(ToStringIpv6Params, to_string) {
     ASSERT_EQ(ss_compressed.str(), std::string(expected_compressed));
     ASSERT_EQ(ss_compressed_upper.str(), std::string(expected_compressed_upper));
 }
+TEST_P(ToStringIpv6Params, to_chars) {
+    const char* expected_address = std::get<0>(GetParam());
+    const char* expected_full = std::get<1>(GetParam());
+    const char* expected_compact = std::get<2>(GetParam());
+    const char* expected_compressed = std::get<3>(GetParam());
+
+    const auto actual = ipv6_address::parse(expected_address);
+
+    char buffer[ipv6_address::base_max_string_len] = {};
+    char* end = actual.to_chars(buffer, buffer + sizeof(buffer), format::full);
+    ASSERT_NE(end, nullptr);
+    ASSERT_EQ(std::string(buffer, end), std::string(expected_full));
+    end = actual.to_chars(buffer, buffer + sizeof(buffer), format::compact);
+    ASSERT_NE(end, nullptr);
+    ASSERT_EQ(std::string(buffer, end), std::string(expected_compact));
+    end = actual.to_chars(buffer, buffer + sizeof(buffer));
+    ASSERT_NE(end, nullptr);
+    ASSERT_EQ(std::string(buffer, end), std::string(expected_compressed));
+
+    const auto size = std::string(expected_compressed).size();
+    ASSERT_EQ(actual.to_chars(buffer, buffer + size), buffer + size);
+    ASSERT_EQ(actual.to_chars(buffer, buffer + size - 1), nullptr);
+}
 INSTANTIATE_TEST_SUITE_P(
     ipv6_address, ToStringIpv6Params,
     testing::Values(
@@ -925,15 +960,15 @@ TEST(ipv6_address, Hash) {
     auto ip3_with_scope = ipv6_address::parse("2001:db8::3%scope");
     auto hash_functor = std::hash<ipv6_address>{};
 
-    ASSERT_EQ(ip1.hash(), sizeof(size_t) == 8 ? 6222153021643990098ULL : 1539407693U);
-    ASSERT_EQ(ip2.hash(), sizeof(size_t) == 8 ? 6116520725720747177ULL : 2230264075U);
-    ASSERT_EQ(ip3.hash(), sizeof(size_t) == 8 ? 16584966935191602359ULL : 4145152766U);
-    ASSERT_EQ(ip3_with_scope.hash(), sizeof(size_t) == 8 ? 460899037339188753ULL : 844563635U);
+    ASSERT_EQ(ip1.hash(), sizeof(size_t) == 8 ? 245662094094632270ULL : 1392502674U);
+    ASSERT_EQ(ip2.hash(), sizeof(size_t) == 8 ? 18367635084453420508ULL : 3197972959U);
+    ASSERT_EQ(ip3.hash(), sizeof(size_t) == 8 ? 10370075033955729328ULL : 1122170980U);
+    ASSERT_EQ(ip3_with_scope.hash(), sizeof(size_t) == 8 ? 16363380912208936941ULL : 1180320243U);
 
-    ASSERT_EQ(hash_functor(ip1), sizeof(size_t) == 8 ? 6222153021643990098ULL : 1539407693U);
-    ASSERT_EQ(hash_functor(ip2), sizeof(size_t) == 8 ? 6116520725720747177ULL : 2230264075U);
-    ASSERT_EQ(hash_functor(ip3), sizeof(size_t) == 8 ? 16584966935191602359ULL : 4145152766U);
-    ASSERT_EQ(hash_functor(ip3_with_scope), sizeof(size_t) == 8 ? 460899037339188753ULL : 844563635U);
+    ASSERT_EQ(hash_functor(ip1), sizeof(size_t) == 8 ? 245662094094632270ULL : 1392502674U);
+    ASSERT_EQ(hash_functor(ip2), sizeof(size_t) == 8 ? 18367635084453420508ULL : 3197972959U);
+    ASSERT_EQ(hash_functor(ip3), sizeof(size_t) == 8 ? 10370075033955729328ULL : 1122170980U);
+    ASSERT_EQ(hash_functor(ip3_with_scope), sizeof(size_t) == 8 ? 16363380912208936941ULL : 1180320243U);
 }
 
 TEST(ipv6_address, Containers) {
@@ -1150,6 +1185,68 @@ INSTANTIATE_TEST_SUITE_P(
         std::make_tuple("ff00::", false)
     ));
 
+using ClassifyIpv6Params = TestWithParam<std::tuple<const char*, address_flags>>;
+TEST_P(ClassifyIpv6Params, classify) {
+    const auto expected = std::get<1>(GetParam());
+
+    const auto actual = ipv6_address::parse(std::get<0>(GetParam())).classify();
+
+    ASSERT_EQ(actual, expected);
+}
+INSTANTIATE_TEST_SUITE_P(
+    ipv6_address, ClassifyIpv6Params,
+    testing::Values(
+        std::make_tuple("::", address_flags::is_private | address_flags::is_reserved | address_flags::is_unspecified),
+        std::make_tuple("::1", address_flags::is_private | address_flags::is_reserved | address_flags::is_loopback),
+        std::make_tuple("::2", address_flags::is_global | address_flags::is_reserved),
+        std::make_tuple("::ffff:10.0.0.1", address_flags::is_private | address_flags::is_reserved),
+        std::make_tuple("::ffff:8.8.8.8", address_flags::is_global | address_flags::is_reserved),
+        std::make_tuple("64:ff9b:1::1", address_flags::is_private | address_flags::is_reserved),
+        std::make_tuple("64:ff9b::1", address_flags::is_global | address_flags::is_reserved),
+        std::make_tuple("100::1", address_flags::is_private | address_flags::is_reserved),
+        std::make_tuple("100:0:0:1::1", address_flags::is_global | address_flags::is_reserved),
+        std::make_tuple("2001:1::1", address_flags::is_global),
+        std::make_tuple("2001:1::3", address_flags::is_private),
+        std::make_tuple("2001:3::1", address_flags::is_global),
+        std::make_tuple("2001:4:112::1", address_flags::is_global),
+        std::make_tuple("2001:4:113::1", address_flags::is_private),
+        std::make_tuple("2001:2f::1", address_flags::is_global),
+        std::make_tuple("2001:db8::1", address_flags::is_private),
+        std::make_tuple("2002::1", address_flags::is_private),
+        std::make_tuple("2606:4700::1111", address_flags::is_global),
+        std::make_tuple("fc00::1", address_flags::is_private),
+        std::make_tuple("fe80::1", address_flags::is_private | address_flags::is_link_local),
+        std::make_tuple("fec0::1", address_flags::is_global | address_flags::is_site_local),
+        std::make_tuple("ff02::1", address_flags::is_global | address_flags::is_multicast)
+    ));
+
+#ifndef IPADDRESS_TEST_MODULE
+TEST(ipv6_address, ClassifyRandomized) {
+    std::mt19937_64 rng(42);
+    for (auto i = 0; i < 100000; ++i) {
+        // Zero out some of the middle bits, so that small special-purpose blocks are hit as well
+        auto upper = rng();
+        auto lower = rng();
+        if (i % 4 == 1) {
+            upper &= 0xFFFFFFFF0000FFFFULL;
+            lower &= 0xFFFF;
+        } else if (i % 4 == 2) {
+            upper &= 0xFFFF0000000000FFULL;
+            lower = (lower & 0xFFFFFFFFULL) | 0xFFFF00000000ULL;
+        } else if (i % 4 == 3) {
+            upper &= 0x000000000000FFFFULL;
+            lower &= 0xFF;
+        }
+        const auto ip = ipv6_address::from_uint(uint128_t(upper, lower));
+
+        ASSERT_EQ(ip.classify(), ipaddress::internal::props<ipv6_address>::scan(ip)) << ip;
+        ASSERT_EQ(ip.is_private(), ipaddress::internal::props<ipv6_address>::scan_private(ip)) << ip;
+        ASSERT_EQ(ip.is_global(), ipaddress::internal::props<ipv6_address>::scan_global(ip)) << ip;
+        ASSERT_EQ(ip.is_reserved(), ipaddress::internal::props<ipv6_address>::scan_reserved(ip)) << ip;
+    }
+}
+#endif
+
 using Ipv4MappedIpv6Params = TestWithParam<std::tuple<const char*, const char*, bool>>;
 TEST_P(Ipv4MappedIpv6Params, ipv4_mapped) {
     const auto expected_ipv4 = std::get<1>(GetParam());
@@ -1221,6 +1318,12 @@ TEST_P(SummarizeAddressRangeIpv6AddressParams, summarize_address_range) {
     }
     
     ASSERT_EQ(actual, expected);
+
+    std::vector<ipv6_network> bulk;
+    const std::pair<ipv6_address, ipv6_address> ranges[] = { { first, last }, { first, last } };
+    summarize_address_ranges(std::begin(ranges), std::end(ranges), std::back_inserter(bulk));
+    expected.insert(expected.end(), actual.begin(), actual.end());
+    ASSERT_EQ(bulk, expected);
 }
 INSTANTIATE_TEST_SUITE_P(
     ipv6_address, SummarizeAddressRangeIpv6AddressParams,
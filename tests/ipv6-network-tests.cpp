@@ -9,6 +9,7 @@
 import ipaddress;
 #else
 #include <ipaddress/ipaddress.hpp>
+#include <ipaddress/parallel.hpp>
 #endif
 
 using namespace testing;
@@ -798,6 +799,28 @@ TEST_P(ToStringNetworkIpv6Params, to_string) {
     ASSERT_EQ(ss_compact.str(), std::string(expected_compact));
     ASSERT_EQ(ss_compressed.str(), std::string(expected_compressed));
 }
+TEST_P(ToStringNetworkIpv6Params, to_chars) {
+    const auto expected_full = std::get<1>(GetParam());
+    const auto expected_compact = std::get<2>(GetParam());
+    const auto expected_compressed = std::get<3>(GetParam());
+
+    const auto actual = ipv6_network::parse(std::get<0>(GetParam()));
+
+    char buffer[64] = {};
+    char* end = actual.to_chars(buffer, buffer + sizeof(buffer), format::full);
+    ASSERT_NE(end, nullptr);
+    ASSERT_EQ(std::string(buffer, end), std::string(expected_full));
+    end = actual.to_chars(buffer, buffer + sizeof(buffer), format::compact);
+    ASSERT_NE(end, nullptr);
+    ASSERT_EQ(std::string(buffer, end), std::string(expected_compact));
+    end = actual.to_chars(buffer, buffer + sizeof(buffer));
+    ASSERT_NE(end, nullptr);
+    ASSERT_EQ(std::string(buffer, end), std::string(expected_compressed));
+
+    const auto size = std::string(expected_compressed).size();
+    ASSERT_EQ(actual.to_chars(buffer, buffer + size), buffer + size);
+    ASSERT_EQ(actual.to_chars(buffer, buffer + size - 1), nullptr);
+}
 INSTANTIATE_TEST_SUITE_P(
     ipv6_network, ToStringNetworkIpv6Params,
     testing::Values(
@@ -913,15 +936,15 @@ TEST(ipv6_network, Hash) {
     auto net4 = ipv6_network::parse("2001:db8::%scope/32");
     auto hash_functor = std::hash<ipv6_network>{};
 
-    ASSERT_EQ(net1.hash(), sizeof(size_t) == 8 ? 15427398023827107304ULL : 3105424018U);
-    ASSERT_EQ(net2.hash(), sizeof(size_t) == 8 ? 15427398023827107304ULL : 3105424018U);
-    ASSERT_EQ(net3.hash(), sizeof(size_t) == 8 ? 15947883579910446492ULL : 3052474356U);
-    ASSERT_EQ(net4.hash(), sizeof(size_t) == 8 ? 1368690913789066344ULL : 589600209U);
+    ASSERT_EQ(net1.hash(), sizeof(size_t) == 8 ? 13941985508749465331ULL : 2382898453U);
+    ASSERT_EQ(net2.hash(), sizeof(size_t) == 8 ? 13941985508749465331ULL : 2382898453U);
+    ASSERT_EQ(net3.hash(), sizeof(size_t) == 8 ? 10919206251649669972ULL : 520266641U);
+    ASSERT_EQ(net4.hash(), sizeof(size_t) == 8 ? 294159985467377673ULL : 3739730908U);
 
-    ASSERT_EQ(hash_functor(net1), sizeof(size_t) == 8 ? 15427398023827107304ULL : 3105424018U);
-    ASSERT_EQ(hash_functor(net2), sizeof(size_t) == 8 ? 15427398023827107304ULL : 3105424018U);
-    ASSERT_EQ(hash_functor(net3), sizeof(size_t) == 8 ? 15947883579910446492ULL : 3052474356U);
-    ASSERT_EQ(hash_functor(net4), sizeof(size_t) == 8 ? 1368690913789066344ULL : 589600209U);
+    ASSERT_EQ(hash_functor(net1), sizeof(size_t) == 8 ? 13941985508749465331ULL : 2382898453U);
+    ASSERT_EQ(hash_functor(net2), sizeof(size_t) == 8 ? 13941985508749465331ULL : 2382898453U);
+    ASSERT_EQ(hash_functor(net3), sizeof(size_t) == 8 ? 10919206251649669972ULL : 520266641U);
+    ASSERT_EQ(hash_functor(net4), sizeof(size_t) == 8 ? 294159985467377673ULL : 3739730908U);
 }
 
 TEST(ipv6_network, Containers) {
@@ -1568,6 +1591,36 @@ TEST(ipv6_network, CollapseAddressesOverloads) {
     ASSERT_EQ(collapsed_nets2_4, ipv6_network::parse("2001:db8::20/126"));
 }
 
+TEST(ipv6_network, CollapseAddressesBuffer) {
+    std::vector<ipv6_network> nets;
+    for (uint64_t i = 0; i < 512; ++i) {
+        nets.push_back(ipv6_network::from_address(ipv6_address::from_uint(uint128_t(0x20010DB800000000ULL, (i * 211) % 512)), 128));
+        nets.push_back(ipv6_network::from_address(ipv6_address::from_uint(uint128_t(0x20010DB800010000ULL | i, 0)), 64));
+    }
+
+    collapse_buffer<ipv6_network> buffer;
+    const auto collapsed = collapse_addresses(nets.begin(), nets.end(), buffer);
+    ASSERT_EQ(collapsed.size(), 2);
+    ASSERT_EQ(collapsed[0], ipv6_network::parse("2001:db8::/119"));
+    ASSERT_EQ(collapsed[1], ipv6_network::parse("2001:db8:1::/55"));
+    ASSERT_EQ(collapse_addresses(nets.begin(), nets.end(), buffer), collapsed);
+}
+
+TEST(ipv6_network, CollapseAddressesThreads) {
+    std::vector<ipv6_network> nets;
+    uint64_t seed = 2024;
+    for (size_t i = 0; i < 100000; ++i) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        const auto prefixlen = 100 + (seed >> 40) % 29;
+        const auto address = ipv6_address::from_uint(uint128_t(0x20010DB800000000ULL, (seed >> 16) & 0x3FFFFFF));
+        nets.push_back(ipv6_network::from_address(address, prefixlen, false));
+    }
+
+    const auto expected = collapse_addresses(nets.begin(), nets.end());
+    const auto actual = collapse_addresses(nets.begin(), nets.end(), 4);
+    ASSERT_EQ(actual, expected);
+}
+
 using CollapseAddressesIpv6NetworkParams = TestWithParam<std::tuple<std::vector<const char*>, std::vector<const char*>>>;
 TEST_P(CollapseAddressesIpv6NetworkParams, collapse_addresses) {
     std::vector<ipv6_network> expected;
@@ -1592,6 +1645,15 @@ INSTANTIATE_TEST_SUITE_P(
         std::make_tuple(
             std::vector<const char*>{"2001:db8::1/128", "2001:db8::2/128"},
             std::vector<const char*>{"2001:db8::1/128", "2001:db8::2/128"}),
+        std::make_tuple(
+            std::vector<const char*>{"2001:db8::/127", "2001:db8::/127"},
+            std::vector<const char*>{"2001:db8::/127"}),
+        std::make_tuple(
+            std::vector<const char*>{"2001:db8::1/128", "2001:db8:1::/48", "2001:db8::/32", "2001:db9::/32"},
+            std::vector<const char*>{"2001:db8::/31"}),
+        std::make_tuple(
+            std::vector<const char*>{"8000::/1", "2001:db8::/32", "::/1"},
+            std::vector<const char*>{"::/0"}),
         std::make_tuple(
             std::vector<const char*>{"2001:db8::1/128", "2001:db8::2/128", "2001:db8::4/128"},
             std::vector<const char*>{"2001:db8::1/128", "2001:db8::2/128", "2001:db8::4/128"}),